@@ -240,6 +240,8 @@ bool print_annotate_event(PRINT_EVENT_INFO *print_event_info)
 static Exit_status dump_local_log_entries(PRINT_EVENT_INFO *, const char*);
 static Exit_status dump_remote_log_entries(PRINT_EVENT_INFO *, const char*);
 static Exit_status dump_log_entries(const char* logname);
+static Exit_status process_payload_events(PRINT_EVENT_INFO *, Log_event *,
+                                          my_off_t, const char *);
 static Exit_status safe_connect();
 
 
@@ -1493,6 +1495,11 @@ Exit_status process_event(PRINT_EVENT_INFO *print_event_info, Log_event *ev,
         destroy_evt= FALSE;
       break;
     }
+    case TRANSACTION_PAYLOAD_EVENT:
+      if (ev->print(result_file, print_event_info))
+        goto err;
+      retval= process_payload_events(print_event_info, ev, pos, logname);
+      break;
     case START_ENCRYPTION_EVENT:
       glob_description_event->start_decryption((Start_encryption_log_event*)ev);
       /* fall through */
@@ -1550,7 +1557,7 @@ Exit_status process_event(PRINT_EVENT_INFO *print_event_info, Log_event *ev,
       }
     }
 
-    if (remote_opt)
+    if (remote_opt && !ev->event_owns_temp_buf)
       ev->temp_buf= 0;
     if (destroy_evt) /* destroy it later if not set (ignored table map) */
       delete ev;
@@ -1560,6 +1567,66 @@ Exit_status process_event(PRINT_EVENT_INFO *print_event_info, Log_event *ev,
 }
 
 
+/**
+  Process the events of a Transaction_payload_log_event one by one, as if
+  they were read from the binlog in place of the payload event.
+
+  @param[in,out] print_event_info Parameters and context state
+  determining how to print.
+  @param[in] ev The Transaction_payload_log_event.
+  @param[in] pos Offset of the payload event from beginning of binlog file.
+  @param[in] logname Name of input binlog.
+
+  @return As for process_event().
+*/
+static Exit_status process_payload_events(PRINT_EVENT_INFO *print_event_info,
+                                          Log_event *ev, my_off_t pos,
+                                          const char *logname)
+{
+  Exit_status retval= OK_CONTINUE;
+  char *events;
+  ulong events_len;
+  bool is_malloc;
+  const char *buf, *end;
+
+  if (!ev->temp_buf ||
+      transaction_payload_uncompress(glob_description_event,
+                                     ev->checksum_alg ==
+                                     BINLOG_CHECKSUM_ALG_CRC32,
+                                     ev->temp_buf,
+                                     uint4korr(ev->temp_buf +
+                                               EVENT_LEN_OFFSET),
+                                     NULL, 0, &is_malloc, &events,
+                                     &events_len))
+  {
+    error("Could not uncompress the events of a Transaction_payload event "
+          "at offset %llu.", (ulonglong) pos);
+    return ERROR_STOP;
+  }
+
+  for (buf= events, end= events + events_len;
+       buf < end && retval == OK_CONTINUE; )
+  {
+    ulong event_len= uint4korr(buf + EVENT_LEN_OFFSET);
+    const char *error_msg= 0;
+    Log_event *inner;
+
+    /* The event owns a copy of its buffer, as it may be kept */
+    if (!(inner= read_remote_annotate_event((uchar*) buf, event_len,
+                                            &error_msg)))
+    {
+      error("Could not construct log event object: %s", error_msg);
+      retval= ERROR_STOP;
+      break;
+    }
+    retval= process_event(print_event_info, inner, pos, logname);
+    buf+= event_len;
+  }
+  my_free(events);
+  return retval;
+}
+
+
 static struct my_option my_options[] =
 {
   {"help", '?', "Display this help and exit.",
@@ -0,0 +1,57 @@
+MACRO (MYSQL_CHECK_URING)
+
+  STRING(TOLOWER "${WITH_URING}" WITH_URING_LOWERCASE)
+
+  IF(NOT WITH_URING)
+    MESSAGE_ONCE(uring "WITH_URING=OFF: io_uring asynchronous I/O disabled")
+
+  ELSEIF(NOT WITH_URING_LOWERCASE STREQUAL "auto" AND NOT WITH_URING_LOWERCASE STREQUAL "on")
+      MESSAGE(FATAL_ERROR "Wrong value for WITH_URING")
+
+  ELSEIF(CMAKE_SYSTEM_NAME MATCHES "Linux")
+    CHECK_INCLUDE_FILES(liburing.h HAVE_LIBURING_H)
+
+    IF(HAVE_LIBURING_H)
+      SET(SAVE_CMAKE_REQUIRED_LIBRARIES ${CMAKE_REQUIRED_LIBRARIES})
+      SET(CMAKE_REQUIRED_LIBRARIES ${CMAKE_REQUIRED_LIBRARIES} uring)
+      CHECK_C_SOURCE_COMPILES(
+      "
+      #include <liburing.h>
+      int main()
+      {
+         struct io_uring ring;
+         struct io_uring_sqe *sqe;
+         if (io_uring_queue_init(8, &ring, 0))
+           return 1;
+         sqe= io_uring_get_sqe(&ring);
+         io_uring_prep_nop(sqe);
+         io_uring_submit(&ring);
+         io_uring_queue_exit(&ring);
+         return 0;
+      }"
+      HAVE_URING)
+      SET(CMAKE_REQUIRED_LIBRARIES ${SAVE_CMAKE_REQUIRED_LIBRARIES})
+      IF(HAVE_URING)
+        # HAVE_URING is defined for the compiler by innodb.cmake,
+        # because libaio is needed as well
+        SET(URING_LIBRARY "uring")
+      ENDIF()
+    ENDIF()
+
+    IF(WITH_URING_LOWERCASE STREQUAL "auto" AND HAVE_URING)
+      MESSAGE_ONCE(uring "WITH_URING=AUTO: io_uring asynchronous I/O enabled")
+    ELSEIF(WITH_URING_LOWERCASE STREQUAL "auto" AND NOT HAVE_URING)
+      MESSAGE_ONCE(uring "WITH_URING=AUTO: io_uring asynchronous I/O disabled")
+    ELSEIF(HAVE_URING)
+      MESSAGE_ONCE(uring "WITH_URING=ON: io_uring asynchronous I/O enabled")
+    ELSE()
+      # Forget it in cache, abort the build.
+      UNSET(WITH_URING CACHE)
+      UNSET(URING_LIBRARY CACHE)
+      MESSAGE(FATAL_ERROR "WITH_URING=ON: Could not find liburing headers/libraries")
+    ENDIF()
+
+ ENDIF()
+
+ENDMACRO()
+
@@ -74,6 +74,7 @@
 #cmakedefine HAVE_SYS_PRCTL_H 1
 #cmakedefine HAVE_SYS_RESOURCE_H 1
 #cmakedefine HAVE_SYS_SELECT_H 1
+#cmakedefine HAVE_SYS_SENDFILE_H 1
 #cmakedefine HAVE_SYS_SHM_H 1
 #cmakedefine HAVE_SYS_SOCKET_H 1
 #cmakedefine HAVE_SYS_SOCKIO_H 1
@@ -209,8 +210,10 @@
 #cmakedefine HAVE_REALPATH 1
 #cmakedefine HAVE_RENAME 1
 #cmakedefine HAVE_RWLOCK_INIT 1
+#cmakedefine HAVE_SCHED_GETCPU 1
 #cmakedefine HAVE_SCHED_YIELD 1
 #cmakedefine HAVE_SELECT 1
+#cmakedefine HAVE_SENDFILE 1
 #cmakedefine HAVE_SETENV 1
 #cmakedefine HAVE_SETLOCALE 1
 #cmakedefine HAVE_SETUPTERM 1
@@ -633,6 +633,8 @@ unsigned long my_net_read_packet_reallen(NET *net, my_bool read_from_server,
 #ifdef MY_GLOBAL_INCLUDED
 void my_net_set_write_timeout(NET *net, uint timeout);
 void my_net_set_read_timeout(NET *net, uint timeout);
+my_bool net_write_file(NET *net, const uchar *header, size_t head_len,
+                       File file, my_off_t offset, size_t len);
 #endif
 
 struct sockaddr;
@@ -79,6 +79,9 @@ my_bool vio_reset(Vio* vio, enum enum_vio_type type,
 size_t	vio_read(Vio *vio, uchar *	buf, size_t size);
 size_t  vio_read_buff(Vio *vio, uchar * buf, size_t size);
 size_t	vio_write(Vio *vio, const uchar * buf, size_t size);
+/* Write a header and a part of a file, with sendfile() when possible */
+int	vio_sendfile(Vio *vio, const uchar *header, size_t header_length,
+                     File file, my_off_t offset, size_t length);
 int	vio_blocking(Vio *vio, my_bool onoff, my_bool *old_mode);
 my_bool	vio_is_blocking(Vio *vio);
 /* setsockopt TCP_NODELAY at IPPROTO_TCP level, when possible */
@@ -56,9 +56,12 @@ static uint suffix_length(ulong string_length);
 static uint sortlength(THD *thd, SORT_FIELD *sortorder, uint s_length,
 		       bool *multi_byte_charset);
 static SORT_ADDON_FIELD *get_addon_fields(TABLE *table, uint sortlength,
-                                          LEX_STRING *addon_buf);
+                                          LEX_STRING *addon_buf,
+                                          bool *packed);
 static void unpack_addon_fields(struct st_sort_addon_field *addon_field,
                                 uchar *buff, uchar *buff_end);
+static void unpack_packed_addon_fields(struct st_sort_addon_field *addon_field,
+                                       uchar *buff, uchar *buff_end);
 static bool check_if_pq_applicable(Sort_param *param, SORT_INFO *info,
                                    TABLE *table,
                                    ha_rows records, size_t memory_available);
@@ -77,7 +80,8 @@ void Sort_param::init_for_filesort(uint sortlen, TABLE *table,
       Get the descriptors of all fields whose values are appended 
       to sorted fields and get its total length in addon_buf.length
     */
-    addon_field= get_addon_fields(table, sort_length, &addon_buf);
+    addon_field= get_addon_fields(table, sort_length, &addon_buf,
+                                  &using_packed_addons);
   }
   if (addon_field)
   {
@@ -182,10 +186,17 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   param.init_for_filesort(sortlength(thd, filesort->sortorder, s_length,
                                      &multi_byte_charset),
                           table, max_rows, filesort->sort_positions);
+  param.max_sort_threads= (uint) thd->variables.max_sort_threads;
+  if (param.max_sort_threads > 1 &&
+      !(param.thread_stats=
+        tracker->get_sort_thread_stats(thd->mem_root,
+                                       param.max_sort_threads)))
+    param.max_sort_threads= 1;
 
   sort->addon_buf=    param.addon_buf;
   sort->addon_field=  param.addon_field;
-  sort->unpack=       unpack_addon_fields;
+  sort->unpack=       (param.using_packed_addons ?
+                       unpack_packed_addon_fields : unpack_addon_fields);
   if (multi_byte_charset &&
       !(param.tmp_buffer= (char*) my_malloc(param.sort_length,
                                             MYF(MY_WME | MY_THREAD_SPECIFIC))))
@@ -251,7 +262,10 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
       goto err;
     }
     tracker->report_sort_buffer_size(sort->sort_buffer_size());
+    if (param.using_packed_addons)
+      sort->init_packed_records();
   }
+  sort->using_packed_addons= param.using_packed_addons;
 
   if (open_cached_file(&buffpek_pointers,mysql_tmpdir,TEMP_PREFIX,
 		       DISK_BUFFER_SIZE, MYF(MY_WME)))
@@ -327,6 +341,11 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
       goto err;
   }
 
+  if (param.parallel_sorts || param.parallel_merge_passes)
+    tracker->report_sort_threads(param.sort_threads_used,
+                                 param.parallel_sorts,
+                                 param.parallel_merge_passes);
+
   if (num_rows > param.max_rows)
   {
     // If find_all_keys() produced more results than the query LIMIT.
@@ -696,6 +715,7 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
 {
   int error, quick_select;
   uint idx, indexpos;
+  ha_rows keys_written= 0;
   uchar *ref_pos, *next_pos, ref_buff[MAX_REFLENGTH];
   TABLE *sort_form;
   handler *file;
@@ -815,12 +835,29 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
         pq->push(ref_pos);
         idx= pq->num_elements();
       }
+      else if (param->using_packed_addons)
+      {
+        if (!fs_info->has_room_for_packed_record(param->rec_length))
+        {
+          if (write_keys(param, fs_info, idx, buffpek_pointers, tempfile))
+            goto err;
+          keys_written+= MY_MIN(idx, param->max_rows);
+          fs_info->init_packed_records();
+          idx= 0;
+          indexpos++;
+        }
+        uchar *to= fs_info->get_packed_record_buffer();
+        make_sortkey(param, to, ref_pos);
+        fs_info->adjust_packed_record_buffer(param->get_record_length(to));
+        idx++;
+      }
       else
       {
         if (idx == param->max_keys_per_buffer)
         {
           if (write_keys(param, fs_info, idx, buffpek_pointers, tempfile))
             goto err;
+          keys_written+= MY_MIN(idx, param->max_rows);
 	  idx= 0;
 	  indexpos++;
         }
@@ -858,12 +895,13 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
     file->print_error(error,MYF(ME_ERROR_LOG));
     DBUG_RETURN(HA_POS_ERROR);
   }
-  if (indexpos && idx &&
-      write_keys(param, fs_info, idx, buffpek_pointers, tempfile))
-    DBUG_RETURN(HA_POS_ERROR);			/* purecov: inspected */
-  retval= (my_b_inited(tempfile) ?
-           (ha_rows) (my_b_tell(tempfile)/param->rec_length) :
-           idx);
+  if (indexpos && idx)
+  {
+    if (write_keys(param, fs_info, idx, buffpek_pointers, tempfile))
+      DBUG_RETURN(HA_POS_ERROR);		/* purecov: inspected */
+    keys_written+= MY_MIN(idx, param->max_rows);
+  }
+  retval= my_b_inited(tempfile) ? keys_written : idx;
   DBUG_PRINT("info", ("find_all_keys return %llu", (ulonglong) retval));
   DBUG_RETURN(retval);
 
@@ -899,13 +937,11 @@ static bool
 write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
            IO_CACHE *buffpek_pointers, IO_CACHE *tempfile)
 {
-  size_t rec_length;
   uchar **end;
   BUFFPEK buffpek;
   DBUG_ENTER("write_keys");
 
-  rec_length= param->rec_length;
-  uchar **sort_keys= fs_info->get_sort_keys();
+  uchar **sort_keys= fs_info->get_key_pointers();
 
   fs_info->sort_buffer(param, count);
 
@@ -922,7 +958,8 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
     count=(uint) param->max_rows;               /* purecov: inspected */
   buffpek.count=(ha_rows) count;
   for (end=sort_keys+count ; sort_keys != end ; sort_keys++)
-    if (my_b_write(tempfile, (uchar*) *sort_keys, (uint) rec_length))
+    if (my_b_write(tempfile, (uchar*) *sort_keys,
+                   param->get_record_length(*sort_keys)))
       goto err;
   if (my_b_write(buffpek_pointers, (uchar*) &buffpek, sizeof(buffpek)))
     goto err;
@@ -1214,7 +1251,9 @@ static void make_sortkey(Sort_param *param, uchar *to, uchar *ref_pos)
     /* 
       Save field values appended to sorted fields.
       First null bit indicators are appended then field values follow.
-      In this implementation we use fixed layout for field values -
+      With packed addons the values are stored with their actual length,
+      NULL values take no space, and the total length is stored first.
+      Otherwise we use fixed layout for field values -
       the same for all records.
     */
     SORT_ADDON_FIELD *addonf= param->addon_field;
@@ -1222,6 +1261,18 @@ static void make_sortkey(Sort_param *param, uchar *to, uchar *ref_pos)
     DBUG_ASSERT(addonf != 0);
     memset(nulls, 0, addonf->offset);
     to+= addonf->offset;
+    if (param->using_packed_addons)
+    {
+      for ( ; (field= addonf->field) ; addonf++)
+      {
+        if (addonf->null_bit && field->is_null())
+          nulls[addonf->null_offset]|= addonf->null_bit;
+        else
+          to= field->pack(to, field->ptr);
+      }
+      int2store(nulls, (uint) (to - nulls));
+      return;
+    }
     for ( ; (field= addonf->field) ; addonf++)
     {
       if (addonf->null_bit && field->is_null())
@@ -1306,11 +1357,33 @@ static bool save_index(Sort_param *param, uint count,
   table_sort->sort_buffer(param, count);
   res_length= param->res_length;
   offset= param->rec_length-res_length;
+  uchar **sort_keys= table_sort->get_key_pointers();
+
+  if (param->using_packed_addons)
+  {
+    /* Only the first max_rows records are read back, see filesort() */
+    if ((ha_rows) count > param->max_rows)
+      count= (uint) param->max_rows;
+    size_t length= 0;
+    for (uint i= 0; i < count; i++)
+      length+= param->get_result_length(sort_keys[i]);
+    if (!(to= table_sort->record_pointers=
+          (uchar*) my_malloc(length, MYF(MY_WME | MY_THREAD_SPECIFIC))))
+      DBUG_RETURN(1);               /* purecov: inspected */
+    table_sort->record_pointers_length= length;
+    for (uchar **end= sort_keys+count ; sort_keys != end ; sort_keys++)
+    {
+      uint addon_length= param->get_result_length(*sort_keys);
+      memcpy(to, *sort_keys+offset, addon_length);
+      to+= addon_length;
+    }
+    DBUG_RETURN(0);
+  }
+
   if (!(to= table_sort->record_pointers= 
         (uchar*) my_malloc(res_length*count,
                            MYF(MY_WME | MY_THREAD_SPECIFIC))))
     DBUG_RETURN(1);                 /* purecov: inspected */
-  uchar **sort_keys= table_sort->get_sort_keys();
   for (uchar **end= sort_keys+count ; sort_keys != end ; sort_keys++)
   {
     memcpy(to, *sort_keys+offset, res_length);
@@ -1442,6 +1515,7 @@ static bool check_if_pq_applicable(Sort_param *param,
         my_free(filesort_info->addon_field);
         filesort_info->addon_field= NULL;
         param->addon_field= NULL;
+        param->using_packed_addons= false;
 
         param->res_length= param->ref_length;
         param->sort_length+= param->ref_length;
@@ -1455,6 +1529,171 @@ static bool check_if_pq_applicable(Sort_param *param,
 }
 
 
+/**
+  A part of a merge pass of merge_many_buff() that one thread runs: the
+  groups of runs [first_group, end_group) of the pass.
+*/
+
+struct Merge_part
+{
+  Sort_param param;             // With the keys of its part of the buffer
+  IO_CACHE *from_file;
+  IO_CACHE to_file;             // Writes to the file of the pass
+  uchar *sort_buffer;           // Its part of the sort buffer
+  BUFFPEK *buffpek;             // The runs of the pass
+  BUFFPEK *lastbuff;            // The merged runs of the pass
+  uint maxbuffer;               // The last run of the pass
+  uint n_groups;                // Number of groups of runs of the pass
+  uint first_group, end_group;
+  my_off_t end_pos;             // End of its merged runs in the file
+  bool error;
+};
+
+
+/**
+  IO_CACHE write function of the parts of a parallel merge pass, which
+  write to the same file descriptor: each part writes at its own position
+  rather than seek and write.
+*/
+
+static int merge_part_write(IO_CACHE *info, const uchar *Buffer, size_t Count)
+{
+  if (mysql_file_pwrite(info->file, Buffer, Count, info->pos_in_file,
+                        info->myflags | MY_NABP))
+    return info->error= -1;
+  info->pos_in_file+= Count;
+  return 0;
+}
+
+
+/** Merge the groups of runs of a part of a parallel merge pass */
+
+static ha_rows merge_part(void *arg)
+{
+  Merge_part *part= (Merge_part*) arg;
+  ha_rows rows= 0;
+  for (uint group= part->first_group; group < part->end_group; group++)
+  {
+    BUFFPEK *first= part->buffpek + group * MERGEBUFF;
+    BUFFPEK *last= (group == part->n_groups - 1 ?
+                    part->buffpek + part->maxbuffer : first + MERGEBUFF - 1);
+    if (merge_buffers(&part->param, part->from_file, &part->to_file,
+                      part->sort_buffer, part->lastbuff + group,
+                      first, last, 0))
+    {
+      part->error= true;
+      break;
+    }
+    rows+= part->lastbuff[group].count;
+  }
+  part->end_pos= my_b_tell(&part->to_file);
+  if (flush_io_cache(&part->to_file))
+    part->error= true;
+  end_io_cache(&part->to_file);
+  return rows;
+}
+
+
+/**
+  Merge the runs of a pass of merge_many_buff() with several threads.
+
+  The groups of MERGEBUFF runs of the pass are split in n_parts parts of
+  consecutive groups. Each part is merged by its own thread, with its own
+  part of the sort buffer. A part writes its merged runs to to_file from
+  the position its first run has in from_file on. A group never writes
+  more than it reads, so the parts do not overlap, even though the merged
+  runs are no longer contiguous when a LIMIT cut some of them short.
+
+  The temporary files must not be encrypted, as the parts read and write
+  them at the same time, with pread() and pwrite().
+
+  @return false ok, true error
+*/
+
+static bool parallel_merge_pass(Sort_param *param, uchar *sort_buffer,
+                                BUFFPEK *buffpek, uint maxbuffer,
+                                uint n_groups, uint n_parts,
+                                IO_CACHE *from_file, IO_CACHE *to_file)
+{
+  THD *thd= current_thd;
+  Merge_part *parts;
+  BUFFPEK *lastbuff;
+  const uint keys= param->max_keys_per_buffer / n_parts;
+  my_off_t end_pos= 0;
+  uint n_inited;
+  bool error= false;
+  DBUG_ENTER("parallel_merge_pass");
+
+  if ((to_file->file == -1 && real_open_cached_file(to_file)) ||
+      !my_multi_malloc(MYF(MY_WME | MY_THREAD_SPECIFIC),
+                       &parts, (size_t) n_parts * sizeof(Merge_part),
+                       &lastbuff, (size_t) n_groups * sizeof(BUFFPEK),
+                       NullS))
+    DBUG_RETURN(true);
+
+  for (n_inited= 0; n_inited < n_parts; n_inited++)
+  {
+    Merge_part *part= parts + n_inited;
+    part->param= *param;
+    part->param.max_keys_per_buffer= keys;
+    part->param.merge_thd= thd;
+    part->from_file= from_file;
+    part->sort_buffer= sort_buffer + (size_t) n_inited * keys *
+                                     param->rec_length;
+    part->buffpek= buffpek;
+    part->lastbuff= lastbuff;
+    part->maxbuffer= maxbuffer;
+    part->n_groups= n_groups;
+    part->first_group= n_inited * n_groups / n_parts;
+    part->end_group= (n_inited + 1) * n_groups / n_parts;
+    part->error= false;
+    /* The buffer is freed by the sort thread, so it is not MY_THREAD_SPECIFIC */
+    if (init_io_cache(&part->to_file, to_file->file, DISK_BUFFER_SIZE,
+                      WRITE_CACHE,
+                      buffpek[part->first_group * MERGEBUFF].file_pos,
+                      0, MYF(0)))
+    {
+      error= true;
+      break;
+    }
+    part->to_file.write_function= merge_part_write;
+  }
+
+  if (error ||
+      filesort_run_parallel(param, merge_part, parts, sizeof(Merge_part),
+                            n_parts))
+  {
+    for (uint i= 0; i < n_inited; i++)
+      end_io_cache(&parts[i].to_file);
+    error= true;
+  }
+  else
+  {
+    for (uint i= 0; i < n_parts; i++)
+    {
+      error|= parts[i].error;
+      set_if_bigger(end_pos, parts[i].end_pos);
+    }
+    thd->query_plan_fsort_passes+= n_groups;
+    for (uint i= 0; i < n_groups; i++)
+      thd->inc_status_sort_merge_passes();
+  }
+
+  if (!error)
+  {
+    memcpy(buffpek, lastbuff, n_groups * sizeof(BUFFPEK));
+    param->parallel_merge_passes++;
+    /* Make the end of the merged runs the end of to_file */
+    error= reinit_io_cache(to_file, WRITE_CACHE, end_pos, 0, 1);
+  }
+  else if (!thd->is_error() && !thd->killed)
+    my_error(ER_TEMP_FILE_WRITE_FAILURE, MYF(0));
+
+  my_free(parts);
+  DBUG_RETURN(error);
+}
+
+
 /** Merge buffers to make < MERGEBUFF2 buffers. */
 
 int merge_many_buff(Sort_param *param, uchar *sort_buffer,
@@ -1479,6 +1718,23 @@ int merge_many_buff(Sort_param *param, uchar *sort_buffer,
       goto cleanup;
     if (reinit_io_cache(to_file,WRITE_CACHE,0L,0,0))
       goto cleanup;
+
+    /* Each group of MERGEBUFF runs, and the last, longer one, is merged */
+    uint n_groups= (*maxbuffer - MERGEBUFF*3/2) / MERGEBUFF + 2;
+    uint n_parts= MY_MIN(param->max_sort_threads, n_groups);
+    set_if_smaller(n_parts,
+                   param->max_keys_per_buffer / MIN_KEYS_PER_MERGE_THREAD);
+    if (n_parts > 1 && !param->unique_buff &&
+        !((from_file->myflags | to_file->myflags) & MY_ENCRYPT))
+    {
+      if (parallel_merge_pass(param, sort_buffer, buffpek, *maxbuffer,
+                              n_groups, n_parts, from_file, to_file))
+        goto cleanup;
+      temp=from_file; from_file=to_file; to_file=temp;
+      *maxbuffer= n_groups - 1;
+      continue;
+    }
+
     lastbuff=buffpek;
     for (i=0 ; i <= *maxbuffer-MERGEBUFF*3/2 ; i+=MERGEBUFF)
     {
@@ -1533,6 +1789,61 @@ ulong read_to_buffer(IO_CACHE *fromfile, BUFFPEK *buffpek,
 } /* read_to_buffer */
 
 
+/**
+  Read variable length records to buffer.
+
+  Reads as many complete records as fit into the area of the BUFFPEK,
+  which has room for max_keys records of the maximal length.
+
+  @retval  Number of bytes read
+           (ulong)-1 if something goes wrong
+*/
+
+static ulong read_packed_to_buffer(IO_CACHE *fromfile, BUFFPEK *buffpek,
+                                   Sort_param *param)
+{
+  ulong count= 0;
+  ulong length= 0;
+
+  if (buffpek->count)
+  {
+    size_t bytes= (size_t) (buffpek->max_keys * param->rec_length);
+    DBUG_ASSERT(fromfile->end_of_file > buffpek->file_pos);
+    if (bytes > fromfile->end_of_file - buffpek->file_pos)
+      bytes= (size_t) (fromfile->end_of_file - buffpek->file_pos);
+    if (unlikely(my_b_pread(fromfile, (uchar*) buffpek->base, bytes,
+                            buffpek->file_pos)))
+      return ((ulong) -1);
+
+    uchar *record= buffpek->base;
+    uchar *end= buffpek->base + bytes;
+    while (count < buffpek->count &&
+           record + param->sort_length + PACKED_ADDON_LENGTH_BYTES <= end &&
+           record + param->get_record_length(record) <= end)
+    {
+      record+= param->get_record_length(record);
+      count++;
+    }
+    DBUG_ASSERT(count);
+    length= (ulong) (record - buffpek->base);
+    buffpek->key=buffpek->base;
+    buffpek->file_pos+= length;			/* New filepos */
+    buffpek->count-=	count;
+    buffpek->mem_count= count;
+  }
+  return (length);
+} /* read_packed_to_buffer */
+
+
+static inline ulong read_to_buffer(IO_CACHE *fromfile, BUFFPEK *buffpek,
+                                   Sort_param *param)
+{
+  if (param->using_packed_addons)
+    return read_packed_to_buffer(fromfile, buffpek, param);
+  return read_to_buffer(fromfile, buffpek, param->rec_length);
+}
+
+
 /**
   Put all room used by freed buffer to use in adjacent buffer.
 
@@ -1606,11 +1917,15 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
   uchar *src;
   uchar *unique_buff= param->unique_buff;
   const bool killable= !param->not_killable;
-  THD* const thd=current_thd;
+  /* A part of a parallel merge pass is accounted for by its session */
+  THD* const thd= param->merge_thd ? param->merge_thd : current_thd;
   DBUG_ENTER("merge_buffers");
 
-  thd->inc_status_sort_merge_passes();
-  thd->query_plan_fsort_passes++;
+  if (!param->merge_thd)
+  {
+    thd->inc_status_sort_merge_passes();
+    thd->query_plan_fsort_passes++;
+  }
 
   rec_length= param->rec_length;
   res_length= param->res_length;
@@ -1620,7 +1935,6 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
   bool check_dupl_count= flag && min_dupl_count;
   offset= (rec_length-
            (flag && min_dupl_count ? sizeof(dupl_count) : 0)-res_length);
-  uint wr_len= flag ? res_length : rec_length;
   uint wr_offset= flag ? offset : 0;
   maxcount= (ulong) (param->max_keys_per_buffer/((uint) (Tb-Fb) +1));
   to_start_filepos= my_b_tell(to_file);
@@ -1646,12 +1960,20 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
   {
     buffpek->base= strpos;
     buffpek->max_keys= maxcount;
-    bytes_read= read_to_buffer(from_file, buffpek, rec_length);
+    bytes_read= read_to_buffer(from_file, buffpek, param);
     if (unlikely(bytes_read == (ulong) -1))
       goto err;					/* purecov: inspected */
 
-    strpos+= bytes_read;
-    buffpek->max_keys= buffpek->mem_count;	// If less data in buffers than expected
+    if (param->using_packed_addons)
+    {
+      /* Records vary in length, keep the whole area for later reads */
+      strpos+= buffpek->max_keys * rec_length;
+    }
+    else
+    {
+      strpos+= bytes_read;
+      buffpek->max_keys= buffpek->mem_count;	// If less data in buffers than expected
+    }
     queue_insert(&queue, (uchar*) buffpek);
   }
 
@@ -1671,7 +1993,7 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
     if (! --buffpek->mem_count)
     {
       if (unlikely(!(bytes_read= read_to_buffer(from_file, buffpek,
-                                                rec_length))))
+                                                param))))
       {
         (void) queue_remove_top(&queue);
         reuse_freed_buff(&queue, buffpek, rec_length);
@@ -1686,7 +2008,8 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
 
   while (queue.elements > 1)
   {
-    if (killable && unlikely(thd->check_killed()))
+    if (killable && unlikely(param->merge_thd ? thd->killed != NOT_KILLED
+                                              : thd->check_killed()))
       goto err;                               /* purecov: inspected */
 
     for (;;)
@@ -1724,7 +2047,9 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
       */          
       if (!check_dupl_count || dupl_count >= min_dupl_count)
       {
-        if (my_b_write(to_file, src+wr_offset, wr_len))
+        if (my_b_write(to_file, src+wr_offset,
+                       flag ? param->get_result_length(src) :
+                              param->get_record_length(src)))
           goto err;                           /* purecov: inspected */
       }
       if (cmp)
@@ -1741,11 +2066,11 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
       }
 
     skip_duplicate:
-      buffpek->key+= rec_length;
+      buffpek->key+= param->get_record_length(buffpek->key);
       if (! --buffpek->mem_count)
       {
         if (unlikely(!(bytes_read= read_to_buffer(from_file, buffpek,
-                                                  rec_length))))
+                                                  param))))
         {
           (void) queue_remove_top(&queue);
           reuse_freed_buff(&queue, buffpek, rec_length);
@@ -1786,7 +2111,7 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
     if (!check_dupl_count || dupl_count >= min_dupl_count)
     {
       src= unique_buff;
-      if (my_b_write(to_file, src+wr_offset, wr_len))
+      if (my_b_write(to_file, src+wr_offset, flag ? res_length : rec_length))
         goto err;                             /* purecov: inspected */
       if (!--max_rows)
         goto end;                             
@@ -1803,32 +2128,38 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
     max_rows-= buffpek->mem_count;
     if (flag == 0)
     {
-      if (my_b_write(to_file, (uchar*) buffpek->key,
-                     (size_t)(rec_length*buffpek->mem_count)))
+      size_t length= (size_t) (rec_length*buffpek->mem_count);
+      if (param->using_packed_addons)
+      {
+        uchar *end= buffpek->key;
+        for (ha_rows n= buffpek->mem_count; n; n--)
+          end+= param->get_record_length(end);
+        length= (size_t) (end - buffpek->key);
+      }
+      if (my_b_write(to_file, (uchar*) buffpek->key, length))
         goto err;                             /* purecov: inspected */
     }
     else
     {
-      uchar *end;
-      src= buffpek->key+offset;
-      for (end= src+buffpek->mem_count*rec_length ;
-           src != end ;
-           src+= rec_length)
+      uchar *rec= buffpek->key;
+      for (ha_rows n= buffpek->mem_count; n;
+           n--, rec+= param->get_record_length(rec))
       {
+        src= rec+offset;
         if (check_dupl_count)
         {
           memcpy((uchar *) &dupl_count, src+dupl_count_ofs, sizeof(dupl_count)); 
           if (dupl_count < min_dupl_count)
 	    continue;
         }
-        if (my_b_write(to_file, src, wr_len))
+        if (my_b_write(to_file, src, param->get_result_length(rec)))
           goto err;
       }
     }
   }
   while (likely(!(error=
                   (bytes_read= read_to_buffer(from_file, buffpek,
-                                              rec_length)) == (ulong) -1)) &&
+                                              param)) == (ulong) -1)) &&
          bytes_read != 0);
 
 end:
@@ -2038,6 +2369,8 @@ bool filesort_use_addons(TABLE *table, uint sortlength,
   @param ptabfield           Array of references to the table fields
   @param sortlength          Total length of sorted fields
   @param [out] addon_buf     Buffer to us for appended fields
+  @param [out] packed        Set to TRUE if the values are to be stored
+                             with their actual length
 
   @note
     The null bits for the appended values are supposed to be put together
@@ -2050,7 +2383,8 @@ bool filesort_use_addons(TABLE *table, uint sortlength,
 */
 
 static SORT_ADDON_FIELD *
-get_addon_fields(TABLE *table, uint sortlength, LEX_STRING *addon_buf)
+get_addon_fields(TABLE *table, uint sortlength, LEX_STRING *addon_buf,
+                 bool *packed)
 {
   Field **pfield;
   Field *field;
@@ -2071,20 +2405,46 @@ get_addon_fields(TABLE *table, uint sortlength, LEX_STRING *addon_buf)
   */
   addon_buf->str= 0;
   addon_buf->length= 0;
+  *packed= false;
 
   // see remove_const() for HA_SLOW_RND_POS explanation
   if (table->file->ha_table_flags() & HA_SLOW_RND_POS)
     sortlength= 0;
 
-  if (!filesort_use_addons(table, sortlength, &length, &fields, &null_fields) ||
-      !my_multi_malloc(MYF(MY_WME | MY_THREAD_SPECIFIC), &addonf,
+  if (!filesort_use_addons(table, sortlength, &length, &fields, &null_fields))
+    DBUG_RETURN(0);
+
+  /*
+    Strings are stored with their actual length if the total length of
+    the appended values fits into the length prefix. Otherwise they
+    take their maximal length in every record.
+  */
+  if (length + PACKED_ADDON_LENGTH_BYTES <= UINT_MAX16)
+  {
+    for (pfield= table->field; (field= *pfield) ; pfield++)
+    {
+      if (bitmap_is_set(read_set, field->field_index) &&
+          field->max_packed_col_length(field->pack_length()) !=
+          field->pack_length())
+      {
+        *packed= true;
+        length+= PACKED_ADDON_LENGTH_BYTES;
+        break;
+      }
+    }
+  }
+
+  if (!my_multi_malloc(MYF(MY_WME | MY_THREAD_SPECIFIC), &addonf,
                        sizeof(SORT_ADDON_FIELD) * (fields+1),
                        &addon_buf->str, length, NullS))
-
+  {
+    *packed= false;
     DBUG_RETURN(0);
+  }
 
+  uint null_start= *packed ? PACKED_ADDON_LENGTH_BYTES : 0;
   addon_buf->length= length;
-  length= (null_fields+7)/8;
+  length= null_start + (null_fields+7)/8;
   null_fields= 0;
   for (pfield= table->field; (field= *pfield) ; pfield++)
   {
@@ -2094,7 +2454,7 @@ get_addon_fields(TABLE *table, uint sortlength, LEX_STRING *addon_buf)
     addonf->offset= length;
     if (field->maybe_null())
     {
-      addonf->null_offset= null_fields/8;
+      addonf->null_offset= null_start + null_fields/8;
       addonf->null_bit= 1<<(null_fields & 7);
       null_fields++;
     }
@@ -2148,6 +2508,36 @@ unpack_addon_fields(struct st_sort_addon_field *addon_field, uchar *buff,
   }
 }
 
+
+/**
+  Copy (unpack) values appended to sorted fields with their actual
+  length, see make_sortkey(), back to their regular positions.
+
+  @param addon_field     Array of descriptors for appended fields
+  @param buff            Buffer which to unpack the value from
+  @param buff_end        End of the record in the buffer
+*/
+
+static void
+unpack_packed_addon_fields(struct st_sort_addon_field *addon_field,
+                           uchar *buff, uchar *buff_end)
+{
+  Field *field;
+  SORT_ADDON_FIELD *addonf= addon_field;
+  const uchar *start= buff + addonf->offset;
+
+  for ( ; (field= addonf->field) ; addonf++)
+  {
+    if (addonf->null_bit && (addonf->null_bit & buff[addonf->null_offset]))
+    {
+      field->set_null();
+      continue;
+    }
+    field->set_notnull();
+    start= field->unpack(field->ptr, start, buff_end, 0);
+  }
+}
+
 /*
 ** functions to change a double or float to a sortable string
 ** The following should work for IEEE
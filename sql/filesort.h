@@ -87,7 +87,7 @@ class SORT_INFO
 
 public:
   SORT_INFO()
-    :addon_field(0), record_pointers(0)
+    :addon_field(0), using_packed_addons(false), record_pointers(0)
   {
     buffpek.str= 0;
     my_b_clear(&io_cache);
@@ -116,9 +116,12 @@ class SORT_INFO
   LEX_STRING buffpek;           /* Buffer for buffpek structures */
   LEX_STRING addon_buf;         /* Pointer to a buffer if sorted with fields */
   struct st_sort_addon_field *addon_field;     /* Pointer to the fields info */
+  /* TRUE <=> addon fields are stored with their actual length */
+  bool      using_packed_addons;
   /* To unpack back */
   void    (*unpack)(struct st_sort_addon_field *, uchar *, uchar *);
   uchar     *record_pointers;    /* If sorted in memory */
+  size_t    record_pointers_length; /* Bytes in record_pointers, if packed */
   /*
     How many rows in final result.
     Also how many rows in record_pointers, if used
@@ -140,6 +143,21 @@ class SORT_INFO
   uchar **get_sort_keys()
   { return filesort_buffer.get_sort_keys(); }
 
+  uchar **get_key_pointers()
+  { return filesort_buffer.get_key_pointers(); }
+
+  void init_packed_records()
+  { filesort_buffer.init_packed_records(); }
+
+  bool has_room_for_packed_record(uint max_length) const
+  { return filesort_buffer.has_room_for_packed_record(max_length); }
+
+  uchar *get_packed_record_buffer()
+  { return filesort_buffer.get_packed_record_buffer(); }
+
+  void adjust_packed_record_buffer(uint length)
+  { filesort_buffer.adjust_packed_record_buffer(length); }
+
   uchar **alloc_sort_buffer(uint num_records, uint record_length)
   { return filesort_buffer.alloc_sort_buffer(num_records, record_length); }
 
@@ -18,6 +18,7 @@
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include "mysqld.h"                             // key_thread_filesort
 
 
 namespace {
@@ -142,6 +143,7 @@ uchar **Filesort_buffer::alloc_sort_buffer(uint num_records,
 
   m_idx_array= Idx_array(sort_keys, num_records);
   m_record_length= record_length;
+  m_packed_keys= NULL;
   start_of_data= m_idx_array.array() + m_idx_array.size();
   m_start_of_data= reinterpret_cast<uchar*>(start_of_data);
 
@@ -154,15 +156,406 @@ void Filesort_buffer::free_sort_buffer()
   my_free(m_idx_array.array());
   m_idx_array.reset();
   m_start_of_data= NULL;
+  m_packed_keys= NULL;
 }
 
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+namespace {
+/**
+  A part of a sort buffer sorted, a pair of sorted runs merged, or a part
+  of a merge pass of filesort_run_parallel(), run by one thread of a
+  parallel sort.
+*/
+struct Sort_task
+{
+  uchar **keys;            // Keys to sort, or the first run to merge
+  uint count;              // Number of keys in 'keys'
+  uchar **keys2;           // The second run to merge, NULL when sorting
+  uint count2;             // Number of keys in 'keys2'
+  uchar **to;              // Scratch space when sorting, or merge result
+  size_t sort_length;
+  ha_rows (*func)(void *); // Task of filesort_run_parallel(), or NULL
+  void *arg;               // Argument of func
+  ha_rows rows;            // Rows sorted or merged by the task
+  ulonglong time;          // Time spent running the task, in nanoseconds
+  bool inline_run;         // Whether the thread that queued it ran it
+  Sort_task *prev, *next;  // Links in the queue of Sort_threads
+  enum { QUEUED, RUNNING, DONE } state;
+};
+
+
+void sort_key_pointers(uchar **keys, uint count, size_t sort_length,
+                       uchar **buffer)
+{
+  if (buffer && radixsort_is_appliccable(count, sort_length))
+    radixsort_for_str_ptr(keys, count, sort_length, buffer);
+  else
+    my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(sort_length),
+              &sort_length);
+}
+
+
+void merge_key_pointers(uchar **a, uint a_count, uchar **b, uint b_count,
+                        uchar **to, size_t sort_length)
+{
+  uchar **a_end= a + a_count, **b_end= b + b_count;
+  while (a < a_end && b < b_end)
+    *to++= memcmp(*b, *a, sort_length) < 0 ? *b++ : *a++;
+  if (a < a_end)
+    memcpy(to, a, (a_end - a) * sizeof(uchar*));
+  else if (b < b_end)
+    memcpy(to, b, (b_end - b) * sizeof(uchar*));
+}
+
+
+void run_sort_task(Sort_task *task)
+{
+  ulonglong start= my_interval_timer();
+  if (task->func)
+    task->rows= task->func(task->arg);
+  else if (task->keys2)
+  {
+    merge_key_pointers(task->keys, task->count, task->keys2, task->count2,
+                       task->to, task->sort_length);
+    task->rows= task->count + task->count2;
+  }
+  else
+  {
+    sort_key_pointers(task->keys, task->count, task->sort_length, task->to);
+    task->rows= task->count;
+  }
+  task->time= my_interval_timer() - start;
+}
+
+
+/**
+  The threads that run the tasks of all parallel sorts.
+
+  The threads are created on demand and live until shutdown, so that the
+  sorts and merge rounds of a filesort do not create threads of their own.
+  No more than max_threads threads are created, however many sorts run at
+  the same time. A task that no thread has picked up by the time the
+  sorting thread is done with its own share is run by the sorting thread.
+
+  The threads sort parts of a sort buffer and merge them, and merge parts
+  of the merge passes of merge_many_buff(). Reading the rows for the next
+  sort buffer is not overlapped with sorting the previous one, as that
+  would take a second sort buffer of sort_buffer_size for every filesort.
+*/
+class Sort_threads
+{
+  mysql_mutex_t mutex;
+  /** Signalled when tasks are queued, or on shutdown */
+  mysql_cond_t COND_queued;
+  /** Signalled when a task is done, or a thread exits */
+  mysql_cond_t COND_done;
+  /** The queue of tasks that wait for a thread */
+  Sort_task *first, *last;
+  /** Number of threads */
+  uint n_threads;
+  /** Number of threads that wait for a task */
+  uint n_idle;
+  bool shutdown;
+  bool initialized;
+
+  void enqueue(Sort_task *task)
+  {
+    task->state= Sort_task::QUEUED;
+    task->prev= last;
+    task->next= NULL;
+    if (last)
+      last->next= task;
+    else
+      first= task;
+    last= task;
+  }
+
+  void dequeue(Sort_task *task)
+  {
+    DBUG_ASSERT(task->state == Sort_task::QUEUED);
+    if (task->prev)
+      task->prev->next= task->next;
+    else
+      first= task->next;
+    if (task->next)
+      task->next->prev= task->prev;
+    else
+      last= task->prev;
+    task->state= Sort_task::RUNNING;
+  }
+
+  /** Maximum number of threads, one less than the number of CPUs */
+  uint max_threads;
+
+public:
+  void init()
+  {
+    mysql_mutex_init(key_LOCK_sort_threads, &mutex, MY_MUTEX_INIT_FAST);
+    mysql_cond_init(key_COND_sort_threads_queued, &COND_queued, NULL);
+    mysql_cond_init(key_COND_sort_threads_done, &COND_done, NULL);
+    first= last= NULL;
+    n_threads= n_idle= 0;
+    shutdown= false;
+    max_threads= my_getncpus() - 1;
+    initialized= true;
+  }
+
+  void end()
+  {
+    if (!initialized)
+      return;
+    initialized= false;
+    mysql_mutex_lock(&mutex);
+    shutdown= true;
+    mysql_cond_broadcast(&COND_queued);
+    while (n_threads)
+      mysql_cond_wait(&COND_done, &mutex);
+    mysql_mutex_unlock(&mutex);
+    mysql_cond_destroy(&COND_done);
+    mysql_cond_destroy(&COND_queued);
+    mysql_mutex_destroy(&mutex);
+  }
+
+  void run(Sort_task *tasks, uint n_tasks);
+  void worker();
+};
+
+Sort_threads sort_threads;
+
+
+pthread_handler_t sort_thread(void *)
+{
+  my_thread_init();
+  sort_threads.worker();
+  my_thread_end();
+  return 0;
+}
+
+
+void Sort_threads::worker()
+{
+  mysql_mutex_lock(&mutex);
+  for (;;)
+  {
+    while (!first && !shutdown)
+    {
+      n_idle++;
+      mysql_cond_wait(&COND_queued, &mutex);
+      n_idle--;
+    }
+    if (!first)
+      break;
+    Sort_task *task= first;
+    dequeue(task);
+    mysql_mutex_unlock(&mutex);
+    run_sort_task(task);
+    mysql_mutex_lock(&mutex);
+    task->state= Sort_task::DONE;
+    mysql_cond_broadcast(&COND_done);
+  }
+  n_threads--;
+  mysql_cond_broadcast(&COND_done);
+  mysql_mutex_unlock(&mutex);
+}
+
+
+/**
+  Run the tasks in parallel. The first task is run by the calling thread,
+  as is every task that no thread has started when that one is done.
+*/
+void Sort_threads::run(Sort_task *tasks, uint n_tasks)
+{
+  mysql_mutex_lock(&mutex);
+  for (uint i= 1; i < n_tasks; i++)
+  {
+    tasks[i].inline_run= false;
+    enqueue(&tasks[i]);
+  }
+  for (uint i= n_idle + 1; i < n_tasks && n_threads < max_threads; i++)
+  {
+    pthread_t thread;
+    if (mysql_thread_create(key_thread_filesort, &thread, &connection_attrib,
+                            sort_thread, NULL))
+      break;
+    n_threads++;
+  }
+  mysql_cond_broadcast(&COND_queued);
+  mysql_mutex_unlock(&mutex);
+
+  tasks[0].inline_run= true;
+  run_sort_task(&tasks[0]);
+
+  mysql_mutex_lock(&mutex);
+  /* The threads take tasks from the start of the queue */
+  for (uint i= n_tasks; --i > 0; )
+  {
+    Sort_task *task= &tasks[i];
+    if (task->state != Sort_task::QUEUED)
+      continue;
+    dequeue(task);
+    task->inline_run= true;
+    mysql_mutex_unlock(&mutex);
+    run_sort_task(task);
+    mysql_mutex_lock(&mutex);
+    task->state= Sort_task::DONE;
+  }
+  for (uint i= 1; i < n_tasks; i++)
+  {
+    while (tasks[i].state != Sort_task::DONE)
+      mysql_cond_wait(&COND_done, &mutex);
+  }
+  mysql_mutex_unlock(&mutex);
+}
+
+
+/** Add the work of the tasks of a parallel sort to the thread statistics */
+void add_thread_stats(Sort_param *param, const Sort_task *tasks,
+                      uint n_tasks)
+{
+  set_if_bigger(param->sort_threads_used, n_tasks);
+  for (uint i= 0; i < n_tasks; i++)
+  {
+    Sort_thread_stats *stats= &param->thread_stats[i];
+    if (tasks[i].keys2 || tasks[i].func)
+      stats->merged_rows+= tasks[i].rows;
+    else
+      stats->sorted_rows+= tasks[i].rows;
+    stats->time+= tasks[i].time;
+    if (i && tasks[i].inline_run)
+      stats->inline_tasks++;
+  }
+}
+}
+
+
+void filesort_threads_init()
+{
+  sort_threads.init();
+}
+
+
+void filesort_threads_end()
+{
+  sort_threads.end();
+}
+
+
+bool filesort_run_parallel(Sort_param *param, ha_rows (*func)(void *),
+                           void *args, size_t arg_size, uint n_tasks)
+{
+  Sort_task *tasks;
+  if (!(tasks= (Sort_task*) my_malloc(n_tasks * sizeof(Sort_task),
+                                      MYF(MY_WME | MY_THREAD_SPECIFIC))))
+    return true;
+  for (uint i= 0; i < n_tasks; i++)
+  {
+    tasks[i].keys2= NULL;
+    tasks[i].func= func;
+    tasks[i].arg= (uchar*) args + i * arg_size;
+  }
+  sort_threads.run(tasks, n_tasks);
+  add_thread_stats(param, tasks, n_tasks);
+  my_free(tasks);
+  return false;
+}
+
+
+/**
+  Sort the key pointers with several threads.
+
+  The pointers are split in n_threads parts of about the same size, and
+  each part is sorted by its own thread. The sorted parts are then merged
+  pairwise, all pairs of a round in parallel, alternating between the key
+  pointers and a scratch array of the same size.
+
+  @return false ok, true if memory could not be allocated
+*/
+static bool parallel_sort_buffer(Sort_param *param, uchar **keys, uint count,
+                                 uint n_threads)
+{
+  const size_t sort_length= param->sort_length;
+  uchar **buffer;
+  Sort_task *tasks;
+  if (!my_multi_malloc(MYF(MY_THREAD_SPECIFIC),
+                       &buffer, (size_t) count * sizeof(uchar*),
+                       &tasks, (size_t) n_threads * sizeof(Sort_task),
+                       NullS))
+    return true;
+
+  uint part_size= count / n_threads;
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Sort_task *task= tasks + i;
+    task->keys= keys + i * part_size;
+    task->count= i == n_threads - 1 ? count - i * part_size : part_size;
+    task->keys2= NULL;
+    task->to= buffer + i * part_size;
+    task->sort_length= sort_length;
+    task->func= NULL;
+  }
+  sort_threads.run(tasks, n_threads);
+  add_thread_stats(param, tasks, n_threads);
+
+  /* The runs are described by the 'keys' and 'count' of the tasks */
+  uchar **from= keys, **to= buffer;
+  for (uint n_runs= n_threads; n_runs > 1; n_runs= (n_runs + 1) / 2)
+  {
+    uint n_merges= n_runs / 2;
+    for (uint i= 0; i < n_merges; i++)
+    {
+      Sort_task *task= tasks + i;
+      Sort_task *first= tasks + 2 * i, *second= tasks + 2 * i + 1;
+      uint count1= first->count, count2= second->count;
+      uchar **run1= first->keys, **run2= second->keys;
+      task->keys= run1;
+      task->count= count1;
+      task->keys2= run2;
+      task->count2= count2;
+      task->to= to + (run1 - from);
+    }
+    sort_threads.run(tasks, n_merges);
+    add_thread_stats(param, tasks, n_merges);
+
+    for (uint i= 0; i < n_merges; i++)
+    {
+      Sort_task *task= tasks + i;
+      task->keys= task->to;
+      task->count+= task->count2;
+    }
+    if (n_runs & 1)
+    {
+      /* The last run had no pair, move it over as it is */
+      Sort_task *last= tasks + n_runs - 1;
+      uchar **run= to + (last->keys - from);
+      memcpy(run, last->keys, last->count * sizeof(uchar*));
+      tasks[n_merges].keys= run;
+      tasks[n_merges].count= last->count;
+    }
+    swap_variables(uchar **, from, to);
+  }
+  if (from != keys)
+    memcpy(keys, from, count * sizeof(uchar*));
+
+  my_free(buffer);
+  return false;
+}
+
+
+void Filesort_buffer::sort_buffer(Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   if (count <= 1 || size == 0)
     return;
-  uchar **keys= get_sort_keys();
+  uchar **keys= get_key_pointers();
+
+  uint n_threads= MY_MIN(param->max_sort_threads,
+                         count / MIN_KEYS_PER_SORT_THREAD);
+  if (n_threads > 1 && !parallel_sort_buffer(param, keys, count, n_threads))
+  {
+    param->parallel_sorts++;
+    return;
+  }
+
   uchar **buffer= NULL;
   if (radixsort_is_appliccable(count, param->sort_length) &&
       (buffer= (uchar**) my_malloc(count*sizeof(char*),
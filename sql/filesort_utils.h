@@ -43,6 +43,20 @@ double get_merge_many_buffs_cost_fast(ha_rows num_rows,
                                       ha_rows num_keys_per_buffer,
                                       uint    elem_size);
 
+/** Initialize the threads that are shared by parallel sorts */
+void filesort_threads_init();
+/** Stop the threads that are shared by parallel sorts */
+void filesort_threads_end();
+/**
+  Run func on each of n_tasks arguments, which are arg_size bytes apart
+  from args on, with the threads that are shared by parallel sorts. The
+  calling thread runs the first one. func returns the rows it merged,
+  which are added to param->thread_stats.
+  @return false ok, true if memory could not be allocated
+*/
+bool filesort_run_parallel(Sort_param *param, ha_rows (*func)(void *),
+                           void *args, size_t arg_size, uint n_tasks);
+
 
 /**
   A wrapper class around the buffer used by filesort().
@@ -60,7 +74,8 @@ class Filesort_buffer
 {
 public:
   Filesort_buffer()
-    : m_idx_array(), m_start_of_data(NULL), allocated_size(0)
+    : m_idx_array(), m_start_of_data(NULL), allocated_size(0),
+      m_next_rec_ptr(NULL), m_packed_keys(NULL)
   {}
   
   ~Filesort_buffer()
@@ -77,8 +92,11 @@ class Filesort_buffer
     m_idx_array.reset();
   }
 
-  /** Sort me... */
-  void sort_buffer(const Sort_param *param, uint count);
+  /**
+    Sort me... using up to param->max_sort_threads threads.
+    Statistics of parallel sorts are added to param and its thread_stats.
+  */
+  void sort_buffer(Sort_param *param, uint count);
 
   /// Initializes a record pointer.
   uchar *get_record_buffer(uint idx)
@@ -94,6 +112,47 @@ class Filesort_buffer
       (void) get_record_buffer(ix);
   }
 
+  /**
+    Prepares the buffer for variable length records.
+    The records are appended from the start of the buffer, and the
+    pointers to them are stored downwards from the end of it, so that
+    short records leave room for more keys.
+  */
+  void init_packed_records()
+  {
+    uchar *end= reinterpret_cast<uchar*>(m_idx_array.array()) +
+                allocated_size;
+    m_next_rec_ptr= reinterpret_cast<uchar*>(m_idx_array.array());
+    m_packed_keys= reinterpret_cast<uchar**>(end - ((size_t) end) %
+                                             sizeof(uchar*));
+  }
+
+  /// Whether a record of max_length bytes and its pointer still fit.
+  bool has_room_for_packed_record(uint max_length) const
+  {
+    return m_next_rec_ptr + max_length + sizeof(uchar*) <=
+           reinterpret_cast<uchar*>(m_packed_keys);
+  }
+
+  /// Initializes a pointer to the next variable length record.
+  uchar *get_packed_record_buffer()
+  {
+    *--m_packed_keys= m_next_rec_ptr;
+    return m_next_rec_ptr;
+  }
+
+  /// Accounts for the length of the record just stored.
+  void adjust_packed_record_buffer(uint length)
+  {
+    m_next_rec_ptr+= length;
+  }
+
+  /// Pointers to the records to sort, fixed or variable length.
+  uchar **get_key_pointers()
+  {
+    return m_packed_keys ? m_packed_keys : m_idx_array.array();
+  }
+
   /// Returns total size: pointer array + record buffers.
   size_t sort_buffer_size() const
   {
@@ -121,6 +180,8 @@ class Filesort_buffer
     m_record_length= rhs.m_record_length;
     m_start_of_data= rhs.m_start_of_data;
     allocated_size=  rhs.allocated_size;
+    m_next_rec_ptr=  rhs.m_next_rec_ptr;
+    m_packed_keys=   rhs.m_packed_keys;
     return *this;
   }
 
@@ -131,6 +192,8 @@ class Filesort_buffer
   uint       m_record_length;
   uchar     *m_start_of_data;                   /* Start of key data */
   size_t    allocated_size;
+  uchar     *m_next_rec_ptr;                    /* Next packed record */
+  uchar    **m_packed_keys;                     /* Pointers to packed data */
 };
 
 #endif  // FILESORT_UTILS_INCLUDED
@@ -1012,9 +1012,11 @@ enum enum_schema_tables
   SCH_OPT_TRACE,
   SCH_PARAMETERS,
   SCH_PARTITIONS,
+  SCH_PLAN_CACHE,
   SCH_PLUGINS,
   SCH_PROCESSLIST,
   SCH_PROFILES,
+  SCH_QUERY_CACHE_PARTITIONS,
   SCH_REFERENTIAL_CONSTRAINTS,
   SCH_PROCEDURES,
   SCH_SCHEMATA,
@@ -3633,6 +3635,19 @@ class handler :public Sql_alloc
     uint key_len= calculate_key_len(table, active_index, key, keypart_map);
     return index_read_last(buf, key, key_len);
   }
+  /**
+     @brief
+     Read the first row of a part of an index in a parallel scan.
+     @see ha_parallel_index_read()
+  */
+  virtual int parallel_index_read(uchar *buf, const key_range *start)
+  {
+    if (!start)
+      return index_first(buf);
+    return index_read_map(buf, start->key, start->keypart_map, start->flag);
+  }
+  virtual int parallel_index_next(uchar *buf)
+  { return index_next(buf); }
   virtual int close(void)=0;
   inline void update_rows_read()
   {
@@ -3762,6 +3777,61 @@ class handler :public Sql_alloc
   virtual ha_rows records_in_range(uint inx, key_range *min_key,
                                    key_range *max_key)
     { return (ha_rows) 10; }
+  /**
+    Find values that split an index into parts of about the same size,
+    so that the parts can be scanned in parallel by other threads.
+
+    This is called by the thread executing the statement right before the
+    parallel scan starts. If it returns values, handlers of the table that
+    are opened on TABLE objects of their own, and locked, index
+    initialized and prepared with parallel_read_init() by that thread,
+    must be readable from other threads with ha_parallel_index_read() and
+    ha_parallel_index_next().
+
+    @param keyno     The index
+    @param max_keys  The maximum number of values to return
+    @param keys      Buffer for max_keys values of the first key part of
+                     the index, in key format (store_length bytes each)
+
+    @return The number of values written, in ascending order.
+            0 if the index cannot be split.
+  */
+  virtual uint split_index(uint keyno, uint max_keys, uchar *keys)
+    { return 0; }
+  /**
+    Prepare a handler for the reads of a worker of a parallel scan.
+
+    This is called by the thread executing the statement, after
+    ha_index_init(). Until parallel_read_end(), the reads are done by
+    another thread, and must not modify the THD or the transaction of
+    the statement.
+  */
+  virtual int parallel_read_init() { return 0; }
+  /**
+    End the reads of a worker of a parallel scan. This is called by the
+    thread executing the statement, before ha_index_end().
+  */
+  virtual void parallel_read_end() {}
+  /**
+    Read the first row of a part of an index in a parallel scan.
+
+    Unlike ha_index_read_map() and ha_index_next(), these do not update
+    the statistics of the TABLE and the THD, which belong to the thread
+    executing the statement.
+
+    @param buf    Buffer for the row
+    @param start  Start of the part, or NULL to start at the first key
+  */
+  int ha_parallel_index_read(uchar *buf, const key_range *start)
+  {
+    DBUG_ASSERT(inited == INDEX);
+    return parallel_index_read(buf, start);
+  }
+  int ha_parallel_index_next(uchar *buf)
+  {
+    DBUG_ASSERT(inited == INDEX);
+    return parallel_index_next(buf);
+  }
   /*
     If HA_PRIMARY_KEY_REQUIRED_FOR_POSITION is set, then it sets ref
     (reference to the row, aka position, with the primary key given in
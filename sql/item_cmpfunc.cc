@@ -7510,3 +7510,311 @@ Item *Item_equal::multiple_equality_transformer(THD *thd, uchar *arg)
     break;
   }
 }
+
+
+/**
+  Check a compiled comparison of a field with constants for the row that
+  is stored row_offset bytes from record[0]. The values are read like the
+  val_int(), val_real() and val_datetime_packed() methods of the field
+  would read them.
+*/
+
+bool Cond_filter::Step::is_true(my_ptrdiff_t row_offset) const
+{
+  if (field->is_null(row_offset))
+    return false;
+
+  const uchar *ptr= field->ptr + row_offset;
+  int cmp0, cmp1= 0;
+  switch (cmp_type) {
+  case INT_RESULT:
+  {
+    longlong nr;
+    switch (kind) {
+    case FIELD_TINY:
+      nr= unsigned_field ? (longlong) ptr[0] : (longlong) (signed char) ptr[0];
+      break;
+    case FIELD_SHORT:
+      nr= unsigned_field ? (longlong) uint2korr(ptr) : (longlong) sint2korr(ptr);
+      break;
+    case FIELD_INT24:
+      nr= unsigned_field ? (longlong) uint3korr(ptr) : (longlong) sint3korr(ptr);
+      break;
+    case FIELD_LONG:
+      nr= unsigned_field ? (longlong) uint4korr(ptr) : (longlong) sint4korr(ptr);
+      break;
+    default:
+      DBUG_ASSERT(kind == FIELD_LONGLONG);
+      nr= sint8korr(ptr);
+      break;
+    }
+    Longlong_hybrid value(nr, unsigned_field);
+    cmp0= value.cmp(Longlong_hybrid(int_value[0], unsigned_value[0]));
+    if (op == Item_func::BETWEEN)
+      cmp1= value.cmp(Longlong_hybrid(int_value[1], unsigned_value[1]));
+    break;
+  }
+  case REAL_RESULT:
+  {
+    double value;
+    switch (kind) {
+    case FIELD_FLOAT:
+    {
+      float nr;
+      float4get(nr, ptr);
+      value= (double) nr;
+      break;
+    }
+    case FIELD_DOUBLE:
+      float8get(value, ptr);
+      break;
+    case FIELD_TINY:
+      value= unsigned_field ? (double) ptr[0] : (double) (signed char) ptr[0];
+      break;
+    case FIELD_SHORT:
+      value= unsigned_field ? (double) uint2korr(ptr) : (double) sint2korr(ptr);
+      break;
+    case FIELD_INT24:
+      value= unsigned_field ? (double) uint3korr(ptr) : (double) sint3korr(ptr);
+      break;
+    case FIELD_LONG:
+      value= unsigned_field ? (double) uint4korr(ptr) : (double) sint4korr(ptr);
+      break;
+    default:
+      DBUG_ASSERT(kind == FIELD_LONGLONG);
+      value= unsigned_field ? ulonglong2double((ulonglong) uint8korr(ptr)) :
+                              (double) sint8korr(ptr);
+      break;
+    }
+    cmp0= value < real_value[0] ? -1 : value == real_value[0] ? 0 : 1;
+    if (op == Item_func::BETWEEN)
+      cmp1= value < real_value[1] ? -1 : value == real_value[1] ? 0 : 1;
+    break;
+  }
+  default:
+  {
+    DBUG_ASSERT(cmp_type == TIME_RESULT);
+    MYSQL_TIME ltime;
+    if (kind == FIELD_DATE)
+    {
+      uint32 tmp= (uint32) uint3korr(ptr);
+      bzero((void*) &ltime, sizeof(ltime));
+      ltime.day=   tmp & 31;
+      ltime.month= (tmp >> 5) & 15;
+      ltime.year=  (tmp >> 9);
+    }
+    else
+    {
+      DBUG_ASSERT(kind == FIELD_DATETIME);
+      TIME_from_longlong_datetime_packed(&ltime,
+                                         my_datetime_packed_from_binary(ptr,
+                                                                        dec));
+    }
+    longlong value= pack_time(&ltime);
+    cmp0= value < int_value[0] ? -1 : value == int_value[0] ? 0 : 1;
+    if (op == Item_func::BETWEEN)
+      cmp1= value < int_value[1] ? -1 : value == int_value[1] ? 0 : 1;
+    break;
+  }
+  }
+
+  switch (op) {
+  case Item_func::EQ_FUNC: return cmp0 == 0;
+  case Item_func::NE_FUNC: return cmp0 != 0;
+  case Item_func::LT_FUNC: return cmp0 < 0;
+  case Item_func::LE_FUNC: return cmp0 <= 0;
+  case Item_func::GT_FUNC: return cmp0 > 0;
+  case Item_func::GE_FUNC: return cmp0 >= 0;
+  default:
+    DBUG_ASSERT(op == Item_func::BETWEEN);
+    return cmp0 >= 0 && cmp1 <= 0;
+  }
+}
+
+
+/**
+  Set the field of a step if item is a field that can be read directly
+  from the record for comparison type step->cmp_type.
+*/
+
+bool Cond_filter::set_field(Step *step, Item *item)
+{
+  if (item->type() != Item::FIELD_ITEM)
+    return true;
+  Field *field= ((Item_field *) item)->field;
+  if (field->flags & VERS_SYSTEM_FIELD)
+    return true;
+  field_kind kind;
+  switch (field->real_type()) {
+  case MYSQL_TYPE_TINY:     kind= FIELD_TINY; break;
+  case MYSQL_TYPE_SHORT:    kind= FIELD_SHORT; break;
+  case MYSQL_TYPE_INT24:    kind= FIELD_INT24; break;
+  case MYSQL_TYPE_LONG:     kind= FIELD_LONG; break;
+  case MYSQL_TYPE_LONGLONG: kind= FIELD_LONGLONG; break;
+  case MYSQL_TYPE_FLOAT:    kind= FIELD_FLOAT; break;
+  case MYSQL_TYPE_DOUBLE:   kind= FIELD_DOUBLE; break;
+  case MYSQL_TYPE_NEWDATE:  kind= FIELD_DATE; break;
+  case MYSQL_TYPE_DATETIME2: kind= FIELD_DATETIME; break;
+  default:
+    return true;
+  }
+  switch (step->cmp_type) {
+  case INT_RESULT:
+    if (kind > FIELD_LONGLONG)
+      return true;
+    break;
+  case REAL_RESULT:
+    if (kind > FIELD_DOUBLE)
+      return true;
+    break;
+  default:
+    if (kind < FIELD_DATE)
+      return true;
+    break;
+  }
+  step->field= field;
+  step->kind= kind;
+  step->dec= field->decimals();
+  step->unsigned_field= kind <= FIELD_DOUBLE &&
+                        ((Field_num *) field)->unsigned_flag;
+  return false;
+}
+
+
+/**
+  Evaluate a constant of a compiled comparison.
+  @return true if item is not a constant or its value is NULL
+*/
+
+bool Cond_filter::set_value(THD *thd, Step *step, uint idx, Item *item)
+{
+  if (!item->const_item() || item->is_expensive())
+    return true;
+  switch (step->cmp_type) {
+  case INT_RESULT:
+    step->int_value[idx]= item->val_int();
+    step->unsigned_value[idx]= item->unsigned_flag;
+    break;
+  case REAL_RESULT:
+    step->real_value[idx]= item->val_real();
+    break;
+  default:
+    step->int_value[idx]= item->val_datetime_packed(thd);
+    break;
+  }
+  return item->null_value || thd->is_error();
+}
+
+
+/**
+  Compile one conjunct.
+  @return true if the conjunct has to be evaluated with val_bool()
+*/
+
+bool Cond_filter::compile_step(THD *thd, Item *item, Step *step)
+{
+  if (item->type() != Item::FUNC_ITEM)
+    return true;
+  Item_func *func= (Item_func *) item;
+  Item **args= func->arguments();
+  switch (func->functype()) {
+  case Item_func::EQ_FUNC:
+  case Item_func::NE_FUNC:
+  case Item_func::LT_FUNC:
+  case Item_func::LE_FUNC:
+  case Item_func::GT_FUNC:
+  case Item_func::GE_FUNC:
+  {
+    Arg_comparator *comparator=
+      ((Item_bool_rowready_func2 *) func)->get_comparator();
+    arg_cmp_func cmp= comparator->compare_func();
+    if (cmp == &Arg_comparator::compare_int_signed ||
+        cmp == &Arg_comparator::compare_int_unsigned ||
+        cmp == &Arg_comparator::compare_int_signed_unsigned ||
+        cmp == &Arg_comparator::compare_int_unsigned_signed)
+      step->cmp_type= INT_RESULT;
+    else if (cmp == &Arg_comparator::compare_real)
+      step->cmp_type= REAL_RESULT;
+    else if (cmp == &Arg_comparator::compare_datetime)
+      step->cmp_type= TIME_RESULT;
+    else
+      return true;
+    step->op= func->functype();
+    if (!set_field(step, comparator->left()))
+      return set_value(thd, step, 0, comparator->right());
+    if (set_field(step, comparator->right()) ||
+        set_value(thd, step, 0, comparator->left()))
+      return true;
+    /* const <op> field: swap the operands */
+    switch (step->op) {
+    case Item_func::LT_FUNC: step->op= Item_func::GT_FUNC; break;
+    case Item_func::LE_FUNC: step->op= Item_func::GE_FUNC; break;
+    case Item_func::GT_FUNC: step->op= Item_func::LT_FUNC; break;
+    case Item_func::GE_FUNC: step->op= Item_func::LE_FUNC; break;
+    default: break;
+    }
+    return false;
+  }
+  case Item_func::BETWEEN:
+  {
+    Item_func_between *between= (Item_func_between *) func;
+    const Type_handler *handler= between->compare_type_handler();
+    if (between->negated)
+      return true;
+    if (handler->cmp_type() == INT_RESULT)
+      step->cmp_type= INT_RESULT;
+    else if (handler->cmp_type() == REAL_RESULT)
+      step->cmp_type= REAL_RESULT;
+    else if (handler == &type_handler_newdate ||
+             handler == &type_handler_datetime)
+      step->cmp_type= TIME_RESULT;
+    else
+      return true;
+    step->op= Item_func::BETWEEN;
+    return set_field(step, args[0]) ||
+           set_value(thd, step, 0, args[1]) ||
+           set_value(thd, step, 1, args[2]);
+  }
+  default:
+    return true;
+  }
+}
+
+
+Cond_filter *Cond_filter::create(THD *thd, Item *cond)
+{
+  List<Item> single;
+  List<Item> *conjuncts= &single;
+  /*
+    The conditions attached to a JOIN_TAB are only used as filters, so
+    stopping at the first conjunct that is not TRUE is correct even for
+    an AND that is not marked as top level (make_cond_for_table() does
+    not mark the ANDs it creates).
+  */
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond *) cond)->functype() == Item_func::COND_AND_FUNC)
+    conjuncts= ((Item_cond *) cond)->argument_list();
+  else if (single.push_back(cond, thd->mem_root))
+    return NULL;
+
+  Step *steps;
+  if (!(steps= (Step *) thd->alloc(sizeof(Step) * conjuncts->elements)))
+    return NULL;
+  uint n_steps= 0;
+  bool compiled= false;
+  List_iterator_fast<Item> li(*conjuncts);
+  Item *item;
+  while ((item= li++))
+  {
+    Step *step= steps + n_steps++;
+    bzero((void*) step, sizeof(*step));
+    step->item= item;
+    if (compile_step(thd, item, step))
+      step->field= NULL;
+    else
+      compiled= true;
+  }
+  if (thd->is_error() || !compiled)
+    return NULL;
+  return new (thd->mem_root) Cond_filter(steps, n_steps);
+}
@@ -141,6 +141,10 @@ class Arg_comparator: public Sql_alloc
   }
   const Type_handler *compare_type_handler() const { return m_compare_handler; }
   Item_result compare_type() const { return m_compare_handler->cmp_type(); }
+  arg_cmp_func compare_func() const { return func; }
+  /* The compared items, possibly caches of converted constants */
+  Item *left() const { return *a; }
+  Item *right() const { return *b; }
   CHARSET_INFO *compare_collation() const { return m_compare_collation; }
   Arg_comparator *subcomparators() const { return comparators; }
   void cleanup()
@@ -908,6 +912,8 @@ class Item_func_between :public Item_func_opt_neg
   }
   enum Functype functype() const   { return BETWEEN; }
   const char *func_name() const { return "between"; }
+  const Type_handler *compare_type_handler() const
+  { return m_comparator.type_handler(); }
   enum precedence precedence() const { return BETWEEN_PRECEDENCE; }
   bool fix_length_and_dec();
   bool fix_length_and_dec_string(THD *)
@@ -3560,6 +3566,88 @@ class Le_creator :public Comp_creator
   bool l_op() const { return 1; }
 };
 
+/**
+  A compiled form of a condition that is used to filter rows.
+
+  The condition is split into its top level conjuncts, which are checked
+  in their original order. Conjuncts that compare a numeric or temporal
+  field with constants (=, <>, <, <=, >, >= and BETWEEN) are checked
+  directly on the record buffer of the field, without the virtual calls
+  of Item::val_int() and Arg_comparator. Other conjuncts are evaluated
+  with Item::val_bool().
+
+  The result is only meaningful as a filter: is_true() returns false
+  both when the condition is FALSE and when it is NULL.
+*/
+
+class Cond_filter :public Sql_alloc
+{
+  /* How the value of a field is read from the record */
+  enum field_kind
+  {
+    FIELD_NONE, FIELD_TINY, FIELD_SHORT, FIELD_INT24, FIELD_LONG,
+    FIELD_LONGLONG, FIELD_FLOAT, FIELD_DOUBLE, FIELD_DATE, FIELD_DATETIME
+  };
+  struct Step
+  {
+    Item *item;                 // The conjunct
+    Field *field;               // NULL if item is evaluated with val_bool()
+    field_kind kind;
+    uint dec;                   // Fractional digits of a DATETIME field
+    bool unsigned_field;
+    Item_result cmp_type;       // INT_RESULT, REAL_RESULT or TIME_RESULT
+    Item_func::Functype op;     // EQ_FUNC...GT_FUNC or BETWEEN
+    longlong int_value[2];      // Constants for INT_RESULT and TIME_RESULT
+    bool unsigned_value[2];
+    double real_value[2];       // Constants for REAL_RESULT
+    bool is_true(my_ptrdiff_t row_offset) const;
+  };
+  Step *steps, *steps_end;
+
+  Cond_filter(Step *steps_arg, uint n_steps)
+    :steps(steps_arg), steps_end(steps_arg + n_steps)
+  {}
+  static bool compile_step(THD *thd, Item *item, Step *step);
+  static bool set_field(Step *step, Item *item);
+  static bool set_value(THD *thd, Step *step, uint idx, Item *item);
+
+public:
+  /**
+    Compile a condition.
+    @return NULL if no conjunct of the condition could be compiled
+  */
+  static Cond_filter *create(THD *thd, Item *cond);
+
+  /** Check the condition for the current row */
+  bool is_true() const
+  {
+    for (const Step *step= steps; step < steps_end; step++)
+    {
+      if (step->field ? !step->is_true(0) : !step->item->val_bool())
+        return false;
+    }
+    return true;
+  }
+
+  /**
+    Check only the compiled conjuncts on the fields of a table, for a row
+    that is stored row_offset bytes from record[0]. A row for which this
+    returns true may still not satisfy the condition. The items are not
+    used, so this can be called by threads other than the one executing
+    the statement, as long as the fields are not moved meanwhile.
+  */
+  bool is_true_compiled(const TABLE *table, my_ptrdiff_t row_offset) const
+  {
+    for (const Step *step= steps; step < steps_end; step++)
+    {
+      if (step->field && step->field->table == table &&
+          !step->is_true(row_offset))
+        return false;
+    }
+    return true;
+  }
+};
+
 /*
   These need definitions from this file but the variables are defined
   in mysqld.h. The variables really belong in this component, but for
@@ -258,6 +258,77 @@ void make_default_log_name(char **out, const char* log_ext, bool once)
 }
 
 
+/*
+  Writeset of the events in a binlog cache: the hashes of the unique keys of
+  the rows they change, logged in a Writeset_log_event before the GTID event
+  of the event group so that a parallel slave can run event groups changing
+  different rows in parallel (@@binlog_writeset_max_keys).
+
+  The writeset is not usable if it would have more keys than allowed, or if
+  the changed rows cannot be identified by their unique keys (statements,
+  tables without unique keys, with foreign keys or temporary tables).
+*/
+class Binlog_writeset
+{
+public:
+  Binlog_writeset(): keys(0), count(0), size(0), usable(true),
+    last_table(0), last_query_id(0), last_table_usable(false)
+  { }
+  ~Binlog_writeset() { my_free(keys); }
+
+  void reset()
+  {
+    count= 0;
+    usable= true;
+    last_table= 0;
+  }
+
+  void set_unusable() { usable= false; }
+  bool is_usable() const { return usable && count > 0; }
+
+  void add(uint64 key)
+  {
+    if (!usable)
+      return;
+    /* An update logs the same keys for the before and after images */
+    for (uint i= count > 4 ? count - 4 : 0; i < count; i++)
+      if (keys[i] == key)
+        return;
+    if (count == size)
+    {
+      uint new_size= (uint) MY_MIN(opt_binlog_writeset_max_keys,
+                                   MY_MAX(size * 2, 16));
+      uint64 *new_keys;
+      if (count >= new_size ||
+          !(new_keys= (uint64*) my_realloc(keys, sizeof(uint64) * new_size,
+                                           MYF(MY_ALLOW_ZERO_PTR))))
+      {
+        usable= false;
+        return;
+      }
+      keys= new_keys;
+      size= new_size;
+    }
+    keys[count++]= key;
+  }
+
+  void add_row(TABLE *table, const uchar *record, const MY_BITMAP *known,
+               const MY_BITMAP *changed);
+
+  uint64 *keys;
+  uint count;
+
+private:
+  uint size;
+  bool usable;
+
+  /* Whether rows of the table last seen can be identified by their keys */
+  TABLE *last_table;
+  query_id_t last_query_id;
+  bool last_table_usable;
+};
+
+
 /*
   Helper classes to store non-transactional and transactional data
   before copying it to the binary log.
@@ -341,6 +412,7 @@ class binlog_cache_data
     status= 0;
     incident= FALSE;
     before_stmt_pos= MY_OFF_T_UNDEF;
+    writeset.reset();
     DBUG_ASSERT(empty());
   }
 
@@ -411,6 +483,8 @@ class binlog_cache_data
   */
   IO_CACHE cache_log;
 
+  Binlog_writeset writeset;
+
 private:
   /*
     Pending binrows event. This event is the event where the rows are currently
@@ -5933,6 +6007,135 @@ THD::binlog_set_pending_rows_event(Rows_log_event* ev, bool is_transactional)
 }
 
 
+/**
+  Add the hashes of the unique keys of a row to the writeset.
+
+  @param table    the table of the row
+  @param record   the row, in the format of table->record[0]
+  @param known    the columns that have a value in the row, NULL for all
+  @param changed  the columns changed by an update, NULL for other rows
+*/
+
+void Binlog_writeset::add_row(TABLE *table, const uchar *record,
+                              const MY_BITMAP *known,
+                              const MY_BITMAP *changed)
+{
+  THD *thd= table->in_use;
+  my_ptrdiff_t offset= record - table->record[0];
+  const LEX_CSTRING *table_key= &table->s->table_cache_key;
+  uint added= 0;
+
+  if (!usable)
+    return;
+  if (table != last_table || thd->query_id != last_query_id)
+  {
+    /*
+      Rows of a table with foreign keys depend on rows of other tables,
+      rows of temporary tables have no identity on the slave.
+    */
+    last_table= table;
+    last_query_id= thd->query_id;
+    last_table_usable= !table->s->tmp_table &&
+                       table->file->can_switch_engines();
+  }
+  if (!last_table_usable)
+  {
+    usable= false;
+    return;
+  }
+
+  for (uint keynr= 0; keynr < table->s->keys; keynr++)
+  {
+    KEY *key= table->key_info + keynr;
+    KEY_PART_INFO *part, *end= key->key_part + key->user_defined_key_parts;
+    bool all_known= true, any_changed= false, has_null= false;
+    ulong nr1= 1, nr2= 4;
+    uchar keynr_buf[4];
+
+    if (!(key->flags & HA_NOSAME))
+      continue;
+    if (key->algorithm == HA_KEY_ALG_LONG_HASH)
+    {
+      usable= false;
+      return;
+    }
+    for (part= key->key_part; part < end; part++)
+    {
+      Field *field= part->field;
+      if (part->key_part_flag & HA_PART_KEY_SEG)
+      {
+        /* Different values may conflict on their prefix */
+        usable= false;
+        return;
+      }
+      if (known && !bitmap_is_set(known, field->field_index))
+        all_known= false;
+      if (changed && bitmap_is_set(changed, field->field_index))
+        any_changed= true;
+      if (field->is_null_in_record(record))
+        has_null= true;
+    }
+    if (!all_known)
+    {
+      /* A key not changed by an update has the same value in both images */
+      if (changed && !any_changed)
+        continue;
+      usable= false;
+      return;
+    }
+    /* Rows with NULL in a unique key do not conflict on it */
+    if (has_null)
+      continue;
+
+    my_charset_bin.coll->hash_sort(&my_charset_bin, (uchar*) table_key->str,
+                                   table_key->length, &nr1, &nr2);
+    int4store(keynr_buf, keynr);
+    my_charset_bin.coll->hash_sort(&my_charset_bin, keynr_buf,
+                                   sizeof(keynr_buf), &nr1, &nr2);
+    for (part= key->key_part; part < end; part++)
+    {
+      part->field->move_field_offset(offset);
+      part->field->hash(&nr1, &nr2);
+      part->field->move_field_offset(-offset);
+    }
+    add((uint64) nr1 ^ ((uint64) nr2 << 32));
+    added++;
+  }
+  /* The row can only be identified by a key */
+  if (!added)
+    usable= false;
+}
+
+
+/**
+  Add the unique keys of a row logged in row format to the writeset of the
+  binlog cache the row goes to (@@binlog_writeset_max_keys).
+
+  @see Binlog_writeset::add_row()
+*/
+
+void THD::binlog_writeset_add_row(TABLE *table, bool is_transactional,
+                                  const uchar *record,
+                                  const MY_BITMAP *known,
+                                  const MY_BITMAP *changed)
+{
+  binlog_cache_mngr *cache_mngr;
+
+  if (!opt_binlog_writeset_max_keys)
+    return;
+  /* Ensure that all events in a GTID group are in the same cache */
+  if (variables.option_bits & OPTION_GTID_BEGIN)
+    is_transactional= 1;
+  if ((cache_mngr= binlog_setup_trx_data()))
+  {
+    binlog_cache_data *cache_data=
+      cache_mngr->get_binlog_cache_data(use_trans_cache(this,
+                                                        is_transactional));
+    cache_data->writeset.add_row(table, record, known, changed);
+  }
+}
+
+
 /**
   This function removes the pending rows event, discarding any outstanding
   rows. If there is no pending rows event available, this is effectively a
@@ -6029,7 +6232,8 @@ MYSQL_BIN_LOG::flush_and_set_pending_rows_event(THD *thd,
 
 bool
 MYSQL_BIN_LOG::write_gtid_event(THD *thd, bool standalone,
-                                bool is_transactional, uint64 commit_id)
+                                bool is_transactional, uint64 commit_id,
+                                Binlog_writeset *writeset)
 {
   rpl_gtid gtid;
   uint32 domain_id;
@@ -6103,6 +6307,21 @@ MYSQL_BIN_LOG::write_gtid_event(THD *thd, bool standalone,
     DBUG_RETURN(false);
 #endif
 
+  /*
+    The writeset goes before the GTID event, so that the slave knows it
+    when it schedules the event group.
+  */
+  if (writeset && writeset->is_usable() &&
+      !(gtid_event.flags2 & Gtid_log_event::FL_DDL))
+  {
+    Writeset_log_event writeset_event(thd, &gtid, writeset->keys,
+                                      writeset->count);
+    if (write_event(&writeset_event))
+      DBUG_RETURN(true);
+    status_var_add(thd->status_var.binlog_bytes_written,
+                   writeset_event.data_written);
+  }
+
   if (write_event(&gtid_event))
     DBUG_RETURN(true);
   status_var_add(thd->status_var.binlog_bytes_written, gtid_event.data_written);
@@ -6223,6 +6442,14 @@ MYSQL_BIN_LOG::get_most_recent_gtid_list(rpl_gtid **list, uint32 *size)
 }
 
 
+int
+MYSQL_BIN_LOG::get_replicated_gtid_list(rpl_gtid **list, uint32 *size)
+{
+  return rpl_global_gtid_binlog_state.get_replicated_gtid_list(
+    list, size, global_system_variables.server_id);
+}
+
+
 bool
 MYSQL_BIN_LOG::append_state_pos(String *str)
 {
@@ -6425,6 +6652,12 @@ bool MYSQL_BIN_LOG::write(Log_event *event_info, my_bool *with_annotate)
       if (thd->lex->stmt_accessed_non_trans_temp_table())
         cache_data->set_changes_to_non_trans_temp_table();
 
+      /* The rows changed by a statement logged as such are not known */
+      if (event_info->get_type_code() != TABLE_MAP_EVENT &&
+          thd->lex->sql_command != SQLCOM_SAVEPOINT &&
+          thd->lex->sql_command != SQLCOM_ROLLBACK_TO_SAVEPOINT)
+        cache_data->writeset.set_unusable();
+
       thd->binlog_start_trans_and_stmt();
     }
     DBUG_PRINT("info",("event type: %d",event_info->get_type_code()));
@@ -7346,6 +7579,40 @@ MYSQL_BIN_LOG::write_binlog_checkpoint_event_already_locked(const char *name_arg
 }
 
 
+/*
+  Compress the events of a binlog cache into a Transaction_payload_log_event,
+  if @@log_bin_compress_transactions is set.
+
+  A cache that was written to its temporary file is read back from it. The
+  cache is only compressed if the compressed events are smaller, and if the
+  events fit in @@slave_max_allowed_packet, so that the slave can read them.
+
+  @return The event, to be deleted by the caller, or NULL if the cache
+          should be written as it is.
+*/
+
+static Log_event *binlog_compress_cache(THD *thd, IO_CACHE *cache)
+{
+  size_t length= (size_t) my_b_write_tell(cache);
+  Transaction_payload_log_event *ev;
+
+  if (!opt_bin_log_compress_transactions ||
+      length < opt_bin_log_compress_min_len ||
+      length > slave_max_allowed_packet ||
+      cache->type != WRITE_CACHE)
+    return NULL;
+  if (!(ev= new Transaction_payload_log_event(thd, cache, length)))
+    return NULL;
+  if (!ev->is_valid() ||
+      ev->payload_len + LOG_EVENT_HEADER_LEN >= length)
+  {
+    delete ev;
+    return NULL;
+  }
+  return ev;
+}
+
+
 /**
   Write a cached log entry to the binary log.
   - To support transaction over replication, we wrap the transaction
@@ -7379,6 +7646,7 @@ MYSQL_BIN_LOG::write_transaction_to_binlog(THD *thd,
 {
   group_commit_entry entry;
   Ha_trx_info *ha_info;
+  bool res;
   DBUG_ENTER("MYSQL_BIN_LOG::write_transaction_to_binlog");
 
   /*
@@ -7414,18 +7682,31 @@ MYSQL_BIN_LOG::write_transaction_to_binlog(THD *thd,
   }
 
   entry.end_event= end_ev;
+
+  /*
+    Compress the caches here, so that the group commit leader only has to
+    write the compressed events while holding LOCK_log.
+  */
+  entry.stmt_payload= using_stmt_cache && !cache_mngr->stmt_cache.empty() ?
+    binlog_compress_cache(thd, &cache_mngr->stmt_cache.cache_log) : NULL;
+  entry.trx_payload= using_trx_cache && !cache_mngr->trx_cache.empty() ?
+    binlog_compress_cache(thd, &cache_mngr->trx_cache.cache_log) : NULL;
+
   if (cache_mngr->stmt_cache.has_incident() ||
       cache_mngr->trx_cache.has_incident())
   {
     Incident_log_event inc_ev(thd, INCIDENT_LOST_EVENTS, &write_error_msg);
     entry.incident_event= &inc_ev;
-    DBUG_RETURN(write_transaction_to_binlog_events(&entry));
+    res= write_transaction_to_binlog_events(&entry);
   }
   else
   {
     entry.incident_event= NULL;
-    DBUG_RETURN(write_transaction_to_binlog_events(&entry));
+    res= write_transaction_to_binlog_events(&entry);
   }
+  delete entry.stmt_payload;
+  delete entry.trx_payload;
+  DBUG_RETURN(res);
 }
 
 
@@ -8206,6 +8487,31 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
 }
 
 
+/*
+  Get the writeset of an event group to commit: the union of the writesets
+  of the binlog caches written.
+*/
+
+static Binlog_writeset *entry_writeset(group_commit_entry *entry)
+{
+  binlog_cache_mngr *mngr= entry->cache_mngr;
+  bool use_stmt= entry->using_stmt_cache && !mngr->stmt_cache.empty();
+  bool use_trx= entry->using_trx_cache && !mngr->trx_cache.empty();
+  Binlog_writeset *stmt_writeset= &mngr->stmt_cache.writeset;
+
+  if (!use_trx)
+    return use_stmt ? stmt_writeset : NULL;
+  if (use_stmt)
+  {
+    if (!stmt_writeset->is_usable())
+      mngr->trx_cache.writeset.set_unusable();
+    for (uint i= 0; i < stmt_writeset->count; i++)
+      mngr->trx_cache.writeset.add(stmt_writeset->keys[i]);
+  }
+  return &mngr->trx_cache.writeset;
+}
+
+
 int
 MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
                                          uint64 commit_id)
@@ -8213,11 +8519,13 @@ MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
   binlog_cache_mngr *mngr= entry->cache_mngr;
   DBUG_ENTER("MYSQL_BIN_LOG::write_transaction_or_stmt");
 
-  if (write_gtid_event(entry->thd, false, entry->using_trx_cache, commit_id))
+  if (write_gtid_event(entry->thd, false, entry->using_trx_cache, commit_id,
+                       entry_writeset(entry)))
     DBUG_RETURN(ER_ERROR_ON_WRITE);
 
   if (entry->using_stmt_cache && !mngr->stmt_cache.empty() &&
-      write_cache(entry->thd, mngr->get_binlog_cache_log(FALSE)))
+      write_cache_or_payload(entry->thd, mngr->get_binlog_cache_log(FALSE),
+                             entry->stmt_payload))
   {
     entry->error_cache= &mngr->stmt_cache.cache_log;
     DBUG_RETURN(ER_ERROR_ON_WRITE);
@@ -8227,8 +8535,9 @@ MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
   {
     DBUG_EXECUTE_IF("crash_before_writing_xid",
                     {
-                      if ((write_cache(entry->thd,
-                                       mngr->get_binlog_cache_log(TRUE))))
+                      if ((write_cache_or_payload(entry->thd,
+                                                  mngr->get_binlog_cache_log(TRUE),
+                                                  entry->trx_payload)))
                         DBUG_PRINT("info", ("error writing binlog cache"));
                       else
                         flush_and_sync(0);
@@ -8237,7 +8546,8 @@ MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
                       DBUG_SUICIDE();
                     });
 
-    if (write_cache(entry->thd, mngr->get_binlog_cache_log(TRUE)))
+    if (write_cache_or_payload(entry->thd, mngr->get_binlog_cache_log(TRUE),
+                               entry->trx_payload))
     {
       entry->error_cache= &mngr->trx_cache.cache_log;
       DBUG_RETURN(ER_ERROR_ON_WRITE);
@@ -8283,6 +8593,25 @@ MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
 }
 
 
+/*
+  Write the events of a binlog cache, or the Transaction_payload_log_event
+  they were compressed into.
+*/
+
+int
+MYSQL_BIN_LOG::write_cache_or_payload(THD *thd, IO_CACHE *cache,
+                                      Log_event *payload)
+{
+  if (!payload)
+    return write_cache(thd, cache);
+  mysql_mutex_assert_owner(&LOCK_log);
+  if (write_event(payload))
+    return ER_ERROR_ON_WRITE;
+  status_var_add(thd->status_var.binlog_bytes_written, payload->data_written);
+  return 0;
+}
+
+
 /*
   Wait for sufficient commits to queue up for group commit, according to the
   values of binlog_commit_wait_count and binlog_commit_wait_usec.
@@ -408,6 +408,7 @@ class MYSQL_QUERY_LOG: public MYSQL_LOG
 
 class binlog_cache_mngr;
 class binlog_cache_data;
+class Binlog_writeset;
 struct rpl_gtid;
 struct wait_for_commit;
 
@@ -445,6 +446,13 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
     */
     Log_event *end_event;
     Log_event *incident_event;
+    /*
+      With @@log_bin_compress_transactions, the events of the statement and
+      transaction caches compressed into Transaction_payload_log_event, to
+      be written in place of the caches. NULL if the cache is not compressed.
+    */
+    Log_event *stmt_payload;
+    Log_event *trx_payload;
     /* Set during group commit to record any per-thread error. */
     int error;
     int commit_errno;
@@ -559,6 +567,7 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   void do_checkpoint_request(ulong binlog_id);
   void purge();
   int write_transaction_or_stmt(group_commit_entry *entry, uint64 commit_id);
+  int write_cache_or_payload(THD *thd, IO_CACHE *cache, Log_event *payload);
   int queue_for_group_commit(group_commit_entry *entry);
   bool write_transaction_to_binlog_events(group_commit_entry *entry);
   void trx_group_commit_leader(group_commit_entry *leader);
@@ -877,10 +886,11 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   void set_status_variables(THD *thd);
   bool is_xidlist_idle();
   bool write_gtid_event(THD *thd, bool standalone, bool is_transactional,
-                        uint64 commit_id);
+                        uint64 commit_id, Binlog_writeset *writeset= NULL);
   int read_state_from_file();
   int write_state_to_file();
   int get_most_recent_gtid_list(rpl_gtid **list, uint32 *size);
+  int get_replicated_gtid_list(rpl_gtid **list, uint32 *size);
   bool append_state_pos(String *str);
   bool append_state(String *str);
   bool is_empty_state();
@@ -771,17 +771,10 @@ uint32 binlog_get_compress_len(uint32 len)
 }
 
 /**
-   Compress buf from 'src' to 'dst'.
-
-   Note: 1) Then the caller should guarantee the length of 'dst', which
-      can be got by binlog_get_uncompress_len, is enough to hold
-      the content uncompressed.
-         2) The 'comlen' should stored the length of 'dst', and it will
-      be set as the size of compressed content after return.
-
-   return zero if successful, others otherwise.
+  Store the record header and original length of a compressed record of
+  'len' bytes in 'dst'. Returns the number of bytes of the original length.
 */
-int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen)
+static uchar binlog_store_compress_header(char *dst, uint32 len)
 {
   uchar lenlen;
   if (len & 0xFF000000)
@@ -811,6 +804,23 @@ int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen)
     lenlen = 1;
   }
   dst[0] = 0x80 | (lenlen & 0x07);
+  return lenlen;
+}
+
+/**
+   Compress buf from 'src' to 'dst'.
+
+   Note: 1) Then the caller should guarantee the length of 'dst', which
+      can be got by binlog_get_uncompress_len, is enough to hold
+      the content uncompressed.
+         2) The 'comlen' should stored the length of 'dst', and it will
+      be set as the size of compressed content after return.
+
+   return zero if successful, others otherwise.
+*/
+int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen)
+{
+  uchar lenlen= binlog_store_compress_header(dst, len);
 
   uLongf tmplen = (uLongf)*comlen - BINLOG_COMPRESSED_HEADER_LEN - lenlen - 1;
   if (compress((Bytef *)dst + BINLOG_COMPRESSED_HEADER_LEN + lenlen, &tmplen,
@@ -1044,6 +1054,99 @@ row_log_event_uncompress(const Format_description_log_event *description_event,
   return 0;
 }
 
+/**
+   Expand a transaction_payload_log_event into the events it holds,
+   from 'src' to 'dst', the length of the events stored in 'newlen'.
+
+   Every event gets the end_log_pos of the payload event, and a checksum
+   if contain_checksum is set, as if it had been read from the binlog in
+   place of the payload event.
+
+   @Note:
+      1) The caller should call my_free to release 'dst' if *is_malloc is
+         returned as true.
+      2) If *is_malloc is returned as false, then 'dst' reuses the passed-in
+         'buf'.
+
+   return zero if successful, non-zero otherwise.
+*/
+
+int
+transaction_payload_uncompress(const Format_description_log_event *description_event,
+                               bool contain_checksum, const char *src,
+                               ulong src_len, char* buf, ulong buf_size,
+                               bool* is_malloc, char **dst, ulong *newlen)
+{
+  ulong len= uint4korr(src + EVENT_LEN_OFFSET);
+  uint32 log_pos= uint4korr(src + LOG_POS_OFFSET);
+  uint checksum_len= contain_checksum ? BINLOG_CHECKSUM_LEN : 0;
+  const char *tmp= src + description_event->common_header_len +
+                   TRANSACTION_PAYLOAD_HEADER_LEN;
+  char *events, *new_dst;
+  ulong pos, count;
+
+  DBUG_ASSERT((uchar)src[EVENT_TYPE_OFFSET] == TRANSACTION_PAYLOAD_EVENT);
+
+  *is_malloc= false;
+  // bad event
+  if (src_len < len || len <= (ulong) (tmp - src) + checksum_len)
+    return 1;
+
+  uint32 comp_len= (uint32) (len - (tmp - src) - checksum_len);
+  uint32 un_len= binlog_get_uncompress_len(tmp);
+  // bad event
+  if (un_len == 0)
+    return 1;
+
+  if (!(events= (char *) my_malloc(un_len, MYF(MY_WME))))
+    return 1;
+  if (binlog_buf_uncompress(tmp, events, comp_len, &un_len))
+    goto err;
+
+  /* Count the events, each of them may need room for a checksum */
+  for (pos= 0, count= 0; pos < un_len; count++)
+  {
+    ulong event_len;
+    if (un_len - pos < LOG_EVENT_MINIMAL_HEADER_LEN ||
+        (event_len= uint4korr(events + pos + EVENT_LEN_OFFSET)) <
+        LOG_EVENT_MINIMAL_HEADER_LEN ||
+        event_len > un_len - pos)
+      goto err;                                 // bad event
+    pos+= event_len;
+  }
+
+  *newlen= un_len + count * checksum_len;
+  if (ALIGN_SIZE(*newlen) <= buf_size)
+    new_dst= buf;
+  else
+  {
+    if (!(new_dst= (char *) my_malloc(ALIGN_SIZE(*newlen), MYF(MY_WME))))
+      goto err;
+    *is_malloc= true;
+  }
+
+  for (pos= 0, tmp= events; tmp < events + un_len; )
+  {
+    ulong event_len= uint4korr(tmp + EVENT_LEN_OFFSET);
+    char *ev= new_dst + pos;
+
+    memcpy(ev, tmp, event_len);
+    int4store(ev + LOG_POS_OFFSET, log_pos);
+    int4store(ev + EVENT_LEN_OFFSET, event_len + checksum_len);
+    if (contain_checksum)
+      int4store(ev + event_len, my_checksum(0L, (uchar *) ev, event_len));
+    tmp+= event_len;
+    pos+= event_len + checksum_len;
+  }
+  my_free(events);
+  *dst= new_dst;
+  return 0;
+
+err:
+  my_free(events);
+  return 1;
+}
+
 /**
   Get the length of uncompress content.
   return 0 means error.
@@ -1259,6 +1362,8 @@ const char* Log_event::get_type_str(Log_event_type type)
   case WRITE_ROWS_COMPRESSED_EVENT_V1: return "Write_rows_compressed_v1";
   case UPDATE_ROWS_COMPRESSED_EVENT_V1: return "Update_rows_compressed_v1";
   case DELETE_ROWS_COMPRESSED_EVENT_V1: return "Delete_rows_compressed_v1";
+  case TRANSACTION_PAYLOAD_EVENT: return "Transaction_payload";
+  case WRITESET_EVENT: return "Writeset";
 
   default: return "Unknown";				/* impossible */
   }
@@ -2051,7 +2156,10 @@ Log_event* Log_event::read_log_event(const char* buf, uint event_len,
   }
 
   if (event_type > fdle->number_of_event_types &&
-      event_type != FORMAT_DESCRIPTION_EVENT)
+      event_type != FORMAT_DESCRIPTION_EVENT &&
+      !((event_type == TRANSACTION_PAYLOAD_EVENT ||
+         event_type == WRITESET_EVENT) &&
+        fdle->number_of_event_types >= LOG_EVENT_TYPES))
   {
     /*
       It is unsafe to use the fdle if its post_header_len
@@ -2214,6 +2322,12 @@ Log_event* Log_event::read_log_event(const char* buf, uint event_len,
     case START_ENCRYPTION_EVENT:
       ev = new Start_encryption_log_event(buf, event_len, fdle);
       break;
+    case TRANSACTION_PAYLOAD_EVENT:
+      ev = new Transaction_payload_log_event(buf, event_len, fdle);
+      break;
+    case WRITESET_EVENT:
+      ev = new Writeset_log_event(buf, event_len, fdle);
+      break;
     default:
       /*
         Create an object of Ignorable_log_event for unrecognized sub-class.
@@ -10803,7 +10917,7 @@ Rows_log_event::Rows_log_event(THD *thd_arg, TABLE *tbl_arg, ulong tid,
 #ifdef HAVE_REPLICATION
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    master_had_triggers(0)
+    master_had_triggers(0), m_hash_scan(NULL), m_hash_scan_done(false)
 #endif
 {
   /*
@@ -10855,7 +10969,7 @@ Rows_log_event::Rows_log_event(const char *buf, uint event_len,
 #if !defined(MYSQL_CLIENT) && defined(HAVE_REPLICATION)
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    master_had_triggers(0)
+    master_had_triggers(0), m_hash_scan(NULL), m_hash_scan_done(false)
 #endif
 {
   DBUG_ENTER("Rows_log_event::Rows_log_event(const char*,...)");
@@ -13942,6 +14056,195 @@ static int row_not_found_error(rpl_group_info *rgi)
          ? HA_ERR_KEY_NOT_FOUND : HA_ERR_RECORD_CHANGED;
 }
 
+/*
+  Rows of a DELETE or UPDATE event on a table without a usable key, located
+  with a single table scan instead of one scan per row.
+*/
+struct Rows_hash_scan_row
+{
+  Rows_hash_scan_row *next;     /* Next row of the event */
+  const uchar *row;             /* Before image in the event */
+  ulonglong hash;               /* Hash of the before image */
+  ulonglong after_hash;         /* Hash of the after image of an update */
+  bool found;
+  uchar ref[1];                 /* handler::position() of the row found */
+};
+
+struct Rows_hash_scan
+{
+  MEM_ROOT mem_root;
+  HASH rows;                    /* Rows_hash_scan_row by hash */
+  Rows_hash_scan_row *next;     /* Next row to locate */
+};
+
+
+/* Hash of table->record[0], equal for records equal by record_compare() */
+static ulonglong record_hash(TABLE *table)
+{
+  ulong nr1= 1, nr2= 4;
+  for (Field **ptr= table->field; *ptr; ptr++)
+    (*ptr)->hash(&nr1, &nr2);
+  return (ulonglong) nr1 ^ ((ulonglong) nr2 << 32);
+}
+
+
+/**
+  Locate all rows of the event with one scan of the table.
+
+  The before images of the rows are put in a hash, then each row of the
+  table is looked up in it. A row of the table is taken by at most one row
+  of the event, so identical rows are handled as by consecutive scans. The
+  position of the row found for each row of the event is kept in
+  m_hash_scan, where find_row() takes it from.
+
+  This is not done if a row of an update could be changed by an earlier
+  row of the same event (its before image equals an after image), as the
+  rows are located before any of them is changed. Then, and for events of
+  one row, find_row() scans the table for each row.
+
+  @returns Error code on failure, 0 on success (also if the rows are not
+  located this way).
+*/
+
+int Rows_log_event::hash_scan_rows(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  handler *file= table->file;
+  const uchar *curr_row= m_curr_row;
+  bool is_update= get_general_type_code() == UPDATE_ROWS_EVENT;
+  Rows_hash_scan_row *row, **last_row;
+  uint n_rows= 0, n_found= 0;
+  int error= 0;
+  DBUG_ENTER("Rows_log_event::hash_scan_rows");
+
+  m_hash_scan_done= true;
+  if (table->versioned() ||
+      !(m_hash_scan= (Rows_hash_scan*) my_malloc(sizeof(Rows_hash_scan),
+                                                 MYF(0))))
+    DBUG_RETURN(0);
+  if (my_hash_init(&m_hash_scan->rows, &my_charset_bin, 256,
+                   offsetof(Rows_hash_scan_row, hash), sizeof(ulonglong),
+                   0, 0, MYF(0)))
+  {
+    my_free(m_hash_scan);
+    m_hash_scan= NULL;
+    DBUG_RETURN(0);
+  }
+  init_alloc_root(&m_hash_scan->mem_root, "Rows_hash_scan", 8192, 0, MYF(0));
+  m_hash_scan->next= NULL;
+  last_row= &m_hash_scan->next;
+
+  /* Hash the before images */
+  for (m_curr_row= curr_row; m_curr_row < m_rows_end;
+       m_curr_row= m_curr_row_end)
+  {
+    if (!(row= (Rows_hash_scan_row*)
+          alloc_root(&m_hash_scan->mem_root,
+                     sizeof(Rows_hash_scan_row) + file->ref_length)))
+      goto abandon;
+    prepare_record(table, m_width, FALSE);
+    if (unpack_current_row(rgi) || m_curr_row_end <= m_curr_row)
+      goto abandon;
+    row->row= m_curr_row;
+    row->hash= record_hash(table);
+    row->found= false;
+    if (is_update)
+    {
+      m_curr_row= m_curr_row_end;
+      prepare_record(table, m_width, FALSE);
+      if (unpack_current_row(rgi, &m_cols_ai))
+        goto abandon;
+      row->after_hash= record_hash(table);
+    }
+    if (my_hash_insert(&m_hash_scan->rows, (uchar*) row))
+      goto abandon;
+    *last_row= row;
+    last_row= &row->next;
+    n_rows++;
+  }
+  *last_row= NULL;
+  if (n_rows < 2)
+    goto abandon;
+  if (is_update)
+  {
+    for (row= m_hash_scan->next; row; row= row->next)
+      if (my_hash_search(&m_hash_scan->rows, (uchar*) &row->after_hash,
+                         sizeof(row->after_hash)))
+        goto abandon;
+  }
+
+  /* Look up each row of the table */
+  DBUG_PRINT("info",("locating %u records using hash scan", n_rows));
+  if (unlikely((error= file->ha_rnd_init_with_error(1))))
+    goto end;
+  while (n_found < n_rows)
+  {
+    HASH_SEARCH_STATE state;
+    ulonglong hash;
+
+    if (unlikely((error= file->ha_rnd_next(table->record[0]))))
+    {
+      if (error == HA_ERR_END_OF_FILE)
+        error= 0;
+      else
+        file->print_error(error, MYF(0));
+      break;
+    }
+    hash= record_hash(table);
+    if (!(row= (Rows_hash_scan_row*)
+          my_hash_first(&m_hash_scan->rows, (uchar*) &hash, sizeof(hash),
+                        &state)))
+      continue;
+    /*
+      Compare the row of the table, moved to record[1], with the before
+      images that have the same hash.
+    */
+    file->position(table->record[0]);
+    store_record(table, record[1]);
+    for ( ; row; row= (Rows_hash_scan_row*)
+                   my_hash_next(&m_hash_scan->rows, (uchar*) &hash,
+                                sizeof(hash), &state))
+    {
+      if (row->found)
+        continue;
+      m_curr_row= row->row;
+      prepare_record(table, m_width, FALSE);
+      if (unpack_current_row(rgi))
+        continue;
+      if (!record_compare(table))
+      {
+        memcpy(row->ref, file->ref, file->ref_length);
+        row->found= true;
+        n_found++;
+        break;
+      }
+    }
+  }
+  file->ha_rnd_end();
+  goto end;
+
+abandon:
+  end_hash_scan();
+  m_hash_scan_done= true;
+end:
+  m_curr_row= curr_row;
+  DBUG_RETURN(error);
+}
+
+
+void Rows_log_event::end_hash_scan()
+{
+  if (m_hash_scan)
+  {
+    my_hash_free(&m_hash_scan->rows);
+    free_root(&m_hash_scan->mem_root, MYF(0));
+    my_free(m_hash_scan);
+    m_hash_scan= NULL;
+  }
+  m_hash_scan_done= false;
+}
+
+
 /**
   Locate the current row in event's table.
 
@@ -14200,6 +14503,46 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
     /* We use this to test that the correct key is used in test cases. */
     DBUG_EXECUTE_IF("slave_crash_if_table_scan", abort(););
 
+    /*
+      Locate all rows of the event with one scan on the first row, then
+      take the position found for each row.
+    */
+    if (!m_hash_scan_done)
+    {
+      if (unlikely((error= hash_scan_rows(rgi))))
+        goto end;
+      /* Unpack the current row again */
+      prepare_record(table, m_width, FALSE);
+      if (unlikely((error= unpack_current_row(rgi))))
+        goto end;
+      store_record(table, record[1]);
+    }
+    if (m_hash_scan && m_hash_scan->next &&
+        m_hash_scan->next->row == m_curr_row)
+    {
+      Rows_hash_scan_row *row= m_hash_scan->next;
+      m_hash_scan->next= row->next;
+      if (!row->found)
+      {
+        DBUG_PRINT("info", ("Record not found"));
+        error= HA_ERR_END_OF_FILE;
+        goto end;
+      }
+      if (unlikely((error= table->file->ha_rnd_init_with_error(0))))
+        goto end;
+      if (unlikely((error= table->file->ha_rnd_pos(table->record[0],
+                                                   row->ref))))
+      {
+        table->file->print_error(error, MYF(0));
+        table->file->ha_rnd_end();
+        goto end;
+      }
+      if (!record_compare(table))
+        goto end;
+      /* Should not happen: the row was changed since it was located */
+      table->file->ha_rnd_end();
+    }
+
     /* We don't have a key: search the table using rnd_next() */
     if (unlikely((error= table->file->ha_rnd_init_with_error(1))))
     {
@@ -14337,6 +14680,7 @@ Delete_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key);
   m_key= NULL;
   m_key_info= NULL;
+  end_hash_scan();
 
   return error;
 }
@@ -14557,6 +14901,7 @@ Update_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key); // Free for multi_malloc
   m_key= NULL;
   m_key_info= NULL;
+  end_hash_scan();
 
   return error;
 }
@@ -14956,6 +15301,254 @@ bool Ignorable_log_event::print(FILE *file,
 #endif
 
 
+/**************************************************************************
+  Transaction_payload_log_event methods
+**************************************************************************/
+
+#ifdef MYSQL_SERVER
+/**
+  Compress the events_len bytes of a binlog cache into a compressed record
+  in the format of binlog_buf_compress().
+
+  A cache held in memory is compressed from its buffer and is not changed.
+  A cache that was written to its temporary file is flushed to it, and the
+  file is streamed through deflate. The cache is then left in write mode at
+  its end, with all the events in the file, so that it can still be written
+  to the binlog if the event is not used.
+*/
+Transaction_payload_log_event::Transaction_payload_log_event(
+        THD *thd_arg, IO_CACHE *cache, size_t events_len)
+  :Log_event(thd_arg, 0, true), payload(0), payload_len(0)
+{
+  uint32 len= (uint32) events_len;
+  uint32 alloc_len= binlog_get_compress_len(len);
+  uint32 header_len;
+  size_t length;
+  z_stream strm;
+  int res= Z_OK;
+
+  DBUG_ASSERT(cache->type == WRITE_CACHE);
+  if (!(payload= (char*) my_malloc(alloc_len, MYF(MY_WME))))
+    return;
+
+  if (cache->pos_in_file == 0)
+  {
+    if (binlog_buf_compress((const char*) cache->write_buffer, payload, len,
+                            &alloc_len))
+      goto err;
+    payload_len= alloc_len;
+    return;
+  }
+
+  if (my_b_flush_io_cache(cache, 1))
+    goto err;
+  header_len= BINLOG_COMPRESSED_HEADER_LEN +
+              binlog_store_compress_header(payload, len);
+
+  strm.zalloc= Z_NULL;
+  strm.zfree= Z_NULL;
+  strm.opaque= Z_NULL;
+  if (deflateInit(&strm, Z_DEFAULT_COMPRESSION) != Z_OK)
+    goto err;
+  strm.next_out= (Bytef*) payload + header_len;
+  strm.avail_out= alloc_len - header_len - 1;
+
+  if (reinit_io_cache(cache, READ_CACHE, 0, 0, 0))
+  {
+    deflateEnd(&strm);
+    goto err;
+  }
+  /* Nothing is in the buffer until the first read from the file */
+  length= my_b_bytes_in_cache(cache);
+  do
+  {
+    if (length)
+    {
+      strm.next_in= (Bytef*) cache->read_pos;
+      strm.avail_in= (uInt) length;
+      res= deflate(&strm, Z_NO_FLUSH);
+    }
+  } while (res == Z_OK && (length= my_b_fill(cache)));
+  if (res == Z_OK && !cache->error && strm.total_in == len)
+    res= deflate(&strm, Z_FINISH);
+  payload_len= header_len + (uint32) strm.total_out;
+  deflateEnd(&strm);
+  /* All events are in the file, so the buffer is not kept (clear_cache) */
+  if (reinit_io_cache(cache, WRITE_CACHE, events_len, 0, 1) ||
+      res != Z_STREAM_END)
+    goto err;
+  return;
+
+err:
+  my_free(payload);
+  payload= 0;
+  payload_len= 0;
+}
+
+
+#ifdef HAVE_REPLICATION
+void Transaction_payload_log_event::pack_info(Protocol *protocol)
+{
+  char buf[64];
+  size_t bytes;
+  bytes= my_snprintf(buf, sizeof(buf), "Compressed events of %u bytes",
+                     binlog_get_uncompress_len(payload));
+  protocol->store(buf, bytes, &my_charset_bin);
+}
+
+
+int Transaction_payload_log_event::do_apply_event(rpl_group_info *rgi)
+{
+  /* The slave IO thread writes the events of the payload to the relay log */
+  rgi->rli->report(ERROR_LEVEL, ER_SLAVE_FATAL_ERROR,
+                   ER_THD(thd, ER_SLAVE_FATAL_ERROR),
+                   "Transaction_payload event found in the relay log");
+  return 1;
+}
+#endif
+
+
+bool Transaction_payload_log_event::write()
+{
+  return write_header(TRANSACTION_PAYLOAD_HEADER_LEN + payload_len) ||
+         write_data(payload, payload_len) ||
+         write_footer();
+}
+#endif  /* MYSQL_SERVER */
+
+
+#ifdef MYSQL_CLIENT
+bool Transaction_payload_log_event::print(FILE *file,
+                                          PRINT_EVENT_INFO *print_event_info)
+{
+  if (print_event_info->short_form)
+    return 0;
+
+  Write_on_release_cache cache(&print_event_info->head_cache, file,
+                               Write_on_release_cache::FLUSH_F);
+
+  if (print_header(&cache, print_event_info, FALSE) ||
+      my_b_printf(&cache, "\tTransaction_payload\n"
+                  "# Compressed events of %u bytes\n",
+                  binlog_get_uncompress_len(payload)))
+    return 1;
+  return cache.flush_data();
+}
+#endif  /* MYSQL_CLIENT */
+
+
+Transaction_payload_log_event::Transaction_payload_log_event(
+       const char *buf, uint event_len,
+       const Format_description_log_event *description_event)
+  :Log_event(buf, description_event), payload(0), payload_len(0)
+{
+  uint header_size= description_event->common_header_len +
+                    TRANSACTION_PAYLOAD_HEADER_LEN;
+  /* At least the header byte and one byte of original length */
+  if (event_len < header_size + 2 || (buf[header_size] & 0x80) == 0)
+    return;
+  payload_len= event_len - header_size;
+  payload= (char*) my_memdup(buf + header_size, payload_len, MYF(MY_WME));
+}
+
+
+/**************************************************************************
+  Writeset_log_event methods
+**************************************************************************/
+
+#ifdef MYSQL_SERVER
+Writeset_log_event::Writeset_log_event(THD *thd_arg, const rpl_gtid *gtid,
+                                       const uint64 *keys_arg, uint count_arg)
+  :Log_event(thd_arg, LOG_EVENT_IGNORABLE_F, true), seq_no(gtid->seq_no),
+   domain_id(gtid->domain_id), count((uint16) count_arg), keys(keys_arg),
+   keys_buf(0)
+{
+  cache_type= Log_event::EVENT_NO_CACHE;
+}
+
+
+#ifdef HAVE_REPLICATION
+void Writeset_log_event::pack_info(Protocol *protocol)
+{
+  char buf[64];
+  size_t bytes;
+  bytes= my_snprintf(buf, sizeof(buf), "%u keys of GTID %u-%u-%llu",
+                     (uint) count, domain_id, server_id, seq_no);
+  protocol->store(buf, bytes, &my_charset_bin);
+}
+#endif
+
+
+bool Writeset_log_event::write()
+{
+  uchar buf[14];
+
+  int8store(buf, seq_no);
+  int4store(buf + 8, domain_id);
+  int2store(buf + 12, count);
+  if (write_header(get_data_size()) ||
+      write_data(buf, sizeof(buf)))
+    return true;
+  for (uint i= 0; i < count; )
+  {
+    uchar data[8 * 64];
+    uint n= 0;
+    for (; n < 64 && i < count; n++, i++)
+      int8store(data + 8 * n, keys[i]);
+    if (write_data(data, 8 * n))
+      return true;
+  }
+  return write_footer();
+}
+#endif  /* MYSQL_SERVER */
+
+
+#ifdef MYSQL_CLIENT
+bool Writeset_log_event::print(FILE *file, PRINT_EVENT_INFO *print_event_info)
+{
+  if (print_event_info->short_form)
+    return 0;
+
+  Write_on_release_cache cache(&print_event_info->head_cache, file,
+                               Write_on_release_cache::FLUSH_F);
+  char buf[21];
+
+  longlong10_to_str(seq_no, buf, 10);
+  if (print_header(&cache, print_event_info, FALSE) ||
+      my_b_printf(&cache, "\tWriteset\n# %u keys of GTID %u-%u-%s\n",
+                  (uint) count, domain_id, server_id, buf))
+    return 1;
+  return cache.flush_data();
+}
+#endif  /* MYSQL_CLIENT */
+
+
+Writeset_log_event::Writeset_log_event(
+       const char *buf, uint event_len,
+       const Format_description_log_event *description_event)
+  :Log_event(buf, description_event), seq_no(0), domain_id(0), count(0),
+   keys(0), keys_buf(0)
+{
+  uint header_size= description_event->common_header_len +
+                    WRITESET_HEADER_LEN;
+  uint n;
+
+  if (event_len < header_size + 14)
+    return;
+  buf+= header_size;
+  n= uint2korr(buf + 12);
+  if (event_len < header_size + 14 + 8 * n ||
+      !(keys_buf= (uint64*) my_malloc(8 * n + 1, MYF(MY_WME))))
+    return;
+  for (uint i= 0; i < n; i++)
+    keys_buf[i]= uint8korr(buf + 14 + 8 * i);
+  keys= keys_buf;
+  count= (uint16) n;
+  domain_id= uint4korr(buf + 8);
+  seq_no= uint8korr(buf);
+}
+
+
 #ifdef MYSQL_CLIENT
 /**
   The default values for these variables should be values that are
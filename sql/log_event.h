@@ -213,6 +213,8 @@ class String;
 #define IGNORABLE_HEADER_LEN   0
 #define ROWS_HEADER_LEN_V2    10
 #define ANNOTATE_ROWS_HEADER_LEN  0
+#define TRANSACTION_PAYLOAD_HEADER_LEN 0
+#define WRITESET_HEADER_LEN 0
 #define BINLOG_CHECKPOINT_HEADER_LEN 4
 #define GTID_HEADER_LEN       19
 #define GTID_LIST_HEADER_LEN   4
@@ -565,9 +567,13 @@ class String;
 #define MARIA_SLAVE_CAPABILITY_BINLOG_CHECKPOINT 3
 /* MariaDB >= 10.0.1, which knows about global transaction id events. */
 #define MARIA_SLAVE_CAPABILITY_GTID 4
+/* MariaDB >= 10.4, which knows about transaction_payload_log_event. */
+#define MARIA_SLAVE_CAPABILITY_TRANSACTION_PAYLOAD 5
+/* MariaDB >= 10.4, which knows about writeset_log_event. */
+#define MARIA_SLAVE_CAPABILITY_WRITESET 6
 
 /* Our capability. */
-#define MARIA_SLAVE_CAPABILITY_MINE MARIA_SLAVE_CAPABILITY_GTID
+#define MARIA_SLAVE_CAPABILITY_MINE MARIA_SLAVE_CAPABILITY_WRITESET
 
 
 /**
@@ -711,6 +717,17 @@ enum Log_event_type
   UPDATE_ROWS_COMPRESSED_EVENT = 170,
   DELETE_ROWS_COMPRESSED_EVENT = 171,
 
+  /*
+    The events of a transaction, compressed together into one event.
+  */
+  TRANSACTION_PAYLOAD_EVENT= 172,
+
+  /*
+    The writeset of the event group whose GTID event follows, for the
+    parallel slave. Logged with LOG_EVENT_IGNORABLE_F.
+  */
+  WRITESET_EVENT= 173,
+
   /* Add new MariaDB events here - right above this comment!  */
 
   ENUM_END_EVENT /* end marker */
@@ -783,8 +800,14 @@ static inline bool LOG_EVENT_IS_ROW_V2(enum Log_event_type type)
    The number of types we handle in Format_description_log_event (UNKNOWN_EVENT
    is not to be handled, it does not exist in binlogs, it does not have a
    format).
+
+   TRANSACTION_PAYLOAD_EVENT and WRITESET_EVENT are left out, so that the
+   format description event keeps its size. They have no post-header, and
+   are never sent to a slave that does not know them (see
+   MARIA_SLAVE_CAPABILITY_TRANSACTION_PAYLOAD and
+   MARIA_SLAVE_CAPABILITY_WRITESET).
 */
-#define LOG_EVENT_TYPES (ENUM_END_EVENT-1)
+#define LOG_EVENT_TYPES (TRANSACTION_PAYLOAD_EVENT-1)
 
 enum Int_event_type
 {
@@ -801,6 +824,7 @@ class THD;
 class Format_description_log_event;
 class Relay_log_info;
 class binlog_cache_data;
+struct Rows_hash_scan;
 
 bool copy_event_cache_to_file_and_reinit(IO_CACHE *cache, FILE *file);
 
@@ -1526,6 +1550,7 @@ class Log_event
     case USER_VAR_EVENT:
     case TABLE_MAP_EVENT:
     case ANNOTATE_ROWS_EVENT:
+    case TRANSACTION_PAYLOAD_EVENT:
       return true;
     case DELETE_ROWS_EVENT:
     case UPDATE_ROWS_EVENT:
@@ -1558,6 +1583,7 @@ class Log_event
     case BINLOG_CHECKPOINT_EVENT:
     case GTID_LIST_EVENT:
     case START_ENCRYPTION_EVENT:
+    case WRITESET_EVENT:
       return false;
 
     default:
@@ -3356,6 +3382,7 @@ class Binlog_checkpoint_log_event: public Log_event
         @@SESSION.replicate_allow_parallel value was true at commit).</td>
     <td>Bit 4 set indicates that this transaction encountered a row (or other)
         lock wait during execution.</td>
+    <td>Bit 5 set indicates that the event group contains DDL.</td>
   </tr>
 
   <tr>
@@ -4652,9 +4679,14 @@ class Rows_log_event : public Log_event
   KEY      *m_key_info; /* Pointer to KEY info for m_key_nr */
   uint      m_key_nr;   /* Key number */
   bool master_had_triggers;     /* set after tables opening */
+  /* Positions of the rows found with one table scan, see find_row() */
+  Rows_hash_scan *m_hash_scan;
+  bool m_hash_scan_done;
 
   int find_key(); // Find a best key to use in find_row()
   int find_row(rpl_group_info *);
+  int hash_scan_rows(rpl_group_info *);
+  void end_hash_scan();
   int write_row(rpl_group_info *, const bool);
   int update_sequence();
 
@@ -5172,6 +5204,151 @@ class Ignorable_log_event : public Log_event {
   virtual int get_data_size() { return IGNORABLE_HEADER_LEN; }
 };
 
+
+/**
+  @class Transaction_payload_log_event
+
+  The events of one transaction, compressed together into one event when
+  @@log_bin_compress_transactions is set.
+
+  @section Transaction_payload_log_event_binary_format Binary Format
+
+  The event has no post-header. The body is the compressed record (see
+  binlog_buf_compress()) of the events of the binlog cache, as they are
+  held there: without checksums, and with end_log_pos relative to the
+  start of the transaction. The GTID event that starts the transaction and
+  the XID or COMMIT event that ends it are not compressed.
+
+  The slave IO thread writes the events of the payload to the relay log
+  (see transaction_payload_uncompress()), so the event itself is never
+  applied.
+*/
+class Transaction_payload_log_event: public Log_event
+{
+public:
+  char *payload;
+  uint32 payload_len;
+
+#ifdef MYSQL_SERVER
+  Transaction_payload_log_event(THD *thd_arg, IO_CACHE *cache,
+                                size_t events_len);
+#ifdef HAVE_REPLICATION
+  void pack_info(Protocol *protocol);
+#endif
+#else
+  bool print(FILE *file, PRINT_EVENT_INFO *print_event_info);
+#endif
+  Transaction_payload_log_event(const char *buf, uint event_len,
+             const Format_description_log_event *description_event);
+  ~Transaction_payload_log_event() { my_free(payload); }
+  Log_event_type get_type_code() { return TRANSACTION_PAYLOAD_EVENT; }
+  int get_data_size() { return TRANSACTION_PAYLOAD_HEADER_LEN + payload_len; }
+  bool is_valid() const { return payload != 0; }
+  bool is_part_of_group() { return 1; }
+#ifdef MYSQL_SERVER
+  bool write();
+#endif
+
+private:
+#if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
+  virtual int do_apply_event(rpl_group_info *rgi);
+#endif
+};
+
+/**
+  @class Writeset_log_event
+
+  The writeset of an event group: hashes of the unique keys of the rows
+  it changes, logged when @@binlog_writeset_max_keys is set. A parallel
+  slave in conservative mode runs event groups with disjoint writesets in
+  parallel even if they did not group commit on the master.
+
+  The event is written just before the GTID event of the event group, so
+  that the slave knows the writeset when it schedules the event group,
+  and it is not part of the event group. It has LOG_EVENT_IGNORABLE_F set,
+  and is not sent to slaves without MARIA_SLAVE_CAPABILITY_WRITESET.
+
+  @section Writeset_log_event_binary_format Binary Format
+
+  The event has no post-header. The body is:
+
+  <table>
+  <caption>Body for Writeset_log_event</caption>
+
+  <tr>
+    <th>Name</th>
+    <th>Format</th>
+    <th>Description</th>
+  </tr>
+
+  <tr>
+    <td>seq_no</td>
+    <td>8 byte unsigned integer</td>
+    <td>Sequence number of the GTID of the event group. The server id is
+        the one of the event.</td>
+  </tr>
+
+  <tr>
+    <td>domain_id</td>
+    <td>4 byte unsigned integer</td>
+    <td>Replication domain id of the GTID of the event group.</td>
+  </tr>
+
+  <tr>
+    <td>count</td>
+    <td>2 byte unsigned integer</td>
+    <td>Number of the key hashes.</td>
+  </tr>
+
+  <tr>
+    <td>keys</td>
+    <td>count 8 byte unsigned integers</td>
+    <td>Hashes of the unique keys of the changed rows.</td>
+  </tr>
+  </table>
+*/
+class Writeset_log_event: public Log_event
+{
+public:
+  uint64 seq_no;
+  uint32 domain_id;
+  uint16 count;
+  const uint64 *keys;
+
+#ifdef MYSQL_SERVER
+  Writeset_log_event(THD *thd_arg, const rpl_gtid *gtid,
+                     const uint64 *keys_arg, uint count_arg);
+#ifdef HAVE_REPLICATION
+  void pack_info(Protocol *protocol);
+#endif
+#else
+  bool print(FILE *file, PRINT_EVENT_INFO *print_event_info);
+#endif
+  Writeset_log_event(const char *buf, uint event_len,
+                     const Format_description_log_event *description_event);
+  ~Writeset_log_event() { my_free(keys_buf); }
+  Log_event_type get_type_code() { return WRITESET_EVENT; }
+  enum_logged_status logged_status() { return LOGGED_NO_DATA; }
+  int get_data_size() { return WRITESET_HEADER_LEN + 14 + 8 * count; }
+  bool is_valid() const { return seq_no != 0; }
+#ifdef MYSQL_SERVER
+  bool write();
+  /* Hand over the keys read from the event to the caller */
+  uint64 *release_keys()
+  {
+    uint64 *res= keys_buf;
+    keys_buf= 0;
+    keys= 0;
+    count= 0;
+    return res;
+  }
+#endif
+
+private:
+  /* The keys read from the event, owned by the event */
+  uint64 *keys_buf;
+};
+
 #ifdef MYSQL_CLIENT
 bool copy_cache_to_string_wrapped(IO_CACHE *body,
                                   LEX_STRING *to,
@@ -5261,5 +5438,10 @@ int row_log_event_uncompress(const Format_description_log_event *description_eve
                              const char *src, ulong src_len, char* buf, ulong buf_size, bool* is_malloc,
                              char **dst, ulong *newlen);
 
+int transaction_payload_uncompress(const Format_description_log_event *description_event,
+                                   bool contain_checksum, const char *src, ulong src_len,
+                                   char* buf, ulong buf_size, bool* is_malloc,
+                                   char **dst, ulong *newlen);
+
 
 #endif /* _log_event_h */
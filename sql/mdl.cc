@@ -26,10 +26,12 @@
 #include <mysql/psi/mysql_stage.h>
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_MDL_wait_LOCK_wait_status;
+static PSI_mutex_key key_MDL_lock_fast_path_mutex;
 
 static PSI_mutex_info all_mdl_mutexes[]=
 {
-  { &key_MDL_wait_LOCK_wait_status, "MDL_wait::LOCK_wait_status", 0}
+  { &key_MDL_wait_LOCK_wait_status, "MDL_wait::LOCK_wait_status", 0},
+  { &key_MDL_lock_fast_path_mutex, "MDL_lock::fast_path_mutex", 0}
 };
 
 static PSI_rwlock_key key_MDL_lock_rwlock;
@@ -153,9 +155,11 @@ class MDL_map
 public:
   void init();
   void destroy();
-  MDL_lock *find_or_insert(LF_PINS *pins, const MDL_key *key);
+  MDL_lock *find_or_insert(LF_PINS *pins, const MDL_key *key,
+                           MDL_ticket *fast_path_ticket, bool *fast_path);
   unsigned long get_lock_owner(LF_PINS *pins, const MDL_key *key);
   void remove(LF_PINS *pins, MDL_lock *lock);
+  void remove_if_unused(LF_PINS *pins, const MDL_key *key);
   LF_PINS *get_pins() { return lf_hash_get_pins(&m_locks); }
 private:
   LF_HASH m_locks; /**< All acquired locks in the server. */
@@ -317,8 +321,35 @@ Deadlock_detection_visitor::opt_change_victim_to(MDL_context *new_victim)
   This is an abstract class which lacks information about
   compatibility rules for lock types. They should be specified
   in its descendants.
+
+  Fast path
+  ---------
+  Lock types which are compatible with each other both when granted and
+  when waiting, and which are taken by most statements (SR and SW on
+  tables, IX on schemas, DML and COMMIT backup locks), are "unobtrusive".
+  All other types are "obtrusive".
+
+  As long as there are no tickets of obtrusive types for the lock, an
+  unobtrusive ticket is granted without m_rwlock: it is added to one of
+  the m_fast_path shards, chosen by the context, so that connections
+  using the same hot table do not contend on the same mutex and cache
+  line.
+
+  The shards take about 2KB, so they are allocated only for hot locks:
+  once MDL_FAST_PATH_MIN_TICKETS tickets are granted at the same time
+  through m_rwlock. They are kept until the object is freed, also when
+  it is reused for another key by the lock-free hash.
+
+  An obtrusive request increments m_obtrusive_locks, which stops the fast
+  path, and moves all fast path tickets to the granted queue. From then on
+  and until the last obtrusive ticket is gone, the lock works as if
+  there was no fast path, so that can_grant_lock(), the deadlock detector
+  and notify_conflicting_locks() see all granted tickets.
 */
 
+#define MDL_FAST_PATH_SHARDS 16
+#define MDL_FAST_PATH_MIN_TICKETS 4
+
 class MDL_lock
 {
 public:
@@ -331,7 +362,7 @@ class MDL_lock
                      I_P_List_adapter<MDL_ticket,
                                       &MDL_ticket::next_in_lock,
                                       &MDL_ticket::prev_in_lock>,
-                     I_P_List_null_counter,
+                     I_P_List_counter,
                      I_P_List_fast_push_back<MDL_ticket> >
             List;
     operator const List &() const { return m_list; }
@@ -340,6 +371,7 @@ class MDL_lock
     void add_ticket(MDL_ticket *ticket);
     void remove_ticket(MDL_ticket *ticket);
     bool is_empty() const { return m_list.is_empty(); }
+    uint elements() const { return m_list.elements(); }
     bitmap_t bitmap() const { return m_bitmap; }
   private:
     void clear_bit_if_not_in_list(enum_mdl_type type);
@@ -367,6 +399,7 @@ class MDL_lock
     virtual bool needs_notification(const MDL_ticket *ticket) const = 0;
     virtual bool conflicting_locks(const MDL_ticket *ticket) const = 0;
     virtual bitmap_t hog_lock_types_bitmap() const = 0;
+    virtual bitmap_t unobtrusive_lock_types_bitmap() const = 0;
     virtual ~MDL_lock_strategy() {}
   };
 
@@ -403,6 +436,9 @@ class MDL_lock
     */
     virtual bitmap_t hog_lock_types_bitmap() const
     { return 0; }
+
+    virtual bitmap_t unobtrusive_lock_types_bitmap() const
+    { return MDL_BIT(MDL_INTENTION_EXCLUSIVE); }
   private:
     static const bitmap_t m_granted_incompatible[MDL_TYPE_END];
     static const bitmap_t m_waiting_incompatible[MDL_TYPE_END];
@@ -451,6 +487,12 @@ class MDL_lock
               MDL_BIT(MDL_EXCLUSIVE));
     }
 
+    virtual bitmap_t unobtrusive_lock_types_bitmap() const
+    {
+      return (MDL_BIT(MDL_SHARED) | MDL_BIT(MDL_SHARED_HIGH_PRIO) |
+              MDL_BIT(MDL_SHARED_READ) | MDL_BIT(MDL_SHARED_WRITE));
+    }
+
   private:
     static const bitmap_t m_granted_incompatible[MDL_TYPE_END];
     static const bitmap_t m_waiting_incompatible[MDL_TYPE_END];
@@ -488,6 +530,13 @@ class MDL_lock
     */
     virtual bitmap_t hog_lock_types_bitmap() const
     { return 0; }
+
+    virtual bitmap_t unobtrusive_lock_types_bitmap() const
+    {
+      return (MDL_BIT(MDL_BACKUP_DML) | MDL_BIT(MDL_BACKUP_TRANS_DML) |
+              MDL_BIT(MDL_BACKUP_SYS_DML) | MDL_BIT(MDL_BACKUP_ALTER_COPY) |
+              MDL_BIT(MDL_BACKUP_COMMIT));
+    }
   private:
     static const bitmap_t m_granted_incompatible[MDL_BACKUP_END];
     static const bitmap_t m_waiting_incompatible[MDL_BACKUP_END];
@@ -594,16 +643,76 @@ class MDL_lock
   */
   ulong m_hog_lock_count;
 
+  /** Tickets granted through the fast path to the contexts of a shard. */
+  struct Fast_path_shard
+  {
+    mysql_mutex_t mutex;
+    Ticket_list::List tickets;
+    /** Number of the tickets, may be read without the mutex. */
+    Atomic_counter<uint32> count;
+    /** Avoid false sharing between the shards. */
+    char pad[CPU_LEVEL1_DCACHE_LINESIZE];
+  };
+  /**
+    Array of MDL_FAST_PATH_SHARDS shards, NULL until the lock is hot.
+    Set once under m_rwlock, freed by the destructor.
+  */
+  std::atomic<Fast_path_shard*> m_fast_path;
+
+  Fast_path_shard *get_fast_path() const
+  { return m_fast_path.load(std::memory_order_acquire); }
+
+  /**
+    Number of tickets of obtrusive types which are granted, waiting or
+    being acquired. The fast path is not used when it is not 0.
+    Changed under m_rwlock, read under the fast path mutexes.
+  */
+  Atomic_counter<uint32> m_obtrusive_locks;
+
+  bool is_obtrusive(enum_mdl_type type) const
+  { return !(m_strategy->unobtrusive_lock_types_bitmap() & MDL_BIT(type)); }
+
+  /**
+    Take into account a ticket of the type added to the lock.
+    @pre m_rwlock is write-locked.
+  */
+  void add_obtrusive(enum_mdl_type type)
+  {
+    if (is_obtrusive(type) && !m_obtrusive_locks++)
+      materialize_fast_path_locks();
+  }
+
+  /**
+    Take into account a ticket of the type removed from the lock.
+    @pre m_rwlock is write-locked.
+  */
+  void remove_obtrusive(enum_mdl_type type)
+  {
+    if (is_obtrusive(type))
+      m_obtrusive_locks--;
+  }
+
+  void enable_fast_path_if_hot();
+  bool fast_path_add_ticket(MDL_ticket *ticket);
+  bool fast_path_remove_ticket(LF_PINS *pins, MDL_ticket *ticket);
+  void materialize_fast_path_locks();
+  void materialize_fast_path_ticket(MDL_ticket *ticket);
+  bool retire();
+
 public:
 
   MDL_lock()
     : m_hog_lock_count(0),
+      m_fast_path(NULL),
+      m_obtrusive_locks(0),
       m_strategy(0)
   { mysql_prlock_init(key_MDL_lock_rwlock, &m_rwlock); }
 
   MDL_lock(const MDL_key *key_arg)
   : key(key_arg),
     m_hog_lock_count(0),
+    m_fast_path(NULL),
+    m_obtrusive_locks(0),
     m_strategy(&m_backup_lock_strategy)
   {
     DBUG_ASSERT(key_arg->mdl_namespace() == MDL_key::BACKUP);
@@ -611,7 +720,15 @@ class MDL_lock
   }
 
   ~MDL_lock()
-  { mysql_prlock_destroy(&m_rwlock); }
+  {
+    if (Fast_path_shard *shards= get_fast_path())
+    {
+      for (uint i= 0; i < MDL_FAST_PATH_SHARDS; i++)
+        mysql_mutex_destroy(&shards[i].mutex);
+      my_free(shards);
+    }
+    mysql_prlock_destroy(&m_rwlock);
+  }
 
   static void lf_alloc_constructor(uchar *arg)
   { new (arg + LF_HASH_OVERHEAD) MDL_lock(); }
@@ -624,10 +741,26 @@ class MDL_lock
   {
     DBUG_ASSERT(key_arg->mdl_namespace() != MDL_key::BACKUP);
     new (&lock->key) MDL_key(key_arg);
-    if (key_arg->mdl_namespace() == MDL_key::SCHEMA)
-      lock->m_strategy= &m_scoped_lock_strategy;
-    else
-      lock->m_strategy= &m_object_lock_strategy;
+    lock->m_strategy= get_strategy(key_arg);
+  }
+
+  static const MDL_lock_strategy *get_strategy(const MDL_key *key_arg)
+  {
+    switch (key_arg->mdl_namespace()) {
+    case MDL_key::BACKUP:
+      return &m_backup_lock_strategy;
+    case MDL_key::SCHEMA:
+      return &m_scoped_lock_strategy;
+    default:
+      return &m_object_lock_strategy;
+    }
+  }
+
+  /** Check if a lock of the type may be granted through the fast path. */
+  static bool is_unobtrusive(const MDL_key *key_arg, enum_mdl_type type)
+  {
+    return (get_strategy(key_arg)->unobtrusive_lock_types_bitmap() &
+            MDL_BIT(type));
   }
 
   const MDL_lock_strategy *m_strategy;
@@ -720,6 +853,16 @@ static my_bool mdl_iterate_lock(MDL_lock *lock, mdl_iterate_arg *arg)
   MDL_ticket *ticket;
   while ((ticket= granted_it++) && !(res= arg->callback(ticket, arg->argument, true)))
     /* no-op */;
+  MDL_lock::Fast_path_shard *shards= lock->get_fast_path();
+  for (uint i= 0; !res && shards && i < MDL_FAST_PATH_SHARDS; i++)
+  {
+    MDL_lock::Fast_path_shard *shard= &shards[i];
+    mysql_mutex_lock(&shard->mutex);
+    MDL_lock::Ticket_iterator fast_path_it(shard->tickets);
+    while ((ticket= fast_path_it++) && !(res= arg->callback(ticket, arg->argument, true)))
+      /* no-op */;
+    mysql_mutex_unlock(&shard->mutex);
+  }
   while ((ticket= waiting_it++) && !(res= arg->callback(ticket, arg->argument, false)))
     /* no-op */;
   mysql_prlock_unlock(&lock->m_rwlock);
@@ -788,15 +931,25 @@ void MDL_map::destroy()
   Find MDL_lock object corresponding to the key, create it
   if it does not exist.
 
+  @param pins              LF_HASH pins of the context
+  @param mdl_key           Key of the lock
+  @param fast_path_ticket  If not NULL, a ticket of an unobtrusive type
+                           to grant through the fast path if possible
+  @param[out] fast_path    Set to TRUE if fast_path_ticket was granted.
+                           MDL_lock::m_rwlock is not locked in this case.
+
   @retval non-NULL - Success. MDL_lock instance for the key with
-                     locked MDL_lock::m_rwlock.
+                     locked MDL_lock::m_rwlock (unless *fast_path).
   @retval NULL     - Failure (OOM).
 */
 
-MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key)
+MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key,
+                                  MDL_ticket *fast_path_ticket,
+                                  bool *fast_path)
 {
   MDL_lock *lock;
 
+  *fast_path= false;
   if (mdl_key->mdl_namespace() == MDL_key::BACKUP)
   {
     /*
@@ -807,6 +960,11 @@ MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key)
       for them look like '<namespace-id>\0\0'.
     */
     DBUG_ASSERT(mdl_key->length() == 3);
+    if (fast_path_ticket && m_backup_lock->fast_path_add_ticket(fast_path_ticket))
+    {
+      *fast_path= true;
+      return m_backup_lock;
+    }
     mysql_prlock_wrlock(&m_backup_lock->m_rwlock);
     return m_backup_lock;
   }
@@ -817,6 +975,14 @@ MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key)
     if (lf_hash_insert(&m_locks, pins, (uchar*) mdl_key) == -1)
       return NULL;
 
+  if (fast_path_ticket && lock->fast_path_add_ticket(fast_path_ticket))
+  {
+    /* The ticket keeps the lock in the hash, see MDL_lock::retire(). */
+    lf_hash_search_unpin(pins);
+    *fast_path= true;
+    return lock;
+  }
+
   mysql_prlock_wrlock(&lock->m_rwlock);
   if (unlikely(!lock->m_strategy))
   {
@@ -880,12 +1046,45 @@ void MDL_map::remove(LF_PINS *pins, MDL_lock *lock)
     return;
   }
 
-  lock->m_strategy= 0;
+  if (!lock->retire())
+  {
+    /* There are tickets granted through the fast path. */
+    mysql_prlock_unlock(&lock->m_rwlock);
+    return;
+  }
   mysql_prlock_unlock(&lock->m_rwlock);
   lf_hash_delete(&m_locks, pins, lock->key.ptr(), lock->key.length());
 }
 
 
+/**
+  Destroy MDL_lock object for the key if it has no tickets.
+
+  Used after the last ticket granted through the fast path is released,
+  as the lock object may be destroyed by another thread as soon as the
+  ticket is removed.
+*/
+
+void MDL_map::remove_if_unused(LF_PINS *pins, const MDL_key *mdl_key)
+{
+  MDL_lock *lock= (MDL_lock*) lf_hash_search(&m_locks, pins, mdl_key->ptr(),
+                                             mdl_key->length());
+  if (!lock)
+    return;
+
+  mysql_prlock_wrlock(&lock->m_rwlock);
+  lf_hash_search_unpin(pins);
+  if (lock->m_strategy && lock->is_empty())
+    remove(pins, lock);
+  else
+    mysql_prlock_unlock(&lock->m_rwlock);
+}
+
+
+/** Number of created contexts, used to spread them over the fast path shards */
+static Atomic_counter<uint32> mdl_context_count(0);
+
+
 /**
   Initialize a metadata locking context.
 
@@ -897,7 +1096,8 @@ MDL_context::MDL_context()
   m_owner(NULL),
   m_needs_thr_lock_abort(FALSE),
   m_waiting_for(NULL),
-  m_pins(NULL)
+  m_pins(NULL),
+  m_fast_path_shard(mdl_context_count++ % MDL_FAST_PATH_SHARDS)
 {
   mysql_prlock_init(key_MDL_context_LOCK_waiting_for, &m_LOCK_waiting_for);
 }
@@ -1725,9 +1925,9 @@ MDL_lock::can_grant_lock(enum_mdl_type type_arg,
     We should get rid of this code and forbid FTWRL/BACKUP statements
     when wsrep is active.
   */
-  if ((wsrep_thd_is_toi(requestor_ctx->get_thd()) ||
-       wsrep_thd_is_applying(requestor_ctx->get_thd())) &&
-      key.mdl_namespace() == MDL_key::BACKUP)
+  if (key.mdl_namespace() == MDL_key::BACKUP &&
+      (wsrep_thd_is_toi(requestor_ctx->get_thd()) ||
+       wsrep_thd_is_applying(requestor_ctx->get_thd())))
   {
     bool waiting_incompatible= m_waiting.bitmap() & waiting_incompat_map;
     bool granted_incompatible= m_granted.bitmap() & granted_incompat_map;
@@ -1809,6 +2009,7 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
 {
   mysql_prlock_wrlock(&m_rwlock);
   (this->*list).remove_ticket(ticket);
+  remove_obtrusive(ticket->get_type());
   if (is_empty())
     mdl_locks.remove(pins, this);
   else
@@ -1833,6 +2034,236 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
 }
 
 
+/**
+  Grant a lock of an unobtrusive type through the fast path.
+
+  @pre The ticket is of an unobtrusive type.
+
+  @retval TRUE   The ticket is granted
+  @retval FALSE  There are obtrusive tickets or the lock object is
+                 being destroyed, the lock must be acquired under
+                 m_rwlock
+*/
+
+bool MDL_lock::fast_path_add_ticket(MDL_ticket *ticket)
+{
+  Fast_path_shard *shards= get_fast_path();
+  Fast_path_shard *shard;
+  bool granted= false;
+
+  if (!shards)
+    return false;
+  shard= &shards[ticket->get_ctx()->get_fast_path_shard()];
+  mysql_mutex_lock(&shard->mutex);
+  /*
+    An obtrusive request increments m_obtrusive_locks before it locks the
+    shards to move their tickets, and retire() resets m_strategy with all
+    shards locked, so the checks below are reliable under the mutex.
+  */
+  if (m_strategy && !m_obtrusive_locks)
+  {
+    ticket->m_lock= this;
+    ticket->m_is_fast_path= true;
+    shard->tickets.push_front(ticket);
+    shard->count++;
+    granted= true;
+  }
+  mysql_mutex_unlock(&shard->mutex);
+  return granted;
+}
+
+
+/**
+  Release a ticket granted through the fast path.
+
+  @retval TRUE   The ticket is released
+  @retval FALSE  The ticket was moved to the granted queue, it must be
+                 released with remove_ticket()
+*/
+
+bool MDL_lock::fast_path_remove_ticket(LF_PINS *pins, MDL_ticket *ticket)
+{
+  Fast_path_shard *shards= get_fast_path();
+  Fast_path_shard *shard;
+  MDL_key unused_key;
+  bool unused= false;
+
+  if (!shards)
+    return FALSE;
+  shard= &shards[ticket->get_ctx()->get_fast_path_shard()];
+  mysql_mutex_lock(&shard->mutex);
+  if (!ticket->m_is_fast_path)
+  {
+    mysql_mutex_unlock(&shard->mutex);
+    return FALSE;
+  }
+  shard->tickets.remove(ticket);
+  ticket->m_is_fast_path= false;
+
+  if (!--shard->count && key.mdl_namespace() != MDL_key::BACKUP)
+  {
+    /*
+      This was the last ticket of the shard, check if it was the last
+      ticket of the lock. The fence guarantees that of two contexts
+      releasing the last tickets of two shards at the same time at least
+      one sees that the other shard is empty.
+      The lock object can't be destroyed while we hold the mutex.
+    */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    unused= true;
+    for (uint i= 0; i < MDL_FAST_PATH_SHARDS; i++)
+    {
+      if (shards[i].count)
+      {
+        unused= false;
+        break;
+      }
+    }
+    if (unused)
+      unused_key.mdl_key_init(&key);
+  }
+  mysql_mutex_unlock(&shard->mutex);
+
+  /*
+    The lock object may be destroyed and reused as soon as the mutex is
+    released, so it is looked up again by the key.
+  */
+  if (unused)
+    mdl_locks.remove_if_unused(pins, &unused_key);
+  return TRUE;
+}
+
+
+/**
+  Move the tickets granted through the fast path to the granted queue,
+  where they are seen by can_grant_lock(), the deadlock detector and
+  notify_conflicting_locks().
+
+  @pre m_rwlock is write-locked and m_obtrusive_locks is not 0, so no
+       new tickets are added to the fast path.
+*/
+
+void MDL_lock::materialize_fast_path_locks()
+{
+  Fast_path_shard *shards= get_fast_path();
+
+  DBUG_ASSERT(m_obtrusive_locks);
+
+  for (uint i= 0; shards && i < MDL_FAST_PATH_SHARDS; i++)
+  {
+    Fast_path_shard *shard= &shards[i];
+    MDL_ticket *ticket;
+
+    mysql_mutex_lock(&shard->mutex);
+    while ((ticket= shard->tickets.pop_front()))
+    {
+      ticket->m_is_fast_path= false;
+      m_granted.add_ticket(ticket);
+    }
+    shard->count= 0;
+    mysql_mutex_unlock(&shard->mutex);
+  }
+}
+
+
+/**
+  Move a ticket of the lock owned by the current context from the fast
+  path to the granted queue, if it is there.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::materialize_fast_path_ticket(MDL_ticket *ticket)
+{
+  Fast_path_shard *shards= get_fast_path();
+  Fast_path_shard *shard;
+
+  if (!shards)
+    return;
+  shard= &shards[ticket->get_ctx()->get_fast_path_shard()];
+  mysql_mutex_lock(&shard->mutex);
+  if (ticket->m_is_fast_path)
+  {
+    shard->tickets.remove(ticket);
+    shard->count--;
+    ticket->m_is_fast_path= false;
+    m_granted.add_ticket(ticket);
+  }
+  mysql_mutex_unlock(&shard->mutex);
+}
+
+
+/**
+  Mark the lock object as being destroyed, unless there are tickets
+  granted through the fast path.
+
+  @pre m_rwlock is write-locked and the granted and waiting queues are
+       empty.
+
+  @retval TRUE   The lock object may be removed from the hash
+  @retval FALSE  The lock is still in use
+*/
+
+bool MDL_lock::retire()
+{
+  Fast_path_shard *shards= get_fast_path();
+  bool unused= true;
+  uint i;
+
+  if (!shards)
+  {
+    m_strategy= 0;
+    return true;
+  }
+  for (i= 0; i < MDL_FAST_PATH_SHARDS; i++)
+  {
+    mysql_mutex_lock(&shards[i].mutex);
+    if (shards[i].count)
+    {
+      unused= false;
+      i++;
+      break;
+    }
+  }
+  if (unused)
+    m_strategy= 0;
+  while (i--)
+    mysql_mutex_unlock(&shards[i].mutex);
+  return unused;
+}
+
+
+/**
+  Allocate the fast path shards if the lock is hot, that is if
+  MDL_FAST_PATH_MIN_TICKETS unobtrusive tickets are granted at the same
+  time. The shards are not allocated if this fails.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::enable_fast_path_if_hot()
+{
+  Fast_path_shard *shards;
+
+  if (m_fast_path.load(std::memory_order_relaxed) || m_obtrusive_locks ||
+      m_granted.elements() < MDL_FAST_PATH_MIN_TICKETS)
+    return;
+
+  if (!(shards= (Fast_path_shard*) my_malloc(MDL_FAST_PATH_SHARDS *
+                                             sizeof(Fast_path_shard),
+                                             MYF(MY_ZEROFILL))))
+    return;
+  for (uint i= 0; i < MDL_FAST_PATH_SHARDS; i++)
+  {
+    mysql_mutex_init(key_MDL_lock_fast_path_mutex, &shards[i].mutex,
+                     MY_MUTEX_INIT_FAST);
+    new (&shards[i].tickets) Ticket_list::List();
+    new (&shards[i].count) Atomic_counter<uint32>(0);
+  }
+  m_fast_path.store(shards, std::memory_order_release);
+}
+
+
 /**
   Check if we have any pending locks which conflict with existing
   shared lock.
@@ -2004,6 +2435,7 @@ MDL_context::try_acquire_lock(MDL_request *mdl_request)
       is no need to release it.
     */
     DBUG_ASSERT(! ticket->m_lock->is_empty());
+    ticket->m_lock->remove_obtrusive(ticket->get_type());
     mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
     MDL_ticket::destroy(ticket);
   }
@@ -2024,7 +2456,8 @@ MDL_context::try_acquire_lock(MDL_request *mdl_request)
                    lock exists. In this case "out_ticket" out parameter
                    points to ticket which was constructed for the request.
                    MDL_ticket::m_lock points to the corresponding MDL_lock
-                   object and MDL_lock::m_rwlock write-locked.
+                   object and MDL_lock::m_rwlock write-locked. The ticket
+                   is counted in MDL_lock::m_obtrusive_locks.
   @retval  TRUE    Out of resources, an error has been reported.
 */
 
@@ -2034,8 +2467,9 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
 {
   MDL_lock *lock;
   MDL_key *key= &mdl_request->key;
-  MDL_ticket *ticket;
+  MDL_ticket *ticket, *fast_path_ticket;
   enum_mdl_duration found_duration;
+  bool fast_path;
 
   /* Don't take chances in production. */
   DBUG_ASSERT(mdl_request->ticket == NULL);
@@ -2088,18 +2522,35 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                    )))
     return TRUE;
 
-  /* The below call implicitly locks MDL_lock::m_rwlock on success. */
-  if (!(lock= mdl_locks.find_or_insert(m_pins, key)))
+  fast_path_ticket= (MDL_lock::is_unobtrusive(key, mdl_request->type) ?
+                     ticket : NULL);
+
+  /*
+    The below call implicitly locks MDL_lock::m_rwlock on success,
+    unless the ticket is granted through the fast path.
+  */
+  if (!(lock= mdl_locks.find_or_insert(m_pins, key, fast_path_ticket,
+                                       &fast_path)))
   {
     MDL_ticket::destroy(ticket);
     return TRUE;
   }
 
+  if (fast_path)
+  {
+    m_tickets[mdl_request->duration].push_front(ticket);
+    mdl_request->ticket= ticket;
+    return FALSE;
+  }
+
   ticket->m_lock= lock;
+  lock->add_obtrusive(mdl_request->type);
 
   if (lock->can_grant_lock(mdl_request->type, this, false))
   {
     lock->m_granted.add_ticket(ticket);
+    if (fast_path_ticket)
+      lock->enable_fast_path_if_hot();
 
     mysql_prlock_unlock(&lock->m_rwlock);
 
@@ -2162,6 +2613,7 @@ MDL_context::clone_ticket(MDL_request *mdl_request)
   mdl_request->ticket= ticket;
 
   mysql_prlock_wrlock(&ticket->m_lock->m_rwlock);
+  ticket->m_lock->add_obtrusive(ticket->m_type);
   ticket->m_lock->m_granted.add_ticket(ticket);
   mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
 
@@ -2268,6 +2720,7 @@ MDL_context::acquire_lock(MDL_request *mdl_request, double lock_wait_timeout)
 
   if (lock_wait_timeout == 0)
   {
+    lock->remove_obtrusive(ticket->get_type());
     mysql_prlock_unlock(&lock->m_rwlock);
     MDL_ticket::destroy(ticket);
     my_error(ER_LOCK_WAIT_TIMEOUT, MYF(0));
@@ -2527,14 +2980,25 @@ MDL_context::upgrade_shared_lock(MDL_ticket *mdl_ticket,
 
   /* Merge the acquired and the original lock. @todo: move to a method. */
   mysql_prlock_wrlock(&mdl_ticket->m_lock->m_rwlock);
+  /* Both tickets may be of unobtrusive types. */
+  mdl_ticket->m_lock->materialize_fast_path_ticket(mdl_ticket);
   if (is_new_ticket)
+  {
+    mdl_ticket->m_lock->materialize_fast_path_ticket(mdl_xlock_request.ticket);
     mdl_ticket->m_lock->m_granted.remove_ticket(mdl_xlock_request.ticket);
+  }
   /*
     Set the new type of lock in the ticket. To update state of
     MDL_lock object correctly we need to temporarily exclude
     ticket from the granted queue and then include it back.
+    The new type is counted before the old ones are discounted, so that
+    the fast path stays closed if the new type is obtrusive.
   */
   mdl_ticket->m_lock->m_granted.remove_ticket(mdl_ticket);
+  mdl_ticket->m_lock->add_obtrusive(new_type);
+  mdl_ticket->m_lock->remove_obtrusive(mdl_ticket->m_type);
+  if (is_new_ticket)
+    mdl_ticket->m_lock->remove_obtrusive(mdl_xlock_request.ticket->m_type);
   mdl_ticket->m_type= new_type;
   mdl_ticket->m_lock->m_granted.add_ticket(mdl_ticket);
 
@@ -2814,7 +3278,8 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
 
   DBUG_ASSERT(this == ticket->get_ctx());
 
-  lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
+  if (!lock->fast_path_remove_ticket(m_pins, ticket))
+    lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
 
   m_tickets[duration].remove(ticket);
   MDL_ticket::destroy(ticket);
@@ -2924,11 +3389,15 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
                 m_type == MDL_BACKUP_WAIT_FLUSH)));
 
   mysql_prlock_wrlock(&m_lock->m_rwlock);
+  /* Tickets of the types above are never granted through the fast path. */
+  DBUG_ASSERT(!m_is_fast_path);
   /*
     To update state of MDL_lock object correctly we need to temporarily
     exclude ticket from the granted queue and then include it back.
   */
   m_lock->m_granted.remove_ticket(this);
+  m_lock->add_obtrusive(type);
+  m_lock->remove_obtrusive(m_type);
   m_type= type;
   m_lock->m_granted.add_ticket(this);
   m_lock->reschedule_waiters();
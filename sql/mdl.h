@@ -720,6 +720,7 @@ class MDL_ticket : public MDL_wait_for_subgraph
   virtual uint get_deadlock_weight() const;
 private:
   friend class MDL_context;
+  friend class MDL_lock;
 
   MDL_ticket(MDL_context *ctx_arg, enum_mdl_type type_arg
 #ifndef DBUG_OFF
@@ -731,7 +732,8 @@ class MDL_ticket : public MDL_wait_for_subgraph
      m_duration(duration_arg),
 #endif
      m_ctx(ctx_arg),
-     m_lock(NULL)
+     m_lock(NULL),
+     m_is_fast_path(false)
   {}
 
   static MDL_ticket *create(MDL_context *ctx_arg, enum_mdl_type type_arg
@@ -760,6 +762,13 @@ class MDL_ticket : public MDL_wait_for_subgraph
   */
   MDL_lock *m_lock;
 
+  /**
+    TRUE if the ticket was granted through the fast path of the lock and
+    is not in its granted queue. Protected by the fast path mutex of the
+    lock (@sa MDL_lock::m_fast_path).
+  */
+  bool m_is_fast_path;
+
 private:
   MDL_ticket(const MDL_ticket &);               /* not implemented */
   MDL_ticket &operator=(const MDL_ticket &);    /* not implemented */
@@ -904,6 +913,9 @@ class MDL_context
 
   MDL_context_owner *get_owner() { return m_owner; }
 
+  /** Shard of MDL_lock::m_fast_path used for the tickets of the context */
+  uint get_fast_path_shard() const { return m_fast_path_shard; }
+
   /** @pre Only valid if we started waiting for lock. */
   inline uint get_deadlock_weight() const
   { return m_waiting_for->get_deadlock_weight(); }
@@ -1024,6 +1036,7 @@ class MDL_context
    */
   MDL_wait_for_subgraph *m_waiting_for;
   LF_PINS *m_pins;
+  uint m_fast_path_shard;
 private:
   MDL_ticket *find_ticket(MDL_request *mdl_req,
                           enum_mdl_duration *duration);
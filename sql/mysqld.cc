@@ -23,6 +23,8 @@
 #endif
 #include "sql_parse.h"    // path_starts_from_data_home_dir
 #include "sql_cache.h"    // query_cache, query_cache_*
+#include "sql_plan_cache.h" // plan_cache_init, plan_cache_destroy
+#include "filesort_utils.h" // filesort_threads_init, filesort_threads_end
 #include "sql_locale.h"   // MY_LOCALES, my_locales, my_locale_by_name
 #include "sql_show.h"     // free_status_vars, add_status_vars,
                           // reset_status_vars
@@ -380,6 +382,7 @@ static longlong start_memory_used;
 bool opt_bin_log, opt_bin_log_used=0, opt_ignore_builtin_innodb= 0;
 bool opt_bin_log_compress;
 uint opt_bin_log_compress_min_len;
+bool opt_bin_log_compress_transactions;
 my_bool opt_log, debug_assert_if_crashed_table= 0, opt_help= 0;
 my_bool debug_assert_on_not_freed_memory= 0;
 my_bool disable_log_notes, opt_support_flashback= 0;
@@ -455,6 +458,7 @@ my_bool sp_automatic_privileges= 1;
 
 ulong opt_binlog_rows_event_max_size;
 my_bool opt_master_verify_checksum= 0;
+ulong opt_binlog_dump_sendfile_size= 0;
 my_bool opt_slave_sql_verify_checksum= 1;
 const char *binlog_format_names[]= {"MIXED", "STATEMENT", "ROW", NullS};
 volatile sig_atomic_t calling_initgroups= 0; /**< Used in SIGSEGV handler. */
@@ -555,9 +559,11 @@ ulong opt_slave_domain_parallel_threads= 0;
 ulong opt_slave_parallel_mode= SLAVE_PARALLEL_CONSERVATIVE;
 ulong opt_binlog_commit_wait_count= 0;
 ulong opt_binlog_commit_wait_usec= 0;
+ulong opt_binlog_writeset_max_keys= 0;
 ulong opt_slave_parallel_max_queued= 131072;
 my_bool opt_gtid_ignore_duplicates= FALSE;
 uint opt_gtid_cleanup_batch_size= 64;
+uint opt_gtid_slave_pos_batch_size= 1;
 
 const double log_10[] = {
   1e000, 1e001, 1e002, 1e003, 1e004, 1e005, 1e006, 1e007, 1e008, 1e009,
@@ -902,6 +908,7 @@ PSI_mutex_key key_LOCK_prepare_ordered, key_LOCK_commit_ordered,
   key_LOCK_slave_background;
 PSI_mutex_key key_TABLE_SHARE_LOCK_share;
 PSI_mutex_key key_LOCK_ack_receiver;
+PSI_mutex_key key_LOCK_parallel_scan, key_LOCK_sort_threads;
 
 PSI_mutex_key key_TABLE_SHARE_LOCK_rotation;
 PSI_cond_key key_TABLE_SHARE_COND_rotation;
@@ -983,6 +990,8 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_LOCK_rpl_thread_pool, "LOCK_rpl_thread_pool", 0},
   { &key_LOCK_parallel_entry, "LOCK_parallel_entry", 0},
   { &key_LOCK_ack_receiver, "Ack_receiver::mutex", 0},
+  { &key_LOCK_parallel_scan, "Parallel_scan::mutex", 0},
+  { &key_LOCK_sort_threads, "Sort_threads::mutex", 0},
   { &key_LOCK_binlog, "LOCK_binlog", 0}
 };
 
@@ -1046,6 +1055,8 @@ PSI_cond_key key_COND_rpl_thread_queue, key_COND_rpl_thread,
   key_COND_prepare_ordered, key_COND_slave_background;
 PSI_cond_key key_COND_wait_gtid, key_COND_gtid_ignore_duplicates;
 PSI_cond_key key_COND_ack_receiver;
+PSI_cond_key key_COND_parallel_scan_full, key_COND_parallel_scan_free;
+PSI_cond_key key_COND_sort_threads_queued, key_COND_sort_threads_done;
 
 static PSI_cond_info all_server_conds[]=
 {
@@ -1096,6 +1107,10 @@ static PSI_cond_info all_server_conds[]=
   { &key_COND_wait_gtid, "COND_wait_gtid", 0},
   { &key_COND_gtid_ignore_duplicates, "COND_gtid_ignore_duplicates", 0},
   { &key_COND_ack_receiver, "Ack_receiver::cond", 0},
+  { &key_COND_parallel_scan_full, "Parallel_scan::COND_full", 0},
+  { &key_COND_parallel_scan_free, "Parallel_scan::COND_free", 0},
+  { &key_COND_sort_threads_queued, "Sort_threads::COND_queued", 0},
+  { &key_COND_sort_threads_done, "Sort_threads::COND_done", 0},
   { &key_COND_binlog_send, "COND_binlog_send", 0},
   { &key_TABLE_SHARE_COND_rotation, "TABLE_SHARE::COND_rotation", 0}
 };
@@ -1104,14 +1119,17 @@ PSI_thread_key key_thread_delayed_insert,
   key_thread_handle_manager, key_thread_main,
   key_thread_one_connection, key_thread_signal_hand,
   key_thread_slave_background, key_rpl_parallel_thread;
-PSI_thread_key key_thread_ack_receiver;
+PSI_thread_key key_thread_ack_receiver, key_thread_filesort,
+  key_thread_parallel_scan;
 
 static PSI_thread_info all_server_threads[]=
 {
   { &key_thread_delayed_insert, "delayed_insert", 0},
+  { &key_thread_filesort, "filesort", 0},
   { &key_thread_handle_manager, "manager", PSI_FLAG_GLOBAL},
   { &key_thread_main, "main", PSI_FLAG_GLOBAL},
   { &key_thread_one_connection, "one_connection", 0},
+  { &key_thread_parallel_scan, "parallel_scan", 0},
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
   { &key_thread_slave_background, "slave_background", PSI_FLAG_GLOBAL},
   { &key_thread_ack_receiver, "Ack_receiver", PSI_FLAG_GLOBAL},
@@ -1438,7 +1456,8 @@ int deny_severity = LOG_WARNING;
 #endif
 #ifdef HAVE_QUERY_CACHE
 ulong query_cache_min_res_unit= QUERY_CACHE_MIN_RESULT_DATA_SIZE;
-Query_cache query_cache;
+uint query_cache_partitions= 1;
+Partitioned_query_cache query_cache;
 #endif
 
 
@@ -1985,6 +2004,8 @@ static void clean_up(bool print_message)
   grant_free();
 #endif
   query_cache_destroy();
+  plan_cache_destroy();
+  filesort_threads_end();
   hostname_cache_free();
   item_func_sleep_free();
   lex_free();				/* Free some memory */
@@ -4876,9 +4897,11 @@ static int init_server_components()
   {
     global_system_variables.query_cache_type= 1;
   }
-  query_cache_init();
+  query_cache_init(query_cache_partitions);
   DBUG_ASSERT(query_cache_size < ULONG_MAX);
   query_cache_resize((ulong)query_cache_size);
+  plan_cache_init();
+  filesort_threads_init();
   my_rnd_init(&sql_rand,(ulong) server_start_time,(ulong) server_start_time/2);
   setup_fpu();
   init_thr_lock();
@@ -7259,6 +7282,16 @@ static int show_prepared_stmt_count(THD *thd, SHOW_VAR *var, char *buff,
   return 0;
 }
 
+static int show_table_open_cache_mutex_waits(THD *thd, SHOW_VAR *var,
+                                             char *buff,
+                                             enum enum_var_type scope)
+{
+  var->type= SHOW_LONGLONG;
+  var->value= buff;
+  *((longlong *) buff)= (longlong) tc_mutex_waits();
+  return 0;
+}
+
 static int show_table_definitions(THD *thd, SHOW_VAR *var, char *buff,
                                   enum enum_var_type scope)
 {
@@ -7550,6 +7583,52 @@ static int show_default_keycache(THD *thd, SHOW_VAR *var, char *buff,
 }
 
 
+#ifdef HAVE_QUERY_CACHE
+/* The sums of the statistics of the query cache partitions */
+
+static int show_query_cache_vars(THD *thd, SHOW_VAR *var, char *buff,
+                                 enum enum_var_type scope)
+{
+  struct st_data {
+    Query_cache_statistics stats;
+    SHOW_VAR var[9];
+  } *data;
+  SHOW_VAR *v;
+
+  data=(st_data *)buff;
+  v= data->var;
+
+  var->type= SHOW_ARRAY;
+  var->value= v;
+
+  query_cache.get_statistics(&data->stats);
+
+#define set_one_qcache_var(X,Y)         \
+  v->name= X;                           \
+  v->type= SHOW_LONGLONG;               \
+  v->value= &data->stats.Y;             \
+  v++;
+
+  set_one_qcache_var("free_blocks",      free_memory_blocks);
+  set_one_qcache_var("free_memory",      free_memory);
+  set_one_qcache_var("hits",             hits);
+  set_one_qcache_var("inserts",          inserts);
+  set_one_qcache_var("lowmem_prunes",    lowmem_prunes);
+  set_one_qcache_var("not_cached",       refused);
+  set_one_qcache_var("queries_in_cache", queries_in_cache);
+  set_one_qcache_var("total_blocks",     total_blocks);
+
+  v->name= 0;
+
+  DBUG_ASSERT((char*)(v+1) <= buff + SHOW_VAR_FUNC_BUFF_SIZE);
+
+#undef set_one_qcache_var
+
+  return 0;
+}
+#endif /* HAVE_QUERY_CACHE */
+
+
 static int show_memory_used(THD *thd, SHOW_VAR *var, char *buff,
                             struct system_status_var *status_var,
                             enum enum_var_type scope)
@@ -7719,6 +7798,8 @@ SHOW_VAR status_vars[]= {
   {"Opened_tables",            (char*) offsetof(STATUS_VAR, opened_tables), SHOW_LONG_STATUS},
   {"Opened_views",             (char*) offsetof(STATUS_VAR, opened_views), SHOW_LONG_STATUS},
   {"Prepared_stmt_count",      (char*) &show_prepared_stmt_count, SHOW_SIMPLE_FUNC},
+  {"Prepared_stmt_plan_cache_hits", (char*) offsetof(STATUS_VAR, ps_plan_cache_hits), SHOW_LONG_STATUS},
+  {"Prepared_stmt_plan_cache_replans", (char*) offsetof(STATUS_VAR, ps_plan_cache_replans), SHOW_LONG_STATUS},
   {"Rows_sent",                (char*) offsetof(STATUS_VAR, rows_sent), SHOW_LONGLONG_STATUS},
   {"Rows_read",                (char*) offsetof(STATUS_VAR, rows_read), SHOW_LONGLONG_STATUS},
   {"Rows_tmp_read",            (char*) offsetof(STATUS_VAR, rows_tmp_read), SHOW_LONGLONG_STATUS},
@@ -7743,14 +7824,7 @@ SHOW_VAR status_vars[]= {
   {"Rpl_semi_sync_slave_send_ack", (char*) &rpl_semi_sync_slave_send_ack, SHOW_LONGLONG},
 #endif /* HAVE_REPLICATION */
 #ifdef HAVE_QUERY_CACHE
-  {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
-  {"Qcache_free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
-  {"Qcache_hits",              (char*) &query_cache.hits,       SHOW_LONG},
-  {"Qcache_inserts",           (char*) &query_cache.inserts,    SHOW_LONG},
-  {"Qcache_lowmem_prunes",     (char*) &query_cache.lowmem_prunes, SHOW_LONG},
-  {"Qcache_not_cached",        (char*) &query_cache.refused,    SHOW_LONG},
-  {"Qcache_queries_in_cache",  (char*) &query_cache.queries_in_cache, SHOW_LONG_NOFLUSH},
-  {"Qcache_total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
+  {"Qcache",                   (char*) &show_query_cache_vars, SHOW_FUNC},
 #endif /*HAVE_QUERY_CACHE*/
   {"Queries",                  (char*) &show_queries,            SHOW_SIMPLE_FUNC},
   {"Questions",                (char*) offsetof(STATUS_VAR, questions), SHOW_LONG_STATUS},
@@ -7821,6 +7895,7 @@ SHOW_VAR status_vars[]= {
   {"Table_open_cache_active_instances", (char*) &tc_active_instances, SHOW_UINT},
   {"Table_open_cache_hits",    (char*) offsetof(STATUS_VAR, table_open_cache_hits), SHOW_LONGLONG_STATUS},
   {"Table_open_cache_misses",  (char*) offsetof(STATUS_VAR, table_open_cache_misses), SHOW_LONGLONG_STATUS},
+  {"Table_open_cache_mutex_waits", (char*) &show_table_open_cache_mutex_waits, SHOW_SIMPLE_FUNC},
   {"Table_open_cache_overflows", (char*) offsetof(STATUS_VAR, table_open_cache_overflows), SHOW_LONGLONG_STATUS},
 #ifdef HAVE_MMAP
   {"Tc_log_max_pages_used",    (char*) &tc_log_max_pages_used,  SHOW_LONG},
@@ -9325,6 +9400,9 @@ void refresh_status(THD *thd)
 
   /* Reset the counters of all key caches (default and named). */
   process_key_caches(reset_key_cache_counters, 0);
+#ifdef HAVE_QUERY_CACHE
+  query_cache.reset_statistics();
+#endif
   flush_status_time= time((time_t*) 0);
   mysql_mutex_unlock(&LOCK_status);
 
@@ -525,6 +525,77 @@ net_write_command(NET *net,uchar command,
   DBUG_RETURN(rc);
 }
 
+
+#ifdef MYSQL_SERVER
+/**
+  Write a packet made of a header and a part of a file, and flush it.
+
+  The file data is not copied into the net buffer, it is sent after the
+  buffered data with vio_sendfile().
+
+  @param net		NET handler
+  @param header	Data to write before the file data
+  @param head_len	Length of header
+  @param file		File to send data from
+  @param offset	Offset of the data in file
+  @param len		Length of the data
+
+  @note The connection must not be compressed, and the packet must fit in
+    one protocol packet.
+
+  @retval
+    0	ok
+  @retval
+    1	error
+*/
+
+my_bool
+net_write_file(NET *net, const uchar *header, size_t head_len,
+               File file, my_off_t offset, size_t len)
+{
+  size_t length= head_len + len;
+  uchar buff[NET_HEADER_SIZE];
+  int rc= 0;
+  DBUG_ENTER("net_write_file");
+  DBUG_PRINT("enter",("length: %lu", (ulong) length));
+  DBUG_ASSERT(!net->compress);
+  DBUG_ASSERT(length < MAX_PACKET_LENGTH);
+
+  if (unlikely(net->error == 2))
+    DBUG_RETURN(1);
+
+  MYSQL_NET_WRITE_START(length);
+
+  int3store(buff, length);
+  buff[3]= (uchar) net->pkt_nr++;
+  if (net_write_buff(net, buff, NET_HEADER_SIZE) ||
+      net_write_buff(net, header, head_len))
+  {
+    MYSQL_NET_WRITE_DONE(1);
+    DBUG_RETURN(1);
+  }
+
+  net->reading_or_writing= 2;
+  if (vio_sendfile(net->vio, net->buff, (size_t) (net->write_pos - net->buff),
+                   file, offset, len))
+  {
+    net->error= 2;                              /* Close socket */
+    net->last_errno= (vio_was_timeout(net->vio) ? ER_NET_WRITE_INTERRUPTED :
+                      ER_NET_ERROR_ON_WRITE);
+    MYSQL_SERVER_my_error(net->last_errno, MYF(0));
+    rc= 1;
+  }
+  else
+    update_statistics(thd_increment_bytes_sent(net->thd,
+                                               net->write_pos - net->buff +
+                                               len));
+  net->write_pos= net->buff;
+  net->reading_or_writing= 0;
+  MYSQL_NET_WRITE_DONE(rc);
+  DBUG_RETURN(rc);
+}
+#endif /* MYSQL_SERVER */
+
 /**
   Caching the data in a local buffer before sending it.
 
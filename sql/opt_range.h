@@ -1102,6 +1102,11 @@ class QUICK_RANGE_SELECT : public QUICK_SELECT_I
                       uchar *cur_prefix);
   bool reverse_sorted() { return 0; }
   bool unique_key_range();
+  /* The range if the scan is over a single range, NULL otherwise */
+  QUICK_RANGE *single_range()
+  {
+    return ranges.elements == 1 ? *(QUICK_RANGE **) ranges.buffer : NULL;
+  }
   int init_ror_merged_scan(bool reuse_handler, MEM_ROOT *alloc);
   void save_last_pos()
   { file->position(record); }
@@ -34,12 +34,16 @@
 #include "sql_class.h"                          // THD
 #include "sql_base.h"
 #include "sql_sort.h"                           // SORT_ADDON_FIELD
+#include "sql_select.h"                         // JOIN_TAB
+#include "sql_parallel_scan.h"
 
 static int rr_quick(READ_RECORD *info);
 int rr_sequential(READ_RECORD *info);
 static int rr_from_tempfile(READ_RECORD *info);
 static int rr_unpack_from_tempfile(READ_RECORD *info);
 static int rr_unpack_from_buffer(READ_RECORD *info);
+static int rr_unpack_packed_from_tempfile(READ_RECORD *info);
+static int rr_unpack_packed_from_buffer(READ_RECORD *info);
 int rr_from_pointers(READ_RECORD *info);
 static int rr_from_cache(READ_RECORD *info);
 static int init_rr_cache(THD *thd, READ_RECORD *info);
@@ -48,6 +52,7 @@ static int rr_index_first(READ_RECORD *info);
 static int rr_index_last(READ_RECORD *info);
 static int rr_index(READ_RECORD *info);
 static int rr_index_desc(READ_RECORD *info);
+static int rr_parallel(READ_RECORD *info);
 
 
 /**
@@ -229,7 +234,9 @@ bool init_read_record(READ_RECORD *info,THD *thd, TABLE *table,
   {
     DBUG_PRINT("info",("using rr_from_tempfile"));
     info->read_record_func=
-        addon_field ? rr_unpack_from_tempfile : rr_from_tempfile;
+        !addon_field ? rr_from_tempfile :
+        filesort->using_packed_addons ? rr_unpack_packed_from_tempfile :
+        rr_unpack_from_tempfile;
     info->io_cache= tempfile;
     reinit_io_cache(info->io_cache,READ_CACHE,0L,0,0);
     info->ref_pos=table->file->ref;
@@ -274,10 +281,18 @@ bool init_read_record(READ_RECORD *info,THD *thd, TABLE *table,
     if (unlikely(table->file->ha_rnd_init_with_error(0)))
       DBUG_RETURN(1);
     info->cache_pos= filesort->record_pointers;
-    info->cache_end= (info->cache_pos+ 
-                      filesort->return_rows * info->ref_length);
-    info->read_record_func=
-        addon_field ? rr_unpack_from_buffer : rr_from_pointers;
+    if (addon_field && filesort->using_packed_addons)
+    {
+      info->cache_end= info->cache_pos + filesort->record_pointers_length;
+      info->read_record_func= rr_unpack_packed_from_buffer;
+    }
+    else
+    {
+      info->cache_end= (info->cache_pos+
+                        filesort->return_rows * info->ref_length);
+      info->read_record_func=
+          addon_field ? rr_unpack_from_buffer : rr_from_pointers;
+    }
   }
   else if (table->file->keyread_enabled())
   {
@@ -321,6 +336,11 @@ bool init_read_record(READ_RECORD *info,THD *thd, TABLE *table,
 
 void end_read_record(READ_RECORD *info)
 {                   /* free cache if used */
+  if (info->parallel_scan)
+  {
+    delete info->parallel_scan;
+    info->parallel_scan= 0;
+  }
   if (info->cache)
   {
     my_free_lock(info->cache);
@@ -357,6 +377,49 @@ static int rr_handle_error(READ_RECORD *info, int error)
 }
 
 
+/**
+  Initialize READ_RECORD to read the table of a JOIN_TAB with several
+  threads (see sql_parallel_scan.h).
+
+  @retval 0   Ok, read_record() returns the rows read by the threads
+  @retval -1  The table cannot be read in parallel, info is not changed
+  @retval 1   Error
+*/
+
+int init_parallel_read_record(READ_RECORD *info, st_join_table *tab)
+{
+  Parallel_scan *scan;
+  int res;
+  DBUG_ENTER("init_parallel_read_record");
+
+  end_read_record(info);
+  if ((res= Parallel_scan::start(tab, &scan)))
+    DBUG_RETURN(res);
+
+  bzero((char*) info, sizeof(*info));
+  info->thd= tab->join->thd;
+  info->table= tab->table;
+  info->forms= &info->table;
+  info->record= tab->table->record[0];
+  info->select= tab->select;
+  info->print_error= 1;
+  info->unlock_row= rr_unlock_row;
+  info->parallel_scan= scan;
+  info->read_record_func= rr_parallel;
+  tab->table->status= 0;
+  DBUG_RETURN(0);
+}
+
+
+static int rr_parallel(READ_RECORD *info)
+{
+  int tmp;
+  if ((tmp= info->parallel_scan->read_next(info->record)))
+    return rr_handle_error(info, tmp);
+  return 0;
+}
+
+
 /** Read a record from head-database. */
 
 static int rr_quick(READ_RECORD *info)
@@ -532,6 +595,31 @@ static int rr_unpack_from_tempfile(READ_RECORD *info)
   return 0;
 }
 
+
+/**
+  Read a result set record with packed addon fields from a temporary file
+  after sorting.
+
+  Same as rr_unpack_from_tempfile(), except that the record is read in
+  two steps: first its length, then the rest of it.
+*/
+
+static int rr_unpack_packed_from_tempfile(READ_RECORD *info)
+{
+  uint length;
+  if (my_b_read(info->io_cache, info->rec_buf, PACKED_ADDON_LENGTH_BYTES))
+    return -1;
+  length= Sort_param::read_addon_length(info->rec_buf);
+  DBUG_ASSERT(length > PACKED_ADDON_LENGTH_BYTES &&
+              length <= info->ref_length);
+  if (my_b_read(info->io_cache, info->rec_buf + PACKED_ADDON_LENGTH_BYTES,
+                length - PACKED_ADDON_LENGTH_BYTES))
+    return -1;
+  (*info->unpack)(info->addon_field, info->rec_buf, info->rec_buf + length);
+
+  return 0;
+}
+
 int rr_from_pointers(READ_RECORD *info)
 {
   int tmp;
@@ -581,6 +669,24 @@ static int rr_unpack_from_buffer(READ_RECORD *info)
   info->cache_pos+= info->ref_length;
   return 0;
 }
+
+
+/**
+  Read a result set record with packed addon fields from a buffer after
+  sorting. Same as rr_unpack_from_buffer(), except that the records
+  differ in length.
+*/
+
+static int rr_unpack_packed_from_buffer(READ_RECORD *info)
+{
+  if (info->cache_pos == info->cache_end)
+    return -1;                      /* End of buffer */
+  uint length= Sort_param::read_addon_length(info->cache_pos);
+  (*info->unpack)(info->addon_field, info->cache_pos,
+                  info->cache_pos + length);
+  info->cache_pos+= length;
+  return 0;
+}
 	/* cacheing of records from a database */
 
 static int init_rr_cache(THD *thd, READ_RECORD *info)
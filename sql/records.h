@@ -26,6 +26,7 @@ class THD;
 class SQL_SELECT;
 class Copy_field;
 class SORT_INFO;
+class Parallel_scan;
 
 struct READ_RECORD;
 
@@ -78,8 +79,10 @@ struct READ_RECORD
   */
   Copy_field *copy_field;
   Copy_field *copy_field_end;
+  /* Set when the table is read by several threads */
+  Parallel_scan *parallel_scan;
 public:
-  READ_RECORD() : table(NULL), cache(NULL) {}
+  READ_RECORD() : table(NULL), cache(NULL), parallel_scan(NULL) {}
   ~READ_RECORD() { end_read_record(this); }
 };
 
@@ -89,6 +92,7 @@ bool init_read_record(READ_RECORD *info, THD *thd, TABLE *reg_form,
                       bool print_errors, bool disable_rr_cache);
 bool init_read_record_idx(READ_RECORD *info, THD *thd, TABLE *table,
                           bool print_error, uint idx, bool reverse);
+int init_parallel_read_record(READ_RECORD *info, st_join_table *tab);
 
 void rr_unlock_row(st_join_table *tab);
 
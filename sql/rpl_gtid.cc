@@ -27,6 +27,7 @@
 #include "rpl_rli.h"
 #include "slave.h"
 #include "log_event.h"
+#include "sys_vars_shared.h"
 
 const LEX_CSTRING rpl_gtid_slave_state_table_name=
   { STRING_WITH_LEN("gtid_slave_pos") };
@@ -244,7 +245,8 @@ rpl_slave_state_free_element(void *arg)
 
 
 rpl_slave_state::rpl_slave_state()
-  : pending_gtid_count(0), last_sub_id(0), gtid_pos_tables(0), loaded(false)
+  : pending_gtid_count(0), record_gtid_count(0), last_sub_id(0),
+    gtid_pos_tables(0), loaded(false)
 {
   mysql_mutex_init(key_LOCK_slave_state, &LOCK_slave_state,
                    MY_MUTEX_INIT_SLOW);
@@ -293,7 +295,7 @@ rpl_slave_state::update(uint32 domain_id, uint32 server_id, uint64 sub_id,
   element *elem= NULL;
   list_element *list_elem= NULL;
 
-  DBUG_ASSERT(hton || !loaded);
+  /* hton is NULL for a GTID not written to any table, see record_gtid() */
   if (!(elem= get_element(domain_id)))
     return 1;
 
@@ -620,6 +622,9 @@ rpl_slave_state::record_gtid(THD *thd, const rpl_gtid *gtid, uint64 sub_id,
     DBUG_RETURN(0);
   }
 
+  if (thd->slave_thread && skip_record_gtid(in_transaction))
+    DBUG_RETURN(0);
+
   if (!in_statement)
     thd->reset_for_next_command();
 
@@ -750,6 +755,51 @@ rpl_slave_state::record_gtid(THD *thd, const rpl_gtid *gtid, uint64 sub_id,
 }
 
 
+/*
+  Check if InnoDB makes each commit durable (innodb_flush_log_at_trx_commit=1).
+*/
+static bool
+engine_commit_is_durable()
+{
+  sys_var *var;
+  bool is_null, res= false;
+
+  mysql_prlock_rdlock(&LOCK_system_variables_hash);
+  if ((var= intern_find_sys_var(
+              STRING_WITH_LEN("innodb_flush_log_at_trx_commit"))))
+    res= var->val_int(&is_null, 0, OPT_GLOBAL, 0) == 1;
+  mysql_prlock_unlock(&LOCK_system_variables_hash);
+  return res;
+}
+
+
+/*
+  Check if the GTID of a transaction applied by the slave need not be written
+  to mysql.gtid_slave_pos (@@gtid_slave_pos_batch_size).
+
+  The transaction is written to the binlog with its GTID, and with
+  sync_binlog=1 the binlog is synced before the engine commit. After a crash,
+  rpl_load_gtid_slave_state() finds the GTID in the binlog state, so only one
+  transaction in every batch writes its GTID to the table, to keep the table
+  close to the current position. Without sync_binlog=1 the binlog could lose
+  the GTID of a committed transaction, and without
+  innodb_flush_log_at_trx_commit=1 the engine could lose a transaction that
+  is in the binlog state, so then every GTID is written.
+*/
+bool
+rpl_slave_state::skip_record_gtid(bool in_transaction)
+{
+  uint batch_size= opt_gtid_slave_pos_batch_size;
+
+  if (batch_size <= 1 || !in_transaction || !opt_bin_log ||
+      !opt_log_slave_updates || sync_binlog_period != 1 ||
+      !engine_commit_is_durable())
+    return false;
+  return my_atomic_add32_explicit(&record_gtid_count, 1,
+                                  MY_MEMORY_ORDER_RELAXED) % batch_size != 0;
+}
+
+
 /*
   Return a list of all old GTIDs in any mysql.gtid_slave_pos* table that are
   no longer needed and can be deleted from the table.
@@ -768,47 +818,38 @@ rpl_slave_state::gtid_grab_pending_delete_list()
   for (i= 0; i < hash.records; ++i)
   {
     element *elem= (element *)my_hash_element(&hash, i);
-    list_element *elist= elem->list;
-    list_element *last_elem, **best_ptr_ptr, *cur, *next;
-    uint64 best_sub_id;
+    list_element *best, *best_recorded, *cur, *next;
 
-    if (!elist)
+    if (!elem->list)
       continue;                                 /* Nothing here */
 
-    /* Delete any old stuff, but keep around the most recent one. */
-    cur= elist;
-    best_sub_id= cur->sub_id;
-    best_ptr_ptr= &elist;
-    last_elem= cur;
-    while ((next= cur->next)) {
-      last_elem= next;
-      if (next->sub_id > best_sub_id)
+    /*
+      Delete any old stuff, but keep around the most recent one, and the most
+      recent one written to a table (which is older if the most recent GTIDs
+      were not written, see skip_record_gtid()). GTIDs not written to any
+      table are just freed.
+    */
+    best= best_recorded= NULL;
+    for (cur= elem->list; cur; cur= cur->next)
+    {
+      if (!best || cur->sub_id > best->sub_id)
+        best= cur;
+      if (cur->hton && (!best_recorded || cur->sub_id > best_recorded->sub_id))
+        best_recorded= cur;
+    }
+    for (cur= elem->grab_list(); cur; cur= next)
+    {
+      next= cur->next;
+      if (cur == best || cur == best_recorded)
+        elem->add(cur);
+      else if (!cur->hton)
+        my_free(cur);
+      else
       {
-        best_sub_id= next->sub_id;
-        best_ptr_ptr= &cur->next;
+        cur->next= full_list;
+        full_list= cur;
       }
-      cur= next;
     }
-    /*
-      Append the new elements to the full list. Note the order is important;
-      we do it here so that we do not break the list if best_sub_id is the
-      last of the new elements.
-    */
-    last_elem->next= full_list;
-    /*
-      Delete the highest sub_id element from the old list, and put it back as
-      the single-element new list.
-    */
-    cur= *best_ptr_ptr;
-    *best_ptr_ptr= cur->next;
-    cur->next= NULL;
-    elem->list= cur;
-
-    /*
-      Collect the full list so far here. Note that elist may have moved if we
-      deleted the first element, so order is again important.
-    */
-    full_list= elist;
   }
   mysql_mutex_unlock(&LOCK_slave_state);
 
@@ -2014,6 +2055,49 @@ rpl_binlog_state::get_most_recent_gtid_list(rpl_gtid **list, uint32 *size)
   return res;
 }
 
+/*
+  Get, for each domain, the GTID with the highest seq_no among those not
+  logged by local_server_id, ie. the most recent GTID replicated from another
+  server.
+*/
+int
+rpl_binlog_state::get_replicated_gtid_list(rpl_gtid **list, uint32 *size,
+                                           uint32 local_server_id)
+{
+  uint32 i, j;
+  uint32 alloc_size, out_size;
+  int res= 0;
+
+  out_size= 0;
+  mysql_mutex_lock(&LOCK_binlog_state);
+  alloc_size= hash.records;
+  if (!(*list= (rpl_gtid *)my_malloc(alloc_size * sizeof(rpl_gtid),
+                                     MYF(MY_WME))))
+  {
+    res= 1;
+    goto end;
+  }
+  for (i= 0; i < alloc_size; ++i)
+  {
+    element *e= (element *)my_hash_element(&hash, i);
+    rpl_gtid *best= NULL;
+    for (j= 0; j < e->hash.records; ++j)
+    {
+      rpl_gtid *gtid= (rpl_gtid *)my_hash_element(&e->hash, j);
+      if (gtid->server_id != local_server_id &&
+          (!best || gtid->seq_no > best->seq_no))
+        best= gtid;
+    }
+    if (best)
+      memcpy(&((*list)[out_size++]), best, sizeof(rpl_gtid));
+  }
+
+end:
+  mysql_mutex_unlock(&LOCK_binlog_state);
+  *size= out_size;
+  return res;
+}
+
 bool
 rpl_binlog_state::append_pos(String *str)
 {
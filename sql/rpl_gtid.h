@@ -194,6 +194,8 @@ struct rpl_slave_state
   HASH hash;
   /* GTIDs added since last purge of old mysql.gtid_slave_pos rows. */
   uint32 pending_gtid_count;
+  /* GTIDs considered for mysql.gtid_slave_pos, see record_gtid(). */
+  int32 volatile record_gtid_count;
   /* Mutex protecting access to the state. */
   mysql_mutex_t LOCK_slave_state;
   /* Auxiliary buffer to sort gtid list. */
@@ -237,6 +239,7 @@ struct rpl_slave_state
   void select_gtid_pos_table(THD *thd, LEX_CSTRING *out_tablename);
   int record_gtid(THD *thd, const rpl_gtid *gtid, uint64 sub_id,
                   bool in_transaction, bool in_statement, void **out_hton);
+  bool skip_record_gtid(bool in_transaction);
   list_element *gtid_grab_pending_delete_list();
   LEX_CSTRING *select_gtid_pos_table(void *hton);
   void gtid_delete_pending(THD *thd, rpl_slave_state::list_element **list_ptr);
@@ -324,6 +327,8 @@ struct rpl_binlog_state
   uint32 count();
   int get_gtid_list(rpl_gtid *gtid_list, uint32 list_size);
   int get_most_recent_gtid_list(rpl_gtid **list, uint32 *size);
+  int get_replicated_gtid_list(rpl_gtid **list, uint32 *size,
+                               uint32 local_server_id);
   bool append_pos(String *str);
   bool append_state(String *str);
   rpl_gtid *find_nolock(uint32 domain_id, uint32 server_id);
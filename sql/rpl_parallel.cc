@@ -2150,7 +2150,8 @@ free_rpl_parallel_entry(void *element)
 
 
 rpl_parallel::rpl_parallel() :
-  current(NULL), sql_thread_stopping(false)
+  current(NULL), sql_thread_stopping(false),
+  pending_writeset(NULL), pending_writeset_count(0)
 {
   my_hash_init(&domain_hash, &my_charset_bin, 32,
                offsetof(rpl_parallel_entry, domain_id), sizeof(uint32),
@@ -2164,12 +2165,41 @@ rpl_parallel::reset()
   my_hash_reset(&domain_hash);
   current= NULL;
   sql_thread_stopping= false;
+  clear_pending_writeset();
 }
 
 
 rpl_parallel::~rpl_parallel()
 {
   my_hash_free(&domain_hash);
+  clear_pending_writeset();
+}
+
+
+/*
+  Keep the writeset of a Writeset_log_event for the GTID event that follows
+  it. The keys are taken over from the event.
+*/
+void
+rpl_parallel::set_pending_writeset(Writeset_log_event *ev)
+{
+  clear_pending_writeset();
+  if (!ev->is_valid())
+    return;
+  pending_writeset_gtid.domain_id= ev->domain_id;
+  pending_writeset_gtid.server_id= ev->server_id;
+  pending_writeset_gtid.seq_no= ev->seq_no;
+  pending_writeset_count= ev->count;
+  pending_writeset= ev->release_keys();
+}
+
+
+void
+rpl_parallel::clear_pending_writeset()
+{
+  my_free(pending_writeset);
+  pending_writeset= NULL;
+  pending_writeset_count= 0;
 }
 
 
@@ -2387,6 +2417,80 @@ rpl_parallel_entry::queue_master_restart(rpl_group_info *rgi,
 }
 
 
+/*
+  Each key of a writeset sets two bits of the filter, taken from the low and
+  the high half of the key hash.
+*/
+static inline uint32 writeset_bit1(uint64 key)
+{
+  return (uint32) key % rpl_parallel_entry::WRITESET_FILTER_BITS;
+}
+
+static inline uint32 writeset_bit2(uint64 key)
+{
+  return (uint32) (key >> 32) % rpl_parallel_entry::WRITESET_FILTER_BITS;
+}
+
+
+/*
+  Check if an event group can join the batch in current_gco because it
+  changes other rows than every event group of the batch. keys is the
+  writeset of the event group, NULL if it has none.
+*/
+bool
+rpl_parallel_entry::writeset_can_join(const Gtid_log_event *gtid_ev,
+                                      const uint64 *keys, uint count) const
+{
+  uchar flags2= gtid_ev->flags2;
+
+  if (writeset_keys == WRITESET_NONE || !keys ||
+      !(flags2 & Gtid_log_event::FL_TRANSACTIONAL) ||
+      !(flags2 & Gtid_log_event::FL_ALLOW_PARALLEL) ||
+      writeset_keys + count > WRITESET_MAX_KEYS)
+    return false;
+  for (uint i= 0; i < count; i++)
+  {
+    uint32 bit1= writeset_bit1(keys[i]);
+    uint32 bit2= writeset_bit2(keys[i]);
+    if ((writeset_filter[bit1 / 64] & (1ULL << (bit1 % 64))) &&
+        (writeset_filter[bit2 / 64] & (1ULL << (bit2 % 64))))
+      return false;
+  }
+  return true;
+}
+
+
+/*
+  Add the writeset of an event group queued in current_gco to the filter.
+  new_batch is true if the event group starts a new gco.
+*/
+void
+rpl_parallel_entry::writeset_add(const uint64 *keys, uint count,
+                                 bool new_batch)
+{
+  if (new_batch && writeset_keys)
+  {
+    bzero(writeset_filter, sizeof(writeset_filter));
+    writeset_keys= 0;
+  }
+  if (writeset_keys == WRITESET_NONE)
+    return;
+  if (!keys || writeset_keys + count > WRITESET_MAX_KEYS)
+  {
+    writeset_keys= WRITESET_NONE;
+    return;
+  }
+  for (uint i= 0; i < count; i++)
+  {
+    uint32 bit1= writeset_bit1(keys[i]);
+    uint32 bit2= writeset_bit2(keys[i]);
+    writeset_filter[bit1 / 64]|= 1ULL << (bit1 % 64);
+    writeset_filter[bit2 / 64]|= 1ULL << (bit2 % 64);
+  }
+  writeset_keys+= count;
+}
+
+
 int
 rpl_parallel::wait_for_workers_idle(THD *thd)
 {
@@ -2523,6 +2627,13 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
   if (rli->slave_skip_counter)
     return -1;
 
+  /*
+    Keep the writeset for the GTID event that follows. The event itself is
+    then handled like other events outside of event groups.
+  */
+  if (unlikely(typ == WRITESET_EVENT))
+    set_pending_writeset(static_cast<Writeset_log_event *>(ev));
+
   /* Execute pre-10.0 event, which have no GTID, in single-threaded mode. */
   is_group_event= Log_event::is_group_event(typ);
   if (unlikely(!current) && typ != GTID_EVENT &&
@@ -2694,6 +2805,18 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     group_commit_orderer *gco;
     uint8 force_switch_flag;
     enum rpl_group_info::enum_speculation speculation;
+    const uint64 *writeset= NULL;
+    uint writeset_count= 0;
+
+    /* The writeset logged just before this GTID event, if any */
+    if (pending_writeset &&
+        pending_writeset_gtid.seq_no == gtid_ev->seq_no &&
+        pending_writeset_gtid.domain_id == gtid_ev->domain_id &&
+        pending_writeset_gtid.server_id == gtid_ev->server_id)
+    {
+      writeset= pending_writeset;
+      writeset_count= pending_writeset_count;
+    }
 
     if (!(rgi= cur_thread->get_rgi(rli, gtid_ev, e, event_size)))
     {
@@ -2744,6 +2867,18 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
         */
         new_gco= false;
       }
+      else if (mode == SLAVE_PARALLEL_CONSERVATIVE &&
+               e->writeset_can_join(gtid_ev, writeset, writeset_count))
+      {
+        /*
+          The event group changes other rows than every event group in the
+          batch, so it can run in parallel with them even though it did not
+          group commit with them on the master. The batch is now marked
+          MULTI_BATCH, so later event groups join it only if their writeset
+          allows it, not just by sharing our commit_id.
+        */
+        new_gco= false;
+      }
       else if ((mode >= SLAVE_PARALLEL_OPTIMISTIC) &&
                !(flags & group_commit_orderer::FORCE_SWITCH))
       {
@@ -2818,6 +2953,9 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
       gco->flags|= force_switch_flag;
       e->current_gco= gco;
     }
+    if (mode == SLAVE_PARALLEL_CONSERVATIVE)
+      e->writeset_add(writeset, writeset_count, new_gco);
+    clear_pending_writeset();
     rgi->gco= gco;
 
     qev->rgi= e->current_group_info= rgi;
@@ -343,7 +343,24 @@ struct rpl_parallel_entry {
   uint64 count_committing_event_groups;
   /* The group_commit_orderer object for the events currently being queued. */
   group_commit_orderer *current_gco;
-
+  /*
+    In conservative mode, a Bloom filter of the writesets (hashes of the
+    unique keys of the changed rows, see Writeset_log_event) of
+    the event groups in current_gco. An event group whose writeset does not
+    hit the filter changes other rows than every event group of the batch,
+    so it can join the batch even if it did not group commit with them on
+    the master. writeset_keys is the number of keys added to the filter, or
+    WRITESET_NONE if an event group of the batch has no writeset.
+  */
+  static const uint32 WRITESET_FILTER_BITS= 65536;
+  static const uint32 WRITESET_MAX_KEYS= 1024;
+  static const uint32 WRITESET_NONE= ~(uint32) 0;
+  uint64 writeset_filter[WRITESET_FILTER_BITS / 64];
+  uint32 writeset_keys;
+
+  bool writeset_can_join(const Gtid_log_event *gtid_ev, const uint64 *keys,
+                         uint count) const;
+  void writeset_add(const uint64 *keys, uint count, bool new_batch);
   rpl_parallel_thread * choose_thread(rpl_group_info *rgi, bool *did_enter_cond,
                                       PSI_stage_info *old_stage, bool reuse);
   int queue_master_restart(rpl_group_info *rgi,
@@ -353,10 +370,19 @@ struct rpl_parallel {
   HASH domain_hash;
   rpl_parallel_entry *current;
   bool sql_thread_stopping;
+  /*
+    The writeset of the last Writeset_log_event, for the event group with
+    pending_writeset_gtid when its GTID event follows.
+  */
+  uint64 *pending_writeset;
+  uint pending_writeset_count;
+  rpl_gtid pending_writeset_gtid;
 
   rpl_parallel();
   ~rpl_parallel();
   void reset();
+  void set_pending_writeset(Writeset_log_event *ev);
+  void clear_pending_writeset();
   rpl_parallel_entry *find(uint32 domain_id);
   void wait_for_done(THD *thd, Relay_log_info *rli);
   void stop_during_until();
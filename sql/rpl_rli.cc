@@ -1821,6 +1821,8 @@ rpl_load_gtid_slave_state(THD *thd)
   uint32 i;
   load_gtid_state_cb_data cb_data;
   rpl_slave_state::list_element *old_gtids_list;
+  rpl_gtid *binlog_gtids= NULL;
+  uint32 num_binlog_gtids= 0;
   DBUG_ENTER("rpl_load_gtid_slave_state");
 
   mysql_mutex_lock(&rpl_global_gtid_slave_state->LOCK_slave_state);
@@ -1855,6 +1857,21 @@ rpl_load_gtid_slave_state(THD *thd)
   if ((err= gtid_pos_auto_create_tables(&cb_data.table_list)))
     goto end;
 
+  /*
+    With --gtid-slave-pos-batch-size, the GTIDs of the last transactions
+    applied before a crash may be found only in the binlog state, see
+    rpl_slave_state::skip_record_gtid().
+  */
+  if (opt_gtid_slave_pos_batch_size > 1 && opt_bin_log &&
+      opt_log_slave_updates &&
+      mysql_bin_log.get_replicated_gtid_list(&binlog_gtids,
+                                             &num_binlog_gtids))
+  {
+    my_error(ER_OUT_OF_RESOURCES, MYF(0));
+    err= 1;
+    goto end;
+  }
+
   mysql_mutex_lock(&rpl_global_gtid_slave_state->LOCK_slave_state);
   if (rpl_global_gtid_slave_state->loaded)
   {
@@ -1887,6 +1904,24 @@ rpl_load_gtid_slave_state(THD *thd)
     }
   }
 
+  for (i= 0; i < num_binlog_gtids; ++i)
+  {
+    rpl_gtid *gtid= &binlog_gtids[i];
+    uint64 sub_id= rpl_global_gtid_slave_state->last_sub_id + 1;
+    entry= (struct gtid_pos_element *)
+      my_hash_search(&hash, (const uchar *)&gtid->domain_id, 0);
+    if (entry && entry->gtid.seq_no >= gtid->seq_no)
+      continue;
+    if ((err= rpl_global_gtid_slave_state->update(gtid->domain_id,
+                                                  gtid->server_id, sub_id,
+                                                  gtid->seq_no, NULL, NULL)))
+    {
+      mysql_mutex_unlock(&rpl_global_gtid_slave_state->LOCK_slave_state);
+      my_error(ER_OUT_OF_RESOURCES, MYF(0));
+      goto end;
+    }
+  }
+
   for (i= 0; i < hash.records; ++i)
   {
     entry= (struct gtid_pos_element *)my_hash_element(&hash, i);
@@ -1914,6 +1949,7 @@ rpl_load_gtid_slave_state(THD *thd)
     rpl_global_gtid_slave_state->put_back_list(old_gtids_list);
 
 end:
+  my_free(binlog_gtids);
   if (array_inited)
     delete_dynamic(&array);
   my_hash_free(&hash);
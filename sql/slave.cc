@@ -6169,6 +6169,25 @@ static int queue_old_event(Master_info *mi, const char *buf,
   }
 }
 
+/*
+  Write the events of an expanded Transaction_payload_log_event one by one
+  to the relay log.
+*/
+
+static bool write_payload_events(Relay_log_info *rli, const char *buf,
+                                 ulong len)
+{
+  const char *end= buf + len;
+  while (buf < end)
+  {
+    ulong event_len= uint4korr(buf + EVENT_LEN_OFFSET);
+    if (rli->relay_log.write_event_buffer((uchar*)buf, event_len))
+      return true;
+    buf+= event_len;
+  }
+  return false;
+}
+
 /*
   queue_event()
 
@@ -6198,6 +6217,7 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
   char new_buf_arr[4096];
   bool is_malloc = false;
   bool is_rows_event= false;
+  bool is_payload_event= false;
   /*
     FD_q must have been prepared for the first R_a event
     inside get_master_version_and_clock()
@@ -6748,6 +6768,30 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
     is_compress_event = true;
     goto default_action;
 
+  /*
+    The events of a compressed transaction are written one by one to the
+    relay log, so the SQL thread does not need to know about the payload.
+  */
+  case TRANSACTION_PAYLOAD_EVENT:
+    inc_pos= event_len;
+    if (transaction_payload_uncompress(rli->relay_log.description_event_for_queue,
+                                       checksum_alg == BINLOG_CHECKSUM_ALG_CRC32,
+                                       buf, event_len, new_buf_arr,
+                                       sizeof(new_buf_arr), &is_malloc,
+                                       (char **)&new_buf, &event_len))
+    {
+      char  llbuf[22];
+      error = ER_BINLOG_UNCOMPRESS_ERROR;
+      error_msg.append(STRING_WITH_LEN("binlog uncompress error, master log_pos: "));
+      llstr(mi->master_log_pos, llbuf);
+      error_msg.append(llbuf, strlen(llbuf));
+      goto err;
+    }
+    buf= new_buf;
+    is_compress_event= true;
+    is_payload_event= true;
+    goto default_action;
+
   case WRITE_ROWS_COMPRESSED_EVENT:
   case UPDATE_ROWS_COMPRESSED_EVENT:
   case DELETE_ROWS_COMPRESSED_EVENT:
@@ -7004,7 +7048,9 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
   }
   else
   {
-    if (likely(!rli->relay_log.write_event_buffer((uchar*)buf, event_len)))
+    if (likely(!(is_payload_event ?
+                 write_payload_events(rli, buf, event_len) :
+                 rli->relay_log.write_event_buffer((uchar*)buf, event_len))))
     {
       mi->master_log_pos+= inc_pos;
       DBUG_PRINT("info", ("master_log_pos: %lu", (ulong) mi->master_log_pos));
@@ -78,5 +78,31 @@ void Filesort_tracker::print_json_members(Json_writer *writer)
     else
       writer->add_size(sort_buffer_size);
   }
+
+  if (r_parallel_sorts || r_parallel_merge_passes)
+  {
+    double loops= (double) get_r_loops();
+    writer->add_member("r_sort_threads").add_ll(r_sort_threads);
+    writer->add_member("r_parallel_sorts").
+            add_ll((longlong) rint(r_parallel_sorts / loops));
+    writer->add_member("r_parallel_merge_passes").
+            add_ll((longlong) rint(r_parallel_merge_passes / loops));
+    writer->add_member("r_sort_thread_stats").start_array();
+    for (uint i= 0; i < r_sort_threads && i < n_thread_stats; i++)
+    {
+      const Sort_thread_stats &stats= thread_stats[i];
+      writer->start_object();
+      writer->add_member("r_sorted_rows").
+              add_ll((longlong) rint(stats.sorted_rows / loops));
+      writer->add_member("r_merged_rows").
+              add_ll((longlong) rint(stats.merged_rows / loops));
+      writer->add_member("r_time_ms").
+              add_double(stats.time / loops / 1e6);
+      writer->add_member("r_inline_tasks").
+              add_ll((longlong) rint(stats.inline_tasks / loops));
+      writer->end_object();
+    }
+    writer->end_array();
+  }
 }
 
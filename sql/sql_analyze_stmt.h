@@ -162,6 +162,27 @@ class Table_access_tracker
 };
 
 
+/*
+  A class for collecting statistics about the records that a join buffer
+  had to spill into temporary files because they did not fit into it.
+*/
+
+class Join_spill_tracker
+{
+public:
+  Join_spill_tracker() :
+    r_spills(0), r_partitions(0), r_outer_rows(0), r_inner_rows(0)
+  {}
+
+  ha_rows r_spills; /* How many times the join buffer was overflown */
+  ha_rows r_partitions; /* How many non-empty partitions have been joined */
+  ha_rows r_outer_rows; /* Partial join records written to the files */
+  ha_rows r_inner_rows; /* Rows of the joined table written to the files */
+
+  bool has_spills() { return (r_spills != 0); }
+};
+
+
 class Json_writer;
 
 /*
@@ -174,6 +195,27 @@ class Json_writer;
   The class is designed to handle multiple invocations of filesort().
 */
 
+/**
+  The work done by one of the threads of parallel sorts and merge passes.
+  Thread 0 is the thread that runs the query; thread i > 0 took the i-th
+  part of each sort buffer or merge pass, and is one of the threads shared
+  by all sorts unless no such thread was free, and the thread running the
+  query did that part itself.
+*/
+
+struct Sort_thread_stats
+{
+  /* Rows sorted in the sort buffer */
+  ulonglong sorted_rows;
+  /* Rows merged, in the sort buffer or from the temporary file */
+  ulonglong merged_rows;
+  /* Time spent sorting and merging, in nanoseconds */
+  ulonglong time;
+  /* Parts run by the thread running the query, not by a shared thread */
+  ulonglong inline_tasks;
+};
+
+
 class Filesort_tracker : public Sql_alloc
 {
 public:
@@ -181,7 +223,9 @@ class Filesort_tracker : public Sql_alloc
     time_tracker(do_timing), r_limit(0), r_used_pq(0),
     r_examined_rows(0), r_sorted_rows(0), r_output_rows(0),
     sort_passes(0),
-    sort_buffer_size(0)
+    sort_buffer_size(0),
+    r_sort_threads(0), r_parallel_sorts(0), r_parallel_merge_passes(0),
+    thread_stats(NULL), n_thread_stats(0)
   {}
   
   /* Functions that filesort uses to report various things about its execution */
@@ -223,6 +267,31 @@ class Filesort_tracker : public Sql_alloc
     else
       sort_buffer_size= bufsize;
   }
+
+  inline void report_sort_threads(uint max_threads, ulong sorts,
+                                  ulong merge_passes)
+  {
+    set_if_bigger(r_sort_threads, max_threads);
+    r_parallel_sorts+= sorts;
+    r_parallel_merge_passes+= merge_passes;
+  }
+
+  /**
+    The statistics of the n threads of each parallel sort or merge pass,
+    which filesort() adds to directly.
+    @return NULL if they could not be allocated
+  */
+  Sort_thread_stats *get_sort_thread_stats(MEM_ROOT *mem_root, uint n)
+  {
+    if (!thread_stats &&
+        (thread_stats= (Sort_thread_stats*)
+         alloc_root(mem_root, n * sizeof(Sort_thread_stats))))
+    {
+      memset(thread_stats, 0, n * sizeof(Sort_thread_stats));
+      n_thread_stats= n;
+    }
+    return n <= n_thread_stats ? thread_stats : NULL;
+  }
   
   /* Functions to get the statistics */
   void print_json_members(Json_writer *writer);
@@ -282,6 +351,16 @@ class Filesort_tracker : public Sql_alloc
     other          - value
   */
   ulonglong sort_buffer_size;
+
+  /* Max number of threads that sorted one sort buffer or merged one pass */
+  ulonglong r_sort_threads;
+  /* How many sort buffers were sorted by more than one thread */
+  ulonglong r_parallel_sorts;
+  /* How many merge passes were run by more than one thread */
+  ulonglong r_parallel_merge_passes;
+  /* The work of the first r_sort_threads threads, see get_sort_thread_stats */
+  Sort_thread_stats *thread_stats;
+  uint n_thread_stats;
 };
 
 
@@ -1113,8 +1113,8 @@ Query_cache::insert(THD *thd, Query_cache_tls *query_cache_tls,
     header->result(result);
     DBUG_PRINT("qcache", ("free query %p", query_block));
     // The following call will remove the lock on query_block
-    query_cache.free_query(query_block);
-    query_cache.refused++;
+    free_query(query_block);
+    refused++;
     // append_result_data no success => we need unlock
     unlock();
     DBUG_VOID_RETURN;
@@ -1227,9 +1227,9 @@ void Query_cache::end_of_result(THD *thd)
     }
     last_result_block= header->result()->prev;
     allign_size= ALIGN_SIZE(last_result_block->used);
-    len= MY_MAX(query_cache.min_allocation_unit, allign_size);
-    if (last_result_block->length >= query_cache.min_allocation_unit + len)
-      query_cache.split_block(last_result_block,len);
+    len= MY_MAX(min_allocation_unit, allign_size);
+    if (last_result_block->length >= min_allocation_unit + len)
+      split_block(last_result_block,len);
 
     header->found_rows(limit_found_rows);
     header->set_results_ready(); // signal for plugin
@@ -1291,6 +1291,7 @@ Query_cache::Query_cache(size_t query_cache_limit_arg,
   set_if_bigger(min_allocation_unit,min_needed);
   this->min_allocation_unit= ALIGN_SIZE(min_allocation_unit);
   set_if_bigger(this->min_result_data_size,min_allocation_unit);
+  table_filter_reset();
 }
 
 
@@ -1361,14 +1362,14 @@ size_t Query_cache::set_min_res_unit(size_t size)
 }
 
 
-void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
+void Partitioned_query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
 {
   TABLE_COUNTER_TYPE local_tables;
   size_t tot_length;
   const char *query;
   size_t query_length;
   uint8 tables_type;
-  DBUG_ENTER("Query_cache::store_query");
+  DBUG_ENTER("Partitioned_query_cache::store_query");
   /*
     Testing 'query_cache_size' without a lock here is safe: the thing
     we may loose is that the query won't be cached, but we save on
@@ -1408,8 +1409,8 @@ void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
               thd->base_query.ptr() == thd->query());
 
   tables_type= 0;
-  if ((local_tables= is_cacheable(thd, thd->lex, tables_used,
-				  &tables_type)))
+  if ((local_tables= Query_cache::is_cacheable(thd, thd->lex, tables_used,
+                                               &tables_type)))
   {
     NET *net= &thd->net;
     Query_cache_query_flags flags;
@@ -1473,33 +1474,6 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
                           (int)flags.in_trans,
                           (int)flags.autocommit));
 
-    /*
-      A table- or a full flush operation can potentially take a long time to
-      finish. We choose not to wait for them and skip caching statements
-      instead.
-
-      In case the wait time can't be determined there is an upper limit which
-      causes try_lock() to abort with a time out.
-
-      The 'TIMEOUT' parameter indicate that the lock is allowed to timeout
-
-    */
-    if (try_lock(thd, Query_cache::TIMEOUT))
-      DBUG_VOID_RETURN;
-    if (query_cache_size == 0)
-    {
-      unlock();
-      DBUG_VOID_RETURN;
-    }
-    DUMP(this);
-
-    if (ask_handler_allowance(thd, tables_used))
-    {
-      refused++;
-      unlock();
-      DBUG_VOID_RETURN;
-    }
-
     query=        thd->base_query.ptr();
     query_length= thd->base_query.length();
 
@@ -1524,77 +1498,130 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
     memcpy((void*) (query + (tot_length - QUERY_CACHE_FLAGS_SIZE)),
 	   &flags, QUERY_CACHE_FLAGS_SIZE);
 
-    /* Check if another thread is processing the same query? */
-    Query_cache_block *competitor = (Query_cache_block *)
-      my_hash_search(&queries, (uchar*) query, tot_length);
-    DBUG_PRINT("qcache", ("competitor %p", competitor));
-    if (competitor == 0)
-    {
-      /* Query is not in cache and no one is working with it; Store it */
-      Query_cache_block *query_block;
-      query_block= write_block_data(tot_length, (uchar*) query,
-				    ALIGN_SIZE(sizeof(Query_cache_query)),
-				    Query_cache_block::QUERY, local_tables);
-      if (query_block != 0)
-      {
-	DBUG_PRINT("qcache", ("query block %p allocated, %zu",
-			    query_block, query_block->used));
+    get_partition(query, tot_length)->store_query(thd, tables_used,
+                                                  query, tot_length,
+                                                  local_tables, tables_type);
+  }
+  else
+    statistic_increment(refused, &LOCK_status);
 
-	Query_cache_query *header = query_block->query();
-	header->init_n_lock();
-	if (my_hash_insert(&queries, (uchar*) query_block))
-	{
-	  refused++;
-	  DBUG_PRINT("qcache", ("insertion in query hash"));
-	  header->unlock_n_destroy();
-	  free_memory_block(query_block);
-          unlock();
-	  goto end;
-	}
-	if (!register_all_tables(thd, query_block, tables_used, local_tables))
-	{
-	  refused++;
-	  DBUG_PRINT("warning", ("tables list including failed"));
-	  my_hash_delete(&queries, (uchar *) query_block);
-	  header->unlock_n_destroy();
-	  free_memory_block(query_block);
-          unlock();
-	  goto end;
-	}
-	double_linked_list_simple_include(query_block, &queries_blocks);
-	inserts++;
-	queries_in_cache++;
-	thd->query_cache_tls.first_query_block= query_block;
-	header->writer(&thd->query_cache_tls);
-	header->tables_type(tables_type);
+  DBUG_VOID_RETURN;
+}
 
-        unlock();
 
-        DEBUG_SYNC(thd, "wait_in_query_cache_store_query");
+/**
+  Register the query with the given key in this partition.
+
+  @param thd          Thread handle
+  @param tables_used  Tables used by the query
+  @param key          Key of the query: the query, the current database and
+                      the flags, see Partitioned_query_cache::store_query()
+  @param key_length   Length of the key
+  @param local_tables Number of tables used, as returned by is_cacheable()
+  @param tables_type  Types of the tables, as set by is_cacheable()
+*/
 
-	// init_n_lock make query block locked
-	BLOCK_UNLOCK_WR(query_block);
+void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used,
+                              const char *key, size_t key_length,
+                              TABLE_COUNTER_TYPE local_tables,
+                              uint8 tables_type)
+{
+  DBUG_ENTER("Query_cache::store_query");
+  /*
+    A table- or a full flush operation can potentially take a long time to
+    finish. We choose not to wait for them and skip caching statements
+    instead.
+
+    In case the wait time can't be determined there is an upper limit which
+    causes try_lock() to abort with a time out.
+
+    The 'TIMEOUT' parameter indicate that the lock is allowed to timeout
+
+  */
+  if (try_lock(thd, Query_cache::TIMEOUT))
+    DBUG_VOID_RETURN;
+  if (query_cache_size == 0)
+  {
+    unlock();
+    DBUG_VOID_RETURN;
+  }
+  DUMP(this);
+
+  if (ask_handler_allowance(thd, tables_used))
+  {
+    refused++;
+    unlock();
+    DBUG_VOID_RETURN;
+  }
+
+  /* Check if another thread is processing the same query? */
+  Query_cache_block *competitor = (Query_cache_block *)
+    my_hash_search(&queries, (uchar*) key, key_length);
+  DBUG_PRINT("qcache", ("competitor %p", competitor));
+  if (competitor == 0)
+  {
+    /* Query is not in cache and no one is working with it; Store it */
+    Query_cache_block *query_block;
+    query_block= write_block_data(key_length, (uchar*) key,
+				  ALIGN_SIZE(sizeof(Query_cache_query)),
+				  Query_cache_block::QUERY, local_tables);
+    if (query_block != 0)
+    {
+      DBUG_PRINT("qcache", ("query block %p allocated, %zu",
+			  query_block, query_block->used));
+
+      Query_cache_query *header = query_block->query();
+      header->init_n_lock();
+      if (my_hash_insert(&queries, (uchar*) query_block))
+      {
+	refused++;
+	DBUG_PRINT("qcache", ("insertion in query hash"));
+	header->unlock_n_destroy();
+	free_memory_block(query_block);
+        unlock();
+	DBUG_VOID_RETURN;
       }
-      else
+      if (!register_all_tables(thd, query_block, tables_used, local_tables))
       {
-	// We have not enough memory to store query => do nothing
 	refused++;
+	DBUG_PRINT("warning", ("tables list including failed"));
+	my_hash_delete(&queries, (uchar *) query_block);
+	header->unlock_n_destroy();
+	free_memory_block(query_block);
         unlock();
-	DBUG_PRINT("warning", ("Can't allocate query"));
+	DBUG_VOID_RETURN;
       }
+      double_linked_list_simple_include(query_block, &queries_blocks);
+      inserts++;
+      queries_in_cache++;
+      thd->query_cache_tls.first_query_block= query_block;
+      thd->query_cache_tls.partition= this;
+      header->writer(&thd->query_cache_tls);
+      header->tables_type(tables_type);
+
+      unlock();
+
+      DEBUG_SYNC(thd, "wait_in_query_cache_store_query");
+
+      // init_n_lock make query block locked
+      BLOCK_UNLOCK_WR(query_block);
     }
     else
     {
-      // Another thread is processing the same query => do nothing
+      // We have not enough memory to store query => do nothing
       refused++;
       unlock();
-      DBUG_PRINT("qcache", ("Another thread process same query"));
+      DBUG_PRINT("warning", ("Can't allocate query"));
     }
   }
   else
-    statistic_increment(refused, &structure_guard_mutex);
+  {
+    // Another thread is processing the same query => do nothing
+    refused++;
+    unlock();
+    DBUG_PRINT("qcache", ("Another thread process same query"));
+  }
 
-end:
   DBUG_VOID_RETURN;
 }
 
@@ -1705,19 +1732,13 @@ size_t build_normalized_name(char *buff, size_t bufflen,
 */
 
 int
-Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
+Partitioned_query_cache::send_result_to_client(THD *thd, char *org_sql,
+                                               uint query_length)
 {
-  ulonglong engine_data;
-  Query_cache_query *query;
-#ifndef EMBEDDED_LIBRARY
-  Query_cache_block *first_result_block;
-#endif
-  Query_cache_block *result_block;
-  Query_cache_block_table *block_table, *block_table_end;
   size_t tot_length;
   Query_cache_query_flags flags;
   const char *sql, *sql_end, *found_brace= 0;
-  DBUG_ENTER("Query_cache::send_result_to_client");
+  DBUG_ENTER("Partitioned_query_cache::send_result_to_client");
 
   /*
     Testing without a lock here is safe: the thing
@@ -1872,23 +1893,6 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
       goto err;
     }
   }
-  /*
-    Try to obtain an exclusive lock on the query cache. If the cache is
-    disabled or if a full cache flush is in progress, the attempt to
-    get the lock is aborted.
-
-    The TIMEOUT parameter indicate that the lock is allowed to timeout.
-  */
-  if (try_lock(thd, Query_cache::TIMEOUT))
-    goto err;
-
-  if (query_cache_size == 0)
-  {
-    thd->query_cache_is_applicable= 0;            // Query can't be cached
-    goto err_unlock;
-  }
-
-  Query_cache_block *query_block;
   if (thd->variables.query_cache_strip_comments)
   {
     if (found_brace)
@@ -1920,8 +1924,6 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
     DBUG_PRINT("qcache", ("No active database"));
   }
 
-  THD_STAGE_INFO(thd, stage_checking_query_cache_for_query);
-
   // fill all gaps between fields with 0 to get repeatable key
   bzero(&flags, QUERY_CACHE_FLAGS_SIZE);
   flags.client_long_flag= MY_TEST(thd->client_capabilities & CLIENT_LONG_FLAG);
@@ -1975,14 +1977,67 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
   memcpy((uchar *)(sql + (tot_length - QUERY_CACHE_FLAGS_SIZE)),
 	 (uchar*) &flags, QUERY_CACHE_FLAGS_SIZE);
 
+  DBUG_RETURN(get_partition(sql, tot_length)->
+              send_result_to_client(thd, sql, tot_length));
+
+err:
+  thd->query_cache_is_applicable= 0;            // Query can't be cached
+  DBUG_RETURN(0);				// Query was not cached
+}
+
+
+/**
+  Check if the query with the given key is in this partition. If it was
+  cached, send it to the user.
+
+  @param thd        Pointer to the thread handler
+  @param key        Key of the query, see
+                    Partitioned_query_cache::send_result_to_client()
+  @param key_length Length of the key
+
+  @return status code, as for Partitioned_query_cache::send_result_to_client()
+*/
+
+int
+Query_cache::send_result_to_client(THD *thd, const char *key,
+                                   size_t key_length)
+{
+  ulonglong engine_data;
+  Query_cache_query *query;
+#ifndef EMBEDDED_LIBRARY
+  Query_cache_block *first_result_block;
+#endif
+  Query_cache_block *result_block;
+  Query_cache_block_table *block_table, *block_table_end;
+  Query_cache_block *query_block;
+  DBUG_ENTER("Query_cache::send_result_to_client");
+
+  /*
+    Try to obtain an exclusive lock on the query cache. If the cache is
+    disabled or if a full cache flush is in progress, the attempt to
+    get the lock is aborted.
+
+    The TIMEOUT parameter indicate that the lock is allowed to timeout.
+  */
+  if (try_lock(thd, Query_cache::TIMEOUT))
+    goto err;
+
+  if (query_cache_size == 0)
+  {
+    thd->query_cache_is_applicable= 0;            // Query can't be cached
+    goto err_unlock;
+  }
+
+  THD_STAGE_INFO(thd, stage_checking_query_cache_for_query);
+
 #ifdef WITH_WSREP
   bool once_more;
   once_more= true;
 lookup:
 #endif /* WITH_WSREP */
 
-  query_block = (Query_cache_block *)  my_hash_search(&queries, (uchar*) sql,
-                                                      tot_length);
+  query_block = (Query_cache_block *)  my_hash_search(&queries, (uchar*) key,
+                                                      key_length);
   /* Quick abort on unlocked data */
   if (query_block == 0 ||
       query_block->query()->result() == 0 ||
@@ -2225,10 +2280,10 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
   Remove all cached queries that uses any of the tables in the list
 */
 
-void Query_cache::invalidate(THD *thd, TABLE_LIST *tables_used,
-			     my_bool using_transactions)
+void Partitioned_query_cache::invalidate(THD *thd, TABLE_LIST *tables_used,
+                                         my_bool using_transactions)
 {
-  DBUG_ENTER("Query_cache::invalidate (table list)");
+  DBUG_ENTER("Partitioned_query_cache::invalidate (table list)");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -2256,9 +2311,10 @@ void Query_cache::invalidate(THD *thd, TABLE_LIST *tables_used,
   DBUG_VOID_RETURN;
 }
 
-void Query_cache::invalidate(THD *thd, CHANGED_TABLE_LIST *tables_used)
+void Partitioned_query_cache::invalidate(THD *thd,
+                                         CHANGED_TABLE_LIST *tables_used)
 {
-  DBUG_ENTER("Query_cache::invalidate (changed table list)");
+  DBUG_ENTER("Partitioned_query_cache::invalidate (changed table list)");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -2278,16 +2334,17 @@ void Query_cache::invalidate(THD *thd, CHANGED_TABLE_LIST *tables_used)
   Invalidate locked for write
 
   SYNOPSIS
-    Query_cache::invalidate_locked_for_write()
+    Partitioned_query_cache::invalidate_locked_for_write()
     tables_used - table list
 
   NOTE
     can be used only for opened tables
 */
-void Query_cache::invalidate_locked_for_write(THD *thd,
-                                              TABLE_LIST *tables_used)
+void
+Partitioned_query_cache::invalidate_locked_for_write(THD *thd,
+                                                     TABLE_LIST *tables_used)
 {
-  DBUG_ENTER("Query_cache::invalidate_locked_for_write");
+  DBUG_ENTER("Partitioned_query_cache::invalidate_locked_for_write");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -2307,10 +2364,10 @@ void Query_cache::invalidate_locked_for_write(THD *thd,
   Remove all cached queries that uses the given table
 */
 
-void Query_cache::invalidate(THD *thd, TABLE *table, 
-			     my_bool using_transactions)
+void Partitioned_query_cache::invalidate(THD *thd, TABLE *table,
+                                         my_bool using_transactions)
 {
-  DBUG_ENTER("Query_cache::invalidate (table)");
+  DBUG_ENTER("Partitioned_query_cache::invalidate (table)");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -2325,10 +2382,11 @@ void Query_cache::invalidate(THD *thd, TABLE *table,
   DBUG_VOID_RETURN;
 }
 
-void Query_cache::invalidate(THD *thd, const char *key, size_t  key_length,
-			     my_bool using_transactions)
+void Partitioned_query_cache::invalidate(THD *thd, const char *key,
+                                         size_t key_length,
+                                         my_bool using_transactions)
 {
-  DBUG_ENTER("Query_cache::invalidate (key)");
+  DBUG_ENTER("Partitioned_query_cache::invalidate (key)");
   if (is_disabled())
    DBUG_VOID_RETURN;
 
@@ -2346,6 +2404,18 @@ void Query_cache::invalidate(THD *thd, const char *key, size_t  key_length,
    Remove all cached queries that uses the given database.
 */
 
+void Partitioned_query_cache::invalidate(THD *thd, const char *db)
+{
+  DBUG_ENTER("Partitioned_query_cache::invalidate (db)");
+  if (is_disabled())
+    DBUG_VOID_RETURN;
+
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].invalidate(thd, db);
+  DBUG_VOID_RETURN;
+}
+
+
 void Query_cache::invalidate(THD *thd, const char *db)
 {
   DBUG_ENTER("Query_cache::invalidate (db)");
@@ -2419,9 +2489,10 @@ void Query_cache::invalidate(THD *thd, const char *db)
 }
 
 
-void Query_cache::invalidate_by_MyISAM_filename(const char *filename)
+void
+Partitioned_query_cache::invalidate_by_MyISAM_filename(const char *filename)
 {
-  DBUG_ENTER("Query_cache::invalidate_by_MyISAM_filename");
+  DBUG_ENTER("Partitioned_query_cache::invalidate_by_MyISAM_filename");
 
   if (is_disabled())
     DBUG_VOID_RETURN;
@@ -2429,7 +2500,8 @@ void Query_cache::invalidate_by_MyISAM_filename(const char *filename)
   /* Calculate the key outside the lock to make the lock shorter */
   char key[MAX_DBKEY_LENGTH];
   uint32 db_length;
-  uint key_length= filename_2_table_key(key, filename, &db_length);
+  uint key_length= Query_cache::filename_2_table_key(key, filename,
+                                                    &db_length);
   THD *thd= current_thd;
   invalidate_table(thd,(uchar *)key, key_length);
   DBUG_VOID_RETURN;
@@ -2453,7 +2525,7 @@ void Query_cache::flush()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   unlock();
   DBUG_VOID_RETURN;
 }
@@ -2787,10 +2859,36 @@ void Query_cache::make_disabled()
   first_block= 0;
   total_blocks= 0;
   tables_blocks= 0;
+  table_filter_reset();
   DBUG_VOID_RETURN;
 }
 
 
+void Query_cache::table_filter_reset()
+{
+  for (uint i= 0; i < QUERY_CACHE_TABLE_FILTER_SIZE; i++)
+    table_filter[i]= 0;
+}
+
+
+/**
+  Hash of a table key, computed with the collation of the 'tables' hash
+  (see init_cache()), so that the keys of one table have the same hash.
+*/
+
+my_hash_value_type Query_cache::table_key_hash(const uchar *key,
+                                               size_t key_length)
+{
+#ifndef FN_NO_CASE_SENSE
+  CHARSET_INFO *cs= &my_charset_bin;
+#else
+  CHARSET_INFO *cs= (lower_case_table_names ? &my_charset_bin :
+                     files_charset_info);
+#endif
+  return my_hash_sort(cs, key, key_length);
+}
+
+
 /**
   @class Query_cache
   Free all resources allocated by the cache.
@@ -3282,7 +3380,8 @@ my_bool Query_cache::allocate_data_chain(Query_cache_block **result_block,
   Invalidate the first table in the table_list
 */
 
-void Query_cache::invalidate_table(THD *thd, TABLE_LIST *table_list)
+void Partitioned_query_cache::invalidate_table(THD *thd,
+                                               TABLE_LIST *table_list)
 {
   if (table_list->table != 0)
     invalidate_table(thd, table_list->table);	// Table is open
@@ -3297,12 +3396,30 @@ void Query_cache::invalidate_table(THD *thd, TABLE_LIST *table_list)
   }
 }
 
-void Query_cache::invalidate_table(THD *thd, TABLE *table)
+void Partitioned_query_cache::invalidate_table(THD *thd, TABLE *table)
 {
   invalidate_table(thd, (uchar*) table->s->table_cache_key.str,
                    table->s->table_cache_key.length);
 }
 
+
+/*
+  Invalidate the table in the partitions that may have queries using it.
+  The filters of the partitions are read without locks: a query that
+  starts using the table after that is registered after the invalidation.
+*/
+
+void Partitioned_query_cache::invalidate_table(THD *thd, uchar *key,
+                                               size_t key_length)
+{
+  my_hash_value_type hash= Query_cache::table_key_hash(key, key_length);
+  for (uint i= 0; i < n_partitions; i++)
+  {
+    if (n_partitions == 1 || partitions[i].may_use_table(hash))
+      partitions[i].invalidate_table(thd, key, key_length);
+  }
+}
+
 void Query_cache::invalidate_table(THD *thd, uchar * key, size_t key_length)
 {
   DEBUG_SYNC(thd, "wait_in_query_cache_invalidate1");
@@ -3577,6 +3694,8 @@ Query_cache::insert_table(THD *thd, size_t key_len, const char *key,
     header->callback(callback);
     header->engine_data(engine_data);
     header->set_hashed(hash);
+    if (hash)
+      table_filter_counter((uchar*) key, key_len)++;
 
     /*
       We insert this table without the assumption that it isn't refrenenced by
@@ -3632,7 +3751,10 @@ void Query_cache::unlink_table(Query_cache_block_table *node)
                                &tables_blocks);
     Query_cache_table *header= table_block->table();
     if (header->is_hashed())
+    {
       my_hash_delete(&tables,(uchar *) table_block);
+      table_filter_counter(header->data(), header->key_length())--;
+    }
     free_memory_block(table_block);
   }
   DBUG_VOID_RETURN;
@@ -4238,7 +4360,7 @@ void Query_cache::pack_cache()
 {
   DBUG_ENTER("Query_cache::pack_cache");
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
 
   uchar *border = 0;
   Query_cache_block *before = 0;
@@ -4270,7 +4392,7 @@ void Query_cache::pack_cache()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   DBUG_VOID_RETURN;
 }
 
@@ -4633,6 +4755,241 @@ uint Query_cache::filename_2_table_key (char *key, const char *path,
                               filename, NAME_LEN) - key) + 1);
 }
 
+/*****************************************************************************
+  Partitioned query cache
+*****************************************************************************/
+
+/**
+  Create the partitions of the query cache.
+
+  @param n_partitions_arg  Number of partitions (@@query_cache_partitions)
+*/
+
+void Partitioned_query_cache::init(uint n_partitions_arg)
+{
+  DBUG_ENTER("Partitioned_query_cache::init");
+  DBUG_ASSERT(n_partitions_arg >= 1 &&
+              n_partitions_arg <= MAX_QUERY_CACHE_PARTITIONS);
+  if (!(partitions= new (std::nothrow) Query_cache[n_partitions_arg]))
+  {
+    sql_print_error("Can't allocate %u query cache partitions",
+                    n_partitions_arg);
+    DBUG_VOID_RETURN;
+  }
+  n_partitions= n_partitions_arg;
+  for (uint i= 0; i < n_partitions; i++)
+  {
+    partitions[i].result_size_limit(query_cache_limit);
+    partitions[i].set_min_res_unit(min_res_unit);
+    partitions[i].init();
+  }
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+  Resize the query cache.
+
+  Every partition gets the same part of the memory, the rest of the
+  division goes to the first one.
+
+  @return the sum of the real sizes of the partitions, 0 if disabled
+*/
+
+size_t Partitioned_query_cache::resize(size_t query_cache_size_arg)
+{
+  size_t partition_size, new_query_cache_size= 0;
+  DBUG_ENTER("Partitioned_query_cache::resize");
+  if (!partitions)
+    DBUG_RETURN(0);
+
+  partition_size= query_cache_size_arg / n_partitions;
+  for (uint i= n_partitions; i-- > 0; )
+  {
+    size_t size= (i ? partition_size :
+                  query_cache_size_arg - partition_size * (n_partitions - 1));
+    new_query_cache_size+= partitions[i].resize(size);
+  }
+  query_cache_size= new_query_cache_size;
+  DBUG_RETURN(new_query_cache_size);
+}
+
+
+void Partitioned_query_cache::result_size_limit(size_t limit)
+{
+  query_cache_limit= limit;
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].result_size_limit(limit);
+}
+
+
+size_t Partitioned_query_cache::set_min_res_unit(size_t size)
+{
+  min_res_unit= size;
+  for (uint i= 0; i < n_partitions; i++)
+    size= partitions[i].set_min_res_unit(min_res_unit);
+  return size;
+}
+
+
+/**
+  Choose the partition of a query by the hash of its key.
+
+  The hash is not the one of the 'queries' hash of a partition, so that
+  the queries of a partition are spread evenly over its hash buckets.
+*/
+
+Query_cache *
+Partitioned_query_cache::get_partition(const char *key, size_t key_length)
+{
+  if (n_partitions == 1)
+    return partitions;
+  return (partitions +
+          my_checksum(0, (const uchar*) key, key_length) % n_partitions);
+}
+
+
+bool Partitioned_query_cache::is_disable_in_progress(void)
+{
+  for (uint i= 0; i < n_partitions; i++)
+  {
+    if (partitions[i].is_disable_in_progress())
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+void Partitioned_query_cache::disable_query_cache(THD *thd)
+{
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].disable_query_cache(thd);
+}
+
+
+void Partitioned_query_cache::flush()
+{
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].flush();
+}
+
+
+void Partitioned_query_cache::pack(THD *thd, size_t join_limit,
+                                   uint iteration_limit)
+{
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].pack(thd, join_limit, iteration_limit);
+}
+
+
+void Partitioned_query_cache::destroy()
+{
+  DBUG_ENTER("Partitioned_query_cache::destroy");
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].destroy();
+  delete [] partitions;
+  partitions= 0;
+  n_partitions= 0;
+  query_cache_size= 0;
+  DBUG_VOID_RETURN;
+}
+
+
+/*
+  The following functions work with the partition where the current query
+  of the thread is being stored, see the comment on double-check locking
+  usage above.
+*/
+
+void Partitioned_query_cache::insert(THD *thd,
+                                     Query_cache_tls *query_cache_tls,
+                                     const char *packet, size_t length,
+                                     unsigned pkt_nr)
+{
+  if (query_cache_tls->first_query_block)
+    query_cache_tls->partition->insert(thd, query_cache_tls, packet, length,
+                                       pkt_nr);
+}
+
+
+void Partitioned_query_cache::end_of_result(THD *thd)
+{
+  if (thd->query_cache_tls.first_query_block)
+    thd->query_cache_tls.partition->end_of_result(thd);
+}
+
+
+void Partitioned_query_cache::abort(THD *thd,
+                                    Query_cache_tls *query_cache_tls)
+{
+  if (query_cache_tls->first_query_block)
+    query_cache_tls->partition->abort(thd, query_cache_tls);
+}
+
+
+/**
+  Get the statistics of the partition. The counters are read without
+  the lock, like the status variables.
+*/
+
+void Query_cache::get_statistics(Query_cache_statistics *stats)
+{
+  stats->size= query_cache_size;
+  stats->free_memory= free_memory;
+  stats->free_memory_blocks= free_memory_blocks;
+  stats->total_blocks= total_blocks;
+  stats->queries_in_cache= queries_in_cache;
+  stats->hits= hits;
+  stats->inserts= inserts;
+  stats->refused= refused;
+  stats->lowmem_prunes= lowmem_prunes;
+}
+
+
+void
+Partitioned_query_cache::get_partition_statistics(uint partition_no,
+                                                  Query_cache_statistics *stats)
+{
+  DBUG_ASSERT(partition_no < n_partitions);
+  partitions[partition_no].get_statistics(stats);
+}
+
+
+/**
+  Get the statistics of the whole query cache: the sums of the statistics
+  of the partitions.
+*/
+
+void Partitioned_query_cache::get_statistics(Query_cache_statistics *stats)
+{
+  bzero(stats, sizeof(*stats));
+  stats->refused= refused;
+  for (uint i= 0; i < n_partitions; i++)
+  {
+    Query_cache_statistics partition_stats;
+    partitions[i].get_statistics(&partition_stats);
+    stats->size+= partition_stats.size;
+    stats->free_memory+= partition_stats.free_memory;
+    stats->free_memory_blocks+= partition_stats.free_memory_blocks;
+    stats->total_blocks+= partition_stats.total_blocks;
+    stats->queries_in_cache+= partition_stats.queries_in_cache;
+    stats->hits+= partition_stats.hits;
+    stats->inserts+= partition_stats.inserts;
+    stats->refused+= partition_stats.refused;
+    stats->lowmem_prunes+= partition_stats.lowmem_prunes;
+  }
+}
+
+
+/* Reset the counters that are reset by FLUSH STATUS */
+
+void Partitioned_query_cache::reset_statistics()
+{
+  refused= 0;
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].reset_statistics();
+}
+
 /****************************************************************************
   Functions to be used when debugging
 ****************************************************************************/
@@ -4681,6 +5038,14 @@ void Query_cache::wreck(uint line, const char *message)
 }
 
 
+void Partitioned_query_cache::wreck(uint line, const char *message)
+{
+  query_cache_size= 0;
+  for (uint i= 0; i < n_partitions; i++)
+    partitions[i].wreck(line, message);
+}
+
+
 void Query_cache::bins_dump()
 {
   uint i;
@@ -5112,6 +5477,15 @@ my_bool Query_cache::check_integrity(bool locked)
 }
 
 
+my_bool Partitioned_query_cache::check_integrity(bool locked)
+{
+  my_bool result= 0;
+  for (uint i= 0; i < n_partitions; i++)
+    result|= partitions[i].check_integrity(locked);
+  return result;
+}
+
+
 my_bool Query_cache::in_blocks(Query_cache_block * point)
 {
   my_bool result = 0;
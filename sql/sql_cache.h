@@ -18,6 +18,7 @@
 
 #include "hash.h"
 #include "my_base.h"                            /* ha_rows */
+#include "my_counter.h"                         /* Atomic_counter */
 
 class MY_LOCALE;
 struct TABLE_LIST;
@@ -66,6 +67,14 @@ typedef struct st_changed_table_list CHANGED_TABLE_LIST;
 #define QUERY_CACHE_PACK_ITERATION		2
 #define QUERY_CACHE_PACK_LIMIT			(512*1024L)
 
+/* maximal value of query_cache_partitions */
+#define MAX_QUERY_CACHE_PARTITIONS		64
+/*
+  number of counters in the filter of the tables used by the queries of a
+  partition (see Query_cache::table_filter)
+*/
+#define QUERY_CACHE_TABLE_FILTER_SIZE		1024
+
 #define TABLE_COUNTER_TYPE uint
 
 struct Query_cache_block;
@@ -74,6 +83,7 @@ struct Query_cache_table;
 struct Query_cache_query;
 struct Query_cache_result;
 class Query_cache;
+class Partitioned_query_cache;
 struct Query_cache_tls;
 struct LEX;
 class THD;
@@ -297,8 +307,26 @@ struct Query_cache_memory_bin_step
   }
 };
 
+/* Statistics of the query cache or of one of its partitions */
+
+struct Query_cache_statistics
+{
+  ulonglong size, free_memory, free_memory_blocks, total_blocks,
+    queries_in_cache, hits, inserts, refused, lowmem_prunes;
+};
+
+/**
+  One partition of the query cache.
+
+  Every partition has its own memory, hashes of queries and tables and
+  lock. A query is stored in and looked up from the partition chosen by
+  the hash of its key (see Partitioned_query_cache), so that threads
+  working with different queries do not wait for each other.
+*/
+
 class Query_cache
 {
+  friend class Partitioned_query_cache;
 public:
   /* Info */
   size_t query_cache_size, query_cache_limit;
@@ -354,6 +382,21 @@ class Query_cache
 
   bool initialized;
 
+  /*
+    Counting filter of the tables in the 'tables' hash, indexed by the
+    hash of the table key. It is changed under the lock of the partition
+    and read without it, to skip partitions that do not have queries
+    using a table being invalidated.
+  */
+  Atomic_counter<uint32> table_filter[QUERY_CACHE_TABLE_FILTER_SIZE];
+  Atomic_counter<uint32> &table_filter_counter(const uchar *key,
+                                               size_t key_length)
+  {
+    return table_filter[table_key_hash(key, key_length) %
+                        QUERY_CACHE_TABLE_FILTER_SIZE];
+  }
+  void table_filter_reset();
+
   /* Exclude/include from cyclic double linked list */
   static void double_linked_list_exclude(Query_cache_block *point,
 					 Query_cache_block **list_pointer);
@@ -371,10 +414,6 @@ class Query_cache
 			      size_t data_len,
 			      Query_cache_block *query_block,
 			      my_bool first_block);
-  void invalidate_table(THD *thd, TABLE_LIST *table);
-  void invalidate_table(THD *thd, TABLE *table);
-  void invalidate_table(THD *thd, uchar *key, size_t  key_length);
-  void invalidate_table(THD *thd, Query_cache_block *table_block);
   void invalidate_query_block_list(THD *thd, 
                                    Query_cache_block_table *list_root);
 
@@ -438,12 +477,12 @@ class Query_cache
     If query is cacheable return number tables in query
     (query without tables not cached)
   */
-  TABLE_COUNTER_TYPE is_cacheable(THD *thd,
-                                  LEX *lex, TABLE_LIST *tables_used,
-                                  uint8 *tables_type);
-  TABLE_COUNTER_TYPE process_and_count_tables(THD *thd,
-                                              TABLE_LIST *tables_used,
-                                              uint8 *tables_type);
+  static TABLE_COUNTER_TYPE is_cacheable(THD *thd,
+                                         LEX *lex, TABLE_LIST *tables_used,
+                                         uint8 *tables_type);
+  static TABLE_COUNTER_TYPE process_and_count_tables(THD *thd,
+                                                     TABLE_LIST *tables_used,
+                                                     uint8 *tables_type);
 
   static my_bool ask_handler_allowance(THD *thd, TABLE_LIST *tables_used);
  public:
@@ -467,29 +506,32 @@ class Query_cache
   /* set minimal result data allocation unit size */
   size_t set_min_res_unit(size_t size);
 
-  /* register query in cache */
-  void store_query(THD *thd, TABLE_LIST *used_tables);
+  /* register query with the given key in cache */
+  void store_query(THD *thd, TABLE_LIST *tables_used,
+                   const char *key, size_t key_length,
+                   TABLE_COUNTER_TYPE local_tables, uint8 tables_type);
 
   /*
-    Check if the query is in the cache and if this is true send the
-    data to client.
+    Check if the query with the given key is in the cache and if this is
+    true send the data to client.
   */
-  int send_result_to_client(THD *thd, char *query, uint query_length);
+  int send_result_to_client(THD *thd, const char *key, size_t key_length);
 
-  /* Remove all queries that uses any of the listed following tables */
-  void invalidate(THD *thd, TABLE_LIST *tables_used,
-		  my_bool using_transactions);
-  void invalidate(THD *thd, CHANGED_TABLE_LIST *tables_used);
-  void invalidate_locked_for_write(THD *thd, TABLE_LIST *tables_used);
-  void invalidate(THD *thd, TABLE *table, my_bool using_transactions);
-  void invalidate(THD *thd, const char *key, size_t key_length,
-		  my_bool using_transactions);
+  /* Remove all queries that uses the table with the given key */
+  void invalidate_table(THD *thd, uchar *key, size_t  key_length);
 
   /* Remove all queries that uses any of the tables in following database */
   void invalidate(THD *thd, const char *db);
 
-  /* Remove all queries that uses any of the listed following table */
-  void invalidate_by_MyISAM_filename(const char *filename);
+  /* Hash of a table key, as in the 'tables' hash */
+  static my_hash_value_type table_key_hash(const uchar *key,
+                                           size_t key_length);
+  /* Check if some queries may use the table with the given key hash */
+  bool may_use_table(my_hash_value_type hash)
+  { return table_filter[hash % QUERY_CACHE_TABLE_FILTER_SIZE] != 0; }
+
+  void get_statistics(Query_cache_statistics *stats);
+  void reset_statistics() { hits= inserts= refused= lowmem_prunes= 0; }
 
   void flush();
   void pack(THD *thd,
@@ -544,6 +586,113 @@ class Query_cache
   void disable_query_cache(THD *thd);
 };
 
+
+/**
+  The query cache: a set of partitions (@@query_cache_partitions).
+
+  The key of a query (the query text, the current database and the flags
+  that affect the result) is computed here, and the query is stored in and
+  looked up from the partition chosen by the hash of the key.
+
+  A table is invalidated in every partition that may have queries using
+  it, according to the table filter of the partition. With a single
+  partition the cache works as a non-partitioned one.
+*/
+
+class Partitioned_query_cache
+{
+public:
+  /* Info: the sum of the sizes of the partitions */
+  size_t query_cache_size, query_cache_limit;
+
+private:
+  Query_cache *partitions;
+  uint n_partitions;
+  /* Can be set before init(), passed to the partitions when created */
+  size_t min_res_unit;
+  /* Queries that were not cached before a partition was chosen */
+  size_t refused;
+
+  Query_cache *get_partition(const char *key, size_t key_length);
+  void invalidate_table(THD *thd, TABLE_LIST *table);
+  void invalidate_table(THD *thd, TABLE *table);
+  void invalidate_table(THD *thd, uchar *key, size_t key_length);
+
+public:
+  Partitioned_query_cache()
+    :query_cache_size(0), query_cache_limit(ULONG_MAX),
+     partitions(0), n_partitions(0),
+     min_res_unit(QUERY_CACHE_MIN_RESULT_DATA_SIZE), refused(0)
+  {}
+
+  inline bool is_disabled(void)
+  { return !partitions || partitions[0].is_disabled(); }
+  bool is_disable_in_progress(void);
+
+  /* initialize cache (mutex) */
+  void init(uint n_partitions_arg);
+  /* resize query cache (return real query size, 0 if disabled) */
+  size_t resize(size_t query_cache_size);
+  /* set limit on result size */
+  void result_size_limit(size_t limit);
+  /* set minimal result data allocation unit size */
+  size_t set_min_res_unit(size_t size);
+
+  /* register query in cache */
+  void store_query(THD *thd, TABLE_LIST *used_tables);
+
+  /*
+    Check if the query is in the cache and if this is true send the
+    data to client.
+  */
+  int send_result_to_client(THD *thd, char *query, uint query_length);
+
+  /* Remove all queries that uses any of the listed following tables */
+  void invalidate(THD *thd, TABLE_LIST *tables_used,
+		  my_bool using_transactions);
+  void invalidate(THD *thd, CHANGED_TABLE_LIST *tables_used);
+  void invalidate_locked_for_write(THD *thd, TABLE_LIST *tables_used);
+  void invalidate(THD *thd, TABLE *table, my_bool using_transactions);
+  void invalidate(THD *thd, const char *key, size_t key_length,
+		  my_bool using_transactions);
+
+  /* Remove all queries that uses any of the tables in following database */
+  void invalidate(THD *thd, const char *db);
+
+  /* Remove all queries that uses any of the listed following table */
+  void invalidate_by_MyISAM_filename(const char *filename);
+
+  void flush();
+  void pack(THD *thd,
+            size_t join_limit = QUERY_CACHE_PACK_LIMIT,
+	    uint iteration_limit = QUERY_CACHE_PACK_ITERATION);
+
+  void destroy();
+
+  void insert(THD *thd, Query_cache_tls *query_cache_tls,
+              const char *packet,
+              size_t length,
+              unsigned pkt_nr);
+  void end_of_result(THD *thd);
+  void abort(THD *thd, Query_cache_tls *query_cache_tls);
+
+  void disable_query_cache(THD *thd);
+
+  uint partition_count() { return n_partitions; }
+  Query_cache *partition(uint partition_no)
+  { return partitions + partition_no; }
+
+  /* Statistics of the whole cache and of one partition */
+  void get_statistics(Query_cache_statistics *stats);
+  void get_partition_statistics(uint partition_no,
+                                Query_cache_statistics *stats);
+  void reset_statistics();
+
+  /* Functions used when debugging, see Query_cache */
+  void wreck(uint line, const char *message);
+  my_bool check_integrity(bool not_locked);
+};
+
 #ifdef HAVE_QUERY_CACHE
 struct Query_cache_query_flags
 {
@@ -575,7 +724,7 @@ struct Query_cache_query_flags
 #define query_cache_store_query(A, B) query_cache.store_query(A, B)
 #define query_cache_destroy() query_cache.destroy()
 #define query_cache_result_size_limit(A) query_cache.result_size_limit(A)
-#define query_cache_init() query_cache.init()
+#define query_cache_init(A) query_cache.init(A)
 #define query_cache_resize(A) query_cache.resize(A)
 #define query_cache_set_min_res_unit(A) query_cache.set_min_res_unit(A)
 #define query_cache_invalidate3(A, B, C) query_cache.invalidate(A, B, C)
@@ -594,7 +743,7 @@ struct Query_cache_query_flags
 #define query_cache_store_query(A, B)     do { } while(0)
 #define query_cache_destroy()             do { } while(0)
 #define query_cache_result_size_limit(A)  do { } while(0)
-#define query_cache_init()                do { } while(0)
+#define query_cache_init(A)               do { } while(0)
 #define query_cache_resize(A)             do { } while(0)
 #define query_cache_set_min_res_unit(A)   do { } while(0)
 #define query_cache_invalidate3(A, B, C)  do { } while(0)
@@ -608,5 +757,5 @@ struct Query_cache_query_flags
 #define query_cache_is_cacheable_query(L) 0
 #endif /*HAVE_QUERY_CACHE*/
 
-extern Query_cache query_cache;
+extern Partitioned_query_cache query_cache;
 #endif
@@ -614,6 +614,7 @@ THD::THD(my_thread_id id, bool is_wsrep_applier, bool skip_global_sys_var_lock)
    m_examined_row_count(0),
    accessed_rows_and_keys(0),
    m_digest(NULL),
+   plan_cache_query_id(0), plan_cache_key_length(0),
    m_statement_psi(NULL),
    m_idle_psi(NULL),
    thread_id(id),
@@ -6702,6 +6703,7 @@ int THD::binlog_write_row(TABLE* table, bool is_trans,
   DBUG_ASSERT(is_current_stmt_binlog_format_row());
   DBUG_ASSERT((WSREP_NNULL(this) && wsrep_emulate_bin_log) ||
               mysql_bin_log.is_open());
+  binlog_writeset_add_row(table, is_trans, record, NULL, NULL);
   /*
     Pack records into format for transfer. We are allocating more
     memory than needed, but that doesn't matter.
@@ -6754,6 +6756,11 @@ int THD::binlog_update_row(TABLE* table, bool is_trans,
   */
   MY_BITMAP *old_read_set= table->read_set;
 
+  binlog_writeset_add_row(table, is_trans, before_record, table->read_set,
+                          table->write_set);
+  binlog_writeset_add_row(table, is_trans, after_record, table->read_set,
+                          table->write_set);
+
   /**
      This will remove spurious fields required during execution but
      not needed for binlogging. This is done according to the:
@@ -6833,6 +6840,8 @@ int THD::binlog_delete_row(TABLE* table, bool is_trans,
   */
   MY_BITMAP *old_read_set= table->read_set;
 
+  binlog_writeset_add_row(table, is_trans, record, table->read_set, NULL);
+
   /** 
      This will remove spurious fields required during execution but
      not needed for binlogging. This is done according to the:
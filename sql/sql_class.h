@@ -47,6 +47,7 @@
 #include <mysql_com_server.h>
 #include "session_tracker.h"
 #include "backup.h"
+#include "sql_plan_cache.h"
 
 extern "C"
 void set_thd_stage_info(void *thd,
@@ -434,6 +435,7 @@ class MY_LOCALE;
 */
 
 struct Query_cache_block;
+class Query_cache;
 
 struct Query_cache_tls
 {
@@ -442,12 +444,14 @@ struct Query_cache_tls
     functions and methods to maintain proper locking.
   */
   Query_cache_block *first_query_block;
+  /* The query cache partition of 'first_query_block' */
+  Query_cache *partition;
   void set_first_query_block(Query_cache_block *first_query_block_arg)
   {
     first_query_block= first_query_block_arg;
   }
 
-  Query_cache_tls() :first_query_block(NULL) {}
+  Query_cache_tls() :first_query_block(NULL), partition(NULL) {}
 };
 
 /* SIGNAL / RESIGNAL / GET DIAGNOSTICS */
@@ -617,11 +621,14 @@ typedef struct system_variables
   ulong column_compression_zlib_strategy;
   ulong lock_wait_timeout;
   ulong join_cache_level;
+  ulong join_buffer_spill_partitions;
   ulong max_allowed_packet;
   ulong max_error_count;
   ulong max_length_for_sort_data;
   ulong max_recursive_iterations;
+  ulong max_scan_threads;
   ulong max_sort_length;
+  ulong max_sort_threads;
   ulong max_tmp_tables;
   ulong max_insert_delayed_threads;
   ulong min_examined_row_limit;
@@ -636,6 +643,7 @@ typedef struct system_variables
   ulong optimizer_search_depth;
   ulong optimizer_selectivity_sampling_limit;
   ulong optimizer_use_condition_selectivity;
+  ulong prepared_stmt_plan_cache_replan_factor;
   ulong use_stat_tables;
   double sample_percentage;
   ulong histogram_size;
@@ -693,6 +701,8 @@ typedef struct system_variables
   my_bool old_passwords;
   my_bool big_tables;
   my_bool only_standard_compliant_cte;
+  my_bool fast_condition_evaluation;
+  my_bool prepared_stmt_plan_cache;
   my_bool query_cache_strip_comments;
   my_bool sql_log_slow;
   my_bool sql_log_bin;
@@ -850,6 +860,8 @@ typedef struct system_status_var
   ulong filesort_rows_;
   ulong filesort_scan_count_;
   ulong filesort_pq_sorts_;
+  ulong ps_plan_cache_hits;
+  ulong ps_plan_cache_replans;
 
   /* Features used */
   ulong feature_custom_aggregate_functions; /* +1 when custom aggregate
@@ -2492,6 +2504,9 @@ class THD: public THD_count, /* this must be first */
                         const uchar *buf);
   int binlog_update_row(TABLE* table, bool is_transactional,
                         const uchar *old_data, const uchar *new_data);
+  void binlog_writeset_add_row(TABLE *table, bool is_transactional,
+                               const uchar *record, const MY_BITMAP *known,
+                               const MY_BITMAP *changed);
   static void binlog_prepare_row_images(TABLE* table);
 
   void set_server_id(uint32 sid) { variables.server_id = sid; }
@@ -2974,6 +2989,14 @@ class THD: public THD_count, /* this must be first */
   unsigned char *m_token_array;
   /** Top level statement digest. */
   sql_digest_state m_digest_state;
+  /** Query the plan cache key below was computed for. */
+  query_id_t plan_cache_query_id;
+  /**
+    Plan cache key of the current statement: digest, optimizer variables
+    and database.
+  */
+  uint plan_cache_key_length;
+  uchar plan_cache_key[MD5_HASH_SIZE + PLAN_CACHE_SETTINGS_LENGTH + NAME_LEN];
 
   /** Current statement instrumentation. */
   PSI_statement_locker *m_statement_psi;
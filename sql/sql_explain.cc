@@ -1595,6 +1595,9 @@ void Explain_table_access::tag_to_json(Json_writer *writer, enum explain_extra_t
       else
         writer->add_bool(true);
       break;
+    case ET_PARALLEL_SCAN:
+      writer->add_member("parallel_threads").add_ll(parallel_scan_threads);
+      break;
 
     /*new:*/
     case ET_CONST_ROW_NOT_FOUND:
@@ -1854,6 +1857,8 @@ void Explain_table_access::print_explain_json(Explain_query *query,
     writer->add_member("join_type").add_str(bka_type.join_alg);
     if (bka_type.mrr_type.length())
       writer->add_member("mrr_type").add_str(bka_type.mrr_type);
+    if (bka_type.spill_partitions)
+      writer->add_member("spill_partitions").add_ll(bka_type.spill_partitions);
     if (where_cond)
     {
       writer->add_member("attached_condition");
@@ -1868,6 +1873,16 @@ void Explain_table_access::print_explain_json(Explain_query *query,
         writer->add_double(jbuf_tracker.get_filtered_after_where()*100.0);
       else
         writer->add_null();
+      if (jbuf_spill_tracker.has_spills())
+      {
+        writer->add_member("r_spills").add_ll(jbuf_spill_tracker.r_spills);
+        writer->add_member("r_spilled_partitions").
+          add_ll(jbuf_spill_tracker.r_partitions);
+        writer->add_member("r_spilled_outer_rows").
+          add_ll(jbuf_spill_tracker.r_outer_rows);
+        writer->add_member("r_spilled_inner_rows").
+          add_ll(jbuf_spill_tracker.r_inner_rows);
+      }
     }
   }
 
@@ -1949,6 +1964,8 @@ const char * extra_tag_text[]=
   "Const row not found",
   "Unique row not found",
   "Impossible ON condition",
+
+  "Parallel scan", // special handling
 };
 
 
@@ -1987,6 +2004,12 @@ void Explain_table_access::append_tag_name(String *str, enum explain_extra_tag t
       str->append(STRING_WITH_LEN(", "));
       str->append(bka_type.join_alg);
       str->append(STRING_WITH_LEN(" join"));
+      if (bka_type.spill_partitions)
+      {
+        str->append(STRING_WITH_LEN(", "));
+        str->append_ulonglong(bka_type.spill_partitions);
+        str->append(STRING_WITH_LEN(" spill partitions"));
+      }
       str->append(STRING_WITH_LEN(")"));
       if (bka_type.mrr_type.length())
       {
@@ -2015,6 +2038,14 @@ void Explain_table_access::append_tag_name(String *str, enum explain_extra_tag t
         str->append(" (scanning)");
       break;
     }
+    case ET_PARALLEL_SCAN:
+    {
+      str->append(extra_tag_text[tag]);
+      str->append(STRING_WITH_LEN(" ("));
+      str->append_ulonglong(parallel_scan_threads);
+      str->append(STRING_WITH_LEN(" threads)"));
+      break;
+    }
     default:
      str->append(extra_tag_text[tag]);
   }
@@ -548,6 +548,8 @@ enum explain_extra_tag
   ET_UNIQUE_ROW_NOT_FOUND,
   ET_IMPOSSIBLE_ON_CONDITION,
 
+  ET_PARALLEL_SCAN,
+
   ET_total
 };
 
@@ -559,7 +561,7 @@ enum explain_extra_tag
 class EXPLAIN_BKA_TYPE
 {
 public:
-  EXPLAIN_BKA_TYPE() : join_alg(NULL) {}
+  EXPLAIN_BKA_TYPE() : join_alg(NULL), spill_partitions(0) {}
 
   size_t join_buffer_size;
 
@@ -573,6 +575,12 @@ class EXPLAIN_BKA_TYPE
 
   /* Information about MRR usage.  */
   StringBuffer<64> mrr_type;
+
+  /*
+    Number of partitions the records are spilled into when they do not
+    fit into the join buffer (0 means the join buffer never spills).
+  */
+  uint spill_partitions;
   
   bool is_using_jbuf() { return (join_alg != NULL); }
 };
@@ -722,6 +730,7 @@ class Explain_table_access : public Sql_alloc
     extra_tags(root),
     range_checked_fer(NULL),
     full_scan_on_null_key(false),
+    parallel_scan_threads(0),
     start_dups_weedout(false),
     end_dups_weedout(false),
     where_cond(NULL),
@@ -803,6 +812,9 @@ class Explain_table_access : public Sql_alloc
   // valid with ET_USING_JOIN_BUFFER
   EXPLAIN_BKA_TYPE bka_type;
 
+  // valid with ET_PARALLEL_SCAN
+  uint parallel_scan_threads;
+
   bool start_dups_weedout;
   bool end_dups_weedout;
   
@@ -835,6 +847,7 @@ class Explain_table_access : public Sql_alloc
   Table_access_tracker tracker;
   Exec_time_tracker op_tracker;
   Table_access_tracker jbuf_tracker;
+  Join_spill_tracker jbuf_spill_tracker;
   
   Explain_rowid_filter *rowid_filter;
 
@@ -35,6 +35,9 @@
 
 #define NO_MORE_RECORDS_IN_BUFFER  (uint)(-1)
 
+/* Size of the buffer of each temporary file used by a spilling BNLH cache */
+#define JOIN_SPILL_BUFF_SIZE  (IO_SIZE*4)
+
 static void save_or_restore_used_tabs(JOIN_TAB *join_tab, bool save);
 
 /*****************************************************************************
@@ -3113,6 +3116,23 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
 } 
 
 
+/* Calculate the hash value of a key considering it as a byte array */
+
+static inline ulong key_hash_simple(uchar *key, uint key_len)
+{
+  ulong nr= 1;
+  ulong nr2= 4;
+  uchar *pos= key;
+  uchar *end= key+key_len;
+  for (; pos < end ; pos++)
+  {
+    nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
+    nr2+= 3;
+  }
+  return nr;
+}
+
+
 /* 
   Hash function that considers a key in the hash table as byte array
 
@@ -3133,16 +3153,7 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
 inline
 uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
 {
-  ulong nr= 1;
-  ulong nr2= 4;
-  uchar *pos= key;
-  uchar *end= key+key_len;
-  for (; pos < end ; pos++)
-  {
-    nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
-    nr2+= 3;
-  }
-  return nr % hash_entries;
+  return key_hash_simple(key, key_len) % hash_entries;
 }
 
 
@@ -3177,6 +3188,31 @@ uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
 }
 
 
+/* 
+  Calculate the hash value of a key used by the hash function of the cache
+
+  SYNOPSIS
+    get_key_hash()
+      key             pointer to the key value
+      key_len         key value length
+      
+  DESCRIPTION
+    The function returns the value that the hash function hash_func of the
+    cache reduces modulo the number of hash entries. Equal keys get the same
+    value even if they differ as byte sequences.
+
+  RETURN VALUE
+    the calculated hash value for the given key  
+*/
+
+ulong JOIN_CACHE_HASHED::get_key_hash(uchar *key, uint key_len)
+{
+  if (hash_func == &JOIN_CACHE_HASHED::get_hash_idx_complex)
+    return key_hashnr(ref_key_info, ref_used_key_parts, key);
+  return key_hash_simple(key, key_len);
+}
+
+
 /* 
   Compare two key entries in the hash table as sequence of bytes
 
@@ -3652,6 +3688,9 @@ uchar *JOIN_CACHE_BNLH::get_matching_chain_by_join_key()
   KEY *keyinfo= join_tab->get_keyinfo_by_key_no(ref->key);
   /* Build the join key value out of the record in the record buffer */
   key_copy(key_buff, table->record[0], keyinfo, key_length, TRUE);
+  /* Save the row for the records that have not fit into the join buffer */
+  if (spill_state == SPILL_INNER && spill_inner_record(key_buff))
+    spill_error= TRUE;
   /* Look for this key in the join buffer */
   if (!key_search(key_buff, key_length, &key_ref_ptr))
     return 0;
@@ -3795,6 +3834,9 @@ void JOIN_CACHE_BNLH::read_next_candidate_for_match(uchar *rec_ptr)
   NOTES
     The function first constructs a companion object of the type JOIN_TAB_SCAN,
     then it calls the init method of the parent class.
+    If the records of the cache can be spilled into temporary files the
+    function finally constructs the object of the type JOIN_TAB_SCAN_SPILLED
+    that is used to read the rows of join_tab back from these files.
     
   RETURN VALUE  
     0   initialization with buffer allocations has been succeeded
@@ -3803,12 +3845,505 @@ void JOIN_CACHE_BNLH::read_next_candidate_for_match(uchar *rec_ptr)
 
 int JOIN_CACHE_BNLH::init(bool for_explain)
 {
+  int rc;
   DBUG_ENTER("JOIN_CACHE_BNLH::init");
 
   if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
     DBUG_RETURN(1);
 
-  DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
+  if ((rc= JOIN_CACHE_HASHED::init(for_explain)))
+    DBUG_RETURN(rc);
+
+  spill_partitions= 0;
+  if (can_spill())
+  {
+    if (!(spill_scan= new JOIN_TAB_SCAN_SPILLED(join, join_tab)))
+      DBUG_RETURN(1);
+    spill_partitions= (uint) join->thd->variables.join_buffer_spill_partitions;
+  }
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Check whether the records of the BNLH join cache can be spilled
+
+  SYNOPSIS
+    can_spill()
+
+  DESCRIPTION
+    The function checks whether the records that do not fit into the join
+    buffer can be distributed over temporary files by their join keys, and
+    be joined with the rows of join_tab partition by partition.
+    This is possible only if the cache is not linked, the records and the
+    rows are completely contained in the record buffers of their tables
+    (no blobs, no rowids), and join_tab is not accessed by a range access
+    method chosen for each record.
+
+  RETURN VALUE
+    TRUE    the records can be spilled
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::can_spill()
+{
+  JOIN_TAB *tab;
+
+  if (!join->thd->variables.join_buffer_spill_partitions ||
+      get_join_alg() != BNLH_JOIN_ALG || prev_cache ||
+      join_tab->use_quick == 2 || join_tab->keep_current_rowid ||
+      join_tab->table->s->blob_fields)
+    return FALSE;
+  if (join_tab->first_inner && join_tab->first_inner != join_tab->last_inner)
+    return FALSE;
+  for (tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    if (tab->keep_current_rowid || tab->table->s->blob_fields)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+
+/*
+  Start spilling the records of the BNLH join cache into temporary files
+
+  SYNOPSIS
+    start_spill()
+
+  DESCRIPTION
+    The function is called when the join buffer has been filled up for the
+    first time. It opens the spill files if they have not been opened yet,
+    or prepares them for writing from the beginning otherwise.
+    The join of the records from the join buffer that follows writes all
+    rows of join_tab into the files inner_spill_files, after which all
+    remaining records are written into the files outer_spill_files.
+
+  RETURN VALUE
+    FALSE   the files are ready to be written into
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::start_spill()
+{
+  uint i;
+  DBUG_ENTER("JOIN_CACHE_BNLH::start_spill");
+
+  if (!outer_spill_files)
+  {
+    if (!my_multi_malloc(MYF(MY_WME | MY_THREAD_SPECIFIC),
+                         &outer_spill_files, sizeof(IO_CACHE)*spill_partitions,
+                         &inner_spill_files, sizeof(IO_CACHE)*spill_partitions,
+                         &outer_spill_rows, sizeof(ha_rows)*spill_partitions,
+                         &inner_spill_rows, sizeof(ha_rows)*spill_partitions,
+                         NullS))
+      DBUG_RETURN(TRUE);
+    bzero(outer_spill_files, sizeof(IO_CACHE)*spill_partitions);
+    bzero(inner_spill_files, sizeof(IO_CACHE)*spill_partitions);
+  }
+
+  for (i= 0; i < spill_partitions; i++)
+  {
+    IO_CACHE *files[2]= { outer_spill_files+i, inner_spill_files+i };
+    for (uint j= 0; j < 2; j++)
+    {
+      if (my_b_inited(files[j]) ?
+          reinit_io_cache(files[j], WRITE_CACHE, 0L, 0, 1) :
+          open_cached_file(files[j], mysql_tmpdir, TEMP_PREFIX,
+                           JOIN_SPILL_BUFF_SIZE, MYF(MY_WME)))
+        DBUG_RETURN(TRUE);
+    }
+    outer_spill_rows[i]= inner_spill_rows[i]= 0;
+  }
+
+  join_tab->jbuf_spill_tracker->r_spills++;
+  spill_state= SPILL_INNER;
+  spill_error= FALSE;
+  DBUG_RETURN(FALSE);
+}
+
+
+/* Stop spilling the records of the BNLH join cache */
+
+void JOIN_CACHE_BNLH::end_spill()
+{
+  spill_state= SPILL_NONE;
+  spill_error= FALSE;
+}
+
+
+/*
+  Write the record from the record buffers into a spill file
+
+  SYNOPSIS
+    spill_outer_record()
+
+  DESCRIPTION
+    The function writes the images of the record buffers of the tables
+    preceding join_tab into the spill file of the partition that is
+    determined by the join key built out of these record buffers.
+
+  RETURN VALUE
+    FALSE   the record has been written
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::spill_outer_record()
+{
+  JOIN_TAB *tab;
+  IO_CACHE *file;
+  uint part;
+  TABLE_REF *ref= &join_tab->ref;
+
+  cp_buffer_from_ref(join->thd, join_tab->table, ref);
+  part= get_spill_part(ref->key_buff);
+  file= outer_spill_files+part;
+  for (tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    TABLE *table= tab->table;
+    uchar null_row= (uchar) table->null_row;
+    if (my_b_write(file, table->record[0], table->s->reclength) ||
+        my_b_write(file, &null_row, 1))
+      return TRUE;
+  }
+  outer_spill_rows[part]++;
+  join_tab->jbuf_spill_tracker->r_outer_rows++;
+  return FALSE;
+}
+
+
+/*
+  Write the row of join_tab from its record buffer into a spill file
+
+  SYNOPSIS
+    spill_inner_record()
+      key    the join key built out of the row 
+
+  RETURN VALUE
+    FALSE   the row has been written
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::spill_inner_record(uchar *key)
+{
+  TABLE *table= join_tab->table;
+  uint part= get_spill_part(key);
+
+  if (my_b_write(inner_spill_files+part, table->record[0],
+                 table->s->reclength))
+    return TRUE;
+  inner_spill_rows[part]++;
+  join_tab->jbuf_spill_tracker->r_inner_rows++;
+  return FALSE;
+}
+
+
+/*
+  Read the record written by spill_outer_record back into the record buffers
+
+  SYNOPSIS
+    read_spilled_outer_record()
+      file   the spill file to read the record from
+
+  RETURN VALUE
+    FALSE   the record has been read
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::read_spilled_outer_record(IO_CACHE *file)
+{
+  JOIN_TAB *tab;
+
+  for (tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    TABLE *table= tab->table;
+    uchar null_row;
+    if (my_b_read(file, table->record[0], table->s->reclength) ||
+        my_b_read(file, &null_row, 1))
+      return TRUE;
+    table->null_row= MY_TEST(null_row);
+  }
+  return FALSE;
+}
+
+
+/*
+  Add a record into the BNLH join buffer or into a spill file
+
+  SYNOPSIS
+    put_record()
+
+  DESCRIPTION
+    This implementation of the virtual function put_record writes the record
+    into a spill file if the join buffer has already been overflown and joined.
+    Otherwise it adds the record into the join buffer. If the join buffer
+    gets full for the first time and the records can be spilled the function
+    starts spilling.
+
+  RETURN VALUE
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer, or the record could not be spilled
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::put_record()
+{
+  bool is_full;
+
+  if (spill_state == SPILL_OUTER)
+  {
+    if (spill_outer_record())
+    {
+      spill_error= TRUE;
+      return TRUE;
+    }
+    return FALSE;
+  }
+
+  is_full= JOIN_CACHE_HASHED::put_record();
+  if (is_full && spill_partitions && spill_state == SPILL_NONE &&
+      !next_cache && start_spill())
+    spill_error= TRUE;
+  return is_full;
+}
+
+
+/*
+  Join records from the join buffer and the spill files with join_tab rows
+
+  SYNOPSIS
+    join_records()
+      skip_last    do not find matches for the last record from the buffer
+
+  DESCRIPTION
+    Unless the join buffer has been overflown this implementation of the
+    virtual function join_records just calls the implementation of the
+    base class.
+    When the buffer has been filled up for the first time the function
+    joins the records from the buffer with the rows of join_tab, writing
+    these rows into the partitioned spill files as a side effect of the
+    scan. All records that come after that are written into the spill
+    files as well, and are joined partition by partition when the function
+    is called at the end of the records.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state, except NESTED_LOOP_NO_MORE_ROWS.
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_records(bool skip_last)
+{
+  enum_nested_loop_state rc;
+  DBUG_ENTER("JOIN_CACHE_BNLH::join_records");
+
+  switch (spill_state) {
+  case SPILL_NONE:
+    break;
+  case SPILL_INNER:
+    rc= JOIN_CACHE::join_records(skip_last);
+    if (spill_error)
+      rc= NESTED_LOOP_ERROR;
+    if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+      end_spill();
+    else
+      spill_state= SPILL_OUTER;
+    DBUG_RETURN(rc);
+  case SPILL_OUTER:
+    DBUG_RETURN(join_spilled_records());
+  }
+
+  if (spill_error)
+  {
+    end_spill();
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+  }
+  DBUG_RETURN(JOIN_CACHE::join_records(skip_last));
+}
+
+
+/*
+  Join the records from the spill files partition by partition
+
+  SYNOPSIS
+    join_spilled_records()
+
+  DESCRIPTION
+    For each partition the function reads the records written into its
+    outer spill file back into the join buffer and joins them with the rows
+    of join_tab read from the inner spill file of the partition. If the
+    records of a partition do not fit into the join buffer the inner spill
+    file is read once per refill of the buffer.
+    Records of different partitions cannot match each other, so a partition
+    without rows of join_tab is skipped unless null complemented rows have
+    to be generated for its records.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_spilled_records()
+{
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  JOIN_TAB_SCAN *save_join_tab_scan= join_tab_scan;
+  bool outer_join_first_inner= join_tab->is_first_inner_for_outer_join();
+  DBUG_ENTER("JOIN_CACHE_BNLH::join_spilled_records");
+
+  if (spill_error)
+  {
+    rc= NESTED_LOOP_ERROR;
+    goto finish;
+  }
+
+  join_tab_scan= spill_scan;
+  for (curr_spill_part= 0;
+       curr_spill_part < spill_partitions;
+       curr_spill_part++)
+  {
+    IO_CACHE *file= outer_spill_files+curr_spill_part;
+    ha_rows rows= outer_spill_rows[curr_spill_part];
+
+    if (!rows ||
+        (!inner_spill_rows[curr_spill_part] && !outer_join_first_inner))
+      continue;
+    if (unlikely(join->thd->check_killed()))
+    {
+      rc= NESTED_LOOP_KILLED;
+      goto finish;
+    }
+    join_tab->jbuf_spill_tracker->r_partitions++;
+    if (reinit_io_cache(file, READ_CACHE, 0L, 0, 0))
+    {
+      rc= NESTED_LOOP_ERROR;
+      goto finish;
+    }
+    for ( ; rows; rows--)
+    {
+      if (read_spilled_outer_record(file))
+      {
+        rc= NESTED_LOOP_ERROR;
+        goto finish;
+      }
+      if (JOIN_CACHE_HASHED::put_record() || rows == 1)
+      {
+        rc= JOIN_CACHE::join_records(FALSE);
+        if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+          goto finish;
+      }
+    }
+  }
+  
+finish:
+  join_tab_scan= save_join_tab_scan;
+  end_spill();
+  DBUG_RETURN(rc);
+}
+
+
+/*
+  Add a comment on the join algorithm employed by the BNLH join cache
+
+  SYNOPSIS
+    save_explain_data()
+      explain   the data structure to save the comment to
+
+  DESCRIPTION
+    In addition to what the base implementation does the function saves the
+    number of partitions the records of the cache are spilled into when they
+    do not fit into the join buffer.
+
+  RETURN VALUE
+   0 ok
+   1 error
+*/
+
+bool JOIN_CACHE_BNLH::save_explain_data(EXPLAIN_BKA_TYPE *explain)
+{
+  if (JOIN_CACHE::save_explain_data(explain))
+    return 1;
+  explain->spill_partitions= next_cache ? 0 : spill_partitions;
+  return 0;
+}
+
+
+/* Free the join buffer and close the spill files of the BNLH join cache */
+
+void JOIN_CACHE_BNLH::free()
+{
+  if (outer_spill_files)
+  {
+    for (uint i= 0; i < spill_partitions; i++)
+    {
+      close_cached_file(outer_spill_files+i);
+      close_cached_file(inner_spill_files+i);
+    }
+    my_free(outer_spill_files);
+    outer_spill_files= 0;
+  }
+  end_spill();
+  JOIN_CACHE::free();
+}
+
+
+/* 
+  Initiate the iteration over the rows of join_tab from a spill file
+
+  SYNOPSIS
+    open()
+
+  DESCRIPTION
+    The function prepares the inner spill file of the partition being joined
+    by the BNLH join cache for reading from the beginning.
+
+  RETURN VALUE   
+    0            the initiation is a success 
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_SPILLED::open()
+{
+  JOIN_CACHE_BNLH *bnlh= (JOIN_CACHE_BNLH *) cache;
+  uint part= bnlh->curr_spill_part;
+
+  save_or_restore_used_tabs(join_tab, FALSE);
+  rows_left= bnlh->inner_spill_rows[part];
+  return reinit_io_cache(bnlh->inner_spill_files+part, READ_CACHE, 0L, 0, 0);
+}
+
+
+/* 
+  Read the next row of join_tab from a spill file
+
+  SYNOPSIS
+    next()
+
+  DESCRIPTION
+    The function reads the next row from the inner spill file of the
+    partition being joined into the record buffer of join_tab. The rows
+    in the file have already been checked against the condition pushed
+    to join_tab.
+
+  RETURN VALUE   
+    0            the next row has been successfully read 
+    -1           there are no more rows in the file
+    1            the row could not be read
+*/
+
+int JOIN_TAB_SCAN_SPILLED::next()
+{
+  JOIN_CACHE_BNLH *bnlh= (JOIN_CACHE_BNLH *) cache;
+  TABLE *table= join_tab->table;
+
+  if (!rows_left)
+    return -1;
+  rows_left--;
+  if (my_b_read(bnlh->inner_spill_files+bnlh->curr_spill_part,
+                table->record[0], table->s->reclength))
+    return 1;
+  table->status= 0;
+  table->null_row= 0;
+  return 0;
 }
 
 
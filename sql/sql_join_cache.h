@@ -659,7 +659,7 @@ class JOIN_CACHE :public Sql_alloc
   }
      
   /* Join records from the join buffer with records from the next join table */ 
-  enum_nested_loop_state join_records(bool skip_last);
+  virtual enum_nested_loop_state join_records(bool skip_last);
 
   /* Add a comment on the join algorithm employed by the join cache */
   virtual bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
@@ -668,7 +668,7 @@ class JOIN_CACHE :public Sql_alloc
 
   virtual ~JOIN_CACHE() {}
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -972,6 +972,9 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* Search for a key in the hash table of the join buffer */
   bool key_search(uchar *key, uint key_len, uchar **key_ref_ptr);
 
+  /* Calculate the hash value of a key before it is mapped to a hash entry */
+  ulong get_key_hash(uchar *key, uint key_len);
+
   /* Reallocate the join buffer of a hashed join cache */
   int realloc_buffer();
 
@@ -1178,6 +1181,65 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   void read_next_candidate_for_match(uchar *rec_ptr);
 
+private:
+
+  /*
+    The number of partitions the records are distributed over by their join
+    keys when they do not fit into the join buffer. If it is 0 the records
+    never leave the join buffer.
+  */
+  uint spill_partitions;
+
+  /*
+    The phase of spilling:
+    SPILL_NONE  - all records so far have fit into the join buffer
+    SPILL_INNER - the join buffer has been filled up and is being joined
+                  while the rows of join_tab are written into the files
+                  inner_spill_files
+    SPILL_OUTER - the remaining records are written into the files
+                  outer_spill_files until the end of records is reached
+  */
+  enum { SPILL_NONE, SPILL_INNER, SPILL_OUTER } spill_state;
+
+  /* TRUE if writing into a spill file has failed */
+  bool spill_error;
+
+  /* 
+    The temporary files for the records of the tables preceding join_tab and
+    for the rows of join_tab, one file of each kind per partition
+  */
+  IO_CACHE *outer_spill_files;
+  IO_CACHE *inner_spill_files;
+  /* The number of records written into each of the files above */
+  ha_rows *outer_spill_rows;
+  ha_rows *inner_spill_rows;
+
+  /* The partition whose inner file is currently scanned by spill_scan */
+  uint curr_spill_part;
+
+  /* The iterator over the rows of join_tab from the file of curr_spill_part */
+  JOIN_TAB_SCAN *spill_scan;
+
+  bool can_spill();
+
+  uint get_spill_part(uchar *key)
+  {
+    ulonglong nr= get_key_hash(key, key_length);
+    return (uint) (((nr * 0x9E3779B97F4A7C15ULL) >> 32) % spill_partitions);
+  }
+
+  bool start_spill();
+
+  void end_spill();
+
+  bool spill_outer_record();
+
+  bool spill_inner_record(uchar *key);
+
+  bool read_spilled_outer_record(IO_CACHE *file);
+
+  enum_nested_loop_state join_spilled_records();
+
 public:
 
   /* 
@@ -1185,7 +1247,9 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), spill_partitions(0), spill_state(SPILL_NONE),
+      outer_spill_files(0), spill_scan(0) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1194,7 +1258,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), spill_partitions(0),
+      spill_state(SPILL_NONE), outer_spill_files(0), spill_scan(0) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain);
@@ -1203,6 +1268,43 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   bool is_key_access() { return TRUE; }
 
+  /* Add a record into the BNLH join buffer or into a spill file */
+  bool put_record();
+
+  /* Join the records from the join buffer and from the spill files */
+  enum_nested_loop_state join_records(bool skip_last);
+
+  /* Add a comment on the join algorithm and the spilling of records */
+  bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
+
+  void free();
+
+  friend class JOIN_TAB_SCAN_SPILLED;
+
+};
+
+
+/*
+  The class JOIN_TAB_SCAN_SPILLED is a companion class for the class
+  JOIN_CACHE_BNLH. It implements the iterator over the rows of the joined
+  table that have been written into the spill file of the partition being
+  joined. The rows are read back into the record buffer of the joined table.
+*/
+
+class JOIN_TAB_SCAN_SPILLED: public JOIN_TAB_SCAN
+{
+private:
+  /* The number of rows left to read from the spill file */
+  ha_rows rows_left;
+
+public:
+
+  JOIN_TAB_SCAN_SPILLED(JOIN *j, JOIN_TAB *tab) :JOIN_TAB_SCAN(j, tab) {}
+
+  int open();
+
+  int next();
+
 };
 
 
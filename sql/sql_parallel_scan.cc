@@ -0,0 +1,648 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "sql_select.h"
+#include "opt_range.h"
+#include "item_cmpfunc.h"                        // Cond_filter
+#include "mysqld.h"                             // key_thread_parallel_scan
+#include "sql_parallel_scan.h"
+
+/* Size of a batch of rows passed from a worker to the executing thread */
+#define PARALLEL_SCAN_BATCH_SIZE (64*1024)
+/*
+  The index is split into this many parts per thread. The workers take
+  the parts one by one, so that a worker that reads a part with few
+  matching rows takes more parts.
+*/
+#define PARALLEL_SCAN_PARTS_PER_THREAD 4
+
+
+struct Scan_part
+{
+  key_range start;                          // start.key == NULL: first key
+  key_range end;                            // end.key == NULL: last key
+};
+
+struct Scan_batch
+{
+  Scan_batch *next;
+  uchar *rows;
+  uint n_rows;
+};
+
+struct Scan_worker
+{
+  Parallel_scan *scan;
+  TABLE table;                              // Opened from the same share
+  handler *file;                            // table.file
+  pthread_t thread;
+  bool opened;
+  bool locked;
+  bool read_inited;
+  bool started;
+};
+
+
+/**
+  Check that the key parts in the first key_length bytes of a key image
+  can be compared with a row in any buffer, without Field::ptr, by the
+  worker threads. The record format of such key parts is the same as
+  their key format.
+*/
+
+static bool is_fixed_key_prefix(const KEY *key_info, uint key_length)
+{
+  const KEY_PART_INFO *part= key_info->key_part;
+  for (uint length= 0; length < key_length;
+       length+= part->store_length, part++)
+  {
+    Field *field= part->field;
+    if ((part->key_part_flag & (HA_VAR_LENGTH_PART | HA_BLOB_PART |
+                                HA_BIT_PART)) ||
+        field->cmp_type() == STRING_RESULT ||
+        field->type() == MYSQL_TYPE_BIT ||
+        part->length != field->pack_length())
+      return false;
+  }
+  return true;
+}
+
+
+/**
+  Compare the key parts of a row with a key image.
+  The same as key_cmp(), except that the row does not have to be in
+  record[0].
+*/
+
+static int cmp_row_with_key(const KEY_PART_INFO *part, const uchar *row,
+                            const uchar *key, uint key_length)
+{
+  for (const uchar *end= key + key_length; key < end;
+       key+= part->store_length, part++)
+  {
+    const uchar *value= key;
+    if (part->null_bit)
+    {
+      bool row_is_null= row[part->null_offset] & part->null_bit;
+      value++;
+      if (*key)                                 // The key value is NULL
+      {
+        if (!row_is_null)
+          return 1;
+        continue;
+      }
+      if (row_is_null)
+        return -1;
+    }
+    if (int cmp= part->field->cmp(row + part->offset, value))
+      return cmp;
+  }
+  return 0;
+}
+
+
+/** Compare the first key part of two key images. NULL is the smallest. */
+
+static int cmp_first_key_part(const KEY_PART_INFO *part,
+                              const uchar *a, const uchar *b)
+{
+  if (part->null_bit)
+  {
+    if (*a || *b)
+      return (int) *b - (int) *a;
+    a++;
+    b++;
+  }
+  return part->field->key_cmp(a, b);
+}
+
+
+/**
+  Decide whether the first non-constant table of a join is read in
+  parallel, and set JOIN_TAB::parallel_scan_threads for it.
+
+  This is called at the end of the optimization, when it is known whether
+  the order of the index is used and how the table is accessed.
+*/
+
+void choose_parallel_scan(JOIN *join)
+{
+  THD *thd= join->thd;
+  uint n_threads= (uint) thd->variables.max_scan_threads;
+
+  if (n_threads <= 1 || !join->join_tab ||
+      join->const_tables >= join->top_join_tab_count ||
+      thd->lex->sql_command != SQLCOM_SELECT || thd->in_sub_stmt ||
+      join->select_lex->master_unit() != &thd->lex->unit ||
+      join->ordered_index_usage != JOIN::ordered_index_void)
+    return;
+
+  JOIN_TAB *tab= join->join_tab + join->const_tables;
+  TABLE *table= tab->table;
+  if (tab->bush_children || !table ||
+      tab->type != JT_ALL || tab->use_quick == 2 ||
+      tab->read_first_record != join_init_read_record ||
+      tab->filesort || tab->distinct || tab->range_rowid_filter_info ||
+      tab->keep_current_rowid || tab->emb_sj_nest ||
+      tab->loosescan_match_tab ||
+      table->s->tmp_table != NO_TMP_TABLE ||
+      table->s->blob_fields || table->vfield ||
+      table->file->pushed_idx_cond || table->file->pushed_cond ||
+      (table->reginfo.lock_type != TL_READ &&
+       table->reginfo.lock_type != TL_READ_HIGH_PRIORITY))
+    return;
+
+  uint keyno;
+  if (tab->select && tab->select->quick)
+  {
+    QUICK_RANGE_SELECT *quick= (QUICK_RANGE_SELECT *) tab->select->quick;
+    QUICK_RANGE *range;
+    if (quick->get_type() != QUICK_SELECT_I::QS_TYPE_RANGE ||
+        !(range= quick->single_range()) ||
+        (range->flag & (EQ_RANGE | NULL_RANGE | GEOM_FLAG)) ||
+        !is_fixed_key_prefix(table->key_info + quick->index,
+                             range->max_length))
+      return;
+    keyno= quick->index;
+  }
+  else
+  {
+    if (table->s->primary_key == MAX_KEY ||
+        !table->file->primary_key_is_clustered() ||
+        table->file->keyread_enabled())
+      return;
+    keyno= table->s->primary_key;
+  }
+
+  /* Only indexes that start with an integer column are split */
+  if (table->key_info[keyno].key_part->field->cmp_type() != INT_RESULT ||
+      !is_fixed_key_prefix(table->key_info + keyno,
+                           table->key_info[keyno].key_part->store_length))
+    return;
+
+  tab->parallel_scan_threads= n_threads;
+}
+
+
+Parallel_scan::Parallel_scan(THD *thd_arg, TABLE *table_arg, uint keyno_arg,
+                             const Cond_filter *filter_arg)
+  :thd(thd_arg), table(table_arg), key_info(table_arg->key_info + keyno_arg),
+   keyno(keyno_arg), filter(filter_arg), workers(NULL), n_workers(0),
+   parts(NULL), n_parts(0), next_part(0), batches(NULL), rows(NULL),
+   n_batches(0), rows_per_batch(0),
+   row_length(table_arg->s->rec_buff_length), free_batches(NULL),
+   full_batches(NULL), last_full_batch(NULL), current(NULL), current_row(0),
+   running(0), error(0), aborted(false), rows_read(0), rows_returned(0)
+{
+  mysql_mutex_init(key_LOCK_parallel_scan, &LOCK_scan, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_parallel_scan_full, &COND_full, NULL);
+  mysql_cond_init(key_COND_parallel_scan_free, &COND_free, NULL);
+}
+
+
+Parallel_scan::~Parallel_scan()
+{
+  stop();
+  my_free(workers);
+  mysql_cond_destroy(&COND_free);
+  mysql_cond_destroy(&COND_full);
+  mysql_mutex_destroy(&LOCK_scan);
+}
+
+
+/**
+  Split the scan into parts at the split keys that are inside the range
+  from min_key to max_key (NULL means no limit).
+
+  The first part starts at min_key and the last one ends at max_key.
+  The other parts start at a split key and end before the next one.
+*/
+
+bool Parallel_scan::init_parts(uchar *split_keys, uint n_split_keys,
+                               const key_range *min_key,
+                               const key_range *max_key)
+{
+  const KEY_PART_INFO *first_part= key_info->key_part;
+  uint key_length= first_part->store_length;
+
+  if (!(parts= (Scan_part *) thd->calloc(sizeof(Scan_part) *
+                                         (n_split_keys + 1))))
+    return true;
+
+  Scan_part *part= parts;
+  if (min_key)
+    part->start= *min_key;
+  for (uint i= 0; i < n_split_keys; i++)
+  {
+    uchar *key= split_keys + i * key_length;
+    if ((min_key && cmp_first_key_part(first_part, key, min_key->key) <= 0) ||
+        (max_key && cmp_first_key_part(first_part, key, max_key->key) >= 0))
+      continue;
+    part->end.key= key;
+    part->end.length= key_length;
+    part->end.keypart_map= 1;
+    part->end.flag= HA_READ_BEFORE_KEY;
+    part++;
+    part->start.key= key;
+    part->start.length= key_length;
+    part->start.keypart_map= 1;
+    part->start.flag= HA_READ_KEY_OR_NEXT;
+  }
+  if (max_key)
+    part->end= *max_key;
+  n_parts= (uint) (part - parts) + 1;
+  return false;
+}
+
+
+/** Check if a row read from the index is after the end of a part */
+
+bool Parallel_scan::after_end(const key_range *end, const uchar *row) const
+{
+  int cmp= cmp_row_with_key(key_info->key_part, row, end->key, end->length);
+  return end->flag == HA_READ_BEFORE_KEY ? cmp >= 0 : cmp > 0;
+}
+
+
+const Scan_part *Parallel_scan::get_part()
+{
+  const Scan_part *part= NULL;
+  mysql_mutex_lock(&LOCK_scan);
+  if (!aborted && !error && next_part < n_parts)
+    part= parts + next_part++;
+  mysql_mutex_unlock(&LOCK_scan);
+  return part;
+}
+
+
+/**
+  Pass a full batch (if not NULL) to the executing thread, and wait for a
+  free batch.
+
+  @return The free batch, or NULL if the scan was aborted
+*/
+
+Scan_batch *Parallel_scan::next_batch(Scan_batch *full)
+{
+  Scan_batch *batch= NULL;
+  mysql_mutex_lock(&LOCK_scan);
+  if (full)
+  {
+    full->next= NULL;
+    if (last_full_batch)
+      last_full_batch->next= full;
+    else
+      full_batches= full;
+    last_full_batch= full;
+    mysql_cond_signal(&COND_full);
+  }
+  while (!free_batches && !aborted)
+    mysql_cond_wait(&COND_free, &LOCK_scan);
+  if (!aborted)
+  {
+    batch= free_batches;
+    free_batches= batch->next;
+    batch->n_rows= 0;
+  }
+  mysql_mutex_unlock(&LOCK_scan);
+  return batch;
+}
+
+
+void Parallel_scan::set_error(int error_arg)
+{
+  mysql_mutex_lock(&LOCK_scan);
+  if (!error)
+    error= error_arg;
+  mysql_cond_signal(&COND_full);
+  mysql_mutex_unlock(&LOCK_scan);
+}
+
+
+void Parallel_scan::run(handler *file)
+{
+  Scan_batch *batch= next_batch(NULL);
+  const Scan_part *part;
+  ha_rows n_read= 0;
+
+  while (batch && (part= get_part()))
+  {
+    uchar *row= batch->rows + batch->n_rows * row_length;
+    int res;
+    for (res= file->ha_parallel_index_read(row, part->start.key ?
+                                                &part->start : NULL);
+         !res;
+         res= file->ha_parallel_index_next(row))
+    {
+      n_read++;
+      if (part->end.key && after_end(&part->end, row))
+        break;
+      if (unlikely(aborted))
+        break;
+      if (unlikely(thd->killed))
+      {
+        res= HA_ERR_QUERY_INTERRUPTED;
+        break;
+      }
+      if (filter &&
+          !filter->is_true_compiled(table, row - table->record[0]))
+        continue;
+      if (++batch->n_rows == rows_per_batch && !(batch= next_batch(batch)))
+        break;
+      row= batch->rows + batch->n_rows * row_length;
+    }
+    if (res && res != HA_ERR_END_OF_FILE && res != HA_ERR_KEY_NOT_FOUND)
+    {
+      set_error(res);
+      break;
+    }
+  }
+
+  mysql_mutex_lock(&LOCK_scan);
+  if (batch && batch->n_rows)
+  {
+    batch->next= NULL;
+    if (last_full_batch)
+      last_full_batch->next= batch;
+    else
+      full_batches= batch;
+    last_full_batch= batch;
+  }
+  else if (batch)
+  {
+    batch->next= free_batches;
+    free_batches= batch;
+  }
+  rows_read+= n_read;
+  running--;
+  mysql_cond_signal(&COND_full);
+  mysql_mutex_unlock(&LOCK_scan);
+}
+
+
+pthread_handler_t parallel_scan_thread(void *arg)
+{
+  Scan_worker *worker= (Scan_worker *) arg;
+  my_thread_init();
+  worker->scan->run(worker->file);
+  my_thread_end();
+  return 0;
+}
+
+
+int Parallel_scan::start(JOIN_TAB *tab, Parallel_scan **scan)
+{
+  THD *thd= tab->join->thd;
+  TABLE *table= tab->table;
+  QUICK_RANGE *range= NULL;
+  uint keyno= table->s->primary_key;
+  DBUG_ENTER("Parallel_scan::start");
+
+  if (tab->select && tab->select->quick)
+  {
+    QUICK_RANGE_SELECT *quick= (QUICK_RANGE_SELECT *) tab->select->quick;
+    if (quick->get_type() != QUICK_SELECT_I::QS_TYPE_RANGE ||
+        !(range= quick->single_range()))
+      DBUG_RETURN(-1);
+    keyno= quick->index;
+  }
+
+  KEY *key_info= table->key_info + keyno;
+  uint key_length= key_info->key_part->store_length;
+  uint max_keys= tab->parallel_scan_threads *
+                 PARALLEL_SCAN_PARTS_PER_THREAD - 1;
+  uchar *split_keys;
+  uint n_split_keys;
+  if (!(split_keys= (uchar *) thd->alloc(max_keys * key_length)))
+    DBUG_RETURN(1);
+  if (!(n_split_keys= table->file->split_index(keyno, max_keys, split_keys)))
+    DBUG_RETURN(-1);
+
+  key_range min_key, max_key;
+  key_range *min= NULL, *max= NULL;
+  if (range && !(range->flag & NO_MIN_RANGE))
+  {
+    range->make_min_endpoint(&min_key);
+    min= &min_key;
+  }
+  if (range && !(range->flag & NO_MAX_RANGE))
+  {
+    range->make_max_endpoint(&max_key);
+    max= &max_key;
+  }
+
+  Parallel_scan *ps;
+  if (!(ps= new Parallel_scan(thd, table, keyno,
+                              tab->select_cond ?
+                              tab->get_cond_filter(thd) : NULL)))
+    DBUG_RETURN(1);
+  if (ps->init_parts(split_keys, n_split_keys, min, max))
+  {
+    delete ps;
+    DBUG_RETURN(1);
+  }
+  if (ps->n_parts == 1)
+  {
+    /* All split keys were outside of the range */
+    delete ps;
+    DBUG_RETURN(-1);
+  }
+
+  uint n_threads= MY_MIN(tab->parallel_scan_threads, ps->n_parts);
+  ps->rows_per_batch= MY_MAX(PARALLEL_SCAN_BATCH_SIZE / ps->row_length, 1);
+  ps->n_batches= 2 * n_threads + 1;
+  if (!my_multi_malloc(MYF(MY_WME | MY_THREAD_SPECIFIC),
+                       &ps->workers, n_threads * sizeof(Scan_worker),
+                       &ps->batches, ps->n_batches * sizeof(Scan_batch),
+                       &ps->rows, ((size_t) ps->n_batches *
+                                   ps->rows_per_batch * ps->row_length),
+                       NullS))
+  {
+    delete ps;
+    DBUG_RETURN(1);
+  }
+
+  for (uint i= 0; i < ps->n_batches; i++)
+  {
+    Scan_batch *batch= ps->batches + i;
+    batch->rows= ps->rows + (size_t) i * ps->rows_per_batch * ps->row_length;
+    batch->n_rows= 0;
+    batch->next= ps->free_batches;
+    ps->free_batches= batch;
+    /* Columns that the engine does not read keep their default value */
+    for (uint row= 0; row < ps->rows_per_batch; row++)
+      memcpy(batch->rows + row * ps->row_length, table->s->default_values,
+             ps->row_length);
+  }
+
+  /*
+    Open, lock and initialize the tables of the workers here, as the
+    engine may use the THD and the transaction when doing so. Each worker
+    has a TABLE of its own, so that the handler does not update the
+    TABLE of the statement.
+  */
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Scan_worker *worker= ps->workers + i;
+    int res;
+    worker->scan= ps;
+    worker->opened= worker->locked= worker->read_inited= false;
+    worker->started= false;
+    ps->n_workers++;
+    enum open_frm_error err;
+    if ((err= open_table_from_share(thd, table->s, &table->s->table_name,
+                                    HA_OPEN_KEYFILE | HA_TRY_READ_ONLY,
+                                    EXTRA_RECORD, thd->open_options,
+                                    &worker->table, FALSE)))
+    {
+      open_table_error(table->s, err, my_errno);
+      delete ps;
+      DBUG_RETURN(1);
+    }
+    worker->opened= true;
+    worker->file= worker->table.file;
+    worker->table.in_use= thd;
+    worker->table.reginfo.lock_type= table->reginfo.lock_type;
+    bitmap_copy(worker->table.read_set, table->read_set);
+    if ((res= worker->file->ha_external_lock(thd, F_RDLCK)))
+    {
+      table->file->print_error(res, MYF(0));
+      delete ps;
+      DBUG_RETURN(1);
+    }
+    worker->locked= true;
+    if (table->file->keyread_enabled())
+      worker->file->ha_start_keyread(keyno);
+    if ((res= worker->file->ha_index_init(keyno, false)) ||
+        (res= worker->file->parallel_read_init()))
+    {
+      table->file->print_error(res, MYF(0));
+      delete ps;
+      DBUG_RETURN(1);
+    }
+    worker->read_inited= true;
+  }
+
+  uint n_started= 0;
+  ps->running= n_threads;
+  for (uint i= 0; i < n_threads; i++)
+  {
+    Scan_worker *worker= ps->workers + i;
+    if ((worker->started= !mysql_thread_create(key_thread_parallel_scan,
+                                               &worker->thread, NULL,
+                                               parallel_scan_thread,
+                                               worker)))
+      n_started++;
+    else
+    {
+      mysql_mutex_lock(&ps->LOCK_scan);
+      ps->running--;
+      mysql_cond_signal(&ps->COND_full);
+      mysql_mutex_unlock(&ps->LOCK_scan);
+    }
+  }
+  if (!n_started)
+  {
+    /* No thread could be created */
+    delete ps;
+    DBUG_RETURN(-1);
+  }
+
+  *scan= ps;
+  DBUG_RETURN(0);
+}
+
+
+int Parallel_scan::read_next(uchar *record)
+{
+  if (!current || current_row == current->n_rows)
+  {
+    int res;
+    mysql_mutex_lock(&LOCK_scan);
+    if (current)
+    {
+      current->next= free_batches;
+      free_batches= current;
+      current= NULL;
+      mysql_cond_signal(&COND_free);
+    }
+    while (!full_batches && running && !error)
+      mysql_cond_wait(&COND_full, &LOCK_scan);
+    if (error)
+      res= error;
+    else if ((current= full_batches))
+    {
+      if (!(full_batches= current->next))
+        last_full_batch= NULL;
+      res= 0;
+    }
+    else
+      res= HA_ERR_END_OF_FILE;
+    mysql_mutex_unlock(&LOCK_scan);
+    if (res)
+      return res;
+    current_row= 0;
+  }
+  memcpy(record, current->rows + current_row++ * row_length,
+         table->s->reclength);
+  rows_returned++;
+  return 0;
+}
+
+
+/**
+  Stop the workers and close their tables.
+  The rows read are added to the statistics of the statement.
+*/
+
+void Parallel_scan::stop()
+{
+  mysql_mutex_lock(&LOCK_scan);
+  aborted= true;
+  mysql_cond_broadcast(&COND_free);
+  mysql_mutex_unlock(&LOCK_scan);
+
+  for (uint i= 0; i < n_workers; i++)
+  {
+    if (workers[i].started)
+      pthread_join(workers[i].thread, NULL);
+  }
+  for (uint i= 0; i < n_workers; i++)
+  {
+    Scan_worker *worker= workers + i;
+    if (!worker->opened)
+      continue;
+    handler *file= worker->file;
+    if (worker->read_inited)
+      file->parallel_read_end();
+    if (file->inited)
+      file->ha_index_end();
+    file->ha_end_keyread();
+    if (worker->locked)
+      file->ha_external_lock(thd, F_UNLCK);
+    closefrm(&worker->table);
+  }
+  n_workers= 0;
+
+  thd->status_var.ha_read_key_count+= next_part;
+  thd->status_var.ha_read_next_count+= rows_read;
+  table->file->rows_read+= rows_read;
+  next_part= 0;
+  rows_read= 0;
+}
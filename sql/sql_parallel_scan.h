@@ -0,0 +1,128 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef SQL_PARALLEL_SCAN_INCLUDED
+#define SQL_PARALLEL_SCAN_INCLUDED
+
+#include "my_base.h"                            /* key_range */
+
+class JOIN;
+class THD;
+class handler;
+class Cond_filter;
+struct TABLE;
+struct st_key;
+struct st_join_table;
+
+/*
+  Parallel scans
+  --------------
+
+  The first non-constant table of a SELECT that is read with a full scan of
+  a clustered primary key, or with a scan of a single index range, can be
+  read by several threads (@@max_scan_threads).
+
+  The storage engine splits the index into parts of about the same size
+  (handler::split_index()). Each thread reads the parts it takes from a
+  shared list through a TABLE and handler of its own, which must not
+  modify the THD or the transaction of the statement while the thread
+  reads (handler::parallel_read_init()). It checks the compiled
+  conjuncts of the condition attached to the table (Cond_filter), and
+  passes the rows that pass in batches to the thread executing the
+  statement. That thread returns them from READ_RECORD one by one, so the
+  rest of the execution (joins, grouping, aggregation, sorting) is not
+  changed.
+
+  The rows are returned in no particular order. A parallel scan is
+  therefore not used when the query relies on the order of the index, or
+  when a row of the table must be identified later (rowid filters,
+  duplicate weedout). If the engine cannot split the index, the table is
+  read as usual.
+*/
+
+void choose_parallel_scan(JOIN *join);
+
+struct Scan_part;
+struct Scan_batch;
+struct Scan_worker;
+
+class Parallel_scan
+{
+  THD *thd;
+  TABLE *table;
+  st_key *key_info;
+  uint keyno;
+  const Cond_filter *filter;
+
+  Scan_worker *workers;
+  uint n_workers;
+
+  /* The parts of the index, taken by the workers in order */
+  Scan_part *parts;
+  uint n_parts, next_part;
+
+  /* Batches of rows passed from the workers to the executing thread */
+  Scan_batch *batches;
+  uchar *rows;
+  uint n_batches, rows_per_batch, row_length;
+  Scan_batch *free_batches;
+  Scan_batch *full_batches, *last_full_batch;
+  Scan_batch *current;
+  uint current_row;
+
+  uint running;                                 // Workers not finished
+  int error;                                    // First error of a worker
+  volatile bool aborted;
+  ha_rows rows_read;                            // Rows read by the workers
+  ha_rows rows_returned;
+
+  mysql_mutex_t LOCK_scan;
+  mysql_cond_t COND_full;                       // A batch is full
+  mysql_cond_t COND_free;                       // A batch is free
+
+  Parallel_scan(THD *thd_arg, TABLE *table_arg, uint keyno_arg,
+                const Cond_filter *filter_arg);
+  bool init_parts(uchar *split_keys, uint n_split_keys,
+                  const key_range *min_key, const key_range *max_key);
+  bool after_end(const key_range *end, const uchar *row) const;
+  const Scan_part *get_part();
+  Scan_batch *next_batch(Scan_batch *full);
+  void set_error(int error_arg);
+  void stop();
+
+public:
+  ~Parallel_scan();
+
+  /** The body of a worker thread */
+  void run(handler *file);
+
+  /**
+    Start a parallel scan of the table of a JOIN_TAB.
+
+    @retval 0   The scan was started and *scan is set
+    @retval -1  The table cannot be read in parallel, read it as usual
+    @retval 1   Error
+  */
+  static int start(st_join_table *tab, Parallel_scan **scan);
+
+  /**
+    Read the next row into record.
+    @return 0, HA_ERR_END_OF_FILE or a handler error
+  */
+  int read_next(uchar *record);
+};
+
+#endif /* SQL_PARALLEL_SCAN_INCLUDED */
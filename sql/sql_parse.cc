@@ -28,6 +28,7 @@
                               // close_thread_tables, is_temporary_table
                               // table_cache.h
 #include "sql_cache.h"        // QUERY_CACHE_FLAGS_SIZE, query_cache_*
+#include "sql_plan_cache.h"   // plan_cache_size
 #include "sql_show.h"         // mysqld_list_*, mysqld_show_*,
                               // calc_sum_of_all_status
 #include "mysqld.h"
@@ -10185,6 +10186,13 @@ bool parse_sql(THD *thd, Parser_state *parser_state,
       parser_state->m_lip.m_digest= thd->m_digest;
       parser_state->m_lip.m_digest->m_digest_storage.m_charset_number= thd->charset()->number;
     }
+    else if (plan_cache_size && thd->m_digest)
+    {
+      /* The plan cache uses the digest as the key of the statement */
+      thd->m_digest->reset(thd->m_token_array, max_digest_length);
+      parser_state->m_lip.m_digest= thd->m_digest;
+      parser_state->m_lip.m_digest->m_digest_storage.m_charset_number= thd->charset()->number;
+    }
   }
 
   /* Parse the query. */
@@ -0,0 +1,403 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "sql_select.h"
+#include "sql_show.h"                           // schema_table_store_record
+#include "sql_acl.h"                            // check_global_access
+#include "sql_plist.h"
+#include "sql_digest.h"                         // compute_digest_md5
+#include "my_md5.h"
+#include "sql_plan_cache.h"
+
+
+/** Join order of one SELECT of a cached statement */
+
+struct Plan_cache_select
+{
+  Plan_cache_select *next;
+  uint select_number;
+  size_t memory;                      /* Size of this object and its arrays */
+  Join_plan_cache plan;
+};
+
+
+/** A cached statement */
+
+struct Plan_cache_entry
+{
+  Plan_cache_entry *next, **prev;     /* LRU list, most recently used last */
+  Plan_cache_select *selects;
+  size_t memory;                      /* Size of the entry and its SELECTs */
+  ulonglong hits;
+  ulonglong replans;
+  uint key_length;
+  uchar key[1];                       /* Digest, settings and database */
+};
+
+
+typedef I_P_List<Plan_cache_entry,
+                 I_P_List_adapter<Plan_cache_entry, &Plan_cache_entry::next,
+                                  &Plan_cache_entry::prev>,
+                 I_P_List_null_counter,
+                 I_P_List_fast_push_back<Plan_cache_entry> >
+        Plan_cache_lru;
+
+
+ulonglong plan_cache_size;
+
+static bool plan_cache_inited;
+/** Protects all of the below and the cached entries */
+static mysql_mutex_t LOCK_plan_cache;
+static HASH plan_cache;
+static Plan_cache_lru plan_cache_lru;
+static ulonglong plan_cache_used;
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_LOCK_plan_cache;
+static PSI_mutex_info all_plan_cache_mutexes[]=
+{
+  { &key_LOCK_plan_cache, "LOCK_plan_cache", PSI_FLAG_GLOBAL }
+};
+#endif
+
+
+static uchar *plan_cache_get_key(const uchar *record, size_t *length,
+                                 my_bool)
+{
+  Plan_cache_entry *entry= (Plan_cache_entry*) record;
+  *length= entry->key_length;
+  return entry->key;
+}
+
+
+static void plan_cache_free_entry(void *record)
+{
+  Plan_cache_entry *entry= (Plan_cache_entry*) record;
+  Plan_cache_select *select, *next;
+
+  for (select= entry->selects; select; select= next)
+  {
+    next= select->next;
+    my_free(select);
+  }
+  my_free(entry);
+}
+
+
+void plan_cache_init()
+{
+#ifdef HAVE_PSI_INTERFACE
+  mysql_mutex_register("sql", all_plan_cache_mutexes,
+                       array_elements(all_plan_cache_mutexes));
+#endif
+  mysql_mutex_init(key_LOCK_plan_cache, &LOCK_plan_cache, MY_MUTEX_INIT_FAST);
+  my_hash_init(&plan_cache, &my_charset_bin, 64, 0, 0, plan_cache_get_key,
+               plan_cache_free_entry, 0);
+  plan_cache_lru.empty();
+  plan_cache_used= 0;
+  plan_cache_inited= true;
+}
+
+
+void plan_cache_destroy()
+{
+  if (plan_cache_inited)
+  {
+    plan_cache_inited= false;
+    plan_cache_lru.empty();
+    my_hash_free(&plan_cache);
+    mysql_mutex_destroy(&LOCK_plan_cache);
+  }
+}
+
+
+/**
+  Evict the least recently used statements until the cache takes at most
+  size bytes.
+*/
+
+static void plan_cache_evict(ulonglong size)
+{
+  Plan_cache_entry *entry;
+
+  mysql_mutex_assert_owner(&LOCK_plan_cache);
+  while (plan_cache_used > size && (entry= plan_cache_lru.pop_front()))
+  {
+    plan_cache_used-= entry->memory;
+    my_hash_delete(&plan_cache, (uchar*) entry);
+  }
+}
+
+
+void plan_cache_resize(ulonglong new_size)
+{
+  mysql_mutex_lock(&LOCK_plan_cache);
+  plan_cache_evict(new_size);
+  mysql_mutex_unlock(&LOCK_plan_cache);
+}
+
+
+/**
+  Compute the key of the current statement, if it may be cached.
+
+  A join order chosen with other optimizer variables may not be the one
+  the current values would choose, or may not even be allowed (e.g. a
+  join buffer with join_cache_level=0), so the variables which change
+  the join order search are part of the key.
+*/
+
+bool plan_cache_key(THD *thd)
+{
+  if (thd->plan_cache_query_id != thd->query_id)
+  {
+    sql_digest_state *digest= thd->m_digest;
+
+    thd->plan_cache_query_id= thd->query_id;
+    thd->plan_cache_key_length= 0;
+    if (plan_cache_size && digest && !digest->is_empty() &&
+        !digest->m_digest_storage.m_full)
+    {
+      uchar *pos= thd->plan_cache_key;
+      compute_digest_md5(&digest->m_digest_storage, pos);
+      pos+= MD5_HASH_SIZE;
+      int8store(pos, thd->variables.optimizer_switch);
+      int8store(pos + 8, (ulonglong) thd->variables.join_cache_level);
+      int8store(pos + 16, (ulonglong) thd->variables.optimizer_prune_level);
+      int8store(pos + 24, (ulonglong) thd->variables.optimizer_search_depth);
+      int8store(pos + 32,
+                (ulonglong) thd->variables.optimizer_use_condition_selectivity);
+      pos+= PLAN_CACHE_SETTINGS_LENGTH;
+      if (thd->db.length)
+        memcpy(pos, thd->db.str, thd->db.length);
+      thd->plan_cache_key_length= (uint) (pos - thd->plan_cache_key) +
+                                  (uint) thd->db.length;
+    }
+  }
+  return thd->plan_cache_key_length != 0;
+}
+
+
+static Plan_cache_select *plan_cache_search(THD *thd, uint select_number,
+                                            Plan_cache_entry **entry)
+{
+  Plan_cache_select *select;
+
+  mysql_mutex_assert_owner(&LOCK_plan_cache);
+  if (!(*entry= (Plan_cache_entry*) my_hash_search(&plan_cache,
+                                                   thd->plan_cache_key,
+                                                   thd->plan_cache_key_length)))
+    return NULL;
+  for (select= (*entry)->selects; select; select= select->next)
+  {
+    if (select->select_number == select_number)
+      break;
+  }
+  return select;
+}
+
+
+Join_plan_cache *plan_cache_find(JOIN *join)
+{
+  THD *thd= join->thd;
+  uint size= join->table_count;
+  Join_plan_cache *copy;
+  Plan_cache_entry *entry;
+  Plan_cache_select *select;
+  bool found= false;
+
+  if (!(copy= new (thd->mem_root) Join_plan_cache) ||
+      !multi_alloc_root(thd->mem_root,
+                        &copy->order, sizeof(uint) * size,
+                        &copy->versions, sizeof(ulong) * size,
+                        &copy->records, sizeof(double) * size,
+                        NullS))
+    return NULL;
+  copy->size= size;
+
+  mysql_mutex_lock(&LOCK_plan_cache);
+  if ((select= plan_cache_search(thd, join->select_lex->select_number,
+                                 &entry)) &&
+      select->plan.n_tables <= size)
+  {
+    Join_plan_cache *plan= &select->plan;
+    copy->const_tables= plan->const_tables;
+    copy->n_tables= plan->n_tables;
+    memcpy(copy->order, plan->order, sizeof(uint) * plan->n_tables);
+    memcpy(copy->versions, plan->versions, sizeof(ulong) * plan->n_tables);
+    memcpy(copy->records, plan->records, sizeof(double) * plan->n_tables);
+    found= true;
+  }
+  mysql_mutex_unlock(&LOCK_plan_cache);
+  return found ? copy : NULL;
+}
+
+
+void plan_cache_hit(JOIN *join)
+{
+  THD *thd= join->thd;
+  Plan_cache_entry *entry;
+
+  mysql_mutex_lock(&LOCK_plan_cache);
+  if (plan_cache_search(thd, join->select_lex->select_number, &entry))
+  {
+    entry->hits++;
+    plan_cache_lru.remove(entry);
+    plan_cache_lru.push_back(entry);
+  }
+  mysql_mutex_unlock(&LOCK_plan_cache);
+}
+
+
+void plan_cache_store(JOIN *join)
+{
+  THD *thd= join->thd;
+  uint n_tables= join->table_count - join->const_tables;
+  size_t memory= sizeof(Plan_cache_select) +
+                 n_tables * (sizeof(double) + sizeof(ulong) + sizeof(uint));
+  Plan_cache_select *select, *old;
+  Plan_cache_entry *entry;
+
+  if (!(select= (Plan_cache_select*) my_malloc(memory, MYF(0))))
+    return;
+  select->select_number= join->select_lex->select_number;
+  select->memory= memory;
+  select->plan.size= n_tables;
+  select->plan.records= (double*) (select + 1);
+  select->plan.versions= (ulong*) (select->plan.records + n_tables);
+  select->plan.order= (uint*) (select->plan.versions + n_tables);
+  select->plan.set(join);
+
+  mysql_mutex_lock(&LOCK_plan_cache);
+  if ((old= plan_cache_search(thd, select->select_number, &entry)))
+  {
+    /* The kept order was not reused */
+    Plan_cache_select **pos;
+    for (pos= &entry->selects; *pos != old; pos= &(*pos)->next) {}
+    *pos= old->next;
+    entry->memory-= old->memory;
+    plan_cache_used-= old->memory;
+    entry->replans++;
+    my_free(old);
+  }
+  if (entry)
+    plan_cache_lru.remove(entry);
+  else
+  {
+    size_t entry_memory= sizeof(Plan_cache_entry) + thd->plan_cache_key_length;
+    if (!(entry= (Plan_cache_entry*) my_malloc(entry_memory, MYF(0))))
+      goto err;
+    entry->selects= NULL;
+    entry->memory= entry_memory;
+    entry->hits= entry->replans= 0;
+    entry->key_length= thd->plan_cache_key_length;
+    memcpy(entry->key, thd->plan_cache_key, entry->key_length);
+    if (my_hash_insert(&plan_cache, (uchar*) entry))
+    {
+      my_free(entry);
+      goto err;
+    }
+    plan_cache_used+= entry_memory;
+  }
+  select->next= entry->selects;
+  entry->selects= select;
+  entry->memory+= memory;
+  plan_cache_used+= memory;
+  plan_cache_lru.push_back(entry);
+  plan_cache_evict(plan_cache_size);
+  mysql_mutex_unlock(&LOCK_plan_cache);
+  return;
+
+err:
+  mysql_mutex_unlock(&LOCK_plan_cache);
+  my_free(select);
+}
+
+
+/** A row of INFORMATION_SCHEMA.PLAN_CACHE */
+
+struct Plan_cache_row
+{
+  char digest[MD5_HASH_SIZE * 2];
+  char db[NAME_LEN];
+  uint db_length;
+  uint selects;
+  ulonglong memory;
+  ulonglong hits;
+  ulonglong replans;
+};
+
+
+/**
+  The rows are copied under LOCK_plan_cache and stored in the table
+  after it is released, as storing may write to disk.
+*/
+
+int fill_plan_cache(THD *thd, TABLE_LIST *tables, Item *cond)
+{
+  TABLE *table= tables->table;
+  Plan_cache_lru::Iterator it(plan_cache_lru);
+  Plan_cache_entry *entry;
+  Plan_cache_row *rows, *row;
+  uint n_rows= 0;
+  int res= 0;
+  DBUG_ENTER("fill_plan_cache");
+
+  if (check_global_access(thd, PROCESS_ACL, true))
+    DBUG_RETURN(0);
+
+  mysql_mutex_lock(&LOCK_plan_cache);
+  if (!(rows= (Plan_cache_row*) thd->alloc(sizeof(Plan_cache_row) *
+                                           (plan_cache.records + 1))))
+  {
+    mysql_mutex_unlock(&LOCK_plan_cache);
+    DBUG_RETURN(1);
+  }
+  while ((entry= it++))
+  {
+    uint key_prefix= MD5_HASH_SIZE + PLAN_CACHE_SETTINGS_LENGTH;
+
+    row= &rows[n_rows++];
+    row->selects= 0;
+    for (Plan_cache_select *select= entry->selects; select;
+         select= select->next)
+      row->selects++;
+    array_to_hex(row->digest, entry->key, MD5_HASH_SIZE);
+    row->db_length= entry->key_length - key_prefix;
+    memcpy(row->db, entry->key + key_prefix, row->db_length);
+    row->memory= entry->memory;
+    row->hits= entry->hits;
+    row->replans= entry->replans;
+  }
+  mysql_mutex_unlock(&LOCK_plan_cache);
+
+  for (row= rows; row < rows + n_rows; row++)
+  {
+    restore_record(table, s->default_values);
+    table->field[0]->store(row->digest, sizeof(row->digest),
+                           system_charset_info);
+    table->field[1]->store(row->db, row->db_length, system_charset_info);
+    table->field[2]->store((longlong) row->selects, TRUE);
+    table->field[3]->store((longlong) row->memory, TRUE);
+    table->field[4]->store((longlong) row->hits, TRUE);
+    table->field[5]->store((longlong) row->replans, TRUE);
+    if ((res= schema_table_store_record(thd, table)))
+      break;
+  }
+  DBUG_RETURN(res);
+}
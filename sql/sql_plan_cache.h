@@ -0,0 +1,83 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef SQL_PLAN_CACHE_INCLUDED
+#define SQL_PLAN_CACHE_INCLUDED
+
+class JOIN;
+class THD;
+class Item;
+class Join_plan_cache;
+struct TABLE_LIST;
+
+/*
+  Plan cache
+  ----------
+
+  Text statements are parsed and optimized on every execution. The plan
+  cache keeps the join orders chosen for the SELECTs of a text statement,
+  so that a statement which differs from it only by literals does not
+  search for them again.
+
+  Statements are identified by their digest (the normalized token stream
+  with literals replaced, see sql_digest.cc), the optimizer variables
+  which change the join order search and the current database.
+  The cache holds at most @@plan_cache_size bytes, the least recently used
+  statements are evicted first. A kept join order is used as a prepared
+  statement uses its own (see Join_plan_cache): the tables are put in the
+  kept order and only the access methods are chosen. The order is not
+  used if the share of one of the tables was changed by DDL, ANALYZE
+  TABLE or FLUSH TABLES, or if the row estimates drifted, in which case
+  it is replaced by the new order.
+
+  The statement is still parsed, as the literals are needed to execute
+  it; the digest is computed while parsing. Statements with truncated
+  digests (longer than @@max_digest_length) are not cached.
+
+  INFORMATION_SCHEMA.PLAN_CACHE shows the cached statements.
+*/
+
+/**
+  Length of the optimizer variables in a plan cache key: optimizer_switch,
+  join_cache_level, optimizer_prune_level, optimizer_search_depth and
+  optimizer_use_condition_selectivity, 8 bytes each
+*/
+#define PLAN_CACHE_SETTINGS_LENGTH (5 * 8)
+
+extern ulonglong plan_cache_size;
+
+void plan_cache_init();
+void plan_cache_destroy();
+void plan_cache_resize(ulonglong new_size);
+
+/** Check that the current statement has a key in the plan cache */
+bool plan_cache_key(THD *thd);
+
+/**
+  Get a copy of the join order kept for a SELECT of the current statement.
+  @return the copy, allocated on the statement memory root, or NULL
+*/
+Join_plan_cache *plan_cache_find(JOIN *join);
+
+/** Count a reuse of the join order kept for a SELECT */
+void plan_cache_hit(JOIN *join);
+
+/** Keep the join order chosen for a SELECT of the current statement */
+void plan_cache_store(JOIN *join);
+
+int fill_plan_cache(THD *thd, TABLE_LIST *tables, Item *cond);
+
+#endif /* SQL_PLAN_CACHE_INCLUDED */
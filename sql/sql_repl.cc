@@ -138,6 +138,7 @@ struct binlog_send_info {
   bool send_fake_gtid_list;
   bool slave_gtid_ignore_duplicates;
   bool using_gtid_state;
+  bool send_from_file;                  // See send_event_from_file()
 
   int error;
   const char *errmsg;
@@ -170,7 +171,7 @@ struct binlog_send_info {
       gtid_skip_group(GTID_SKIP_NOT), gtid_until_group(GTID_UNTIL_NOT_DONE),
       flags(flags_arg), current_checksum_alg(BINLOG_CHECKSUM_ALG_UNDEF),
       slave_gtid_strict_mode(false), send_fake_gtid_list(false),
-      slave_gtid_ignore_duplicates(false),
+      slave_gtid_ignore_duplicates(false), send_from_file(false),
       error(0),
       errmsg("Unknown error"),
       heartbeat_period(0),
@@ -1949,13 +1950,15 @@ send_event_to_slave(binlog_send_info *info, Log_event_type event_type,
   }
 
   /*
-    Do not send binlog checkpoint or gtid list events to a slave that does not
-    understand it.
+    Do not send binlog checkpoint, gtid list or writeset events to a slave
+    that does not understand it.
   */
   if ((unlikely(event_type == BINLOG_CHECKPOINT_EVENT) &&
        mariadb_slave_capability < MARIA_SLAVE_CAPABILITY_BINLOG_CHECKPOINT) ||
       (unlikely(event_type == GTID_LIST_EVENT) &&
-       mariadb_slave_capability < MARIA_SLAVE_CAPABILITY_GTID))
+       mariadb_slave_capability < MARIA_SLAVE_CAPABILITY_GTID) ||
+      (unlikely(event_type == WRITESET_EVENT) &&
+       mariadb_slave_capability < MARIA_SLAVE_CAPABILITY_WRITESET))
   {
     if (mariadb_slave_capability >= MARIA_SLAVE_CAPABILITY_TOLERATE_HOLES)
     {
@@ -1972,12 +1975,24 @@ send_event_to_slave(binlog_send_info *info, Log_event_type event_type,
       if (Query_log_event::dummy_event(packet, ev_offset, current_checksum_alg))
       {
         info->error= ER_MASTER_FATAL_ERROR_READING_BINLOG;
-        return "Failed to replace binlog checkpoint or gtid list event with "
-               "dummy: too small event.";
+        return "Failed to replace binlog checkpoint, gtid list or writeset "
+               "event with dummy: too small event.";
       }
     }
   }
 
+  /*
+    The events of a compressed transaction cannot be replaced by a dummy
+    event for a slave that does not understand it, as they must be applied.
+  */
+  if (unlikely(event_type == TRANSACTION_PAYLOAD_EVENT) &&
+      mariadb_slave_capability < MARIA_SLAVE_CAPABILITY_TRANSACTION_PAYLOAD)
+  {
+    info->error= ER_MASTER_FATAL_ERROR_READING_BINLOG;
+    return "Slave does not understand compressed transactions written with "
+           "@@log_bin_compress_transactions; upgrade the slave.";
+  }
+
   /*
     Skip events with the @@skip_replication flag set, if slave requested
     skipping of such events.
@@ -1990,6 +2005,19 @@ send_event_to_slave(binlog_send_info *info, Log_event_type event_type,
       return NULL;
   }
 
+  /* Used in test cases to check that send_event_from_file() was used. */
+  DBUG_EXECUTE_IF("binlog_dump_sendfile_required",
+    if (info->send_from_file &&
+        opt_binlog_dump_sendfile_size &&
+        len - ev_offset >= opt_binlog_dump_sendfile_size &&
+        (LOG_EVENT_IS_WRITE_ROW(event_type) ||
+         LOG_EVENT_IS_UPDATE_ROW(event_type) ||
+         LOG_EVENT_IS_DELETE_ROW(event_type)))
+    {
+      info->error= ER_UNKNOWN_ERROR;
+      return "Rows event was not sent from the binlog file";
+    });
+
   THD_STAGE_INFO(info->thd, stage_sending_binlog_event_to_slave);
 
   pos= my_b_tell(log);
@@ -2027,6 +2055,61 @@ send_event_to_slave(binlog_send_info *info, Log_event_type event_type,
   return NULL;    /* Success */
 }
 
+/*
+  Send a rows event to the slave straight from the binlog file, without
+  reading it into the packet (@@binlog_dump_sendfile_size).
+
+  Rows events are sent to the slave unchanged, unless their event group is
+  skipped or they have @@skip_replication set, which can be checked from
+  the event header alone. The event is then sent with net_write_file(), so
+  that the kernel copies it from the page cache to the socket. Dump threads
+  sending the same part of the binlog share its pages in the page cache.
+
+  @retval 0   The event was sent, log is positioned after it
+  @retval -1  The event must be read and sent as usual
+  @retval 1   Error
+*/
+static int send_event_from_file(binlog_send_info *info, IO_CACHE *log,
+                                my_off_t end_pos)
+{
+  uchar header[LOG_EVENT_MINIMAL_HEADER_LEN];
+  const uchar ok_byte= 0;                       // See reset_transmit_packet()
+  my_off_t pos= my_b_tell(log);
+  ulong event_len;
+  Log_event_type event_type;
+
+  if (info->gtid_skip_group != GTID_SKIP_NOT ||
+      opt_master_verify_checksum || info->fdev->crypto_data.scheme ||
+      pos + LOG_EVENT_MINIMAL_HEADER_LEN > end_pos ||
+      mysql_file_pread(log->file, header, sizeof(header), pos, MYF(MY_NABP)))
+    return -1;
+
+  event_len= uint4korr(header + EVENT_LEN_OFFSET);
+  event_type= (Log_event_type) header[EVENT_TYPE_OFFSET];
+  if (event_len < LOG_EVENT_MINIMAL_HEADER_LEN ||
+      event_len < opt_binlog_dump_sendfile_size ||
+      event_len + sizeof(ok_byte) >= MAX_PACKET_LENGTH ||
+      pos + event_len > end_pos ||
+      !(LOG_EVENT_IS_WRITE_ROW(event_type) ||
+        LOG_EVENT_IS_UPDATE_ROW(event_type) ||
+        LOG_EVENT_IS_DELETE_ROW(event_type)))
+    return -1;
+  if ((info->thd->variables.option_bits & OPTION_SKIP_REPLICATION) &&
+      (uint2korr(header + FLAGS_OFFSET) & LOG_EVENT_SKIP_REPLICATION_F))
+    return -1;
+
+  THD_STAGE_INFO(info->thd, stage_sending_binlog_event_to_slave);
+  if (net_write_file(info->net, &ok_byte, sizeof(ok_byte), log->file, pos,
+                     event_len))
+  {
+    info->error= ER_UNKNOWN_ERROR;
+    info->errmsg= "Failed on net_write_file()";
+    return 1;
+  }
+  my_b_seek(log, pos + event_len);
+  return 0;
+}
+
 static int check_start_offset(binlog_send_info *info,
                               const char *log_file_name,
                               my_off_t pos)
@@ -2631,6 +2714,16 @@ static int send_events(binlog_send_info *info, IO_CACHE* log, LOG_INFO* linfo,
       return 1;
 
     info->last_pos= linfo->pos;
+    if (info->send_from_file && opt_binlog_dump_sendfile_size)
+    {
+      if ((error= send_event_from_file(info, log, end_pos)) > 0)
+        return 1;
+      if (error == 0)
+      {
+        linfo->pos= my_b_tell(log);
+        continue;
+      }
+    }
     error= Log_event::read_log_event(log, packet, info->fdev,
                        opt_master_verify_checksum ? info->current_checksum_alg
                                                   : BINLOG_CHECKSUM_ALG_OFF);
@@ -2821,6 +2914,14 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
   */
   info->heartbeat_period= get_heartbeat_period(thd);
 
+  /*
+    Events are sent from the binlog file only on plain connections, and not
+    to semisync slaves, which need a reply header in the packet.
+  */
+  info->send_from_file= !thd->semi_sync_slave && !info->net->compress &&
+                        (vio_type(info->net->vio) == VIO_TYPE_TCPIP ||
+                         vio_type(info->net->vio) == VIO_TYPE_SOCKET);
+
   while (!should_stop(info))
   {
     /*
@@ -3892,6 +3993,41 @@ bool change_master(THD* thd, Master_info* mi, bool *master_info_added)
 }
 
 
+/*
+  With --gtid-slave-pos-batch-size, the last GTIDs applied by the slave may
+  be recorded only in the binlog state, which RESET MASTER and
+  SET GLOBAL gtid_binlog_state discard. So write the current slave position
+  to mysql.gtid_slave_pos first, and refuse while a slave is running, as it
+  would apply more transactions that are not written to the table.
+*/
+static bool
+record_gtid_slave_pos_for_reset(THD *thd)
+{
+  String str;
+  bool err;
+
+  if (opt_gtid_slave_pos_batch_size <= 1 || !opt_log_slave_updates)
+    return false;
+
+  mysql_mutex_lock(&LOCK_active_mi);
+  if (give_error_if_slave_running(1))
+    err= true;
+  else if (!rpl_global_gtid_slave_state->loaded)
+    err= false;
+  else if (rpl_global_gtid_slave_state->tostring(&str, NULL, 0) ||
+           rpl_global_gtid_slave_state->load(thd, str.ptr(), str.length(),
+                                             false, true))
+  {
+    my_error(ER_FAILED_GTID_STATE_INIT, MYF(0));
+    err= true;
+  }
+  else
+    err= false;
+  mysql_mutex_unlock(&LOCK_active_mi);
+  return err;
+}
+
+
 /**
   Execute a RESET MASTER statement.
 
@@ -3922,6 +4058,9 @@ int reset_master(THD* thd, rpl_gtid *init_state, uint32 init_state_len,
     return 1;
   }
 #endif /* WITH_WSREP */
+  if (record_gtid_slave_pos_for_reset(thd))
+    return 1;
+
   bool ret= 0;
   /* Temporarily disable master semisync before reseting master. */
   repl_semisync_master.before_reset_master();
@@ -4574,6 +4713,50 @@ rpl_gtid_pos_check(THD *thd, char *str, size_t len)
       return true;
   }
 
+  /*
+    With --gtid-slave-pos-batch-size, the GTIDs of other servers in the
+    binlog state override older GTIDs of mysql.gtid_slave_pos when the slave
+    position is loaded (see rpl_slave_state::skip_record_gtid()). So refuse
+    a position that would be lost at the next restart.
+  */
+  if (mysql_bin_log.is_open() && opt_gtid_slave_pos_batch_size > 1 &&
+      opt_log_slave_updates)
+  {
+    rpl_gtid *binlog_gtid_list= NULL;
+    uint32 num_binlog_gtids= 0;
+    uint32 i;
+
+    if (mysql_bin_log.get_replicated_gtid_list(&binlog_gtid_list,
+                                               &num_binlog_gtids))
+    {
+      my_error(ER_OUT_OF_RESOURCES, MYF(MY_WME));
+      return true;
+    }
+    for (i= 0; i < num_binlog_gtids; ++i)
+    {
+      rpl_gtid *binlog_gtid= &binlog_gtid_list[i];
+      rpl_gtid *slave_gtid;
+      if (!(slave_gtid= tmp_slave_state.find(binlog_gtid->domain_id)))
+      {
+        my_error(ER_MASTER_GTID_POS_MISSING_DOMAIN, MYF(0),
+                 binlog_gtid->domain_id, binlog_gtid->domain_id,
+                 binlog_gtid->server_id, binlog_gtid->seq_no);
+        break;
+      }
+      else if (slave_gtid->seq_no < binlog_gtid->seq_no)
+      {
+        my_error(ER_MASTER_GTID_POS_CONFLICTS_WITH_BINLOG, MYF(0),
+                 slave_gtid->domain_id, slave_gtid->server_id,
+                 slave_gtid->seq_no, binlog_gtid->domain_id,
+                 binlog_gtid->server_id, binlog_gtid->seq_no);
+        break;
+      }
+    }
+    my_free(binlog_gtid_list);
+    if (i != num_binlog_gtids)
+      return true;
+  }
+
   return false;
 }
 
@@ -68,6 +68,8 @@
 #include "select_handler.h"
 #include "my_json_writer.h"
 #include "opt_trace.h"
+#include "sql_parallel_scan.h"
+#include "sql_plan_cache.h"
 
 /*
   A key part number that means we're using a fulltext scan.
@@ -2915,6 +2917,8 @@ int JOIN::optimize_stage2()
   if (init_range_rowid_filters())
     DBUG_RETURN(1);
 
+  choose_parallel_scan(this);
+
   error= 0;
 
   if (select_options & SELECT_DESCRIBE)
@@ -5469,7 +5473,7 @@ make_join_statistics(JOIN *join, List<TABLE_LIST> &tables_list,
     /* Find an optimal join order of the non-constant tables. */
     if (join->const_tables != join->table_count)
     {
-      if (choose_plan(join, all_table_map & ~join->const_table_map))
+      if (choose_plan(join, all_table_map & ~join->const_table_map, true))
         goto error;
     }
     else
@@ -8032,6 +8036,194 @@ static void choose_initial_table_order(JOIN *join)
 }
 
 
+/* Where the join order of a SELECT is kept across executions */
+
+enum enum_plan_cache
+{
+  PLAN_CACHE_NONE= 0,
+  PLAN_CACHE_STMT,                      /* By the prepared statement */
+  PLAN_CACHE_SERVER                     /* By the server-wide plan cache */
+};
+
+
+/**
+  Find where the join order of a SELECT may be kept for the next
+  executions of the statement.
+*/
+
+static enum_plan_cache plan_cache_for(JOIN *join)
+{
+  THD *thd= join->thd;
+
+  /* There is nothing to search for with one table */
+  if (join->table_count - join->const_tables < 2 ||
+      join->emb_sjm_nest || join->select_lex->sj_nests.elements)
+    return PLAN_CACHE_NONE;
+  if (thd->stmt_arena->type() == Query_arena::PREPARED_STATEMENT)
+    return (thd->variables.prepared_stmt_plan_cache &&
+            thd->stmt_arena->is_stmt_execute()) ?
+           PLAN_CACHE_STMT : PLAN_CACHE_NONE;
+  if (thd->stmt_arena->is_conventional() && plan_cache_key(thd))
+    return PLAN_CACHE_SERVER;
+  return PLAN_CACHE_NONE;
+}
+
+
+/**
+  Fill the join order from the chosen plan of a JOIN.
+
+  @pre The arrays have room for the non-constant tables of the JOIN.
+*/
+
+void Join_plan_cache::set(JOIN *join)
+{
+  const_tables= join->const_table_map;
+  n_tables= join->table_count - join->const_tables;
+  for (uint i= 0; i < n_tables; i++)
+  {
+    POSITION *pos= join->best_positions + join->const_tables + i;
+    TABLE *table= pos->table->table;
+    order[i]= table->tablenr;
+    versions[i]= table->s->get_table_ref_version();
+    records[i]= pos->records_read;
+  }
+}
+
+
+/**
+  Choose the plan with the join order kept by a previous execution of the
+  statement.
+
+  The tables are put in the kept order and the access methods are chosen
+  by optimize_straight_join(). The kept order is not used if the constant
+  tables or the table shares are not the same, if the order is not valid
+  for the outer joins any more, or if the number of rows estimated for
+  some table drifted by more than @@prepared_stmt_plan_cache_replan_factor.
+
+  @retval TRUE   The plan is chosen
+  @retval FALSE  The join order must be searched for
+*/
+
+static bool reuse_cached_plan(JOIN *join, table_map join_tables,
+                              enum_plan_cache where)
+{
+  THD *thd= join->thd;
+  Join_plan_cache *cache= where == PLAN_CACHE_STMT ?
+                          join->select_lex->plan_cache :
+                          plan_cache_find(join);
+  uint n_tables= join->table_count - join->const_tables;
+  JOIN_TAB **tabs= join->best_ref + join->const_tables;
+  JOIN_TAB *saved_tabs[MAX_TABLES];
+  table_map done_tables= join->const_table_map;
+  bool valid_order= TRUE;
+  double factor= (double) thd->variables.prepared_stmt_plan_cache_replan_factor;
+  DBUG_ENTER("reuse_cached_plan");
+
+  if (!cache)
+    DBUG_RETURN(FALSE);
+  if (cache->const_tables != join->const_table_map ||
+      cache->n_tables != n_tables)
+    goto replan;
+
+  memcpy(saved_tabs, tabs, sizeof(JOIN_TAB*) * n_tables);
+  for (uint i= 0; i < n_tables && valid_order; i++)
+  {
+    JOIN_TAB *tab= NULL;
+    for (uint j= 0; j < n_tables; j++)
+    {
+      if (saved_tabs[j]->table->tablenr == cache->order[i])
+      {
+        tab= saved_tabs[j];
+        break;
+      }
+    }
+    if (!tab ||
+        tab->table->s->get_table_ref_version() != cache->versions[i] ||
+        (tab->dependent & ~done_tables) ||
+        check_interleaving_with_nj(tab))
+      valid_order= FALSE;
+    else
+    {
+      tabs[i]= tab;
+      done_tables|= tab->table->map;
+    }
+  }
+  join->cur_embedding_map= 0;
+  reset_nj_counters(join, join->join_list);
+  if (!valid_order)
+  {
+    memcpy(tabs, saved_tabs, sizeof(JOIN_TAB*) * n_tables);
+    goto replan;
+  }
+  optimize_straight_join(join, join_tables);
+
+  for (uint i= 0; i < n_tables; i++)
+  {
+    double cached= cache->records[i] + 1.0;
+    double records=
+      join->best_positions[join->const_tables + i].records_read + 1.0;
+    if (records > cached * factor || cached > records * factor)
+    {
+      DBUG_PRINT("info", ("table %u: %g rows, %g expected", i,
+                          records, cached));
+      /* Give the search the order it would otherwise start with */
+      memcpy(tabs, saved_tabs, sizeof(JOIN_TAB*) * n_tables);
+      goto replan;
+    }
+  }
+  if (where == PLAN_CACHE_STMT)
+    thd->status_var.ps_plan_cache_hits++;
+  else
+    plan_cache_hit(join);
+  DBUG_RETURN(TRUE);
+
+replan:
+  /* The server-wide cache counts replans when the new order is stored */
+  if (where == PLAN_CACHE_STMT)
+    thd->status_var.ps_plan_cache_replans++;
+  DBUG_RETURN(FALSE);
+}
+
+
+/**
+  Keep the join order chosen for a SELECT for the next executions of the
+  statement.
+
+  Failure to allocate the cache is not an error, the order is searched for
+  again next time.
+*/
+
+static void store_cached_plan(JOIN *join, enum_plan_cache where)
+{
+  THD *thd= join->thd;
+  Join_plan_cache *cache= join->select_lex->plan_cache;
+  uint n_tables= join->table_count - join->const_tables;
+
+  if (where == PLAN_CACHE_SERVER)
+  {
+    plan_cache_store(join);
+    return;
+  }
+
+  if (!cache || cache->size < n_tables)
+  {
+    MEM_ROOT *mem_root= thd->stmt_arena->mem_root;
+    uint size= join->table_count;
+    Join_plan_cache *new_cache;
+    if (!(new_cache= new (mem_root) Join_plan_cache) ||
+        !multi_alloc_root(mem_root,
+                          &new_cache->order, sizeof(uint) * size,
+                          &new_cache->versions, sizeof(ulong) * size,
+                          &new_cache->records, sizeof(double) * size,
+                          NullS))
+      return;
+    new_cache->size= size;
+    join->select_lex->plan_cache= cache= new_cache;
+  }
+  cache->set(join);
+}
+
+
 /**
   Selects and invokes a search strategy for an optimal query plan.
 
@@ -8044,6 +8236,9 @@ static void choose_initial_table_order(JOIN *join)
   @param join         pointer to the structure providing all context info for
                       the query
   @param join_tables  set of the tables in the query
+  @param use_plan_cache  reuse and keep the join order across executions
+                      of the statement (@@prepared_stmt_plan_cache,
+                      @@plan_cache_size)
 
   @retval
     FALSE       ok
@@ -8052,7 +8247,7 @@ static void choose_initial_table_order(JOIN *join)
 */
 
 bool
-choose_plan(JOIN *join, table_map join_tables)
+choose_plan(JOIN *join, table_map join_tables, bool use_plan_cache)
 {
   uint search_depth= join->thd->variables.optimizer_search_depth;
   uint prune_level=  join->thd->variables.optimizer_prune_level;
@@ -8111,13 +8306,20 @@ choose_plan(JOIN *join, table_map join_tables)
   }
   else
   {
-    DBUG_ASSERT(search_depth <= MAX_TABLES + 1);
-    if (search_depth == 0)
-      /* Automatically determine a reasonable value for 'search_depth' */
-      search_depth= determine_search_depth(join);
-    if (greedy_search(join, join_tables, search_depth, prune_level,
-                      use_cond_selectivity))
-      DBUG_RETURN(TRUE);
+    enum_plan_cache plan_cache= use_plan_cache ? plan_cache_for(join) :
+                                                 PLAN_CACHE_NONE;
+    if (!plan_cache || !reuse_cached_plan(join, join_tables, plan_cache))
+    {
+      DBUG_ASSERT(search_depth <= MAX_TABLES + 1);
+      if (search_depth == 0)
+        /* Automatically determine a reasonable value for 'search_depth' */
+        search_depth= determine_search_depth(join);
+      if (greedy_search(join, join_tables, search_depth, prune_level,
+                        use_cond_selectivity))
+        DBUG_RETURN(TRUE);
+      if (plan_cache)
+        store_cached_plan(join, plan_cache);
+    }
   }
 
   /* 
@@ -13251,6 +13453,21 @@ bool JOIN_TAB::preread_init()
 }
 
 
+/**
+  Build cond_filter for the current select_cond.
+
+  The filter is rebuilt whenever select_cond is changed, so that the
+  places that attach or replace the condition need not know about it.
+*/
+
+void JOIN_TAB::build_cond_filter(THD *thd)
+{
+  cond_filter_for= select_cond;
+  cond_filter= thd->variables.fast_condition_evaluation ?
+               Cond_filter::create(thd, select_cond) : NULL;
+}
+
+
 /**
   Build a TABLE_REF structure for index lookup in the temporary table
 
@@ -20119,7 +20336,9 @@ evaluate_join_record(JOIN *join, JOIN_TAB *join_tab,
 
   if (select_cond)
   {
-    select_cond_result= MY_TEST(select_cond->val_int());
+    Cond_filter *filter= join_tab->get_cond_filter(join->thd);
+    select_cond_result= filter ? filter->is_true() :
+                                 MY_TEST(select_cond->val_int());
 
     /* check for errors evaluating the condition */
     if (unlikely(join->thd->is_error()))
@@ -20961,6 +21180,14 @@ int join_init_read_record(JOIN_TAB *tab)
   if (!tab->preread_init_done  && tab->preread_init())
     return 1;
 
+  if (tab->parallel_scan_threads)
+  {
+    int res= init_parallel_read_record(&tab->read_record, tab);
+    if (res > 0)
+      return 1;
+    if (res == 0)
+      return tab->read_record.read_record();
+  }
 
   if (init_read_record(&tab->read_record, tab->join->thd, tab->table,
                        tab->select, tab->filesort_result, 1,1, FALSE))
@@ -25740,6 +25967,7 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
   // psergey-todo: data for filtering!
   tracker= &eta->tracker;
   jbuf_tracker= &eta->jbuf_tracker;
+  jbuf_spill_tracker= &eta->jbuf_spill_tracker;
 
   /* Enable the table access time tracker only for "ANALYZE stmt" */
   if (thd->lex->analyze_stmt)
@@ -26152,6 +26380,12 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
       if (cache->save_explain_data(&eta->bka_type))
         return 1;
     }
+
+    if (parallel_scan_threads)
+    {
+      eta->push_extra(ET_PARALLEL_SCAN);
+      eta->parallel_scan_threads= parallel_scan_threads;
+    }
   }
 
   /* 
@@ -241,6 +241,7 @@ class SJ_TMP_TABLE;
 class JOIN_TAB_RANGE;
 class AGGR_OP;
 class Filesort;
+class Cond_filter;
 struct SplM_plan_info;
 class SplM_opt_info;
 
@@ -263,6 +264,18 @@ typedef struct st_join_table {
     NULL means no index condition pushdown was performed.
   */
   Item          *pre_idx_push_select_cond;
+  /*
+    Compiled form of select_cond used by evaluate_join_record() when
+    @@fast_condition_evaluation is on, and the select_cond it was built
+    for. NULL if select_cond has nothing that can be compiled.
+  */
+  Cond_filter   *cond_filter;
+  Item          *cond_filter_for;
+  /*
+    Maximum number of threads that read this table in parallel, 0 if the
+    table is read by the thread executing the query. See Parallel_scan.
+  */
+  uint          parallel_scan_threads;
   /*
     Pointer to the associated ON expression. on_expr_ref=!NULL except for
     degenerate joins. 
@@ -303,6 +316,7 @@ typedef struct st_join_table {
   Table_access_tracker *tracker;
 
   Table_access_tracker *jbuf_tracker;
+  Join_spill_tracker *jbuf_spill_tracker;
   /* 
     Bitmap of TAB_INFO_* bits that encodes special line for EXPLAIN 'Extra'
     column, or 0 if there is no info.
@@ -634,6 +648,13 @@ typedef struct st_join_table {
   double scan_time();
   ha_rows get_examined_rows();
   bool preread_init();
+  Cond_filter *get_cond_filter(THD *thd)
+  {
+    if (unlikely(cond_filter_for != select_cond))
+      build_cond_filter(thd);
+    return cond_filter;
+  }
+  void build_cond_filter(THD *thd);
 
   bool is_sjm_nest() { return MY_TEST(bush_children); }
   
@@ -1005,6 +1026,36 @@ typedef struct st_rollup
 } ROLLUP;
 
 
+/**
+  @brief
+    Join order of a SELECT kept for its next executions
+
+  @details
+    The order is kept by a prepared statement on its memory root
+    (@@prepared_stmt_plan_cache), or by the server-wide plan cache for
+    text statements with the same digest (@@plan_cache_size, see
+    sql_plan_cache.h). Next executions with the same constant tables put
+    the tables in this order and only choose the access methods
+    (optimize_straight_join()). The order is dropped if the share of one
+    of the tables changed (DDL, ANALYZE TABLE, FLUSH TABLES), or if the
+    number of rows estimated for a table differs from the kept estimate
+    by more than @@prepared_stmt_plan_cache_replan_factor.
+*/
+
+class Join_plan_cache :public Sql_alloc
+{
+public:
+  table_map const_tables;                 /* Constant tables of the plan */
+  uint n_tables;                          /* Number of non-constant tables */
+  uint size;                              /* Allocated size of the arrays */
+  uint *order;                            /* tablenr of the tables in order */
+  ulong *versions;                        /* Table share versions */
+  double *records;                        /* POSITION::records_read */
+
+  void set(JOIN *join);
+};
+
+
 class JOIN_TAB_RANGE: public Sql_alloc
 {
 public:
@@ -2355,7 +2406,8 @@ inline Item * or_items(THD *thd, Item* cond, Item *item)
 {
   return (cond ? (new (thd->mem_root) Item_cond_or(thd, cond, item)) : item);
 }
-bool choose_plan(JOIN *join, table_map join_tables);
+bool choose_plan(JOIN *join, table_map join_tables,
+                 bool use_plan_cache= false);
 void optimize_wo_join_buffering(JOIN *join, uint first_tab, uint last_tab, 
                                 table_map last_remaining_tables, 
                                 bool first_alt, uint no_jbuf_before,
@@ -25,17 +25,41 @@ typedef struct st_buffpek BUFFPEK;
 struct SORT_FIELD;
 class Field;
 struct TABLE;
+class THD;
+struct Sort_thread_stats;
 
 /* Defines used by filesort and uniques */
 
 #define MERGEBUFF		7
 #define MERGEBUFF2		15
 
+/*
+  Minimal number of keys each thread sorts when a sort buffer is sorted
+  by several threads. Smaller buffers are not worth the thread startup.
+*/
+#define MIN_KEYS_PER_SORT_THREAD 16384
+
+/*
+  Minimal number of keys of the sort buffer each thread gets when the
+  runs of a merge pass are merged by several threads, enough to read
+  each of MERGEBUFF2 runs in chunks of 64 keys.
+*/
+#define MIN_KEYS_PER_MERGE_THREAD (MERGEBUFF2 * 64)
+
+/*
+  Number of bytes used to store the length of packed addon fields.
+  The length includes these bytes.
+*/
+#define PACKED_ADDON_LENGTH_BYTES 2
+
 /*
    The structure SORT_ADDON_FIELD describes a fixed layout
    for field values appended to sorted values in records to be sorted
    in the sort buffer.
-   Only fixed layout is supported now.
+   With packed addons (Sort_param::using_packed_addons) the values are
+   stored with their actual length, one after another, and the null bits
+   are preceded by the total length of the appended data. In that case
+   'offset' is valid only for the first field.
    Null bit maps for the appended values is placed before the values 
    themselves. Offsets are from the last sorted field, that is from the
    record referefence, which is still last component of sorted records.
@@ -82,7 +106,18 @@ class Sort_param {
 
   uchar *unique_buff;
   bool not_killable;
+  bool using_packed_addons;      // Addon fields stored with actual length
   char* tmp_buffer;
+  uint max_sort_threads;         // Max threads to sort or merge with.
+  uint sort_threads_used;        // Max threads of one sort or merge pass.
+  ulong parallel_sorts;          // Buffers sorted by more than one thread.
+  ulong parallel_merge_passes;   // Merge passes run by more than one thread.
+  Sort_thread_stats *thread_stats; // max_sort_threads parts, see Sort_threads
+  /*
+    The session of a part of a parallel merge pass, which merge_buffers()
+    runs in a sort thread; NULL when it runs in the session's thread.
+  */
+  THD *merge_thd;
   // The fields below are used only by Unique class.
   qsort2_cmp compare;
   BUFFPEK_COMPARE_CONTEXT cmp_context;
@@ -93,6 +128,24 @@ class Sort_param {
   }
   void init_for_filesort(uint sortlen, TABLE *table,
                          ha_rows maxrows, bool sort_positions);
+
+  /** Length of the addon data of a packed record at 'addon' */
+  static uint read_addon_length(const uchar *addon)
+  { return uint2korr(addon); }
+
+  /** Length of the result (addon data or reference) of the record at 'rec' */
+  uint get_result_length(const uchar *rec) const
+  {
+    return using_packed_addons ?
+      read_addon_length(rec + sort_length) : res_length;
+  }
+
+  /** Length of the record at 'rec' in the sort buffer or a merge chunk */
+  uint get_record_length(const uchar *rec) const
+  {
+    return using_packed_addons ?
+      sort_length + read_addon_length(rec + sort_length) : rec_length;
+  }
 };
 
 
@@ -63,6 +63,7 @@
 #include "sql_repl.h"
 #include "opt_range.h"
 #include "rpl_parallel.h"
+#include "sql_plan_cache.h"
 #include "semisync_master.h"
 #include "semisync_slave.h"
 #include <ssl_compat.h>
@@ -1335,6 +1336,14 @@ static Sys_var_uint Sys_log_bin_compress_min_len(
   GLOBAL_VAR(opt_bin_log_compress_min_len),
   CMD_LINE(OPT_ARG), VALID_RANGE(10, 1024), DEFAULT(256), BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_log_bin_compress_transactions(
+  "log_bin_compress_transactions",
+  "Compress the events of a transaction together into one event in the "
+  "binary log. Only transactions of at least log_bin_compress_min_len "
+  "bytes, and of at most slave_max_allowed_packet bytes, are compressed",
+  GLOBAL_VAR(opt_bin_log_compress_transactions), CMD_LINE(OPT_ARG),
+  DEFAULT(FALSE));
+
 static Sys_var_mybool Sys_trust_function_creators(
        "log_bin_trust_function_creators",
        "If set to FALSE (the default), then when --log-bin is used, creation "
@@ -2038,6 +2047,22 @@ static Sys_var_uint Sys_gtid_cleanup_batch_size(
        GLOBAL_VAR(opt_gtid_cleanup_batch_size), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0,2147483647), DEFAULT(64), BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_gtid_slave_pos_batch_size(
+       "gtid_slave_pos_batch_size",
+       "If greater than 1, and the slave writes the transactions it applies "
+       "to the binary log (--log-slave-updates) with sync_binlog=1 and "
+       "innodb_flush_log_at_trx_commit=1, only one in this many transactions "
+       "writes its GTID to the mysql.gtid_slave_pos table. The slave position "
+       "is then loaded from the table and from the GTIDs of other servers in "
+       "the binary log state, whichever is more recent, @@gtid_slave_pos "
+       "cannot be set to a position older than the binary log, and "
+       "RESET MASTER and setting @@gtid_binlog_state write the slave "
+       "position to the table first and are refused while a slave is "
+       "running.",
+       READ_ONLY GLOBAL_VAR(opt_gtid_slave_pos_batch_size),
+       CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1,65536), DEFAULT(1), BLOCK_SIZE(1));
+
 
 static bool
 check_slave_parallel_threads(sys_var *self, THD *thd, set_var *var)
@@ -2290,6 +2315,17 @@ static Sys_var_ulong Sys_binlog_commit_wait_usec(
        VALID_RANGE(0, ULONG_MAX), DEFAULT(100000), BLOCK_SIZE(1));
 
 
+static Sys_var_ulong Sys_binlog_writeset_max_keys(
+       "binlog_writeset_max_keys",
+       "If non-zero, a transaction logged in row format is preceded in the "
+       "binary log by the hashes of the unique keys of the rows it changes, "
+       "up to this many. A parallel slave in conservative mode runs "
+       "transactions that change different rows in parallel, even if they "
+       "did not group commit together on the master.",
+       GLOBAL_VAR(opt_binlog_writeset_max_keys), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX16), DEFAULT(0), BLOCK_SIZE(1));
+
+
 static bool fix_max_join_size(sys_var *self, THD *thd, enum_var_type type)
 {
   SV *sv= type == OPT_GLOBAL ? &global_system_variables : &thd->variables;
@@ -2346,6 +2382,14 @@ static Sys_var_ulong Sys_max_recursive_iterations(
        SESSION_VAR(max_recursive_iterations), CMD_LINE(OPT_ARG),
        VALID_RANGE(0, UINT_MAX), DEFAULT(UINT_MAX), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_max_scan_threads(
+       "max_scan_threads",
+       "Maximum number of threads used to read the first table of a "
+       "SELECT with a full scan or a range scan. 1 means the table is read "
+       "by the thread executing the query",
+       SESSION_VAR(max_scan_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_max_sort_length(
        "max_sort_length",
        "The number of bytes to use when sorting BLOB or TEXT values (only "
@@ -2354,6 +2398,15 @@ static Sys_var_ulong Sys_max_sort_length(
        SESSION_VAR(max_sort_length), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(4, 8192*1024L), DEFAULT(1024), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_max_sort_threads(
+       "max_sort_threads",
+       "Maximum number of threads used to sort the in-memory sort buffer "
+       "of a filesort, and to merge the sorted runs of a filesort in the "
+       "temporary file. 1 means both are done by the thread executing the "
+       "query",
+       SESSION_VAR(max_sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_max_sp_recursion_depth(
        "max_sp_recursion_depth",
        "Maximum stored procedure recursion depth",
@@ -2647,6 +2700,21 @@ static Sys_var_charptr Sys_plugin_dir(
        READ_ONLY GLOBAL_VAR(opt_plugin_dir_ptr), CMD_LINE(REQUIRED_ARG),
        IN_FS_CHARSET, DEFAULT(0));
 
+static bool fix_plan_cache_size(sys_var *self, THD *thd, enum_var_type type)
+{
+  plan_cache_resize(plan_cache_size);
+  return false;
+}
+static Sys_var_ulonglong Sys_plan_cache_size(
+       "plan_cache_size",
+       "The memory used to keep the join orders chosen for text statements, "
+       "which are reused by statements that differ only by literals. "
+       "0 disables the plan cache",
+       GLOBAL_VAR(plan_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(1024),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_plan_cache_size));
+
 static Sys_var_uint Sys_port(
        "port",
        "Port number to use for connection or 0 to default to, "
@@ -2664,6 +2732,23 @@ static Sys_var_ulong Sys_preload_buff_size(
        SESSION_VAR(preload_buff_size), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(1024, 1024*1024*1024), DEFAULT(32768), BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_prepared_stmt_plan_cache(
+       "prepared_stmt_plan_cache",
+       "Keep the join order chosen by an execution of a prepared statement "
+       "and reuse it in the next executions, choosing only the access "
+       "methods again",
+       SESSION_VAR(prepared_stmt_plan_cache), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
+static Sys_var_ulong Sys_prepared_stmt_plan_cache_replan_factor(
+       "prepared_stmt_plan_cache_replan_factor",
+       "The join order kept by a prepared statement is searched for again "
+       "when the number of rows estimated for one of the tables changes by "
+       "more than this factor",
+       SESSION_VAR(prepared_stmt_plan_cache_replan_factor),
+       CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, UINT_MAX32), DEFAULT(10), BLOCK_SIZE(1));
+
 static Sys_var_uint Sys_protocol_version(
        "protocol_version",
        "The version of the client/server protocol used by the MariaDB server",
@@ -3005,6 +3090,14 @@ static Sys_var_ulong Sys_query_cache_min_res_unit(
        BLOCK_SIZE(8), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_qcache_min_res_unit));
 
+static Sys_var_uint Sys_query_cache_partitions(
+       "query_cache_partitions",
+       "Number of partitions of the query cache. Every partition has its own "
+       "part of query_cache_size and its own lock, and a query is cached in "
+       "the partition chosen by the hash of the query",
+       READ_ONLY GLOBAL_VAR(query_cache_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_QUERY_CACHE_PARTITIONS), DEFAULT(1), BLOCK_SIZE(1));
+
 static const char *query_cache_type_names[]= { "OFF", "ON", "DEMAND", 0 };
 
 static bool check_query_cache_type(sys_var *self, THD *thd, set_var *var)
@@ -3172,6 +3265,16 @@ static Sys_var_mybool Sys_master_verify_checksum(
        GLOBAL_VAR(opt_master_verify_checksum), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
 
+static Sys_var_ulong Sys_binlog_dump_sendfile_size(
+       "binlog_dump_sendfile_size",
+       "Rows events of at least this many bytes are sent to slaves directly "
+       "from the binary log file, with sendfile() where the platform "
+       "supports it, instead of being read and copied into a network packet. "
+       "Not used for compressed, SSL or semisync slave connections, "
+       "encrypted binary logs, or with master_verify_checksum. 0 disables",
+       GLOBAL_VAR(opt_binlog_dump_sendfile_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, MAX_MAX_ALLOWED_PACKET), DEFAULT(0), BLOCK_SIZE(1));
+
 /* These names must match RPL_SKIP_XXX #defines in slave.h. */
 static const char *replicate_events_marked_for_skip_names[]= {
   "REPLICATE", "FILTER_ON_SLAVE", "FILTER_ON_MASTER", 0
@@ -6004,6 +6107,16 @@ static Sys_var_ulong Sys_join_cache_level(
        SESSION_VAR(join_cache_level), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, 8), DEFAULT(2), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_join_buffer_spill_partitions(
+       "join_buffer_spill_partitions",
+       "The number of temporary files the records are distributed over by "
+       "their join key when they do not fit into the buffer of a flat BNLH "
+       "join cache. The joined table is then scanned only once, and the "
+       "spilled records are joined partition by partition. 0 disables "
+       "spilling",
+       SESSION_VAR(join_buffer_spill_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 128), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_mrr_buffer_size(
        "mrr_buffer_size",
        "Size of buffer to use when using MRR with range access",
@@ -6120,6 +6233,14 @@ static Sys_var_harows Sys_expensive_subquery_limit(
        SESSION_VAR(expensive_subquery_limit), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, HA_POS_ERROR), DEFAULT(100), BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_fast_condition_evaluation(
+       "fast_condition_evaluation",
+       "Check simple comparisons of numeric and temporal columns with "
+       "constants in the WHERE condition directly on the row buffer, "
+       "instead of evaluating them through the condition items",
+       SESSION_VAR(fast_condition_evaluation), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_mybool Sys_encrypt_tmp_disk_tables(
        "encrypt_tmp_disk_tables",
        "Encrypt temporary on-disk tables (created as part of query execution)",
@@ -131,10 +131,13 @@ struct Table_cache_instance
   ulong records;
   uint mutex_waits;
   uint mutex_nowaits;
+  /** Contested acquisitions since startup, never reset */
+  ulonglong total_mutex_waits;
   /** Avoid false sharing between instances */
   char pad[CPU_LEVEL1_DCACHE_LINESIZE];
 
-  Table_cache_instance(): records(0), mutex_waits(0), mutex_nowaits(0)
+  Table_cache_instance(): records(0), mutex_waits(0), mutex_nowaits(0),
+                          total_mutex_waits(0)
   {
     mysql_mutex_init(key_LOCK_table_cache, &LOCK_table_cache,
                      MY_MUTEX_INIT_FAST);
@@ -168,6 +171,7 @@ struct Table_cache_instance
     if (mysql_mutex_trylock(&LOCK_table_cache))
     {
       mysql_mutex_lock(&LOCK_table_cache);
+      total_mutex_waits++;
       if (++mutex_waits == 20000)
       {
         if (n_instances < tc_instances)
@@ -215,6 +219,27 @@ struct Table_cache_instance
 static Table_cache_instance *tc;
 
 
+/**
+  Get table cache instance to be used by the current thread.
+
+  Instances are assigned to CPUs rather than to connections: threads
+  running at the same time run on different CPUs and thus use different
+  instances, so an instance mutex is normally contested only when its
+  owner was preempted in the critical section. Falls back to thread id
+  if the CPU cannot be determined.
+*/
+
+static inline uint32 tc_instance(THD *thd, uint32 n_instances)
+{
+#ifdef HAVE_SCHED_GETCPU
+  int cpu= sched_getcpu();
+  if (cpu >= 0)
+    return (uint32) cpu % n_instances;
+#endif
+  return (uint32) (thd->thread_id % n_instances);
+}
+
+
 static void intern_close_table(TABLE *table)
 {
   delete table->triggers;
@@ -242,6 +267,23 @@ uint tc_records(void)
 }
 
 
+/**
+  Get number of contested table cache mutex acquisitions since startup.
+*/
+
+ulonglong tc_mutex_waits(void)
+{
+  ulonglong total= 0;
+  for (uint32 i= 0; i < tc_instances; i++)
+  {
+    mysql_mutex_lock(&tc[i].LOCK_table_cache);
+    total+= tc[i].total_mutex_waits;
+    mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+  }
+  return total;
+}
+
+
 /**
   Remove TABLE object from table cache.
 */
@@ -354,8 +396,9 @@ void tc_purge(bool mark_flushed)
 
 void tc_add_table(THD *thd, TABLE *table)
 {
-  uint32 i= thd->thread_id % my_atomic_load32_explicit((int32*) &tc_active_instances,
-                                                       MY_MEMORY_ORDER_RELAXED);
+  uint32 i= tc_instance(thd,
+                        my_atomic_load32_explicit((int32*) &tc_active_instances,
+                                                  MY_MEMORY_ORDER_RELAXED));
   TABLE *LRU_table= 0;
   TDC_element *element= table->s->tdc;
 
@@ -411,7 +454,7 @@ TABLE *tc_acquire_table(THD *thd, TDC_element *element)
   uint32 n_instances=
     my_atomic_load32_explicit((int32*) &tc_active_instances,
                               MY_MEMORY_ORDER_RELAXED);
-  uint32 i= thd->thread_id % n_instances;
+  uint32 i= tc_instance(thd, n_instances);
   TABLE *table;
 
   tc[i].lock_and_check_contention(n_instances, i);
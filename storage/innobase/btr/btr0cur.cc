@@ -4252,7 +4252,7 @@ btr_cur_update_in_place(
 				btr_search_update_hash_on_delete(cursor);
 			}
 
-			rw_lock_x_lock(ahi_latch);
+			btr_search_x_lock(btr_search_part_no(index));
 		}
 
 		assert_block_ahi_valid(block);
@@ -4262,7 +4262,7 @@ btr_cur_update_in_place(
 
 #ifdef BTR_CUR_HASH_ADAPT
 		if (ahi_latch) {
-			rw_lock_x_unlock(ahi_latch);
+			btr_search_x_unlock(btr_search_part_no(index));
 		}
 	}
 #endif /* BTR_CUR_HASH_ADAPT */
@@ -6734,6 +6734,150 @@ btr_estimate_n_rows_in_range(
 		index, tuple1, mode1, tuple2, mode2, 1);
 }
 
+/** Append the first fields of the node pointers on a page to a list.
+The leftmost node pointer of a level, SQL NULL values and values that are
+equal to the last value in the list are skipped.
+@param[in]	index		B-tree index
+@param[in]	block		latched non-leaf page of the index
+@param[in,out]	fields		first fields of the node pointers
+@param[in,out]	children	child page numbers, or NULL
+@param[in,out]	offsets		offsets of the last record
+@param[in,out]	heap		memory heap for offsets */
+static
+void
+btr_collect_split_fields(
+	const dict_index_t*				index,
+	const buf_block_t*				block,
+	std::vector<const byte*, ut_allocator<const byte*> >&	fields,
+	std::vector<ulint, ut_allocator<ulint> >*	children,
+	ulint*&						offsets,
+	mem_heap_t*&					heap)
+{
+	const page_t*	page = buf_block_get_frame(block);
+	const ulint	comp = page_is_comp(page);
+	const ulint	len = dict_index_get_nth_field(index, 0)->fixed_len;
+
+	for (const rec_t* rec = page_rec_get_next_const(
+		     page_get_infimum_rec(page));
+	     rec != NULL && !page_rec_is_supremum(rec);
+	     rec = page_rec_get_next_const(rec)) {
+
+		offsets = rec_get_offsets(rec, index, offsets, false,
+					  ULINT_UNDEFINED, &heap);
+
+		if (children != NULL) {
+			children->push_back(
+				btr_node_ptr_get_child_page_no(rec, offsets));
+		}
+
+		if (rec_get_info_bits(rec, comp) & REC_INFO_MIN_REC_FLAG) {
+			continue;
+		}
+
+		ulint		f_len;
+		const byte*	field = rec_get_nth_field(rec, offsets, 0,
+							  &f_len);
+
+		if (f_len != len
+		    || (!fields.empty()
+			&& !memcmp(fields.back(), field, len))) {
+			continue;
+		}
+
+		fields.push_back(field);
+	}
+}
+
+/** Find values of the first field of an index that split the index into
+parts of about the same size, for scanning the parts in parallel. The
+values are taken from the node pointers on the root page, or from the level
+below the root if the root page does not have enough node pointers.
+@param[in]	index	B-tree index whose first field is of fixed length
+@param[in]	n_max	maximum number of values
+@param[out]	values	values of the first field in ascending order,
+			fixed_len bytes each, in the stored format
+@return number of values written to values */
+ulint
+btr_get_split_values(
+	dict_index_t*	index,
+	ulint		n_max,
+	byte*		values)
+{
+	typedef std::vector<const byte*, ut_allocator<const byte*> >
+		field_list_t;
+	typedef std::vector<ulint, ut_allocator<ulint> > page_list_t;
+
+	const ulint	len = dict_index_get_nth_field(index, 0)->fixed_len;
+	mem_heap_t*	heap = NULL;
+	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*		offsets = offsets_;
+	ulint		n = 0;
+	mtr_t		mtr;
+
+	ut_ad(len > 0);
+	ut_ad(!index->is_spatial());
+	rec_offs_init(offsets_);
+
+	mtr.start();
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	const buf_block_t*	root = btr_root_block_get(index, RW_S_LATCH,
+							  &mtr);
+	const ulint		level = root != NULL
+		? btr_page_get_level(buf_block_get_frame(root)) : 0;
+
+	if (level > 0) {
+		field_list_t	fields;
+		page_list_t	children;
+
+		btr_collect_split_fields(index, root, fields, &children,
+					 offsets, heap);
+
+		if (fields.size() <= n_max && level > 1) {
+			/* Not enough values on the root page; use the
+			node pointers on the level below it. */
+			const ulint	zip_size = index->table->space->zip_size();
+
+			fields.clear();
+
+			for (page_list_t::const_iterator it = children.begin();
+			     it != children.end(); ++it) {
+				const buf_block_t*	block = btr_block_get(
+					page_id_t(index->table->space_id, *it),
+					zip_size, RW_S_LATCH, index, &mtr);
+
+				if (block == NULL) {
+					fields.clear();
+					break;
+				}
+
+				btr_collect_split_fields(index, block, fields,
+							 NULL, offsets, heap);
+			}
+		}
+
+		/* Pick n_max evenly spaced values, so that the index is
+		split into n_max + 1 parts. */
+		const ulint	n_fields = fields.size();
+
+		for (; n < n_max && n < n_fields; n++) {
+			const byte*	field = n_fields > n_max
+				? fields[(n + 1) * n_fields / (n_max + 1)]
+				: fields[n];
+
+			memcpy(values + n * len, field, len);
+		}
+	}
+
+	mtr.commit();
+
+	if (heap != NULL) {
+		mem_heap_free(heap);
+	}
+
+	return(n);
+}
+
 /*******************************************************************//**
 Record the number of non_null key values in a given index for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
@@ -207,9 +207,9 @@ btr_search_check_free_space_in_heap(const dict_index_t* index)
 
 	if (heap->free_block == NULL) {
 		buf_block_t*	block = buf_block_alloc(NULL);
-		rw_lock_t*	ahi_latch = btr_get_search_latch(index);
+		const ulint	part = btr_search_part_no(index);
 
-		rw_lock_x_lock(ahi_latch);
+		btr_search_x_lock(part);
 
 		if (btr_search_enabled
 		    && heap->free_block == NULL) {
@@ -218,7 +218,7 @@ btr_search_check_free_space_in_heap(const dict_index_t* index)
 			buf_block_free(block);
 		}
 
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(part);
 	}
 }
 
@@ -245,7 +245,13 @@ void btr_search_sys_create(ulint hash_size)
 
 	/* Step-2: Allocate hash tablees. */
 	btr_search_sys = reinterpret_cast<btr_search_sys_t*>(
-		ut_malloc(sizeof(btr_search_sys_t), mem_key_ahi));
+		ut_zalloc(sizeof(btr_search_sys_t), mem_key_ahi));
+
+	/* The counters in btr_search_part_t rely on zero-initialized
+	memory; see ib_counter_t. */
+	btr_search_sys->parts = reinterpret_cast<btr_search_part_t*>(
+		ut_zalloc(sizeof(btr_search_part_t) * btr_ahi_parts,
+			  mem_key_ahi));
 
 	btr_search_sys->hash_tables = reinterpret_cast<hash_table_t**>(
 		ut_malloc(sizeof(hash_table_t*) * btr_ahi_parts, mem_key_ahi));
@@ -319,6 +325,7 @@ void btr_search_sys_free()
 	}
 
 	ut_free(btr_search_sys->hash_tables);
+	ut_free(btr_search_sys->parts);
 	ut_free(btr_search_sys);
 	btr_search_sys = NULL;
 
@@ -333,6 +340,45 @@ void btr_search_sys_free()
 	btr_search_latches = NULL;
 }
 
+/** Sum up the hit or miss counters of adaptive hash index partitions.
+@param[in]	slot	INNODB_METRICS counter, less than BTR_AHI_MONITOR_PARTS
+@param[in]	hits	true=n_hits, false=n_misses
+@return the sum over the partitions slot, slot + BTR_AHI_MONITOR_PARTS, ... */
+ulint btr_search_part_stat(ulint slot, bool hits)
+{
+	ut_ad(slot < BTR_AHI_MONITOR_PARTS);
+
+	if (!btr_search_sys) {
+		return(0);
+	}
+
+	ulint	sum = 0;
+
+	for (ulint i = slot; i < btr_ahi_parts; i += BTR_AHI_MONITOR_PARTS) {
+		const btr_search_part_t& part = btr_search_sys->parts[i];
+		sum += hits ? ulint(part.n_hits) : ulint(part.n_misses);
+	}
+
+	return(sum);
+}
+
+/** Wait for btr_search_guess_latchless() to stop reading the hash tables.
+The caller must have set btr_search_enabled = false. */
+static void btr_search_wait_latchless_readers()
+{
+	ut_ad(!btr_search_enabled);
+
+	/* Pairs with the fence in btr_search_guess_latchless(): either
+	the reader sees !btr_search_enabled, or we see its registration. */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	while (ulint(btr_search_sys->n_latchless_readers)) {
+		os_thread_yield();
+	}
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+}
+
 /** Set index->ref_count = 0 on all indexes of a table.
 @param[in,out]	table	table handler */
 static
@@ -375,6 +421,10 @@ void btr_search_disable(bool need_mutex)
 
 	btr_search_enabled = false;
 
+	/* Lookups that hold no latch may still be reading the hash
+	tables that we are about to clear. */
+	btr_search_wait_latchless_readers();
+
 	/* Clear the index->search_info->ref_count of every index in
 	the data dictionary cache. */
 	for (table = UT_LIST_GET_FIRST(dict_sys->table_LRU); table;
@@ -835,9 +885,10 @@ btr_search_check_guess(
 
 static
 void
-btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
+btr_search_failure(btr_search_t* info, btr_cur_t* cursor, ulint part)
 {
 	cursor->flag = BTR_CUR_HASH_FAIL;
+	btr_search_sys->parts[part].n_misses.inc();
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	++info->n_hash_fail;
@@ -850,6 +901,182 @@ btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
 	info->last_hash_succ = FALSE;
 }
 
+/** Outcome of btr_search_guess_latchless() */
+enum btr_search_latchless_t {
+	/** the page of the found record was latched */
+	BTR_SEARCH_LATCHLESS_HIT,
+	/** the fold value was not found, or the page could not be latched */
+	BTR_SEARCH_LATCHLESS_MISS,
+	/** the partition was modified concurrently; the lookup must be
+	repeated while holding the partition latch */
+	BTR_SEARCH_LATCHLESS_RETRY
+};
+
+/** Check that an adaptive hash index partition was not modified
+since a latch-free lookup started.
+@param[in]	version	btr_search_part_t::version
+@param[in]	v	the even value of version at the start of the lookup
+@return whether everything that was read since then is consistent */
+static inline bool
+btr_search_version_valid(const std::atomic<ulint>& version, ulint v)
+{
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return(version.load(std::memory_order_relaxed) == v);
+}
+
+/** Look up a fold value in an adaptive hash index partition without
+acquiring the partition latch, and buffer-fix the block of the found record.
+Any hash chain node may be freed or overwritten while it is being read.
+The nodes are allocated from buffer pool blocks, which stay mapped, and
+nothing that was read is used before btr_search_part_t::version has been
+validated. The caller must have registered in n_latchless_readers, so
+that btr_search_disable() will not free the hash tables meanwhile.
+@param[in]	part	partition number
+@param[in]	fold	fold value of the search tuple
+@param[in]	v	the even value of btr_search_part_t::version
+@param[out]	rec	the found record
+@param[out]	block	the buffer-fixed block that contains rec
+@return outcome of the lookup */
+static
+btr_search_latchless_t
+btr_search_find_latchless(
+	ulint		part,
+	ulint		fold,
+	ulint		v,
+	const rec_t**	rec,
+	buf_block_t**	block)
+{
+	const std::atomic<ulint>&	version
+		= btr_search_sys->parts[part].version;
+	const hash_table_t*	table = btr_search_sys->hash_tables[part];
+	const ha_node_t*	node = static_cast<const ha_node_t*>(
+		table->array[ut_hash_ulint(fold, table->n_cells)].node);
+	const rec_t*		found;
+
+	/* Validate each pointer before dereferencing it. */
+	for (;;) {
+		if (!btr_search_version_valid(version, v)) {
+			return(BTR_SEARCH_LATCHLESS_RETRY);
+		}
+
+		if (!node) {
+			return(BTR_SEARCH_LATCHLESS_MISS);
+		}
+
+		const ulint	node_fold = node->fold;
+		found = node->data;
+		node = node->next;
+
+		if (node_fold == fold) {
+			break;
+		}
+	}
+
+	if (!btr_search_version_valid(version, v)) {
+		return(BTR_SEARCH_LATCHLESS_RETRY);
+	}
+
+	/* Buffer-fix the block, so that it cannot be freed or reused for
+	another page while we are acquiring the page latch. While we hold
+	the block mutex and the version is unchanged, the hash index entry
+	exists, and the block state cannot change from
+	BUF_BLOCK_REMOVE_HASH before the entry has been removed. */
+	buf_block_t*	b = buf_block_from_ahi_latchless(found);
+	buf_page_mutex_enter(b);
+
+	const bool	valid = btr_search_version_valid(version, v);
+	ut_ad(!valid || buf_block_get_state(b) == BUF_BLOCK_FILE_PAGE
+	      || buf_block_get_state(b) == BUF_BLOCK_REMOVE_HASH);
+	const bool	fixed = valid
+		&& buf_block_get_state(b) == BUF_BLOCK_FILE_PAGE;
+
+	if (fixed) {
+		buf_block_buf_fix_inc(b, __FILE__, __LINE__);
+	}
+
+	buf_page_mutex_exit(b);
+
+	if (!fixed) {
+		return(BTR_SEARCH_LATCHLESS_RETRY);
+	}
+
+	*rec = found;
+	*block = b;
+	return(BTR_SEARCH_LATCHLESS_HIT);
+}
+
+/** Look up a fold value in an adaptive hash index partition without
+acquiring the partition latch, and latch the page of the found record.
+@param[in]	part		partition number
+@param[in]	fold		fold value of the search tuple
+@param[in]	latch_mode	BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param[out]	rec		the found record
+@param[out]	block		the latched page that contains rec
+@param[in,out]	mtr		mini-transaction
+@return outcome of the lookup */
+static
+btr_search_latchless_t
+btr_search_guess_latchless(
+	ulint		part,
+	ulint		fold,
+	ulint		latch_mode,
+	const rec_t**	rec,
+	buf_block_t**	block,
+	mtr_t*		mtr)
+{
+	const std::atomic<ulint>&	version
+		= btr_search_sys->parts[part].version;
+	const ulint	v = version.load(std::memory_order_acquire);
+
+	if (v & 1) {
+		/* btr_search_x_lock() is being held. */
+		return(BTR_SEARCH_LATCHLESS_RETRY);
+	}
+
+	/* Keep btr_search_disable() from freeing the hash tables until
+	we are done reading them. The increment and the decrement must
+	use the same slot. */
+	const size_t	slot = size_t(os_thread_get_curr_id());
+	btr_search_sys->n_latchless_readers.add(slot, 1);
+	/* Pairs with the fence in btr_search_wait_latchless_readers() */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	const rec_t*		found = NULL;
+	buf_block_t*		b = NULL;
+	btr_search_latchless_t	ret = btr_search_enabled
+		? btr_search_find_latchless(part, fold, v, &found, &b)
+		: BTR_SEARCH_LATCHLESS_MISS;
+
+	std::atomic_thread_fence(std::memory_order_release);
+	btr_search_sys->n_latchless_readers.add(slot, ulint(-1));
+
+	if (ret != BTR_SEARCH_LATCHLESS_HIT) {
+		return(ret);
+	}
+
+	const ibool	latched = buf_page_get_known_nowait(
+		latch_mode, b, BUF_MAKE_YOUNG, __FILE__, __LINE__, mtr);
+
+	buf_block_buf_fix_dec(b);
+
+	if (!latched) {
+		return(BTR_SEARCH_LATCHLESS_MISS);
+	}
+
+	/* Any modification of the page after the hash index entry was
+	found would have changed the version. Now that we hold the page
+	latch, the record cannot be modified any more. */
+	if (!btr_search_version_valid(version, v)) {
+		btr_leaf_page_release(b, latch_mode, mtr);
+		return(BTR_SEARCH_LATCHLESS_RETRY);
+	}
+
+	buf_block_dbg_add_level(b, SYNC_TREE_NODE_FROM_HASH);
+	*rec = found;
+	*block = b;
+	return(BTR_SEARCH_LATCHLESS_HIT);
+}
+
 /** Tries to guess the right search position based on the hash search info
 of the index. Note that if mode is PAGE_CUR_LE, which is used in inserts,
 and the function returns TRUE, then cursor->up_match and cursor->low_match
@@ -929,8 +1156,24 @@ btr_search_guess_on_hash(
 	cursor->flag = BTR_CUR_HASH;
 
 	rw_lock_t* use_latch = ahi_latch ? NULL : btr_get_search_latch(index);
+	const ulint	part = btr_search_part_no(index);
+	buf_block_t*	block;
 
 	if (use_latch) {
+		switch (btr_search_guess_latchless(part, fold, latch_mode,
+						   &rec, &block, mtr)) {
+		case BTR_SEARCH_LATCHLESS_HIT:
+			btr_search_sys->n_latchless.inc();
+			goto found;
+		case BTR_SEARCH_LATCHLESS_MISS:
+			btr_search_sys->n_latchless.inc();
+			btr_search_failure(info, cursor, part);
+			return(FALSE);
+		case BTR_SEARCH_LATCHLESS_RETRY:
+			btr_search_sys->n_latchless_retry.inc();
+			break;
+		}
+
 		rw_lock_s_lock(use_latch);
 
 		if (!btr_search_enabled) {
@@ -950,12 +1193,12 @@ btr_search_guess_on_hash(
 			rw_lock_s_unlock(use_latch);
 		}
 
-		btr_search_failure(info, cursor);
+		btr_search_failure(info, cursor, part);
 
 		return(FALSE);
 	}
 
-	buf_block_t*	block = buf_block_from_ahi(rec);
+	block = buf_block_from_ahi(rec);
 
 	if (use_latch) {
 
@@ -970,6 +1213,7 @@ btr_search_guess_on_hash(
 		buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
 	}
 
+found:
 	if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE) {
 
 		ut_ad(buf_block_get_state(block) == BUF_BLOCK_REMOVE_HASH);
@@ -979,7 +1223,7 @@ btr_search_guess_on_hash(
 			btr_leaf_page_release(block, latch_mode, mtr);
 		}
 
-		btr_search_failure(info, cursor);
+		btr_search_failure(info, cursor, part);
 
 		return(FALSE);
 	}
@@ -1002,7 +1246,7 @@ btr_search_guess_on_hash(
 			btr_leaf_page_release(block, latch_mode, mtr);
 		}
 
-		btr_search_failure(info, cursor);
+		btr_search_failure(info, cursor, part);
 
 		return(FALSE);
 	}
@@ -1048,6 +1292,7 @@ btr_search_guess_on_hash(
 	meanwhile! Thus it might not be a bug. */
 #endif
 	info->last_hash_succ = TRUE;
+	btr_search_sys->parts[part].n_hits.inc();
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
@@ -1225,7 +1470,7 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 		mem_heap_free(heap);
 	}
 
-	rw_lock_x_lock(latch);
+	btr_search_x_lock(ahi_slot);
 
 	if (UNIV_UNLIKELY(!block->index)) {
 		/* Someone else has meanwhile dropped the hash index */
@@ -1241,7 +1486,7 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 		/* Someone else has meanwhile built a new hash index on the
 		page, with different parameters */
 
-		rw_lock_x_unlock(latch);
+		btr_search_x_unlock(ahi_slot);
 
 		ut_free(folds);
 		goto retry;
@@ -1265,7 +1510,7 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 
 cleanup:
 	assert_block_ahi_valid(block);
-	rw_lock_x_unlock(latch);
+	btr_search_x_unlock(ahi_slot);
 
 	ut_free(folds);
 }
@@ -1473,7 +1718,7 @@ btr_search_build_page_hash_index(
 	btr_search_check_free_space_in_heap(index);
 
 	hash_table_t*	table	= btr_get_search_table(index);
-	rw_lock_x_lock(ahi_latch);
+	btr_search_x_lock(btr_search_part_no(index));
 
 	if (!btr_search_enabled) {
 		goto exit_func;
@@ -1511,7 +1756,7 @@ btr_search_build_page_hash_index(
 	MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_ROW_ADDED, n_cached);
 exit_func:
 	assert_block_ahi_valid(block);
-	rw_lock_x_unlock(ahi_latch);
+	btr_search_x_unlock(btr_search_part_no(index));
 
 	ut_free(folds);
 	ut_free(recs);
@@ -1554,11 +1799,11 @@ btr_search_info_update_slow(btr_search_t* info, btr_cur_t* cursor)
 		btr_search_n_hash_fail++;
 #endif /* UNIV_SEARCH_PERF_STAT */
 
-		rw_lock_x_lock(ahi_latch);
+		btr_search_x_lock(btr_search_part_no(cursor->index));
 
 		btr_search_update_hash_ref(info, block, cursor);
 
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(btr_search_part_no(cursor->index));
 	}
 
 	if (build_index) {
@@ -1689,9 +1934,9 @@ void btr_search_update_hash_on_delete(btr_cur_t* cursor)
 		mem_heap_free(heap);
 	}
 
-	rw_lock_t*	ahi_latch = btr_get_search_latch(index);
+	const ulint	part = btr_search_part_no(index);
 
-	rw_lock_x_lock(ahi_latch);
+	btr_search_x_lock(part);
 	assert_block_ahi_valid(block);
 
 	if (block->index) {
@@ -1707,7 +1952,7 @@ void btr_search_update_hash_on_delete(btr_cur_t* cursor)
 		assert_block_ahi_valid(block);
 	}
 
-	rw_lock_x_unlock(ahi_latch);
+	btr_search_x_unlock(part);
 }
 
 /** Updates the page hash index when a single record is inserted on a page.
@@ -1748,7 +1993,7 @@ btr_search_update_hash_node_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 	ut_a(cursor->index == index);
 	ut_a(!dict_index_is_ibuf(index));
-	rw_lock_x_lock(ahi_latch);
+	btr_search_x_lock(btr_search_part_no(index));
 
 	if (!block->index) {
 
@@ -1772,9 +2017,9 @@ btr_search_update_hash_node_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 func_exit:
 		assert_block_ahi_valid(block);
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(btr_search_part_no(index));
 	} else {
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(btr_search_part_no(index));
 
 		btr_search_update_hash_on_insert(cursor, ahi_latch);
 	}
@@ -1870,7 +2115,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 	} else {
 		if (left_side) {
 			locked = true;
-			rw_lock_x_lock(ahi_latch);
+			btr_search_x_lock(btr_search_part_no(index));
 
 			if (!btr_search_enabled) {
 				goto function_exit;
@@ -1886,7 +2131,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 		if (!locked) {
 			locked = true;
-			rw_lock_x_lock(ahi_latch);
+			btr_search_x_lock(btr_search_part_no(index));
 
 			if (!btr_search_enabled) {
 				goto function_exit;
@@ -1906,7 +2151,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 		if (!left_side) {
 			if (!locked) {
 				locked = true;
-				rw_lock_x_lock(ahi_latch);
+				btr_search_x_lock(btr_search_part_no(index));
 
 				if (!btr_search_enabled) {
 					goto function_exit;
@@ -1923,7 +2168,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 
 		if (!locked) {
 			locked = true;
-			rw_lock_x_lock(ahi_latch);
+			btr_search_x_lock(btr_search_part_no(index));
 
 			if (!btr_search_enabled) {
 				goto function_exit;
@@ -1942,7 +2187,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor, rw_lock_t* ahi_latch)
 		mem_heap_free(heap);
 	}
 	if (locked) {
-		rw_lock_x_unlock(ahi_latch);
+		btr_search_x_unlock(btr_search_part_no(index));
 	}
 	ut_ad(!rw_lock_own(ahi_latch, RW_LOCK_X));
 }
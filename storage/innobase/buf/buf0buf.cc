@@ -70,6 +70,10 @@ Created 11/5/1995 Heikki Tuuri
 #include <stdlib.h>
 #endif
 
+#ifdef HAVE_URING
+#include <sys/uio.h>
+#endif
+
 #ifdef HAVE_LZO
 #include "lzo/lzo1x.h"
 #endif
@@ -385,6 +389,32 @@ static buf_pool_chunk_map_t*			buf_chunk_map_reg;
 The map pointed by this should not be updated */
 static buf_pool_chunk_map_t*	buf_chunk_map_ref = NULL;
 
+/** Number of buf_page_hash_get_optimistic() calls that may be walking
+a page_hash chain, spread over cache lines. After setting
+buf_pool_resizing, buf_pool_resize() waits for these to finish before
+it frees or replaces anything that the walk could access. */
+static struct buf_page_hash_walkers_t {
+	MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<ulint>	n;
+} buf_page_hash_walkers[IB_N_SLOTS];
+
+/** Wait for the buf_page_hash_get_optimistic() calls that may have
+missed buf_pool_resizing to finish walking the page_hash. */
+static
+void
+buf_page_hash_wait_for_walkers()
+{
+	ut_ad(buf_pool_resizing);
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	for (ulint i = 0; i < array_elements(buf_page_hash_walkers); i++) {
+		while (buf_page_hash_walkers[i].n.load(
+			       std::memory_order_acquire)) {
+			os_thread_yield();
+		}
+	}
+}
+
 #ifdef UNIV_DEBUG
 /** Disable resizing buffer pool to make assertion code not expensive. */
 my_bool			buf_disable_resize_buffer_pool_debug = TRUE;
@@ -2053,6 +2083,54 @@ buf_pool_free_instance(
 	buf_pool->allocator.~ut_allocator();
 }
 
+#ifdef HAVE_URING
+/** Register the memory of all buffer pool chunks with io_uring.
+The kernel limits the size of a registered buffer, so large chunks
+are registered in pieces. */
+static
+void
+buf_pool_register_aio_buffers()
+{
+	/** Maximum size of a registered buffer */
+	const ulint	max_len = 1U << 30;
+	/** Maximum number of registered buffers */
+	const ulint	max_n = 1024;
+
+	std::vector<iovec>	iov;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		const buf_pool_t*	buf_pool = buf_pool_from_array(i);
+
+		for (ulint j = 0; j < buf_pool->n_chunks; j++) {
+			const buf_chunk_t*	chunk = &buf_pool->chunks[j];
+			byte*			mem = chunk->mem;
+			ulint			len = chunk->mem_size();
+
+			while (len > 0) {
+				iovec	v;
+
+				v.iov_base = mem;
+				v.iov_len = std::min(len, max_len);
+				iov.push_back(v);
+
+				mem += v.iov_len;
+				len -= v.iov_len;
+			}
+		}
+	}
+
+	if (iov.size() > max_n) {
+		ib::warn() << "Not registering the buffer pool with io_uring,"
+			" because it consists of " << iov.size()
+			<< " memory ranges; try a larger"
+			" innodb_buffer_pool_chunk_size";
+		return;
+	}
+
+	os_aio_register_buffers(&iov[0], iov.size());
+}
+#endif /* HAVE_URING */
+
 /********************************************************************//**
 Creates the buffer pool.
 @return DB_SUCCESS if success, DB_ERROR if not enough memory or error */
@@ -2099,6 +2177,12 @@ buf_pool_init(
 
 	btr_search_sys_create(buf_pool_get_curr_size() / sizeof(void*) / 64);
 
+#ifdef HAVE_URING
+	if (srv_uring_fixed_buffers) {
+		buf_pool_register_aio_buffers();
+	}
+#endif /* HAVE_URING */
+
 	return(DB_SUCCESS);
 }
 
@@ -2684,6 +2768,12 @@ buf_pool_resize()
 			  srv_buf_pool_old_size, srv_buf_pool_size,
 			  srv_buf_pool_chunk_unit);
 
+#ifdef HAVE_URING
+	/* The chunks may be freed or reallocated. Fall back to
+	normal io_uring reads and writes for the rest of the uptime. */
+	os_aio_unregister_buffers();
+#endif /* HAVE_URING */
+
 	/* set new limit for all buffer pool for resizing */
 	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
 		buf_pool = buf_pool_from_array(i);
@@ -2851,6 +2941,10 @@ buf_pool_resize()
 	/* Indicate critical path */
 	buf_pool_resizing = true;
 
+	/* Lookups that started before this do not hold any latch that
+	would prevent us from freeing chunks or the page_hash. */
+	buf_page_hash_wait_for_walkers();
+
 	/* Acquire all buf_pool_mutex/hash_lock */
 	for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
 		buf_pool_t*	buf_pool = buf_pool_from_array(i);
@@ -4020,12 +4114,14 @@ buf_zip_decompress(
 }
 
 #ifdef BTR_CUR_HASH_ADAPT
-/** Get a buffer block from an adaptive hash index pointer.
-This function does not return if the block is not identified.
+/** Get a buffer block from an adaptive hash index pointer that was read
+without holding the adaptive hash index latch. The block may have been
+freed meanwhile; the caller must check its state while holding the block
+mutex. This function does not return if the block is not identified.
 @param[in]	ptr	pointer to within a page frame
 @return pointer to block, never NULL */
 buf_block_t*
-buf_block_from_ahi(const byte* ptr)
+buf_block_from_ahi_latchless(const byte* ptr)
 {
 	buf_pool_chunk_map_t::iterator it;
 
@@ -4055,6 +4151,17 @@ buf_block_from_ahi(const byte* ptr)
 	/* The function buf_chunk_init() invokes buf_block_init() so that
 	block[n].frame == block->frame + n * srv_page_size.  Check it. */
 	ut_ad(block->frame == page_align(ptr));
+	return(block);
+}
+
+/** Get a buffer block from an adaptive hash index pointer.
+This function does not return if the block is not identified.
+@param[in]	ptr	pointer to within a page frame
+@return pointer to block, never NULL */
+buf_block_t*
+buf_block_from_ahi(const byte* ptr)
+{
+	buf_block_t*	block = buf_block_from_ahi_latchless(ptr);
 	/* Read the state of the block without holding a mutex.
 	A state transition from BUF_BLOCK_FILE_PAGE to
 	BUF_BLOCK_REMOVE_HASH is possible during this execution. */
@@ -4138,6 +4245,135 @@ buf_block_is_uncompressed(
 	return(buf_pointer_is_block_field_instance(buf_pool, (void*) block));
 }
 
+/** Find out if a page_hash node is a block that was created by
+buf_chunk_init(), without dereferencing the pointer.
+@param[in]	bpage	page_hash node
+@return the block
+@retval NULL if bpage is a watch sentinel or a descriptor of
+a compressed-only page, whose memory could have been freed */
+static
+buf_block_t*
+buf_page_hash_node_block(const buf_page_t* bpage)
+{
+	/* The frames of a chunk are allocated after its block
+	descriptors, and the map is ordered by the first frame. */
+	buf_pool_chunk_map_t::const_iterator it
+		= buf_chunk_map_ref->upper_bound(
+			reinterpret_cast<const byte*>(bpage));
+
+	if (it == buf_chunk_map_ref->end()) {
+		return(NULL);
+	}
+
+	const buf_chunk_t*	chunk = it->second;
+	const ulint	offs = ulint(reinterpret_cast<const byte*>(bpage)
+				     - reinterpret_cast<const byte*>(
+					     chunk->blocks));
+
+	if (bpage < &chunk->blocks->page
+	    || offs >= chunk->size * sizeof *chunk->blocks
+	    || offs % sizeof *chunk->blocks) {
+		return(NULL);
+	}
+
+	return(&chunk->blocks[offs / sizeof *chunk->blocks]);
+}
+
+/** Look up and buffer-fix a block without acquiring the page_hash latch.
+The page_hash chain may be modified while it is being traversed, but
+only nodes that are blocks created by buf_chunk_init() are dereferenced,
+and buf_pool_resize() does not free those, the chunk map or the
+page_hash while the caller is registered in buf_page_hash_walkers.
+The result is validated while holding the block mutex, which
+buf_LRU_free_page() and buf_page_realloc() hold while checking the
+buffer-fix count and removing the block from the page_hash.
+@param[in,out]	buf_pool	buffer pool instance
+@param[in]	page_id		page id
+@param[in]	guess		guessed block, or NULL
+@return the buffer-fixed block
+@retval NULL if the lookup must be repeated under the page_hash latch */
+static
+buf_block_t*
+buf_page_hash_walk(
+	buf_pool_t*		buf_pool,
+	const page_id_t		page_id,
+	buf_block_t*		guess)
+{
+	buf_block_t*	block = guess
+		? buf_page_hash_node_block(&guess->page) : NULL;
+
+	if (block == NULL) {
+		hash_table_t*		table = buf_pool->page_hash;
+		const buf_page_t*	bpage = static_cast<const buf_page_t*>(
+			table->array[hash_calc_hash(page_id.fold(), table)]
+			.node);
+
+		/* Give up on long chains. A stale node could even
+		form a cycle. */
+		for (ulint n = 8;;) {
+			if (bpage == NULL || !n--) {
+				return(NULL);
+			}
+
+			block = buf_page_hash_node_block(bpage);
+
+			if (block == NULL) {
+				return(NULL);
+			}
+
+			if (block->page.id == page_id) {
+				break;
+			}
+
+			bpage = block->page.hash;
+		}
+	}
+
+	buf_page_mutex_enter(block);
+
+	const bool	found = block->page.id == page_id
+		&& buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE;
+
+	if (found) {
+		block->fix();
+	}
+
+	buf_page_mutex_exit(block);
+
+	return(found ? block : NULL);
+}
+
+/** Look up and buffer-fix a block without acquiring the page_hash latch,
+unless the buffer pool is being resized.
+@param[in,out]	buf_pool	buffer pool instance
+@param[in]	page_id		page id
+@param[in]	guess		guessed block, or NULL
+@return the buffer-fixed block
+@retval NULL if the lookup must be repeated under the page_hash latch */
+static
+buf_block_t*
+buf_page_hash_get_optimistic(
+	buf_pool_t*		buf_pool,
+	const page_id_t		page_id,
+	buf_block_t*		guess)
+{
+	std::atomic<ulint>&	walkers = buf_page_hash_walkers[
+		get_rnd_value() % array_elements(buf_page_hash_walkers)].n;
+
+	/* Register before checking buf_pool_resizing. Together with
+	the fence in buf_page_hash_wait_for_walkers(), this ensures that
+	either we see the flag, or buf_pool_resize() waits for us. */
+	walkers.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	buf_block_t*	block = buf_pool_resizing
+		? NULL : buf_page_hash_walk(buf_pool, page_id, guess);
+
+	walkers.fetch_sub(1, std::memory_order_release);
+
+	return(block);
+}
+
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
 /********************************************************************//**
 Return true if probe is enabled.
@@ -4277,6 +4513,13 @@ buf_page_get_gen(
 	buf_pool->stat.n_page_gets++;
 	hash_lock = buf_page_hash_lock_get(buf_pool, page_id);
 loop:
+	fix_block = buf_page_hash_get_optimistic(buf_pool, page_id, guess);
+
+	if (fix_block != NULL) {
+		block = fix_block;
+		goto got_block;
+	}
+
 	block = guess;
 
 	rw_lock_s_lock(hash_lock);
@@ -7210,6 +7453,7 @@ buf_print_io(
 		for (i = 0; i < srv_buf_pool_instances; i++) {
 			fprintf(file, "---BUFFER POOL " ULINTPF "\n", i);
 			buf_print_io_instance(&pool_info[i], file);
+			buf_flush_page_cleaner_print(file, i);
 		}
 	}
 
@@ -108,6 +108,20 @@ buf_dblwr_sync_datafiles()
 	os_aio_wait_until_no_pending_writes();
 }
 
+/** Build the path name of a doublewrite file.
+@param[in]	i	file number
+@return	path name, to be freed with ut_free() */
+static
+char*
+buf_dblwr_file_path(ulint i)
+{
+	char	name[sizeof "ib_doublewrite" + 20];
+
+	snprintf(name, sizeof name, "ib_doublewrite" ULINTPF, i);
+
+	return(fil_make_filepath(srv_data_home, name, NO_EXT, false));
+}
+
 /****************************************************************//**
 Creates or initialializes the doublewrite buffer at a database start. */
 static
@@ -156,6 +170,175 @@ buf_dblwr_init(
 
 	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
 		ut_zalloc_nokey(buf_size * sizeof(void*)));
+
+	if (!srv_doublewrite_files || !srv_use_doublewrite_buf
+	    || srv_read_only_mode) {
+		return;
+	}
+
+	/* Batch flushes will be staged in separate files, which are
+	opened by buf_dblwr_files_open(). */
+	buf_dblwr->n_files = srv_doublewrite_files;
+	buf_dblwr->files = static_cast<buf_dblwr_file_t*>(
+		ut_zalloc_nokey(buf_dblwr->n_files
+				* sizeof *buf_dblwr->files));
+
+	for (ulint i = 0; i < buf_dblwr->n_files; i++) {
+		buf_dblwr_file_t&	file = buf_dblwr->files[i];
+
+		mutex_create(LATCH_ID_BUF_DBLWR, &file.mutex);
+		file.b_event = os_event_create("dblwr_file_batch_event");
+		file.path = buf_dblwr_file_path(i);
+		file.handle = OS_FILE_CLOSED;
+
+		file.write_buf_unaligned = static_cast<byte*>(
+			ut_malloc_nokey((1 + srv_doublewrite_batch_size)
+					<< srv_page_size_shift));
+
+		file.write_buf = static_cast<byte*>(
+			ut_align(file.write_buf_unaligned, srv_page_size));
+
+		file.buf_block_arr = static_cast<buf_page_t**>(
+			ut_zalloc_nokey(srv_doublewrite_batch_size
+					* sizeof(void*)));
+	}
+}
+
+/** Open or create the doublewrite files for batch flushing.
+@return whether the operation succeeded */
+static
+bool
+buf_dblwr_files_open()
+{
+	const os_offset_t	size = os_offset_t(srv_doublewrite_batch_size)
+		<< srv_page_size_shift;
+	ulint			n_opened = 0;
+
+	for (ulint i = 0; i < buf_dblwr->n_files; i++) {
+		buf_dblwr_file_t&	file = buf_dblwr->files[i];
+
+		if (file.handle != OS_FILE_CLOSED) {
+			continue;
+		}
+
+		bool		exists;
+		os_file_type_t	type;
+		bool		success = os_file_status(
+			file.path, &exists, &type);
+
+		if (success) {
+			file.handle = os_file_create(
+				innodb_data_file_key, file.path,
+				exists ? OS_FILE_OPEN : OS_FILE_CREATE,
+				OS_FILE_NORMAL, OS_DATA_FILE, false,
+				&success);
+		}
+
+		if (success && os_file_get_size(file.handle) < size) {
+			success = os_file_set_size(file.path, file.handle,
+						   size);
+		}
+
+		if (!success) {
+			ib::error() << "Cannot open or create the"
+				" doublewrite file " << file.path;
+			return(false);
+		}
+
+		n_opened++;
+	}
+
+	if (n_opened) {
+		ib::info() << "Using " << buf_dblwr->n_files
+			<< " doublewrite files for batch flushing";
+	}
+
+	return(true);
+}
+
+/** Read the doublewrite files of any previous innodb_doublewrite_files
+setting, and register the pages in them for crash recovery.
+@return the buffer that holds the pages, to be freed with ut_free() */
+static
+byte*
+buf_dblwr_files_load()
+{
+	const ulint	max_size = TRX_SYS_DOUBLEWRITE_BLOCKS
+		* TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
+	ulint		n_pages[MAX_BUFFER_POOLS];
+	ulint		total = 0;
+
+	for (ulint i = 0; i < MAX_BUFFER_POOLS; i++) {
+		char*		path = buf_dblwr_file_path(i);
+		bool		exists;
+		os_file_type_t	type;
+
+		n_pages[i] = 0;
+
+		if (os_file_status(path, &exists, &type) && exists
+		    && type == OS_FILE_TYPE_FILE) {
+			os_file_size_t	size = os_file_get_size(path);
+
+			if (size.m_total_size != os_offset_t(~0)) {
+				n_pages[i] = std::min<ulint>(
+					ulint(size.m_total_size
+					      >> srv_page_size_shift),
+					max_size);
+				total += n_pages[i];
+			}
+		}
+
+		ut_free(path);
+	}
+
+	if (!total) {
+		return(NULL);
+	}
+
+	byte*	unaligned_buf = static_cast<byte*>(
+		ut_malloc_nokey((1 + total) << srv_page_size_shift));
+	byte*	page = static_cast<byte*>(
+		ut_align(unaligned_buf, srv_page_size));
+
+	for (ulint i = 0; i < MAX_BUFFER_POOLS; i++) {
+		if (!n_pages[i]) {
+			continue;
+		}
+
+		char*		path = buf_dblwr_file_path(i);
+		bool		success;
+		pfs_os_file_t	file = os_file_create(
+			innodb_data_file_key, path, OS_FILE_OPEN,
+			OS_FILE_NORMAL, OS_DATA_FILE, true, &success);
+
+		if (success) {
+			success = os_file_read(
+				IORequestRead, file, page, 0,
+				n_pages[i] << srv_page_size_shift)
+				== DB_SUCCESS;
+			os_file_close(file);
+		}
+
+		if (!success) {
+			ib::warn() << "Failed to read the doublewrite file "
+				<< path;
+			ut_free(path);
+			continue;
+		}
+
+		ut_free(path);
+
+		for (ulint j = 0; j < n_pages[i];
+		     j++, page += srv_page_size) {
+			if (memcmp(field_ref_zero, page + FIL_PAGE_LSN, 8)) {
+				/* Each valid page header must contain
+				a nonzero FIL_PAGE_LSN field. */
+				recv_sys->dblwr.add(page);
+			}
+		}
+	}
+
+	return(unaligned_buf);
 }
 
 /** Create the doublewrite buffer if the doublewrite buffer header
@@ -176,8 +359,9 @@ buf_dblwr_create()
 	mtr_t	mtr;
 
 	if (buf_dblwr) {
-		/* Already inited */
-		return(true);
+		/* Already inited; the doublewrite files may have
+		failed to open in buf_dblwr_init_or_load_pages(). */
+		return(buf_dblwr_files_open());
 	}
 
 start_again:
@@ -195,7 +379,7 @@ buf_dblwr_create()
 
 		mtr.commit();
 		buf_dblwr_being_created = FALSE;
-		return(true);
+		return(buf_dblwr_files_open());
 	} else {
 		if (UT_LIST_GET_FIRST(fil_system.sys_space->chain)->size
 		    < 3 * FSP_EXTENT_SIZE) {
@@ -513,7 +697,51 @@ buf_dblwr_init_or_load_pages(
 
 	ut_free(unaligned_read_buf);
 
-	return(DB_SUCCESS);
+	/* Pages of the doublewrite files are added after the pages of
+	the system tablespace doublewrite buffer. Read the files before
+	buf_dblwr_files_open() may create or extend them. */
+	buf_dblwr->recv_buf_unaligned = buf_dblwr_files_load();
+
+	return(buf_dblwr_files_open() ? DB_SUCCESS : DB_ERROR);
+}
+
+/** Compare the FIL_PAGE_LSN of doublewrite copies of pages.
+@param[in]	a	doublewrite copy of a page
+@param[in]	b	doublewrite copy of a page
+@return whether a is newer than b */
+static
+bool
+buf_dblwr_page_newer(const byte* a, const byte* b)
+{
+	return(mach_read_from_8(a + FIL_PAGE_LSN)
+	       > mach_read_from_8(b + FIL_PAGE_LSN));
+}
+
+/** Delete the doublewrite files that are not used by the current
+innodb_doublewrite_files setting. They were read by
+buf_dblwr_files_load() and are no longer needed after recovery. */
+static
+void
+buf_dblwr_files_remove_unused()
+{
+	if (srv_read_only_mode) {
+		return;
+	}
+
+	for (ulint i = buf_dblwr->n_files; i < MAX_BUFFER_POOLS; i++) {
+		char*	path = buf_dblwr_file_path(i);
+		bool	existed = false;
+
+		os_file_delete_if_exists(innodb_data_file_key, path,
+					 &existed);
+
+		if (existed) {
+			ib::info() << "Removed the unused doublewrite file "
+				<< path;
+		}
+
+		ut_free(path);
+	}
 }
 
 /** Process and remove the double write buffer pages for all tablespaces. */
@@ -536,6 +764,12 @@ buf_dblwr_process()
 		ut_align(unaligned_read_buf, srv_page_size));
 	byte* const buf = read_buf + srv_page_size;
 
+	/* With innodb_doublewrite_files, there may be several copies of
+	a page. Try the newest copies first. Once a good copy has been
+	written to the data file, the older copies will find the page
+	intact and be skipped. */
+	recv_dblwr.pages.sort(buf_dblwr_page_newer);
+
 	for (recv_dblwr_t::list::iterator i = recv_dblwr.pages.begin();
 	     i != recv_dblwr.pages.end();
 	     ++i, ++page_no_dblwr) {
@@ -553,6 +787,19 @@ buf_dblwr_process()
 
 		const ulint		page_no	= page_get_page_no(page);
 		const page_id_t		page_id(space_id, page_no);
+		const lsn_t		lsn = mach_read_from_8(
+			page + FIL_PAGE_LSN);
+
+		if (lsn > recv_sys->recovered_lsn) {
+			/* The redo log must have been written up to the
+			FIL_PAGE_LSN before the page was written. A copy
+			that is newer than the recovered log cannot be
+			consistent with it. */
+			ib::info() << "Ignoring a doublewrite copy of page "
+				<< page_id << " with future log sequence"
+				" number " << lsn;
+			continue;
+		}
 
 		if (page_no >= space->size) {
 
@@ -695,6 +942,10 @@ buf_dblwr_process()
 
 	fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
 	ut_free(unaligned_read_buf);
+	ut_free(buf_dblwr->recv_buf_unaligned);
+	buf_dblwr->recv_buf_unaligned = NULL;
+
+	buf_dblwr_files_remove_unused();
 }
 
 /****************************************************************//**
@@ -718,11 +969,75 @@ buf_dblwr_free()
 	ut_free(buf_dblwr->in_use);
 	buf_dblwr->in_use = NULL;
 
+	for (ulint i = 0; i < buf_dblwr->n_files; i++) {
+		buf_dblwr_file_t&	file = buf_dblwr->files[i];
+
+		ut_ad(file.b_reserved == 0);
+
+		if (file.handle != OS_FILE_CLOSED) {
+			os_file_close(file.handle);
+		}
+
+		os_event_destroy(file.b_event);
+		ut_free(file.write_buf_unaligned);
+		ut_free(file.buf_block_arr);
+		ut_free(file.path);
+		mutex_free(&file.mutex);
+	}
+
+	ut_free(buf_dblwr->files);
+	buf_dblwr->files = NULL;
+	ut_free(buf_dblwr->recv_buf_unaligned);
+	buf_dblwr->recv_buf_unaligned = NULL;
+
 	mutex_free(&buf_dblwr->mutex);
 	ut_free(buf_dblwr);
 	buf_dblwr = NULL;
 }
 
+/** Get the doublewrite file that a page is batch flushed through.
+@param[in]	bpage	page that is being flushed
+@return the doublewrite file of the buffer pool instance of bpage */
+static
+buf_dblwr_file_t*
+buf_dblwr_file(const buf_page_t* bpage)
+{
+	ut_ad(buf_dblwr->n_files);
+
+	return(&buf_dblwr->files[buf_pool_from_bpage(bpage)->instance_no
+				 % buf_dblwr->n_files]);
+}
+
+/** Update a doublewrite file when a batch flush write is completed.
+@param[in,out]	file	doublewrite file that the page was written to */
+static
+void
+buf_dblwr_file_update(buf_dblwr_file_t* file)
+{
+	mutex_enter(&file->mutex);
+
+	ut_ad(file->batch_running);
+	ut_ad(file->b_reserved > 0);
+	ut_ad(file->b_reserved <= file->first_free);
+
+	file->b_reserved--;
+
+	if (file->b_reserved == 0) {
+		mutex_exit(&file->mutex);
+		/* This will finish the batch. Sync data files
+		to the disk. */
+		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+		mutex_enter(&file->mutex);
+
+		/* We can now reuse the doublewrite memory buffer: */
+		file->first_free = 0;
+		file->batch_running = false;
+		os_event_set(file->b_event);
+	}
+
+	mutex_exit(&file->mutex);
+}
+
 /********************************************************************//**
 Updates the doublewrite buffer when an IO request is completed. */
 void
@@ -739,6 +1054,11 @@ buf_dblwr_update(
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
+		if (buf_dblwr->n_files) {
+			buf_dblwr_file_update(buf_dblwr_file(bpage));
+			break;
+		}
+
 		mutex_enter(&buf_dblwr->mutex);
 
 		ut_ad(buf_dblwr->batch_running);
@@ -946,14 +1266,120 @@ buf_dblwr_write_block_to_datafile(
 	}
 }
 
+/** Check the pages of a batch before it is written to the doublewrite
+buffer.
+@param[in]	buf_block_arr	the blocks in the batch
+@param[in]	write_buf	copies of the blocks in the batch
+@param[in]	n		number of blocks in the batch */
+static
+void
+buf_dblwr_check_batch(
+	buf_page_t* const*	buf_block_arr,
+	const byte*		write_buf,
+	ulint			n)
+{
+	for (ulint len2 = 0, i = 0; i < n; len2 += srv_page_size, i++) {
+
+		const buf_block_t*	block;
+
+		block = (buf_block_t*) buf_block_arr[i];
+
+		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
+		    || block->page.zip.data) {
+			/* No simple validate for compressed
+			pages exists. */
+			continue;
+		}
+
+		/* Check that the actual page in the buffer pool is
+		not corrupt and the LSN values are sane. */
+		buf_dblwr_check_block(block);
+		ut_d(buf_dblwr_check_page_lsn(block->page, write_buf + len2));
+	}
+}
+
+/** Write the batch of a doublewrite file and sync it, and then post the
+writes of the batch to the data files.
+@param[in,out]	file	doublewrite file */
+static
+void
+buf_dblwr_file_flush(buf_dblwr_file_t* file)
+{
+try_again:
+	mutex_enter(&file->mutex);
+
+	if (file->first_free == 0) {
+		mutex_exit(&file->mutex);
+		os_aio_simulated_wake_handler_threads();
+		return;
+	}
+
+	if (file->batch_running) {
+		/* Another thread is running the batch right now. Wait
+		for it to finish. */
+		int64_t	sig_count = os_event_reset(file->b_event);
+		mutex_exit(&file->mutex);
+
+		os_event_wait_low(file->b_event, sig_count);
+		goto try_again;
+	}
+
+	ut_ad(file->first_free == file->b_reserved);
+
+	/* Disallow anyone else to post to this file or to start
+	another batch of flushing through it. The other doublewrite
+	files are not affected. */
+	file->batch_running = true;
+	const ulint	first_free = file->first_free;
+
+	mutex_exit(&file->mutex);
+
+	buf_dblwr_check_batch(file->buf_block_arr, file->write_buf,
+			      first_free);
+
+	dberr_t	err = os_file_write(
+		IORequestWrite, file->path, file->handle, file->write_buf,
+		0, first_free << srv_page_size_shift);
+
+	if (err != DB_SUCCESS || !os_file_flush(file->handle)) {
+		ib::fatal() << "Failed to write to the doublewrite file "
+			<< file->path;
+	}
+
+	DBUG_EXECUTE_IF("buf_dblwr_file_torn_write",
+		/* Write only the first half of the first page of the
+		batch to the data file, and kill the server. */
+		const buf_page_t* bpage = file->buf_block_arr[0];
+		const ulint zip_size = bpage->zip_size();
+		fil_io(IORequestWrite, true, bpage->id, zip_size, 0,
+		       (zip_size ? zip_size : srv_page_size) / 2,
+		       file->write_buf, NULL);
+		DBUG_SUICIDE(););
+
+	srv_stats.dblwr_pages_written.add(first_free);
+	srv_stats.dblwr_writes.inc();
+
+	/* As in buf_dblwr_flush_buffered_writes(), the batch may
+	complete and a new one be started before this loop ends, so
+	we must not read file->first_free here. */
+	for (ulint i = 0; i < first_free; i++) {
+		buf_dblwr_write_block_to_datafile(
+			file->buf_block_arr[i], false);
+	}
+
+	os_aio_simulated_wake_handler_threads();
+}
+
 /********************************************************************//**
 Flushes possible buffered writes from the doublewrite memory buffer to disk,
 and also wakes up the aio thread if simulated aio is used. It is very
 important to call this function after a batch of writes has been posted,
 and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+of threads can occur.
+@param[in]	buf_pool	buffer pool instance whose doublewrite file
+				should be flushed, or NULL to flush all */
 void
-buf_dblwr_flush_buffered_writes()
+buf_dblwr_flush_buffered_writes(const buf_pool_t* buf_pool)
 {
 	byte*		write_buf;
 	ulint		first_free;
@@ -969,6 +1395,19 @@ buf_dblwr_flush_buffered_writes()
 
 	ut_ad(!srv_read_only_mode);
 
+	if (buf_dblwr->n_files) {
+		if (buf_pool) {
+			buf_dblwr_file_flush(
+				&buf_dblwr->files[buf_pool->instance_no
+						  % buf_dblwr->n_files]);
+		} else {
+			for (ulint i = 0; i < buf_dblwr->n_files; i++) {
+				buf_dblwr_file_flush(&buf_dblwr->files[i]);
+			}
+		}
+		return;
+	}
+
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
@@ -1014,26 +1453,8 @@ buf_dblwr_flush_buffered_writes()
 
 	write_buf = buf_dblwr->write_buf;
 
-	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
-	     len2 += srv_page_size, i++) {
-
-		const buf_block_t*	block;
-
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
-
-		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
-		    || block->page.zip.data) {
-			/* No simple validate for compressed
-			pages exists. */
-			continue;
-		}
-
-		/* Check that the actual page in the buffer pool is
-		not corrupt and the LSN values are sane. */
-		buf_dblwr_check_block(block);
-		ut_d(buf_dblwr_check_page_lsn(block->page, write_buf + len2));
-	}
+	buf_dblwr_check_batch(buf_dblwr->buf_block_arr, write_buf,
+			      first_free);
 
 	/* Write out the first block of the doublewrite buffer */
 	len = std::min<ulint>(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
@@ -1095,6 +1516,78 @@ buf_dblwr_flush_buffered_writes()
 	os_aio_simulated_wake_handler_threads();
 }
 
+/** Copy a page to a slot of a doublewrite memory buffer.
+@param[out]	p	the slot
+@param[in]	bpage	page to be written */
+static
+void
+buf_dblwr_copy_page(byte* p, const buf_page_t* bpage)
+{
+	/* We request frame here to get correct buffer in case of
+	encryption and/or page compression */
+	const void* frame = buf_page_get_frame(bpage);
+
+	if (auto zip_size = bpage->zip_size()) {
+		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
+		/* Copy the compressed page and clear the rest. */
+		memcpy(p, frame, zip_size);
+		memset(p + zip_size, 0x0, srv_page_size - zip_size);
+	} else {
+		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
+
+		UNIV_MEM_ASSERT_RW(frame, srv_page_size);
+		memcpy(p, frame, srv_page_size);
+	}
+}
+
+/** Post a page for writing through a doublewrite file. If the batch of
+the file is full, it is flushed first.
+@param[in,out]	file	doublewrite file
+@param[in]	bpage	page to write */
+static
+void
+buf_dblwr_file_add_to_batch(buf_dblwr_file_t* file, buf_page_t* bpage)
+{
+try_again:
+	mutex_enter(&file->mutex);
+
+	ut_a(file->first_free <= srv_doublewrite_batch_size);
+
+	if (file->batch_running) {
+		int64_t	sig_count = os_event_reset(file->b_event);
+		mutex_exit(&file->mutex);
+
+		os_event_wait_low(file->b_event, sig_count);
+		goto try_again;
+	}
+
+	if (file->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&file->mutex);
+
+		buf_dblwr_file_flush(file);
+
+		goto try_again;
+	}
+
+	buf_dblwr_copy_page(file->write_buf
+			    + srv_page_size * file->first_free, bpage);
+
+	file->buf_block_arr[file->first_free] = bpage;
+
+	file->first_free++;
+	file->b_reserved++;
+
+	ut_ad(file->first_free == file->b_reserved);
+
+	const bool	full = file->first_free == srv_doublewrite_batch_size;
+
+	mutex_exit(&file->mutex);
+
+	if (full) {
+		buf_dblwr_file_flush(file);
+	}
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1106,6 +1599,11 @@ buf_dblwr_add_to_batch(
 {
 	ut_a(buf_page_in_file(bpage));
 
+	if (buf_dblwr->n_files) {
+		buf_dblwr_file_add_to_batch(buf_dblwr_file(bpage), bpage);
+		return;
+	}
+
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
@@ -1134,24 +1632,9 @@ buf_dblwr_add_to_batch(
 		goto try_again;
 	}
 
-	byte*	p = buf_dblwr->write_buf
-		+ srv_page_size * buf_dblwr->first_free;
-
-	/* We request frame here to get correct buffer in case of
-	encryption and/or page compression */
-	void * frame = buf_page_get_frame(bpage);
-
-	if (auto zip_size = bpage->zip_size()) {
-		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
-		/* Copy the compressed page and clear the rest. */
-		memcpy(p, frame, zip_size);
-		memset(p + zip_size, 0x0, srv_page_size - zip_size);
-	} else {
-		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
-
-		UNIV_MEM_ASSERT_RW(frame, srv_page_size);
-		memcpy(p, frame, srv_page_size);
-	}
+	buf_dblwr_copy_page(buf_dblwr->write_buf
+			    + srv_page_size * buf_dblwr->first_free,
+			    bpage);
 
 	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
 
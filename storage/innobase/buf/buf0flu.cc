@@ -113,10 +113,13 @@ struct page_cleaner_slot_t {
 					set to PAGE_CLEANER_STATE_FLUSHING,
 					n_flushed_lru and n_flushed_list can be
 					updated only by the worker thread */
-	/* This value is set during state==PAGE_CLEANER_STATE_NONE */
+	/* These values are set during state==PAGE_CLEANER_STATE_NONE */
 	ulint			n_pages_requested;
 					/*!< number of requested pages
 					for the slot */
+	lsn_t			lsn_limit;
+					/*!< upper limit of LSN to be
+					flushed */
 	/* These values are updated during state==PAGE_CLEANER_STATE_FLUSHING,
 	and commited with state==PAGE_CLEANER_STATE_FINISHED.
 	The consistency is protected by the 'state' */
@@ -148,16 +151,13 @@ struct page_cleaner_t {
 						page_cleaner_slot_t slots. */
 	os_event_t		is_requested;	/*!< event to activate worker
 						threads. */
-	os_event_t		is_finished;	/*!< event to signal that all
-						slots were finished. */
+	os_event_t		is_finished;	/*!< event to signal that no
+						slot is requested or
+						being flushed. */
 	os_event_t		is_started;	/*!< event to signal that
 						thread is started/exiting */
 	volatile ulint		n_workers;	/*!< number of worker threads
 						in existence */
-	bool			requested;	/*!< true if requested pages
-						to flush */
-	lsn_t			lsn_limit;	/*!< upper limit of LSN to be
-						flushed */
 	ulint			n_slots;	/*!< total number of slots */
 	ulint			n_slots_requested;
 						/*!< number of slots
@@ -1184,7 +1184,8 @@ buf_flush_page(
 				/* avoiding deadlock possibility involves
 				doublewrite buffer, should flush it, because
 				it might hold the another block->lock. */
-				buf_dblwr_flush_buffered_writes();
+				buf_dblwr_flush_buffered_writes(
+					buf_pool_from_bpage(bpage));
 			} else {
 				buf_dblwr_sync_datafiles();
 			}
@@ -1930,7 +1931,7 @@ buf_flush_end(
 	buf_pool_mutex_exit(buf_pool);
 
 	if (!srv_read_only_mode) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool);
 	} else {
 		os_aio_simulated_wake_handler_threads();
 	}
@@ -2289,17 +2290,14 @@ buf_flush_wait_LRU_batch_end(void)
 	}
 }
 
-/*********************************************************************//**
-Calculates if flushing is required based on number of dirty pages in
+/** Calculate if flushing is required based on number of dirty pages in
 the buffer pool.
+@param[in]	dirty_pct	percentage of modified pages
 @return percent of io_capacity to flush to manage dirty page ratio */
 static
 ulint
-af_get_pct_for_dirty()
-/*==================*/
+af_get_pct_for_dirty(double dirty_pct)
 {
-	double	dirty_pct = buf_get_modified_ratio_pct();
-
 	if (dirty_pct == 0.0) {
 		/* No pages modified */
 		return(0);
@@ -2373,13 +2371,16 @@ need to do flushing.
 @return number of pages recommended to be flushed
 @param lsn_limit	pointer to return LSN up to which flushing must happen
 @param last_pages_in	the number of pages flushed by the last flush_list
-			flushing. */
+			flushing.
+@param n_pages_slot	number of pages recommended for each buffer pool
+			instance */
 static
 ulint
 page_cleaner_flush_pages_recommendation(
 /*====================================*/
 	lsn_t*	lsn_limit,
-	ulint	last_pages_in)
+	ulint	last_pages_in,
+	ulint*	n_pages_slot)
 {
 	static	lsn_t		prev_lsn = 0;
 	static	ulint		sum_pages = 0;
@@ -2393,7 +2394,6 @@ page_cleaner_flush_pages_recommendation(
 	ulint			n_pages = 0;
 	ulint			pct_for_dirty = 0;
 	ulint			pct_for_lsn = 0;
-	ulint			pct_total = 0;
 
 	cur_lsn = log_get_lsn_nowait();
 
@@ -2531,22 +2531,26 @@ page_cleaner_flush_pages_recommendation(
 
 	age = cur_lsn > oldest_lsn ? cur_lsn - oldest_lsn : 0;
 
-	pct_for_dirty = af_get_pct_for_dirty();
+	pct_for_dirty = af_get_pct_for_dirty(buf_get_modified_ratio_pct());
 	pct_for_lsn = af_get_pct_for_lsn(age);
 
-	pct_total = ut_max(pct_for_dirty, pct_for_lsn);
-
 	/* Estimate pages to be flushed for the lsn progress */
 	ulint	sum_pages_for_lsn = 0;
 	lsn_t	target_lsn = oldest_lsn
 			     + lsn_avg_rate * buf_flush_lsn_scan_factor;
+	lsn_t	max_age = 0;
 
 	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
 		buf_pool_t*	buf_pool = buf_pool_from_array(i);
 		ulint		pages_for_lsn = 0;
+		lsn_t		instance_age = 0;
 
 		buf_flush_list_mutex_enter(buf_pool);
-		for (buf_page_t* b = UT_LIST_GET_LAST(buf_pool->flush_list);
+		const buf_page_t* last = UT_LIST_GET_LAST(buf_pool->flush_list);
+		if (last && cur_lsn > last->oldest_modification) {
+			instance_age = cur_lsn - last->oldest_modification;
+		}
+		for (const buf_page_t* b = last;
 		     b != NULL;
 		     b = UT_LIST_GET_PREV(list, b)) {
 			if (b->oldest_modification > target_lsn) {
@@ -2554,49 +2558,49 @@ page_cleaner_flush_pages_recommendation(
 			}
 			++pages_for_lsn;
 		}
+		const ulint	flush_list_len
+			= UT_LIST_GET_LEN(buf_pool->flush_list);
 		buf_flush_list_mutex_exit(buf_pool);
 
 		sum_pages_for_lsn += pages_for_lsn;
-
-		mutex_enter(&page_cleaner.mutex);
-		ut_ad(page_cleaner.slots[i].state
-		      == PAGE_CLEANER_STATE_NONE);
-		page_cleaner.slots[i].n_pages_requested
-			= pages_for_lsn / buf_flush_lsn_scan_factor + 1;
-		mutex_exit(&page_cleaner.mutex);
+		max_age = std::max(max_age, instance_age);
+
+		/* Each instance gets its share of the I/O capacity
+		and of the page rate according to its own dirty page
+		ratio and redo log age, and the number of its pages
+		that are needed for the LSN progress. This way, an
+		instance that is lagging behind will be flushed more. */
+		const double	dirty_pct = static_cast<double>(
+			100 * flush_list_len)
+			/ (1 + UT_LIST_GET_LEN(buf_pool->LRU)
+			   + UT_LIST_GET_LEN(buf_pool->free));
+		const ulint	pct = ut_max(af_get_pct_for_dirty(dirty_pct),
+					     af_get_pct_for_lsn(instance_age));
+
+		n_pages_slot[i] = (PCT_IO(pct) + avg_page_rate)
+			/ (3 * srv_buf_pool_instances)
+			+ std::min<ulint>(pages_for_lsn
+					  / buf_flush_lsn_scan_factor,
+					  srv_max_io_capacity * 2) / 3
+			+ 1;
+		n_pages += n_pages_slot[i];
 	}
 
 	sum_pages_for_lsn /= buf_flush_lsn_scan_factor;
-	if(sum_pages_for_lsn < 1) {
-		sum_pages_for_lsn = 1;
-	}
 
 	/* Cap the maximum IO capacity that we are going to use by
-	max_io_capacity. Limit the value to avoid too quick increase */
-	ulint	pages_for_lsn =
-		std::min<ulint>(sum_pages_for_lsn, srv_max_io_capacity * 2);
-
-	n_pages = (PCT_IO(pct_total) + avg_page_rate + pages_for_lsn) / 3;
-
+	max_io_capacity. */
 	if (n_pages > srv_max_io_capacity) {
-		n_pages = srv_max_io_capacity;
-	}
+		ulint	sum = 0;
 
-	/* Normalize request for each instance */
-	mutex_enter(&page_cleaner.mutex);
-	ut_ad(page_cleaner.n_slots_requested == 0);
-	ut_ad(page_cleaner.n_slots_flushing == 0);
-	ut_ad(page_cleaner.n_slots_finished == 0);
+		for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+			n_pages_slot[i] = n_pages_slot[i]
+				* srv_max_io_capacity / n_pages + 1;
+			sum += n_pages_slot[i];
+		}
 
-	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
-		/* if REDO has enough of free space,
-		don't care about age distribution of pages */
-		page_cleaner.slots[i].n_pages_requested = pct_for_lsn > 30 ?
-			page_cleaner.slots[i].n_pages_requested
-			* n_pages / sum_pages_for_lsn + 1
-			: n_pages / srv_buf_pool_instances;
+		n_pages = sum;
 	}
-	mutex_exit(&page_cleaner.mutex);
 
 	MONITOR_SET(MONITOR_FLUSH_N_TO_FLUSH_REQUESTED, n_pages);
 
@@ -2606,6 +2610,7 @@ page_cleaner_flush_pages_recommendation(
 	MONITOR_SET(MONITOR_FLUSH_LSN_AVG_RATE, lsn_avg_rate);
 	MONITOR_SET(MONITOR_FLUSH_PCT_FOR_DIRTY, pct_for_dirty);
 	MONITOR_SET(MONITOR_FLUSH_PCT_FOR_LSN, pct_for_lsn);
+	MONITOR_SET(MONITOR_FLUSH_MAX_INSTANCE_AGE, max_age);
 
 	*lsn_limit = LSN_MAX;
 
@@ -2670,18 +2675,24 @@ buf_flush_page_cleaner_init(void)
 }
 
 /**
-Requests for all slots to flush all buffer pool instances.
+Requests for all idle slots to flush their buffer pool instances.
+A slot whose previous request has not been collected by
+pc_wait_finished() yet is skipped, so that a slow instance will not
+delay the flushing of the others.
 @param min_n	wished minimum mumber of blocks flushed
 		(it is not guaranteed that the actual number is that big)
 @param lsn_limit in the case BUF_FLUSH_LIST all blocks whose
 		oldest_modification is smaller than this should be flushed
 		(if their number does not exceed min_n), otherwise ignored
-*/
+@param n_pages_slot	NULL, or the wished minimum number of blocks
+		flushed for each instance, if min_n is neither 0 nor ULINT_MAX
+@return	number of slots that were skipped */
 static
-void
+ulint
 pc_request(
 	ulint		min_n,
-	lsn_t		lsn_limit)
+	lsn_t		lsn_limit,
+	const ulint*	n_pages_slot = NULL)
 {
 	if (min_n != ULINT_MAX) {
 		/* Ensure that flushing is spread evenly amongst the
@@ -2692,39 +2703,36 @@ pc_request(
 			/ srv_buf_pool_instances;
 	}
 
-	mutex_enter(&page_cleaner.mutex);
-
-	ut_ad(page_cleaner.n_slots_requested == 0);
-	ut_ad(page_cleaner.n_slots_flushing == 0);
-	ut_ad(page_cleaner.n_slots_finished == 0);
+	ulint	n_busy = 0;
 
-	page_cleaner.requested = (min_n > 0);
-	page_cleaner.lsn_limit = lsn_limit;
+	mutex_enter(&page_cleaner.mutex);
 
 	for (ulint i = 0; i < page_cleaner.n_slots; i++) {
 		page_cleaner_slot_t* slot = &page_cleaner.slots[i];
 
-		ut_ad(slot->state == PAGE_CLEANER_STATE_NONE);
-
-		if (min_n == ULINT_MAX) {
-			slot->n_pages_requested = ULINT_MAX;
-		} else if (min_n == 0) {
-			slot->n_pages_requested = 0;
+		if (slot->state != PAGE_CLEANER_STATE_NONE) {
+			n_busy++;
+			continue;
 		}
 
-		/* slot->n_pages_requested was already set by
-		page_cleaner_flush_pages_recommendation() */
+		if (min_n == ULINT_MAX || min_n == 0 || !n_pages_slot) {
+			slot->n_pages_requested = min_n;
+		} else {
+			slot->n_pages_requested = n_pages_slot[i];
+		}
 
+		slot->lsn_limit = lsn_limit;
 		slot->state = PAGE_CLEANER_STATE_REQUESTED;
+		page_cleaner.n_slots_requested++;
 	}
 
-	page_cleaner.n_slots_requested = page_cleaner.n_slots;
-	page_cleaner.n_slots_flushing = 0;
-	page_cleaner.n_slots_finished = 0;
-
-	os_event_set(page_cleaner.is_requested);
+	if (page_cleaner.n_slots_requested) {
+		os_event_set(page_cleaner.is_requested);
+	}
 
 	mutex_exit(&page_cleaner.mutex);
+
+	return(n_busy);
 }
 
 /**
@@ -2777,6 +2785,10 @@ pc_flush_slot(void)
 
 		mutex_exit(&page_cleaner.mutex);
 
+		/* Keep the slot busy past the next request round. */
+		DBUG_EXECUTE_IF("page_cleaner_slow_flush",
+				os_thread_sleep(2000000););
+
 		lru_tm = ut_time_ms();
 
 		/* Flush pages from end of LRU if required */
@@ -2791,7 +2803,7 @@ pc_flush_slot(void)
 		}
 
 		/* Flush pages from flush_list if required */
-		if (page_cleaner.requested) {
+		if (slot->n_pages_requested) {
 			flush_counters_t n;
 			memset(&n, 0, sizeof(flush_counters_t));
 			list_tm = ut_time_ms();
@@ -2799,7 +2811,7 @@ pc_flush_slot(void)
 			slot->succeeded_list = buf_flush_do_batch(
 				buf_pool, BUF_FLUSH_LIST,
 				slot->n_pages_requested,
-				page_cleaner.lsn_limit,
+				slot->lsn_limit,
 				&n);
 
 			slot->n_flushed_list = n.flushed;
@@ -2836,53 +2848,95 @@ pc_flush_slot(void)
 }
 
 /**
-Wait until all flush requests are finished.
-@param n_flushed_lru	number of pages flushed from the end of the LRU list.
-@param n_flushed_list	number of pages flushed from the end of the
-			flush_list.
-@return			true if all flush_list flushing batch were success. */
+Collect the results of finished flush requests.
+@param n_flushed_lru	incremented by the number of pages flushed from
+			the end of the LRU list.
+@param n_flushed_list	incremented by the number of pages flushed from
+			the end of the flush_list.
+@param wait		whether to wait until all requests are finished
+@return			true if all collected flush_list flushing batches
+			were successful. */
 static
 bool
 pc_wait_finished(
 	ulint*	n_flushed_lru,
-	ulint*	n_flushed_list)
+	ulint*	n_flushed_list,
+	bool	wait = true)
 {
 	bool	all_succeeded = true;
 
-	*n_flushed_lru = 0;
-	*n_flushed_list = 0;
-
-	os_event_wait(page_cleaner.is_finished);
-
 	mutex_enter(&page_cleaner.mutex);
 
-	ut_ad(page_cleaner.n_slots_requested == 0);
-	ut_ad(page_cleaner.n_slots_flushing == 0);
-	ut_ad(page_cleaner.n_slots_finished == page_cleaner.n_slots);
+	while (wait && (page_cleaner.n_slots_requested
+			|| page_cleaner.n_slots_flushing)) {
+		if (page_cleaner.n_slots_requested) {
+			/* The worker threads may be busy or gone.
+			Treat the remaining requests by ourselves. */
+			mutex_exit(&page_cleaner.mutex);
+			pc_flush_slot();
+		} else {
+			int64_t	sig_count = os_event_reset(
+				page_cleaner.is_finished);
+			mutex_exit(&page_cleaner.mutex);
+			os_event_wait_low(page_cleaner.is_finished, sig_count);
+		}
+
+		mutex_enter(&page_cleaner.mutex);
+	}
 
 	for (ulint i = 0; i < page_cleaner.n_slots; i++) {
 		page_cleaner_slot_t* slot = &page_cleaner.slots[i];
 
-		ut_ad(slot->state == PAGE_CLEANER_STATE_FINISHED);
+		if (slot->state != PAGE_CLEANER_STATE_FINISHED) {
+			ut_ad(!wait || slot->state == PAGE_CLEANER_STATE_NONE);
+			continue;
+		}
 
 		*n_flushed_lru += slot->n_flushed_lru;
 		*n_flushed_list += slot->n_flushed_list;
 		all_succeeded &= slot->succeeded_list;
 
 		slot->state = PAGE_CLEANER_STATE_NONE;
-
-		slot->n_pages_requested = 0;
+		page_cleaner.n_slots_finished--;
 	}
 
-	page_cleaner.n_slots_finished = 0;
-
-	os_event_reset(page_cleaner.is_finished);
+	ut_ad(page_cleaner.n_slots_finished == 0);
 
 	mutex_exit(&page_cleaner.mutex);
 
 	return(all_succeeded);
 }
 
+/** Print the page cleaner state of a buffer pool instance.
+@param[out]	file	output stream
+@param[in]	i	buffer pool instance number */
+void
+buf_flush_page_cleaner_print(FILE* file, ulint i)
+{
+	if (!page_cleaner.is_running) {
+		return;
+	}
+
+	mutex_enter(&page_cleaner.mutex);
+	const page_cleaner_slot_t&	slot = page_cleaner.slots[i];
+	const bool	busy = slot.state == PAGE_CLEANER_STATE_REQUESTED
+		|| slot.state == PAGE_CLEANER_STATE_FLUSHING;
+	const ulint	n_requested = slot.n_pages_requested;
+	const ulint	n_lru = busy ? 0 : slot.n_flushed_lru;
+	const ulint	n_list = busy ? 0 : slot.n_flushed_list;
+	mutex_exit(&page_cleaner.mutex);
+
+	if (busy) {
+		fprintf(file, "Page cleaner flushing, requested "
+			ULINTPF " pages\n",
+			n_requested == ULINT_MAX ? 0 : n_requested);
+	} else {
+		fprintf(file, "Page cleaner idle, last batch flushed "
+			ULINTPF " LRU, " ULINTPF " flush list pages\n",
+			n_lru, n_list);
+	}
+}
+
 #ifdef UNIV_LINUX
 /**
 Set priority for page_cleaner threads.
@@ -3159,6 +3213,12 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 			buf_flush_sync_lsn = 0;
 			mutex_exit(&page_cleaner.mutex);
 
+			/* Wait for earlier requests, so that all slots
+			will be requested. */
+			ulint	n_flushed_lru = 0;
+			ulint	n_flushed_list = 0;
+			pc_wait_finished(&n_flushed_lru, &n_flushed_list);
+
 			/* Request flushing for threads */
 			pc_request(ULINT_MAX, lsn_limit);
 
@@ -3173,8 +3233,6 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 			page_cleaner.flush_pass++;
 
 			/* Wait for all slots to be finished */
-			ulint	n_flushed_lru = 0;
-			ulint	n_flushed_list = 0;
 			pc_wait_finished(&n_flushed_lru, &n_flushed_list);
 
 			if (n_flushed_list > 0 || n_flushed_lru > 0) {
@@ -3192,25 +3250,44 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 		} else if (srv_check_activity(last_activity)) {
 			ulint	n_to_flush;
 			lsn_t	lsn_limit = 0;
+			ulint	n_pages_slot[MAX_BUFFER_POOLS];
+			ulint	n_flushed_lru = 0;
+			ulint	n_flushed_list = 0;
+
+			/* Collect the slots that finished since the
+			previous round, so that they can be requested again. */
+			pc_wait_finished(&n_flushed_lru, &n_flushed_list,
+					 false);
 
 			/* Estimate pages from flush_list to be flushed */
 			if (ret_sleep == OS_SYNC_TIME_EXCEEDED) {
 				last_activity = srv_get_activity_count();
 				n_to_flush =
 					page_cleaner_flush_pages_recommendation(
-						&lsn_limit, last_pages);
+						&lsn_limit, last_pages,
+						n_pages_slot);
 			} else {
 				n_to_flush = 0;
 			}
 
-			/* Request flushing for threads */
-			pc_request(n_to_flush, lsn_limit);
+			/* Request flushing for threads. Instances that
+			are still busy with an earlier request are skipped. */
+			if (ulint n_busy = pc_request(n_to_flush, lsn_limit,
+						      n_pages_slot)) {
+				MONITOR_INC_VALUE(MONITOR_FLUSH_BUSY_INSTANCES,
+						  n_busy);
+			}
 
 			ulint tm = ut_time_ms();
 
-			/* Coordinator also treats requests */
-			while (pc_flush_slot() > 0) {
-				/* No op */
+			/* If there are no worker threads, the coordinator
+			treats the requests. Otherwise, it will not wait
+			for them to finish, so that the flushing of each
+			instance progresses independently of the others. */
+			if (!page_cleaner.n_workers) {
+				while (pc_flush_slot() > 0) {
+					/* No op */
+				}
 			}
 
 			/* only coordinator is using these counters,
@@ -3218,11 +3295,8 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 			page_cleaner.flush_time += ut_time_ms() - tm;
 			page_cleaner.flush_pass++ ;
 
-			/* Wait for all slots to be finished */
-			ulint	n_flushed_lru = 0;
-			ulint	n_flushed_list = 0;
-
-			pc_wait_finished(&n_flushed_lru, &n_flushed_list);
+			pc_wait_finished(&n_flushed_lru, &n_flushed_list,
+					 false);
 
 			if (n_flushed_list > 0 || n_flushed_lru > 0) {
 				buf_flush_stats(n_flushed_list, n_flushed_lru);
@@ -3297,6 +3371,14 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 	the buffer pool but can't be sure that no new pages are being
 	dirtied until we enter SRV_SHUTDOWN_FLUSH_PHASE phase. */
 
+	{
+		/* Wait for any requests that are still being
+		processed by the worker threads. */
+		ulint	n_flushed_lru = 0;
+		ulint	n_flushed_list = 0;
+		pc_wait_finished(&n_flushed_lru, &n_flushed_list);
+	}
+
 	do {
 		pc_request(ULINT_MAX, LSN_MAX);
 
@@ -604,7 +604,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(trx_pool_mutex),
 	PSI_KEY(trx_pool_manager_mutex),
 	PSI_KEY(srv_sys_mutex),
-	PSI_KEY(lock_mutex),
+	PSI_KEY(lock_rec_hash_mutex),
 	PSI_KEY(lock_wait_mutex),
 	PSI_KEY(trx_mutex),
 	PSI_KEY(srv_threads_mutex),
@@ -642,7 +642,8 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	PSI_RWLOCK_KEY(index_tree_rw_lock),
 	PSI_RWLOCK_KEY(index_online_log),
 	PSI_RWLOCK_KEY(dict_table_stats),
-	PSI_RWLOCK_KEY(hash_table_locks)
+	PSI_RWLOCK_KEY(hash_table_locks),
+	PSI_RWLOCK_KEY(lock_latch)
 };
 # endif /* UNIV_PFS_RWLOCK */
 
@@ -659,6 +660,7 @@ static PSI_thread_info	all_innodb_threads[] = {
 	PSI_KEY(io_read_thread),
 	PSI_KEY(io_write_thread),
 	PSI_KEY(page_cleaner_thread),
+	PSI_KEY(recv_apply_thread),
 	PSI_KEY(recv_writer_thread),
 	PSI_KEY(srv_error_monitor_thread),
 	PSI_KEY(srv_lock_timeout_thread),
@@ -13613,6 +13615,239 @@ ha_innobase::records_in_range(
 	DBUG_RETURN((ha_rows) n_rows);
 }
 
+/*********************************************************************//**
+Finds values of the first key part of an index that split the index into
+parts of about the same size, for a parallel scan. Only non-locking reads
+of indexes that start with an integer column can be split. The transaction
+is started and its read view is opened here, so that parallel_read_init()
+can give each worker a copy of the read view.
+@return number of values written to keys */
+
+uint
+ha_innobase::split_index(
+/*=====================*/
+	uint		keynr,		/*!< in: index number */
+	uint		max_keys,	/*!< in: maximum number of values */
+	uchar*		keys)		/*!< out: values of the first key
+					part in MySQL key format */
+{
+	DBUG_ENTER("ha_innobase::split_index");
+
+	ut_a(m_prebuilt->trx == thd_to_trx(ha_thd()));
+
+	if (srv_read_only_mode
+	    || m_prebuilt->select_lock_type != LOCK_NONE
+	    || m_prebuilt->table->no_rollback()
+	    || !m_prebuilt->table->is_readable()) {
+		DBUG_RETURN(0);
+	}
+
+	dict_index_t*	index = innobase_get_index(keynr);
+
+	if (index == NULL
+	    || index->is_corrupted()
+	    || (index->type & (DICT_FTS | DICT_SPATIAL))
+	    || !row_merge_is_index_usable(m_prebuilt->trx, index)) {
+		DBUG_RETURN(0);
+	}
+
+	const dict_field_t*	field = dict_index_get_nth_field(index, 0);
+	const KEY_PART_INFO*	key_part = table->key_info[keynr].key_part;
+	const ulint		len = field->fixed_len;
+
+	if (field->col->mtype != DATA_INT
+	    || field->prefix_len
+	    || len != key_part->length
+	    || len > 8) {
+		DBUG_RETURN(0);
+	}
+
+	byte*	values = static_cast<byte*>(
+		ut_malloc_nokey(max_keys * len));
+
+	if (values == NULL) {
+		DBUG_RETURN(0);
+	}
+
+	uint	n = static_cast<uint>(
+		btr_get_split_values(index, max_keys, values));
+
+	/* Convert the big-endian values with the sign bit inverted to
+	MySQL key format, like row_sel_field_store_in_mysql_format(). */
+	const bool	is_unsigned = field->col->prtype & DATA_UNSIGNED;
+
+	for (uint i = 0; i < n; i++) {
+		uchar*		key = keys + i * key_part->store_length;
+		const byte*	value = values + i * len;
+
+		if (key_part->null_bit) {
+			*key++ = 0;
+		}
+
+		for (ulint j = 0; j < len; j++) {
+			key[j] = value[len - 1 - j];
+		}
+
+		if (!is_unsigned) {
+			key[len - 1] ^= 128;
+		}
+	}
+
+	ut_free(values);
+
+	if (n > 0) {
+		trx_t*	trx = m_prebuilt->trx;
+
+		trx_start_if_not_started(trx, false);
+		trx->read_view.open(trx);
+	}
+
+	DBUG_RETURN(n);
+}
+
+/** Prepare the handler for the reads of a worker of a parallel scan.
+The worker reads with a transaction of its own, whose read view is a copy
+of the read view that split_index() opened, so that the worker does not
+modify the transaction or the THD of the statement.
+
+The workers do not enter innodb_thread_concurrency. They read on behalf
+of the thread executing the statement, which waits for their rows; if
+either side held a slot while waiting for the other, they could block
+each other for good.
+@return 0 or error code */
+int
+ha_innobase::parallel_read_init()
+{
+	DBUG_ENTER("ha_innobase::parallel_read_init");
+
+	trx_t*	parent = m_prebuilt->trx;
+
+	ut_ad(parent == thd_to_trx(m_user_thd));
+	ut_ad(parent->read_view.is_open());
+	ut_ad(m_prebuilt->select_lock_type == LOCK_NONE);
+	ut_ad(m_prebuilt->sql_stat_start);
+
+	build_template(false);
+
+	trx_t*	trx = trx_create();
+
+	/* Start the transaction as read-only, but do not let the worker
+	use the THD after that. */
+	trx->mysql_thd = parent->mysql_thd;
+	trx->isolation_level = parent->isolation_level;
+	trx_start_if_not_started(trx, false);
+	trx->mysql_thd = NULL;
+	trx->read_view.open_clone(parent->read_view);
+
+	m_prebuilt->trx = trx;
+	m_prebuilt->sql_stat_start = FALSE;
+
+	DBUG_RETURN(0);
+}
+
+/** End the reads of a worker of a parallel scan, and free the
+transaction of the worker. */
+void
+ha_innobase::parallel_read_end()
+{
+	DBUG_ENTER("ha_innobase::parallel_read_end");
+
+	trx_t*	trx = m_prebuilt->trx;
+
+	m_prebuilt->trx = thd_to_trx(m_user_thd);
+	ut_ad(trx != m_prebuilt->trx);
+
+	trx->read_view.close();
+	trx_commit_for_mysql(trx);
+	trx_free(trx);
+
+	DBUG_VOID_RETURN;
+}
+
+/** Convert the result of a read of a worker of a parallel scan.
+Unlike index_read() and general_fetch(), this does not report errors to
+the THD, or update TABLE::status, of the thread executing the statement.
+@param[in]	err	result of row_search_mvcc()
+@param[in]	next	whether the row was read with parallel_index_next()
+@return 0 or error code */
+int
+ha_innobase::parallel_read_result(dberr_t err, bool next)
+{
+	switch (err) {
+	case DB_SUCCESS:
+		if (m_prebuilt->table->is_system_db) {
+			srv_stats.n_system_rows_read.add(
+				thd_get_thread_id(m_user_thd), 1);
+		} else {
+			srv_stats.n_rows_read.add(
+				thd_get_thread_id(m_user_thd), 1);
+		}
+		return(0);
+	case DB_RECORD_NOT_FOUND:
+	case DB_END_OF_INDEX:
+		return(next ? HA_ERR_END_OF_FILE : HA_ERR_KEY_NOT_FOUND);
+	case DB_TABLESPACE_DELETED:
+		return(HA_ERR_NO_SUCH_TABLE);
+	case DB_TABLESPACE_NOT_FOUND:
+		return(HA_ERR_TABLESPACE_MISSING);
+	default:
+		return(convert_error_code_to_mysql(
+			       err, m_prebuilt->table->flags, NULL));
+	}
+}
+
+/** Read the first row of a part of an index in a parallel scan.
+@param[out]	buf	buffer for the row
+@param[in]	start	start of the part, or NULL for the first key
+@return 0, HA_ERR_KEY_NOT_FOUND or error code */
+int
+ha_innobase::parallel_index_read(uchar* buf, const key_range* start)
+{
+	dict_index_t*	index = m_prebuilt->index;
+	page_cur_mode_t	mode = PAGE_CUR_G;
+
+	ut_ad(!m_prebuilt->sql_stat_start);
+
+	if (!m_prebuilt->table->is_readable()) {
+		return(m_prebuilt->table->corrupted
+		       ? HA_ERR_CRASHED
+		       : m_prebuilt->table->space
+		       ? HA_ERR_DECRYPTION_FAILED
+		       : HA_ERR_NO_SUCH_TABLE);
+	}
+
+	if (start != NULL) {
+		row_sel_convert_mysql_key_to_innobase(
+			m_prebuilt->search_tuple,
+			m_prebuilt->srch_key_val1,
+			m_prebuilt->srch_key_val_len,
+			index, start->key, start->length);
+		mode = convert_search_mode_to_innobase(start->flag);
+	} else {
+		dtuple_set_n_fields(m_prebuilt->search_tuple, 0);
+	}
+
+	m_last_match_mode = 0;
+
+	dberr_t	err = row_search_mvcc(buf, mode, m_prebuilt, 0, 0);
+
+	return(parallel_read_result(err, false));
+}
+
+/** Read the next row of a part of an index in a parallel scan.
+@param[out]	buf	buffer for the row
+@return 0, HA_ERR_END_OF_FILE or error code */
+int
+ha_innobase::parallel_index_next(uchar* buf)
+{
+	ut_ad(!m_prebuilt->sql_stat_start);
+
+	dberr_t	err = row_search_mvcc(
+		buf, PAGE_CUR_UNSUPP, m_prebuilt, 0, ROW_SEL_NEXT);
+
+	return(parallel_read_result(err, true));
+}
+
 /*********************************************************************//**
 Gives an UPPER BOUND to the number of rows in a table. This is used in
 filesort.cc.
@@ -18833,6 +19068,14 @@ static MYSQL_SYSVAR_BOOL(doublewrite, srv_use_doublewrite_buf,
   " Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(doublewrite_files, srv_doublewrite_files,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of doublewrite files (ib_doublewrite0, ...) in the data home"
+  " directory used for batch flushing, so that buffer pool instances can"
+  " flush in parallel. 0 (the default) uses the doublewrite buffer in the"
+  " system tablespace.",
+  NULL, NULL, 0, 0, MAX_BUFFER_POOLS, 0);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, innobase_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable atomic writes, instead of using the doublewrite buffer, for files "
@@ -18908,7 +19151,7 @@ static MYSQL_SYSVAR_ULONG(purge_threads, srv_n_purge_threads,
   NULL, NULL,
   4,			/* Default setting */
   1,			/* Minimum value */
-  32, 0);		/* Maximum value */
+  SRV_MAX_N_PURGE_THREADS, 0);	/* Maximum value */
 
 static MYSQL_SYSVAR_ULONG(sync_array_size, srv_sync_array_size,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
@@ -19440,6 +19683,11 @@ static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   "Helps to save your data in case the disk image of the database becomes corrupt.",
   NULL, NULL, 0, 0, 6, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_apply_threads, srv_n_recovery_apply_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying redo log to data pages during crash recovery.",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(page_size, srv_page_size,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Page size to use for all InnoDB tablespaces.",
@@ -19463,6 +19711,12 @@ static MYSQL_SYSVAR_ULONG(log_files_in_group, srv_n_log_files,
   "Number of log files in the log group. InnoDB writes to the files in a circular fashion.",
   NULL, NULL, 2, 1, SRV_N_LOG_FILES_MAX, 0);
 
+static MYSQL_SYSVAR_BOOL(log_parallel_copy, srv_log_parallel_copy,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Whether mini-transactions copy their redo log records to the log buffer"
+  " in parallel, holding the log_sys mutex only for reserving the space",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(log_write_ahead_size, srv_log_write_ahead_size,
   PLUGIN_VAR_RQCMDARG,
   "Redo log write ahead unit size to avoid read-on-write,"
@@ -19612,6 +19866,36 @@ static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   NULL, NULL, FALSE);
 #endif /* HAVE_LIBNUMA */
 
+#ifdef HAVE_URING
+static const char* innodb_linux_aio_names[] = {
+	"auto",
+	"io_uring",
+	"aio",
+	NullS
+};
+
+/** Enumeration of innodb_linux_aio */
+static TYPELIB innodb_linux_aio_typelib = {
+	array_elements(innodb_linux_aio_names) - 1,
+	"innodb_linux_aio_typelib",
+	innodb_linux_aio_names,
+	NULL
+};
+
+static MYSQL_SYSVAR_ENUM(linux_aio, srv_linux_aio,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Interface of innodb_use_native_aio on Linux: auto (io_uring, or libaio"
+  " if io_uring does not work), io_uring, or aio (libaio).",
+  NULL, NULL, SRV_LINUX_AIO_AUTO, &innodb_linux_aio_typelib);
+
+static MYSQL_SYSVAR_BOOL(uring_fixed_buffers, srv_uring_fixed_buffers,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Register the InnoDB buffer pool with io_uring, to avoid pinning"
+  " the pages on each asynchronous read and write. The registration"
+  " is dropped when the buffer pool is resized.",
+  NULL, NULL, FALSE);
+#endif /* HAVE_URING */
+
 static MYSQL_SYSVAR_ENUM(change_buffering, innodb_change_buffering,
   PLUGIN_VAR_RQCMDARG,
   "Buffer changes to secondary indexes.",
@@ -19750,6 +20034,12 @@ static MYSQL_SYSVAR_BOOL(read_only, srv_read_only_mode,
   "Start InnoDB in read only mode (off by default)",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_BOOL(read_view_cache, srv_read_view_cache,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Let read views that are created while no read-write transaction starts"
+  " or commits share one cached MVCC snapshot (off by default)",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_BOOL(cmp_per_index_enabled, srv_cmp_per_index_enabled,
   PLUGIN_VAR_OPCMDARG,
   "Enable INFORMATION_SCHEMA.innodb_cmp_per_index,"
@@ -20006,6 +20296,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(temp_data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(doublewrite_files),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
@@ -20017,6 +20308,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(flush_log_at_trx_commit),
   MYSQL_SYSVAR(flush_method),
   MYSQL_SYSVAR(force_recovery),
+  MYSQL_SYSVAR(recovery_apply_threads),
   MYSQL_SYSVAR(fill_factor),
   MYSQL_SYSVAR(ft_cache_size),
   MYSQL_SYSVAR(ft_total_cache_size),
@@ -20037,6 +20329,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
   MYSQL_SYSVAR(log_write_ahead_size),
+  MYSQL_SYSVAR(log_parallel_copy),
   MYSQL_SYSVAR(log_group_home_dir),
   MYSQL_SYSVAR(log_compressed_pages),
   MYSQL_SYSVAR(log_optimize_ddl),
@@ -20090,6 +20383,10 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif /* HAVE_LIBNUMA */
+#ifdef HAVE_URING
+  MYSQL_SYSVAR(linux_aio),
+  MYSQL_SYSVAR(uring_fixed_buffers),
+#endif /* HAVE_URING */
   MYSQL_SYSVAR(change_buffering),
   MYSQL_SYSVAR(change_buffer_max_size),
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
@@ -20102,6 +20399,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(random_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
   MYSQL_SYSVAR(read_only),
+  MYSQL_SYSVAR(read_view_cache),
   MYSQL_SYSVAR(io_capacity),
   MYSQL_SYSVAR(io_capacity_max),
   MYSQL_SYSVAR(page_cleaners),
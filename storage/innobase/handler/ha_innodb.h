@@ -190,6 +190,16 @@ class ha_innobase: public handler
 		key_range*		min_key,
 		key_range*		max_key);
 
+	uint split_index(uint keynr, uint max_keys, uchar* keys);
+
+	int parallel_read_init();
+
+	void parallel_read_end();
+
+	int parallel_index_read(uchar* buf, const key_range* start);
+
+	int parallel_index_next(uchar* buf);
+
 	ha_rows estimate_rows_upper_bound();
 
 	void update_create_info(HA_CREATE_INFO* create_info);
@@ -458,6 +468,7 @@ class ha_innobase: public handler
 	void update_thd();
 
 	int general_fetch(uchar* buf, uint direction, uint match_mode);
+	int parallel_read_result(dberr_t err, bool next);
 	int change_active_index(uint keynr);
 	dict_index_t* innobase_get_index(uint keynr);
 
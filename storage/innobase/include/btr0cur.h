@@ -613,6 +613,19 @@ btr_estimate_n_rows_in_range(
 	const dtuple_t*	tuple2,
 	page_cur_mode_t	mode2);
 
+/** Find values of the first field of an index that split the index into
+parts of about the same size, for scanning the parts in parallel.
+@param[in]	index	B-tree index whose first field is of fixed length
+@param[in]	n_max	maximum number of values
+@param[out]	values	values of the first field in ascending order,
+			fixed_len bytes each, in the stored format
+@return number of values written to values */
+ulint
+btr_get_split_values(
+	dict_index_t*	index,
+	ulint		n_max,
+	byte*		values);
+
 /*******************************************************************//**
 Estimates the number of different key values in a given index, for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
@@ -30,6 +30,7 @@ Created 2/17/1996 Heikki Tuuri
 #include "dict0dict.h"
 #ifdef BTR_CUR_HASH_ADAPT
 #include "ha0ha.h"
+#include "ut0counter.h"
 
 /** Creates and initializes the adaptive search system at a database start.
 @param[in]	hash_size	hash table size. */
@@ -148,6 +149,19 @@ bool btr_search_validate();
 /** Lock all search latches in exclusive mode. */
 static inline void btr_search_x_lock_all();
 
+/** Get the adaptive hash index partition of an index.
+@param[in]	index	index handler
+@return partition number, less than btr_ahi_parts */
+static inline ulint btr_search_part_no(const dict_index_t* index);
+
+/** Lock a search latch in exclusive mode, for modifying the partition.
+@param[in]	part	partition number */
+static inline void btr_search_x_lock(ulint part);
+
+/** Unlock a search latch that was locked by btr_search_x_lock().
+@param[in]	part	partition number */
+static inline void btr_search_x_unlock(ulint part);
+
 /** Unlock all search latches from exclusive mode. */
 static inline void btr_search_x_unlock_all();
 
@@ -272,13 +286,51 @@ struct btr_search_t{
 };
 
 #ifdef BTR_CUR_HASH_ADAPT
+/** State of an adaptive hash index partition that is accessed without
+holding the partition latch */
+struct btr_search_part_t {
+	/** Modification counter of the partition. It is incremented
+	when the latch is acquired in exclusive mode and when it is
+	released, so it is odd while the hash table may be modified.
+	A lookup that did not acquire the latch is only valid if this
+	was even and did not change meanwhile. */
+	MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<ulint>	version;
+	/** number of successful lookups in the partition */
+	ib_counter_t<ulint>	n_hits;
+	/** number of failed lookups in the partition */
+	ib_counter_t<ulint>	n_misses;
+};
+
 /** The hash index system */
 struct btr_search_sys_t{
 	hash_table_t**	hash_tables;	/*!< the adaptive hash tables,
 					mapping dtuple_fold values
 					to rec_t pointers on index pages */
+	btr_search_part_t* parts;	/*!< btr_ahi_parts partitions */
+	/** number of lookups that were completed without acquiring
+	the partition latch */
+	ib_counter_t<ulint>	n_latchless;
+	/** number of lookups that had to be repeated under the
+	partition latch because the partition was being modified */
+	ib_counter_t<ulint>	n_latchless_retry;
+	/** number of lookups that are reading hash_tables without
+	holding the partition latch. btr_search_disable() waits for
+	this to reach 0 before freeing any memory of the hash tables.
+	Each thread increments and decrements the same slot. */
+	ib_counter_t<ulint>	n_latchless_readers;
 };
 
+/** Number of adaptive hash index partition counters in
+INFORMATION_SCHEMA.INNODB_METRICS. Partition n is reported in
+counter n % BTR_AHI_MONITOR_PARTS. */
+#define BTR_AHI_MONITOR_PARTS	8
+
+/** Sum up the hit or miss counters of adaptive hash index partitions.
+@param[in]	slot	INNODB_METRICS counter, less than BTR_AHI_MONITOR_PARTS
+@param[in]	hits	true=n_hits, false=n_misses
+@return the sum over the partitions slot, slot + BTR_AHI_MONITOR_PARTS, ... */
+ulint btr_search_part_stat(ulint slot, bool hits);
+
 /** Latches protecting access to adaptive hash index. */
 extern rw_lock_t**		btr_search_latches;
 
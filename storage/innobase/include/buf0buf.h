@@ -1177,6 +1177,15 @@ This function does not return if the block is not identified.
 @return pointer to block, never NULL */
 buf_block_t*
 buf_block_from_ahi(const byte* ptr);
+
+/** Get a buffer block from an adaptive hash index pointer that was read
+without holding the adaptive hash index latch. The block may have been
+freed meanwhile; the caller must check its state while holding the block
+mutex. This function does not return if the block is not identified.
+@param[in]	ptr	pointer to within a page frame
+@return pointer to block, never NULL */
+buf_block_t*
+buf_block_from_ahi_latchless(const byte* ptr);
 #endif /* BTR_CUR_HASH_ADAPT */
 
 /********************************************************************//**
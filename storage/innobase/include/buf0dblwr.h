@@ -104,9 +104,11 @@ Flushes possible buffered writes from the doublewrite memory buffer to disk,
 and also wakes up the aio thread if simulated aio is used. It is very
 important to call this function after a batch of writes has been posted,
 and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+of threads can occur.
+@param[in]	buf_pool	buffer pool instance whose doublewrite file
+				should be flushed, or NULL to flush all */
 void
-buf_dblwr_flush_buffered_writes();
+buf_dblwr_flush_buffered_writes(const buf_pool_t* buf_pool = NULL);
 
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
@@ -122,6 +124,35 @@ buf_dblwr_write_single_page(
 	buf_page_t*	bpage,	/*!< in: buffer block to write */
 	bool		sync);	/*!< in: true if sync IO requested */
 
+/** A doublewrite file outside the system tablespace. When
+innodb_doublewrite_files is nonzero, the batch flushes of each buffer pool
+instance are staged in one of these files instead of the TRX_SYS
+doublewrite blocks, so that the batches of different instances can be
+written and synced in parallel. */
+struct buf_dblwr_file_t{
+	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
+				field and write_buf */
+	char*		path;	/*!< path name of the file */
+	pfs_os_file_t	handle;	/*!< file handle */
+	ulint		first_free;/*!< first free position in write_buf
+				measured in units of srv_page_size */
+	ulint		b_reserved;/*!< number of slots currently reserved
+				for batch flush. */
+	os_event_t	b_event;/*!< event where threads wait for a
+				batch flush to end;
+				os_event_set() and os_event_reset()
+				are protected by buf_dblwr_file_t::mutex */
+	bool		batch_running;/*!< set to true if currently a batch
+				is being written from this file */
+	byte*		write_buf;/*!< write buffer used in writing to the
+				file, aligned to srv_page_size */
+	byte*		write_buf_unaligned;/*!< pointer to write_buf,
+				but unaligned */
+	buf_page_t**	buf_block_arr;/*!< array to store pointers to
+				the buffer blocks which have been
+				cached to write_buf */
+};
+
 /** Doublewrite control struct */
 struct buf_dblwr_t{
 	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
@@ -156,6 +187,13 @@ struct buf_dblwr_t{
 	buf_page_t**	buf_block_arr;/*!< array to store pointers to
 				the buffer blocks which have been
 				cached to write_buf */
+	ulint		n_files;/*!< number of doublewrite files for
+				batch flushing (innodb_doublewrite_files),
+				or 0 if the TRX_SYS blocks are used */
+	buf_dblwr_file_t* files;/*!< the doublewrite files, or NULL */
+	byte*		recv_buf_unaligned;/*!< pages read from the
+				doublewrite files at startup, referenced by
+				recv_sys->dblwr until buf_dblwr_process() */
 };
 
 #endif
@@ -246,6 +246,12 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 void
 buf_flush_page_cleaner_init(void);
 
+/** Print the page cleaner state of a buffer pool instance.
+@param[out]	file	output stream
+@param[in]	i	buffer pool instance number */
+void
+buf_flush_page_cleaner_print(FILE* file, ulint i);
+
 /** Wait for any possible LRU flushes that are in progress to end. */
 void
 buf_flush_wait_LRU_batch_end(void);
@@ -2119,8 +2119,8 @@ struct dict_table_t {
 
 	/** Count of the number of record locks on this table. We use this to
 	determine whether we can evict the table from the dictionary cache.
-	It is protected by lock_sys.mutex. */
-	ulint					n_rec_locks;
+	Modified while holding lock_sys.latch in shared or exclusive mode. */
+	Atomic_counter<ulint>			n_rec_locks;
 
 private:
 	/** Count of how many handles are opened to this table. Dropping of the
@@ -812,15 +812,32 @@ struct lock_op_t{
 
 typedef ib_mutex_t LockMutex;
 
+/** Number of mutexes protecting partitions of lock_sys.rec_hash */
+#define LOCK_REC_HASH_MUTEXES	256
+
 /** The lock system struct */
 class lock_sys_t
 {
   bool m_initialised;
 
+  /** A mutex protecting a partition of rec_hash, padded to a cache line */
+  struct rec_hash_mutex_t
+  {
+    MY_ALIGNED(CACHE_LINE_SIZE) LockMutex mutex;
+  };
+
+  /** Mutexes protecting the rec_hash cells while latch is held in
+  shared mode; cell n is protected by rec_mutexes[n % LOCK_REC_HASH_MUTEXES] */
+  rec_hash_mutex_t rec_mutexes[LOCK_REC_HASH_MUTEXES];
+
 public:
 	MY_ALIGNED(CACHE_LINE_SIZE)
-	LockMutex	mutex;			/*!< Mutex protecting the
-						locks */
+	rw_lock_t	latch;			/*!< Latch protecting the
+						locks. Holding it in exclusive
+						mode protects everything. In
+						shared mode, a rec_hash cell
+						may be accessed while holding
+						rec_mutex() of that cell. */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
 	hash_table_t*	prdt_hash;		/*!< hash table of the predicate
@@ -887,6 +904,23 @@ class lock_sys_t
 
   /** Closes the lock system at database shutdown. */
   void close();
+
+  /** @return the mutex protecting a rec_hash cell in shared latch mode
+  @param[in]	cell	rec_hash cell number, see lock_rec_hash() */
+  LockMutex& rec_mutex(ulint cell)
+  {
+    return rec_mutexes[cell % LOCK_REC_HASH_MUTEXES].mutex;
+  }
+
+#ifdef UNIV_DEBUG
+  /** @return whether the current thread may access a record lock hash cell
+  @param[in]	cell	rec_hash cell number, see lock_rec_hash() */
+  bool rec_cell_own(ulint cell)
+  {
+    return rw_lock_own(&latch, RW_LOCK_X)
+      || (rw_lock_own(&latch, RW_LOCK_S) && rec_mutex(cell).is_owned());
+  }
+#endif /* UNIV_DEBUG */
 };
 
 /*********************************************************************//**
@@ -1002,21 +1036,23 @@ lock_rec_free_all_from_discard_page(
 /** The lock system */
 extern lock_sys_t lock_sys;
 
-/** Test if lock_sys.mutex can be acquired without waiting. */
+/** Try to acquire lock_sys.latch in exclusive mode without waiting.
+@return whether the latch was acquired */
 #define lock_mutex_enter_nowait() 		\
-	(lock_sys.mutex.trylock(__FILE__, __LINE__))
+	rw_lock_x_lock_nowait(&lock_sys.latch)
 
-/** Test if lock_sys.mutex is owned. */
-#define lock_mutex_own() (lock_sys.mutex.is_owned())
+/** Test if lock_sys.latch is exclusively owned. */
+#define lock_mutex_own() rw_lock_own(&lock_sys.latch, RW_LOCK_X)
 
-/** Acquire the lock_sys.mutex. */
+/** Acquire lock_sys.latch in exclusive mode. Comments that refer to
+holding lock_sys.mutex mean holding this exclusive latch. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys.mutex);		\
+	rw_lock_x_lock(&lock_sys.latch);	\
 } while (0)
 
-/** Release the lock_sys.mutex. */
+/** Release the exclusive lock_sys.latch. */
 #define lock_mutex_exit() do {			\
-	lock_sys.mutex.exit();			\
+	rw_lock_x_unlock(&lock_sys.latch);	\
 } while (0)
 
 /** Test if lock_sys.wait_mutex is owned. */
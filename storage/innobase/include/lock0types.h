@@ -175,7 +175,8 @@ operator<<(std::ostream& out, const lock_rec_t& lock)
 #endif
 /* @} */
 
-/** Lock struct; protected by lock_sys.mutex */
+/** Lock struct; protected by exclusive lock_sys.latch, or by shared
+lock_sys.latch together with lock_sys.rec_mutex() of the hash cell */
 struct ib_lock_t
 {
 	trx_t*		trx;		/*!< transaction owning the
@@ -106,6 +106,24 @@ log_write_low(
 /*==========*/
 	const byte*	str,		/*!< in: string */
 	ulint		str_len);	/*!< in: string length */
+/** Reserve space for a string in the log buffer, without copying it.
+This updates the log block headers and log_sys.lsn, log_sys.buf_free
+exactly as log_write_low() would. It is assumed that the caller holds
+the log mutex and invokes log_buffer_copy() later.
+@param[in]	str_len	string length
+@return byte offset of the reserved area within log_sys.buf */
+ulint
+log_reserve_low(ulint str_len);
+/** Copy a string to a log buffer area that was reserved by
+log_reserve_low(), skipping the log block framing. This does not
+require the log mutex.
+@param[in,out]	buf	log_sys.buf at the time of the reservation
+@param[in]	offset	byte offset within buf
+@param[in]	str	string
+@param[in]	str_len	string length
+@return byte offset within buf for copying the next string */
+ulint
+log_buffer_copy(byte* buf, ulint offset, const byte* str, ulint str_len);
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -613,6 +631,11 @@ struct log_t{
 					groups */
 	volatile bool	is_extending;	/*!< this is set to true during extend
 					the log buffer size */
+	/** number of log_reserve_low() areas that are still being
+	filled by log_buffer_copy() (innodb_log_parallel_copy=ON);
+	incremented while holding mutex */
+	MY_ALIGNED(CACHE_LINE_SIZE)
+	std::atomic<ulint>	n_pending_copies;
 	lsn_t		write_lsn;	/*!< last written lsn */
 	lsn_t		current_flush_lsn;/*!< end lsn for the current running
 					write + flush operation */
@@ -706,6 +729,21 @@ struct log_t{
   /** Complete an asynchronous checkpoint write. */
   void complete_checkpoint();
 
+  /** Wait until all the mini-transactions that reserved space in buf
+  have copied their log records. No new reservations can be made,
+  because the caller holds mutex. */
+  void wait_for_pending_copies()
+  {
+    ut_ad(mutex.is_owned());
+    for (ulint i= 0; n_pending_copies.load(std::memory_order_acquire); i++)
+    {
+      if (i < srv_n_spin_wait_rounds)
+        ut_delay(srv_spin_wait_delay);
+      else
+        os_thread_yield();
+    }
+  }
+
   /** @return the log block header + trailer size */
   unsigned framing_size() const
   {
@@ -1444,10 +1444,26 @@ be other, synchronous, pending writes. */
 void
 os_aio_wait_until_no_pending_writes();
 
-/** Wakes up simulated aio i/o-handler threads if they have something to do. */
+/** Wakes up simulated aio i/o-handler threads if they have something to do.
+With io_uring, submits the requests that were queued with
+IORequest::DO_NOT_WAKE. */
 void
 os_aio_simulated_wake_handler_threads();
 
+#ifdef HAVE_URING
+/** Register memory with io_uring, so that asynchronous reads and writes
+of buffers inside it can skip the per-request page pinning of the kernel.
+@param[in]	iov	memory ranges, such as the buffer pool chunks
+@param[in]	n	number of memory ranges */
+void
+os_aio_register_buffers(const struct iovec* iov, ulint n);
+
+/** Stop using the memory that was registered by os_aio_register_buffers(),
+for example because the buffer pool is being resized. */
+void
+os_aio_unregister_buffers();
+#endif /* HAVE_URING */
+
 #ifdef _WIN32
 /** This function can be called if one wants to post a batch of reads and
 prefers an i/o-handler thread to handle them all at once later. You must
@@ -137,6 +137,17 @@ class ReadView
   void open(trx_t *trx);
 
 
+  /**
+    Opens a view that sees exactly the same as another open view, for a
+    transaction that reads on behalf of the creator of that view.
+
+    View becomes visible to purge thread.
+
+    @param other    open view to copy
+  */
+  void open_clone(const ReadView &other);
+
+
   /**
     Closes the view.
 
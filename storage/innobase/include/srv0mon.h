@@ -214,6 +214,8 @@ enum monitor_id_t {
 	MONITOR_FLUSH_PCT_FOR_DIRTY,
 	MONITOR_FLUSH_PCT_FOR_LSN,
 	MONITOR_FLUSH_SYNC_WAITS,
+	MONITOR_FLUSH_BUSY_INSTANCES,
+	MONITOR_FLUSH_MAX_INSTANCE_AGE,
 	MONITOR_FLUSH_ADAPTIVE_TOTAL_PAGE,
 	MONITOR_FLUSH_ADAPTIVE_COUNT,
 	MONITOR_FLUSH_ADAPTIVE_PAGES,
@@ -314,6 +316,10 @@ enum monitor_id_t {
 	MONITOR_DML_PURGE_DELAY,
 	MONITOR_PURGE_STOP_COUNT,
 	MONITOR_PURGE_RESUME_COUNT,
+	MONITOR_PURGE_N_THREADS,
+	MONITOR_PURGE_BATCH_TABLES,
+	MONITOR_PURGE_BATCH_MAX_THREAD_RECS,
+	MONITOR_PURGE_TABLE_REBALANCED,
 
 	/* Recovery related counters */
 	MONITOR_MODULE_RECOVERY,
@@ -363,6 +369,24 @@ enum monitor_id_t {
 	/* Adaptive Hash Index related counters */
 	MONITOR_MODULE_ADAPTIVE_HASH,
 	MONITOR_OVLD_ADAPTIVE_HASH_SEARCH,
+	MONITOR_OVLD_ADAPTIVE_HASH_LATCHLESS,
+	MONITOR_OVLD_ADAPTIVE_HASH_LATCHLESS_RETRY,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART0_HITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART1_HITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART2_HITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART3_HITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART4_HITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART5_HITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART6_HITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART7_HITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART0_MISSES,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART1_MISSES,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART2_MISSES,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART3_MISSES,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART4_MISSES,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART5_MISSES,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART6_MISSES,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART7_MISSES,
 #endif /* BTR_CUR_HASH_ADAPT */
 	MONITOR_OVLD_ADAPTIVE_HASH_SEARCH_BTREE,
 #ifdef BTR_CUR_HASH_ADAPT
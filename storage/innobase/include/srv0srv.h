@@ -269,6 +269,24 @@ use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
 extern my_bool	srv_numa_interleave;
+#ifdef HAVE_URING
+/** Possible values of innodb_linux_aio */
+enum srv_linux_aio_t {
+	/** io_uring, or libaio if io_uring does not work */
+	SRV_LINUX_AIO_AUTO,
+	/** io_uring, or simulated AIO if it does not work */
+	SRV_LINUX_AIO_IO_URING,
+	/** libaio */
+	SRV_LINUX_AIO_AIO
+};
+
+/** innodb_linux_aio: the interface of innodb_use_native_aio;
+@see srv_linux_aio_t */
+extern ulong	srv_linux_aio;
+/** innodb_uring_fixed_buffers: whether to register the buffer pool
+memory with io_uring */
+extern my_bool	srv_uring_fixed_buffers;
+#endif /* HAVE_URING */
 
 /* Use atomic writes i.e disable doublewrite buffer */
 extern my_bool srv_use_atomic_writes;
@@ -341,6 +359,9 @@ extern ulong	srv_log_buffer_size;
 extern ulong	srv_flush_log_at_trx_commit;
 extern uint	srv_flush_log_at_timeout;
 extern ulong	srv_log_write_ahead_size;
+/** innodb_log_parallel_copy: whether mini-transactions copy their redo
+log records to log_sys.buf outside log_sys.mutex */
+extern my_bool	srv_log_parallel_copy;
 extern my_bool	srv_adaptive_flushing;
 extern my_bool	srv_flush_sync;
 
@@ -438,6 +459,10 @@ extern ulong	srv_flushing_avg_loops;
 
 extern ulong	srv_force_recovery;
 
+/** innodb_recovery_apply_threads: number of threads that apply redo log
+records to buffer pool pages during crash recovery */
+extern ulong	srv_n_recovery_apply_threads;
+
 extern uint	srv_fast_shutdown;	/*!< If this is 1, do not do a
 					purge and index buffer merge.
 					If this 2, do not even flush the
@@ -462,6 +487,8 @@ extern my_bool			srv_stats_sample_traditional;
 
 extern my_bool	srv_use_doublewrite_buf;
 extern ulong	srv_doublewrite_batch_size;
+extern ulong	srv_doublewrite_files;
+extern my_bool	srv_read_view_cache;
 extern ulong	srv_checksum_algorithm;
 
 extern double	srv_max_buf_pool_modified_pct;
@@ -544,6 +571,9 @@ i/o handler thread */
 extern const char* srv_io_thread_op_info[];
 extern const char* srv_io_thread_function[];
 
+/** Maximum value of innodb_purge_threads */
+#define SRV_MAX_N_PURGE_THREADS	32
+
 /* the number of purge threads to use from the worker pool (currently 0 or 1) */
 extern ulong srv_n_purge_threads;
 
@@ -588,6 +618,7 @@ extern mysql_pfs_key_t	io_log_thread_key;
 extern mysql_pfs_key_t	io_read_thread_key;
 extern mysql_pfs_key_t	io_write_thread_key;
 extern mysql_pfs_key_t	page_cleaner_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
 extern mysql_pfs_key_t	srv_error_monitor_thread_key;
 extern mysql_pfs_key_t	srv_lock_timeout_thread_key;
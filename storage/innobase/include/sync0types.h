@@ -145,7 +145,7 @@ V
 lock_sys_wait_mutex			Mutex protecting lock timeout data
 |
 V
-lock_sys_mutex				Mutex protecting lock_sys_t
+lock_sys_latch				RW-latch protecting lock_sys_t
 |
 V
 trx_sys.mutex				Mutex protecting trx_sys_t
@@ -330,6 +330,7 @@ enum latch_id_t {
 	LATCH_ID_TRX,
 	LATCH_ID_LOCK_SYS,
 	LATCH_ID_LOCK_SYS_WAIT,
+	LATCH_ID_LOCK_SYS_REC_HASH,
 	LATCH_ID_TRX_SYS,
 	LATCH_ID_SRV_SYS,
 	LATCH_ID_SRV_SYS_TASKS,
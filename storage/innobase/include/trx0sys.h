@@ -779,6 +779,146 @@ class rw_trx_hash_t
 };
 
 
+/**
+  MVCC snapshot that is shared by all read views which are created while no
+  read-write transaction gets registered, deregistered or assigned a
+  serialisation number (innodb_read_view_cache).
+
+  The snapshot is protected by a sequence lock: readers copy it without
+  writing to any shared cache line, and retry with a regular snapshot if it
+  was being replaced. A buffer that is replaced by a larger one is only freed
+  by destroy(), because a concurrent reader may still be copying from it.
+*/
+class snapshot_cache_t
+{
+  /** Storage of transaction identifiers */
+  struct buf_t
+  {
+    /** previous, smaller buffer */
+    buf_t *m_prev;
+    /** number of elements in m_ids */
+    size_t m_size;
+    /** transaction identifiers */
+    trx_id_t m_ids[1];
+  };
+
+  /** Sequence number, odd while the snapshot is being replaced */
+  MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<uint32_t> m_version;
+  /** trx_sys.get_max_trx_id() of the snapshot */
+  std::atomic<trx_id_t> m_max_trx_id;
+  /** trx_sys.rw_trx_hash_erased() of the snapshot */
+  std::atomic<uint64_t> m_erased;
+  /** min(trx->no) of the snapshot */
+  std::atomic<trx_id_t> m_min_trx_no;
+  /** number of transaction identifiers in the snapshot */
+  std::atomic<size_t> m_n_ids;
+  /** transaction identifiers of the snapshot, sorted */
+  std::atomic<buf_t*> m_buf;
+  /** whether a thread is replacing the snapshot */
+  MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<bool> m_writer;
+
+public:
+  /** Initialise the cache to hold no snapshot. */
+  void init()
+  {
+    m_version.store(1, std::memory_order_relaxed);
+    m_n_ids.store(0, std::memory_order_relaxed);
+    m_buf.store(NULL, std::memory_order_relaxed);
+    m_writer.store(false, std::memory_order_relaxed);
+  }
+
+
+  /** Free the memory on shutdown. */
+  void destroy()
+  {
+    buf_t *buf= m_buf.load(std::memory_order_relaxed);
+    while (buf)
+    {
+      buf_t *prev= buf->m_prev;
+      ut_free(buf);
+      buf= prev;
+    }
+    m_buf.store(NULL, std::memory_order_relaxed);
+  }
+
+
+  /**
+    Copies the cached snapshot if it was taken at the same state.
+
+    @param[in]  max_trx_id trx_sys.get_max_trx_id() of the requested snapshot
+    @param[in]  erased     trx_sys.rw_trx_hash_erased() of the snapshot
+    @param[out] ids        sorted identifiers of the active transactions
+    @param[out] min_trx_no min(trx->no) of the snapshot
+    @return whether the cached snapshot was copied
+  */
+  bool get(trx_id_t max_trx_id, uint64_t erased, trx_ids_t *ids,
+           trx_id_t *min_trx_no) const
+  {
+    const uint32_t version= m_version.load(std::memory_order_acquire);
+    if ((version & 1) ||
+        m_max_trx_id.load(std::memory_order_relaxed) != max_trx_id ||
+        m_erased.load(std::memory_order_relaxed) != erased)
+      return false;
+
+    const buf_t *buf= m_buf.load(std::memory_order_relaxed);
+    if (buf)
+    {
+      /* A torn read of m_n_ids must not exceed the buffer. */
+      size_t n= std::min(m_n_ids.load(std::memory_order_relaxed),
+                         buf->m_size);
+      ids->assign(buf->m_ids, buf->m_ids + n);
+    }
+    else
+      ids->clear();
+    *min_trx_no= m_min_trx_no.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return m_version.load(std::memory_order_relaxed) == version;
+  }
+
+
+  /**
+    Replaces the cached snapshot, unless another thread is doing so.
+
+    @param max_trx_id trx_sys.get_max_trx_id() of the snapshot
+    @param erased     trx_sys.rw_trx_hash_erased() of the snapshot
+    @param ids        sorted identifiers of the active transactions
+    @param min_trx_no min(trx->no) of the snapshot
+  */
+  void put(trx_id_t max_trx_id, uint64_t erased, const trx_ids_t &ids,
+           trx_id_t min_trx_no)
+  {
+    if (m_writer.exchange(true, std::memory_order_acquire))
+      return;
+
+    const uint32_t version= m_version.load(std::memory_order_relaxed) | 1;
+    m_version.store(version, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    buf_t *buf= m_buf.load(std::memory_order_relaxed);
+    if (!buf || buf->m_size < ids.size())
+    {
+      const size_t size= std::max<size_t>(ids.size() * 2, 64);
+      buf_t *new_buf= static_cast<buf_t*>(
+        ut_malloc_nokey(sizeof *buf + (size - 1) * sizeof *buf->m_ids));
+      new_buf->m_prev= buf;
+      new_buf->m_size= size;
+      m_buf.store(buf= new_buf, std::memory_order_relaxed);
+    }
+
+    if (!ids.empty())
+      memcpy(buf->m_ids, &ids[0], ids.size() * sizeof *buf->m_ids);
+    m_n_ids.store(ids.size(), std::memory_order_relaxed);
+    m_max_trx_id.store(max_trx_id, std::memory_order_relaxed);
+    m_erased.store(erased, std::memory_order_relaxed);
+    m_min_trx_no.store(min_trx_no, std::memory_order_relaxed);
+
+    m_version.store(version + 1, std::memory_order_release);
+    m_writer.store(false, std::memory_order_release);
+  }
+};
+
+
 /** The transaction system central memory data structure. */
 class trx_sys_t
 {
@@ -800,6 +940,22 @@ class trx_sys_t
   MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<trx_id_t> m_rw_trx_hash_version;
 
 
+  /**
+    Number of deregister_rw() calls, if m_snapshot_cache is in use.
+    Together with m_rw_trx_hash_version it identifies the state of
+    rw_trx_hash that an MVCC snapshot was taken at.
+  */
+  MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<uint64_t> m_rw_trx_hash_erased;
+
+
+  /** Whether m_snapshot_cache is used (innodb_read_view_cache) */
+  bool m_use_snapshot_cache;
+
+
+  /** The most recent MVCC snapshot */
+  snapshot_cache_t m_snapshot_cache;
+
+
   bool m_initialised;
 
 public:
@@ -946,8 +1102,14 @@ class trx_sys_t
     of rw_trx_hash.iterate_no_dups(). It means that some transaction
     identifiers may appear multiple times in ids.
 
+    With innodb_read_view_cache, the snapshot is copied from m_snapshot_cache
+    if no transaction was registered, deregistered or assigned a
+    serialisation number since it was taken, so that rw_trx_hash is only
+    iterated once per such change and not once per read view. A snapshot
+    that was taken while none of this happened replaces the cached one.
+
     @param[in,out] caller_trx used to get access to rw_trx_hash_pins
-    @param[out]    ids        array to store registered transaction identifiers
+    @param[out]    ids        sorted registered transaction identifiers
     @param[out]    max_trx_id variable to store m_max_trx_id value
     @param[out]    mix_trx_no variable to store min(trx->no) value
   */
@@ -961,15 +1123,28 @@ class trx_sys_t
     while ((arg.m_id= get_rw_trx_hash_version()) != get_max_trx_id())
       ut_delay(1);
     arg.m_no= arg.m_id;
+    *max_trx_id= arg.m_id;
+
+    uint64_t erased= 0;
+    if (m_use_snapshot_cache)
+    {
+      erased= rw_trx_hash_erased();
+      if (m_snapshot_cache.get(arg.m_id, erased, ids, min_trx_no))
+        return;
+    }
 
     ids->clear();
     ids->reserve(rw_trx_hash.size() + 32);
     rw_trx_hash.iterate(caller_trx,
                         reinterpret_cast<my_hash_walk_action>(copy_one_id),
                         &arg);
+    std::sort(ids->begin(), ids->end());
 
-    *max_trx_id= arg.m_id;
     *min_trx_no= arg.m_no;
+
+    if (m_use_snapshot_cache && get_rw_trx_hash_version() == arg.m_id &&
+        rw_trx_hash_erased() == erased)
+      m_snapshot_cache.put(arg.m_id, erased, *ids, arg.m_no);
   }
 
 
@@ -1032,6 +1207,8 @@ class trx_sys_t
   void deregister_rw(trx_t *trx)
   {
     rw_trx_hash.erase(trx);
+    if (m_use_snapshot_cache)
+      m_rw_trx_hash_erased.fetch_add(1, std::memory_order_release);
   }
 
 
@@ -1138,6 +1315,13 @@ class trx_sys_t
   }
 
 
+  /** Getter for m_rw_trx_hash_erased, must issue ACQUIRE memory barrier. */
+  uint64_t rw_trx_hash_erased()
+  {
+    return m_rw_trx_hash_erased.load(std::memory_order_acquire);
+  }
+
+
   /** Getter for m_rw_trx_hash_version, must issue ACQUIRE memory barrier. */
   trx_id_t get_rw_trx_hash_version()
   {
@@ -587,11 +587,13 @@ struct trx_lock_t {
 	unsigned	table_cached;
 
 	mem_heap_t*	lock_heap;	/*!< memory heap for trx_locks;
-					protected by lock_sys.mutex */
+					protected by lock_sys.mutex, or by
+					trx->mutex and shared lock_sys.latch */
 
 	trx_lock_list_t trx_locks;	/*!< locks requested by the transaction;
 					insertions are protected by trx->mutex
-					and lock_sys.mutex; removals are
+					and lock_sys.latch (in shared or
+					exclusive mode); removals are
 					protected by lock_sys.mutex */
 
 	lock_list	table_locks;	/*!< All table locks requested by this
@@ -25,6 +25,7 @@ INCLUDE(lzma.cmake)
 INCLUDE(bzip2.cmake)
 INCLUDE(snappy.cmake)
 INCLUDE(numa)
+INCLUDE(uring)
 INCLUDE(TestBigEndian)
 
 MYSQL_CHECK_LZ4()
@@ -33,6 +34,7 @@ MYSQL_CHECK_LZMA()
 MYSQL_CHECK_BZIP2()
 MYSQL_CHECK_SNAPPY()
 MYSQL_CHECK_NUMA()
+MYSQL_CHECK_URING()
 TEST_BIG_ENDIAN(IS_BIG_ENDIAN)
 
 INCLUDE(${MYSQL_CMAKE_SCRIPT_DIR}/compile_flags.cmake)
@@ -63,6 +65,19 @@ IF(UNIX)
     IF(HAVE_LIBAIO_H AND HAVE_LIBAIO)
       ADD_DEFINITIONS(-DLINUX_NATIVE_AIO=1)
       LINK_LIBRARIES(aio)
+      IF(HAVE_URING)
+        # innodb_linux_aio chooses between io_uring and libaio
+        # at startup; libaio is the fallback
+        ADD_DEFINITIONS(-DHAVE_URING=1)
+        LINK_LIBRARIES(uring)
+      ENDIF()
+    ELSEIF(HAVE_URING)
+      IF(WITH_URING_LOWERCASE STREQUAL "on")
+        MESSAGE(FATAL_ERROR "WITH_URING=ON: libaio is required as well")
+      ENDIF()
+      MESSAGE_ONCE(uring_libaio "io_uring disabled: libaio not found")
+      SET(HAVE_URING 0)
+      SET(URING_LIBRARY "")
     ENDIF()
     IF(HAVE_LIBNUMA)
       LINK_LIBRARIES(numa)
@@ -42,6 +42,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "row0mysql.h"
 #include "row0vers.h"
 #include "pars0pars.h"
+#include "sync0sync.h"
 
 #include <set>
 
@@ -462,7 +463,12 @@ void lock_sys_t::create(ulint n_cells)
 		(ut_zalloc_nokey(srv_max_n_threads * sizeof *waiting_threads));
 	last_slot = waiting_threads;
 
-	mutex_create(LATCH_ID_LOCK_SYS, &mutex);
+	rw_lock_create(lock_latch_key, &latch, SYNC_LOCK_SYS);
+
+	for (ulint i = 0; i < LOCK_REC_HASH_MUTEXES; i++) {
+		mutex_create(LATCH_ID_LOCK_SYS_REC_HASH,
+			     &rec_mutexes[i].mutex);
+	}
 
 	mutex_create(LATCH_ID_LOCK_SYS_WAIT, &wait_mutex);
 
@@ -500,7 +506,7 @@ void lock_sys_t::resize(ulint n_cells)
 {
 	ut_ad(this == &lock_sys);
 
-	mutex_enter(&mutex);
+	lock_mutex_enter();
 
 	hash_table_t* old_hash = rec_hash;
 	rec_hash = hash_create(n_cells);
@@ -545,7 +551,7 @@ void lock_sys_t::resize(ulint n_cells)
 		buf_pool_mutex_exit(buf_pool);
 	}
 
-	mutex_exit(&mutex);
+	lock_mutex_exit();
 }
 
 
@@ -567,7 +573,16 @@ void lock_sys_t::close()
 
 	os_event_destroy(timeout_event);
 
-	mutex_destroy(&mutex);
+	rw_lock_free(&latch);
+	/* rw_lock_free() destroyed the object. Construct it again, so that
+	the static destructor of lock_sys will find a valid object and
+	create() can be invoked again. */
+	new (&latch) rw_lock_t();
+
+	for (ulint i = 0; i < LOCK_REC_HASH_MUTEXES; i++) {
+		mutex_destroy(&rec_mutexes[i].mutex);
+	}
+
 	mutex_destroy(&wait_mutex);
 
 	for (ulint i = srv_max_n_threads; i--; ) {
@@ -1343,7 +1358,7 @@ lock_rec_create_low(
 	ulint		n_bits;
 	ulint		n_bytes;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_sys.rec_cell_own(lock_rec_hash(space, page_no)));
 	ut_ad(holds_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1505,8 +1520,8 @@ lock_rec_create_low(
 	if (!holds_trx_mutex) {
 		trx_mutex_exit(trx);
 	}
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return lock;
 }
@@ -1911,6 +1926,73 @@ lock_rec_add_to_queue(
 		type_mode, block, heap_no, index, trx, caller_owns_trx_mutex);
 }
 
+/** Try to lock a record while holding lock_sys.latch in shared mode.
+This covers the common cases where no other transaction holds or waits
+for a lock on the page: either there are no record locks on the page, or
+the only one is a granted lock of the same mode by this transaction.
+Anything else is left to lock_rec_lock(), which holds the exclusive latch.
+@param[in]	impl	whether no lock needs to be created
+@param[in]	mode	lock mode
+@param[in]	block	buffer block containing the record
+@param[in]	heap_no	heap number of the record
+@param[in]	index	index of the record
+@param[in,out]	trx	transaction
+@param[out]	err	DB_SUCCESS or DB_SUCCESS_LOCKED_REC
+@return whether the request was handled */
+static
+bool
+lock_rec_lock_fast(
+	bool			impl,
+	ulint			mode,
+	const buf_block_t*	block,
+	ulint			heap_no,
+	dict_index_t*		index,
+	trx_t*			trx,
+	dberr_t&		err)
+{
+	const ulint	cell = buf_block_get_lock_hash_val(block);
+	bool		handled = true;
+
+	rw_lock_s_lock(&lock_sys.latch);
+	trx_mutex_enter(trx);
+	LockMutex&	rec_mutex = lock_sys.rec_mutex(cell);
+	mutex_enter(&rec_mutex);
+
+	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
+	      lock_table_has(trx, index->table, LOCK_IS));
+	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X ||
+	      lock_table_has(trx, index->table, LOCK_IX));
+
+	if (lock_t* lock = lock_rec_get_first_on_page(lock_sys.rec_hash,
+						      block)) {
+		if (lock_rec_get_next_on_page(lock)
+		    || lock->trx != trx
+		    || lock->type_mode != (mode | LOCK_REC)
+		    || lock_rec_get_n_bits(lock) <= heap_no) {
+			handled = false;
+		} else if (!impl && !lock_rec_get_nth_bit(lock, heap_no)) {
+			lock_rec_set_nth_bit(lock, heap_no);
+			err = DB_SUCCESS_LOCKED_REC;
+		}
+	} else {
+		if (!impl) {
+			lock_rec_create(
+#ifdef WITH_WSREP
+				NULL, NULL,
+#endif
+				mode, block, heap_no, index, trx, true);
+		}
+
+		err = DB_SUCCESS_LOCKED_REC;
+	}
+
+	mutex_exit(&rec_mutex);
+	trx_mutex_exit(trx);
+	rw_lock_s_unlock(&lock_sys.latch);
+
+	return(handled);
+}
+
 /*********************************************************************//**
 Tries to lock the specified record in the mode requested. If not immediately
 possible, enqueues a waiting lock request. This is a low-level function
@@ -1947,6 +2029,12 @@ lock_rec_lock(
   ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
   DBUG_EXECUTE_IF("innodb_report_deadlock", return DB_DEADLOCK;);
 
+  if (lock_rec_lock_fast(impl, mode, block, heap_no, index, trx, err))
+  {
+    MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+    return err;
+  }
+
   lock_mutex_enter();
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
         lock_table_has(trx, index->table, LOCK_IS));
@@ -4577,7 +4665,7 @@ lock_print_info_summary(
 	mutex. */
 	if (!nowait) {
 		lock_mutex_enter();
-	} else if (lock_mutex_enter_nowait()) {
+	} else if (!lock_mutex_enter_nowait()) {
 		fputs("FAIL TO OBTAIN LOCK MUTEX,"
 		      " SKIP LOCK INFO PRINTING\n", file);
 		return(FALSE);
@@ -192,6 +192,7 @@ void log_buffer_extend(ulong len)
 	}
 
 	log_sys.is_extending = true;
+	log_sys.wait_for_pending_copies();
 
 	while (ut_calc_align_down(log_sys.buf_free,
 				  OS_FILE_LOG_BLOCK_SIZE)
@@ -203,6 +204,7 @@ void log_buffer_extend(ulong len)
 		log_buffer_flush_to_disk();
 
 		log_mutex_enter_all();
+		log_sys.wait_for_pending_copies();
 	}
 
 	ulong move_start = ut_calc_align_down(
@@ -391,19 +393,20 @@ log_reserve_and_open(
 	return(log_sys.lsn);
 }
 
-/************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
-void
-log_write_low(
-/*==========*/
-	const byte*	str,		/*!< in: string */
-	ulint		str_len)	/*!< in: string length */
+/** Reserve space for a string in the log buffer, without copying it.
+This updates the log block headers and log_sys.lsn, log_sys.buf_free
+exactly as log_write_low() would. It is assumed that the caller holds
+the log mutex and invokes log_buffer_copy() later.
+@param[in]	str_len	string length
+@return byte offset of the reserved area within log_sys.buf */
+ulint
+log_reserve_low(ulint str_len)
 {
 	ulint	len;
 
 	ut_ad(log_mutex_own());
 	const ulint trailer_offset = log_sys.trailer_offset();
+	const ulint offset = log_sys.buf_free;
 part_loop:
 	/* Calculate a part length */
 
@@ -421,10 +424,7 @@ log_write_low(
 			- log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE;
 	}
 
-	memcpy(log_sys.buf + log_sys.buf_free, str, len);
-
 	str_len -= len;
-	str = str + len;
 
 	byte* log_block = static_cast<byte*>(
 		ut_align_down(log_sys.buf + log_sys.buf_free,
@@ -457,6 +457,56 @@ log_write_low(
 	}
 
 	srv_stats.log_write_requests.inc();
+
+	return(offset);
+}
+
+/** Copy a string to a log buffer area that was reserved by
+log_reserve_low(), skipping the log block framing. This does not
+require the log mutex.
+@param[in,out]	buf	log_sys.buf at the time of the reservation
+@param[in]	offset	byte offset within buf
+@param[in]	str	string
+@param[in]	str_len	string length
+@return byte offset within buf for copying the next string */
+ulint
+log_buffer_copy(byte* buf, ulint offset, const byte* str, ulint str_len)
+{
+	const ulint trailer_offset = log_sys.trailer_offset();
+
+	while (str_len > 0) {
+		ut_ad(offset % OS_FILE_LOG_BLOCK_SIZE >= LOG_BLOCK_HDR_SIZE);
+		ut_ad(offset % OS_FILE_LOG_BLOCK_SIZE < trailer_offset);
+
+		const ulint len = std::min(
+			str_len,
+			trailer_offset - offset % OS_FILE_LOG_BLOCK_SIZE);
+
+		memcpy(buf + offset, str, len);
+
+		str += len;
+		str_len -= len;
+		offset += len;
+
+		if (offset % OS_FILE_LOG_BLOCK_SIZE == trailer_offset) {
+			/* Skip the trailer and the next block header */
+			offset += log_sys.framing_size();
+		}
+	}
+
+	return(offset);
+}
+
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+void
+log_write_low(
+/*==========*/
+	const byte*	str,		/*!< in: string */
+	ulint		str_len)	/*!< in: string length */
+{
+	log_buffer_copy(log_sys.buf, log_reserve_low(str_len), str, str_len);
 }
 
 /************************************************************//**
@@ -620,6 +670,7 @@ void log_t::create()
 
   buf_next_to_write= 0;
   is_extending= false;
+  n_pending_copies= 0;
   write_lsn= lsn;
   flushed_to_disk_lsn= 0;
   n_pending_flushes= 0;
@@ -996,6 +1047,10 @@ void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
 	}
 
 	log_mutex_enter();
+	/* Wait for the log records of reserved areas to be copied
+	before writing out or switching log_sys.buf. */
+	log_sys.wait_for_pending_copies();
+
 	if (!flush_to_disk
 	    && log_sys.buf_free == log_sys.buf_next_to_write) {
 		/* Nothing to write and no flush to disk requested */
@@ -118,6 +118,7 @@ static lsn_t	recv_max_page_lsn;
 
 #ifdef UNIV_PFS_THREAD
 mysql_pfs_key_t	trx_rollback_clean_thread_key;
+mysql_pfs_key_t	recv_apply_thread_key;
 mysql_pfs_key_t	recv_writer_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
@@ -2045,6 +2046,95 @@ static ulint recv_read_in_area(const page_id_t page_id)
 	return(n);
 }
 
+/** Arguments of recv_apply_thread() */
+struct recv_apply_thread_arg_t {
+	/** the pages of the partition to apply */
+	std::vector<recv_addr_t*>	addrs;
+	/** thread identifier */
+	os_thread_id_t			id;
+};
+
+/** Apply the hashed log records of one partition of recv_sys->addr_hash.
+Pages are partitioned by tablespace and read-ahead area, so that the
+recv_read_in_area() requests of different partitions do not overlap.
+recv_sys->mutex is only held while the state of a page is being checked.
+@param[in]	addrs	the pages of the partition */
+static void recv_apply_part(const std::vector<recv_addr_t*>& addrs)
+{
+	ut_ad(!mutex_own(&recv_sys->mutex));
+
+	for (std::vector<recv_addr_t*>::const_iterator it = addrs.begin();
+	     it != addrs.end(); ++it) {
+		recv_addr_t*	recv_addr = *it;
+		fil_space_t*	space = fil_space_acquire_for_io(
+			recv_addr->space);
+
+		mutex_enter(&recv_sys->mutex);
+
+		if (!space) {
+			ut_a(recv_sys->n_addrs);
+			recv_sys->n_addrs--;
+			mutex_exit(&recv_sys->mutex);
+			continue;
+		}
+
+		const bool	not_processed
+			= recv_addr->state == RECV_NOT_PROCESSED;
+
+		mutex_exit(&recv_sys->mutex);
+
+		if (not_processed) {
+			const page_id_t	page_id(recv_addr->space,
+						recv_addr->page_no);
+
+			if (buf_page_peek(page_id)) {
+				mtr_t	mtr;
+				mtr.start();
+
+				buf_block_t* block = buf_page_get(
+					page_id, space->zip_size(),
+					RW_X_LATCH, &mtr);
+
+				buf_block_dbg_add_level(
+					block, SYNC_NO_ORDER_CHECK);
+
+				recv_recover_page(FALSE, block);
+				mtr.commit();
+			} else {
+				recv_read_in_area(page_id);
+			}
+		}
+
+		space->release_for_io();
+	}
+}
+
+/******************************************************************//**
+Thread that applies redo log records to the pages of one partition
+of recv_sys->addr_hash.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(
+/*==============================*/
+	void*	arg)	/*!< in: recv_apply_thread_arg_t */
+{
+	my_thread_init();
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	recv_apply_part(static_cast<const recv_apply_thread_arg_t*>(arg)
+			->addrs);
+
+	my_thread_end();
+	/* The thread is joined by recv_apply_hashed_log_recs(). */
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /** Apply the hash table of stored log records to persistent data pages.
 @param[in]	last_batch	whether the change buffer merge will be
 				performed as part of the operation */
@@ -2098,6 +2188,9 @@ void recv_apply_hashed_log_recs(bool last_batch)
 	recv_sys->apply_log_recs = TRUE;
 	recv_sys->apply_batch_on = TRUE;
 
+	const ulint n_pages = recv_sys->n_addrs;
+	const ulint start_time = ut_time_ms();
+
 	for (ulint id = srv_undo_tablespaces_open; id--; ) {
 		recv_sys_t::trunc& t = recv_sys->truncated_undo_spaces[id];
 		if (t.lsn) {
@@ -2106,6 +2199,14 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		}
 	}
 
+	const ulint n_threads = std::min<ulint>(
+		std::max<ulint>(srv_n_recovery_apply_threads, 1),
+		std::max<ulint>(recv_sys->n_addrs, 1));
+	recv_apply_thread_arg_t* args = UT_NEW_ARRAY_NOKEY(
+		recv_apply_thread_arg_t, n_threads);
+
+	/* Hand each thread its own part of addr_hash, so that the threads
+	do not need to walk the whole hash table. */
 	for (ulint i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
 		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
 			     HASH_GET_FIRST(recv_sys->addr_hash, i));
@@ -2115,49 +2216,32 @@ void recv_apply_hashed_log_recs(bool last_batch)
 
 			if (recv_addr->state == RECV_DISCARDED
 			    || !UT_LIST_GET_LEN(recv_addr->rec_list)) {
-not_found:
 				ut_a(recv_sys->n_addrs);
 				recv_sys->n_addrs--;
 				continue;
 			}
 
-			fil_space_t* space = fil_space_acquire_for_io(
-				recv_addr->space);
-			if (!space) {
-				goto not_found;
-			}
-
-			const page_id_t		page_id(recv_addr->space,
-							recv_addr->page_no);
-			const ulint zip_size = space->zip_size();
-
-			if (recv_addr->state == RECV_NOT_PROCESSED) {
-				mutex_exit(&recv_sys->mutex);
-
-				if (buf_page_peek(page_id)) {
-					mtr_t	mtr;
-					mtr.start();
-
-					buf_block_t* block = buf_page_get(
-						page_id, zip_size,
-						RW_X_LATCH, &mtr);
+			args[(recv_addr->space
+			      + recv_addr->page_no / RECV_READ_AHEAD_AREA)
+			     % n_threads].addrs.push_back(recv_addr);
+		}
+	}
 
-					buf_block_dbg_add_level(
-						block, SYNC_NO_ORDER_CHECK);
+	mutex_exit(&recv_sys->mutex);
 
-					recv_recover_page(FALSE, block);
-					mtr.commit();
-				} else {
-					recv_read_in_area(page_id);
-				}
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_create(recv_apply_thread, &args[i], &args[i].id);
+	}
 
-				mutex_enter(&recv_sys->mutex);
-			}
+	recv_apply_part(args[0].addrs);
 
-			space->release_for_io();
-		}
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_join(args[i].id);
 	}
 
+	UT_DELETE_ARRAY(args);
+	mutex_enter(&recv_sys->mutex);
+
 	/* Wait until all the pages have been processed */
 
 	while (recv_sys->n_addrs != 0) {
@@ -2174,6 +2258,15 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		mutex_enter(&(recv_sys->mutex));
 	}
 
+	if (n_pages) {
+		ib::info() << (last_batch
+			       ? "Applied final batch of "
+			       : "Applied a batch of ")
+			   << n_pages << " pages from redo log in "
+			   << ut_time_ms() - start_time << " ms using "
+			   << n_threads << " threads";
+	}
+
 	if (!last_batch) {
 		/* Flush all the file pages to disk and invalidate them in
 		the buffer pool */
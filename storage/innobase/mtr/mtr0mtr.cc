@@ -382,7 +382,8 @@ class mtr_t::Command {
 	/** Constructor.
 	Takes ownership of the mtr->m_impl, is responsible for deleting it.
 	@param[in,out]	mtr	mini-transaction */
-	explicit Command(mtr_t* mtr) : m_impl(&mtr->m_impl), m_locks_released()
+	explicit Command(mtr_t* mtr) : m_impl(&mtr->m_impl), m_locks_released(),
+		m_copy_buf(NULL)
 	{}
 
 	/** Destructor */
@@ -411,6 +412,15 @@ class mtr_t::Command {
 	@param[in]	len	number of bytes to write */
 	void finish_write(ulint len);
 
+	/** Reserve space for the redo log records in the redo log buffer,
+	to be filled by copy_write() after releasing log_sys.mutex.
+	@param[in]	len	number of bytes to write */
+	void reserve_write(ulint len);
+
+	/** Copy the redo log records to the area that was reserved
+	in reserve_write(). */
+	void copy_write();
+
 private:
 	/** Prepare to write the mini-transaction log to the redo log buffer.
 	@return number of bytes to write in finish_write() */
@@ -428,6 +438,12 @@ class mtr_t::Command {
 
 	/** End lsn of the possible log entry for this mtr */
 	lsn_t			m_end_lsn;
+
+	/** log_sys.buf at the time of reserve_write(), or NULL */
+	byte*			m_copy_buf;
+
+	/** Offset of the reserved area within m_copy_buf */
+	ulint			m_copy_offset;
 };
 
 /** Check if a mini-transaction is dirtying a clean page.
@@ -455,6 +471,30 @@ struct mtr_write_log_t {
 	}
 };
 
+/** Copy the block contents to a reserved area of the REDO log buffer */
+struct mtr_copy_log_t {
+	/** Constructor.
+	@param[in,out]	buf	log_sys.buf at the time of the reservation
+	@param[in]	offset	start offset of the reserved area */
+	mtr_copy_log_t(byte* buf, ulint offset) :
+		m_buf(buf), m_offset(offset) {}
+
+	/** Copy a block to the reserved area.
+	@return whether the copying should continue */
+	bool operator()(const mtr_buf_t::block_t* block)
+	{
+		m_offset = log_buffer_copy(m_buf, m_offset,
+					   block->begin(), block->used());
+		return(true);
+	}
+
+private:
+	/** log_sys.buf at the time of the reservation */
+	byte*	m_buf;
+	/** current offset within m_buf */
+	ulint	m_offset;
+};
+
 /** Append records to the system-wide redo log buffer.
 @param[in]	log	redo log records */
 void
@@ -849,6 +889,46 @@ mtr_t::Command::finish_write(
 	m_end_lsn = log_close();
 }
 
+/** Reserve space for the redo log records in the redo log buffer,
+to be filled by copy_write() after releasing log_sys.mutex.
+@param[in]	len	number of bytes to write */
+void
+mtr_t::Command::reserve_write(
+	ulint	len)
+{
+	ut_ad(m_impl->m_log_mode == MTR_LOG_ALL);
+	ut_ad(log_mutex_own());
+	ut_ad(m_impl->m_log.size() == len);
+	ut_ad(len > 0);
+
+	m_start_lsn = log_reserve_and_open(len);
+
+	/* log_reserve_and_open() may have released log_sys.mutex,
+	so read the buffer only now. It cannot be switched or
+	extended until copy_write() has completed. */
+	m_copy_buf = log_sys.buf;
+	m_copy_offset = log_reserve_low(len);
+
+	m_end_lsn = log_close();
+
+	log_sys.n_pending_copies.fetch_add(1, std::memory_order_relaxed);
+}
+
+/** Copy the redo log records to the area that was reserved
+in reserve_write(). */
+void
+mtr_t::Command::copy_write()
+{
+	ut_ad(m_copy_buf);
+	ut_ad(!log_mutex_own());
+
+	mtr_copy_log_t	copy_log(m_copy_buf, m_copy_offset);
+	m_impl->m_log.for_each_block(copy_log);
+
+	log_sys.n_pending_copies.fetch_sub(1, std::memory_order_release);
+	m_copy_buf = NULL;
+}
+
 /** Release the latches and blocks acquired by this mini-transaction */
 void
 mtr_t::Command::release_all()
@@ -893,7 +973,11 @@ mtr_t::Command::execute()
 	ut_ad(m_impl->m_log_mode != MTR_LOG_NONE);
 
 	if (const ulint len = prepare_write()) {
-		finish_write(len);
+		if (srv_log_parallel_copy) {
+			reserve_write(len);
+		} else {
+			finish_write(len);
+		}
 	}
 
 	if (m_impl->m_made_dirty) {
@@ -905,6 +989,14 @@ mtr_t::Command::execute()
 	to insert into the flush list. */
 	log_mutex_exit();
 
+	if (m_copy_buf) {
+		/* Other mini-transactions may reserve space and copy
+		their log records concurrently with us. Any writer of
+		log_sys.buf will wait for us in
+		log_t::wait_for_pending_copies(). */
+		copy_write();
+	}
+
 	m_impl->m_mtr->m_commit_lsn = m_end_lsn;
 
 	release_blocks();
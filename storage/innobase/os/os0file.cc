@@ -53,9 +53,13 @@ Created 10/21/1995 Heikki Tuuri
 #include "os0thread.h"
 
 #include <vector>
+#include <algorithm>
 
 #ifdef LINUX_NATIVE_AIO
-#include <libaio.h>
+# include <libaio.h>
+# ifdef HAVE_URING
+#  include <liburing.h>
+# endif
 #endif /* LINUX_NATIVE_AIO */
 
 #ifdef HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE
@@ -244,7 +248,7 @@ struct Slot {
 	/** aio array containing this slot */
 	AIO				*array;
 #elif defined(LINUX_NATIVE_AIO)
-	/** Linux control block for aio */
+	/** Linux control block for libaio */
 	struct iocb		control;
 
 	/** AIO return code */
@@ -281,8 +285,9 @@ class AIO {
 	~AIO();
 
 	/** Initialize the instance
+	@param[in]	id	Latch ID
 	@return DB_SUCCESS or error code */
-	dberr_t init();
+	dberr_t init(latch_id_t id);
 
 	/** Requests for a slot in the aio array. If no slot is available, waits
 	until not_full-event becomes signaled.
@@ -391,6 +396,85 @@ class AIO {
 	bool linux_dispatch(Slot* slot)
 		MY_ATTRIBUTE((warn_unused_result));
 
+# ifdef HAVE_URING
+	/** @return whether the array uses io_uring instead of libaio */
+	bool uses_uring() const
+	{
+		return(m_uring != NULL);
+	}
+
+	/** Dispatch an AIO request to io_uring. The request is only
+	queued if it was flagged IORequest::DO_NOT_WAKE.
+	@param[in,out]	slot	an already reserved slot
+	@param[in]	wait	false if called by the I/O handler thread
+				of the segment, which must not wait for
+				itself
+	@return whether the request was queued; always true if wait */
+	bool uring_dispatch(Slot* slot, bool wait)
+		MY_ATTRIBUTE((warn_unused_result));
+
+	/** Accessor for the io_uring instance
+	@param[in]	segment	Segment for which to get the ring
+	@return the io_uring instance of the segment */
+	struct io_uring* io_ring(ulint segment)
+		MY_ATTRIBUTE((warn_unused_result))
+	{
+		ut_ad(segment < get_n_segments());
+
+		return(&m_uring[segment].ring);
+	}
+
+	/** Submit the requests that were queued with
+	IORequest::DO_NOT_WAKE in a segment.
+	@param[in]	segment	Segment whose requests to submit */
+	void uring_submit(ulint segment);
+
+	/** Submit the queued requests of all segments of all arrays */
+	static void uring_submit_all();
+
+	/** Arm the periodic timer of a segment unless it is pending,
+	and submit any queued requests. The I/O handler thread calls
+	this before blocking in io_uring_wait_cqe(), so that it wakes
+	up at least every OS_AIO_REAP_TIMEOUT to check the server state.
+	@param[in]	segment	Segment whose timer to arm */
+	void uring_arm_timer(ulint segment);
+
+	/** Note that the I/O handler thread of a segment has made room
+	in the completion queue, waking up any submitter in uring_flush().
+	@param[in]	segment	Segment whose completions were reaped */
+	void uring_reaped(ulint segment)
+	{
+		os_event_set(m_uring[segment].cq_space);
+	}
+
+	/** Note that the periodic timer of a segment has expired
+	@param[in]	segment	Segment whose timer expired */
+	void uring_timer_expired(ulint segment)
+	{
+		mutex_enter(&m_uring[segment].mutex);
+		m_uring[segment].timer_armed = false;
+		mutex_exit(&m_uring[segment].mutex);
+	}
+
+	/** Register memory ranges for IORING_OP_READ_FIXED and
+	IORING_OP_WRITE_FIXED requests in all segments.
+	@param[in]	iov	memory ranges
+	@param[in]	n	number of memory ranges */
+	static void uring_register_buffers(const struct iovec* iov,
+					   ulint n);
+
+	/** Stop using and unregister the registered memory ranges */
+	static void uring_unregister_buffers();
+
+	/** Creates an io_uring instance.
+	@param[in]	max_events	number of submission queue entries
+	@param[out]	ring		ring to initialize
+	@return true on success. */
+	static bool linux_create_io_ctx(unsigned max_events,
+					struct io_uring* ring)
+		MY_ATTRIBUTE((warn_unused_result));
+# endif /* HAVE_URING */
+
 	/** Accessor for an AIO event
 	@param[in]	index	Index into the array
 	@return the event at the index */
@@ -575,9 +659,20 @@ class AIO {
 
 #ifdef LINUX_NATIVE_AIO
 	/** Initialise the Linux native AIO data structures
+	@param[in]	id	Latch ID
+	@return DB_SUCCESS or error code */
+	dberr_t init_linux_native_aio(latch_id_t id)
+		MY_ATTRIBUTE((warn_unused_result));
+
+# ifdef HAVE_URING
+	/** Initialise the io_uring instances of the array. If that fails,
+	m_uring is left NULL, and either libaio is to be used instead
+	(innodb_linux_aio=auto) or srv_use_native_aio is cleared.
+	@param[in]	id	Latch ID of the submission queue mutexes
 	@return DB_SUCCESS or error code */
-	dberr_t init_linux_native_aio()
+	dberr_t init_uring(latch_id_t id)
 		MY_ATTRIBUTE((warn_unused_result));
+# endif /* HAVE_URING */
 #endif /* LINUX_NATIVE_AIO */
 
 private:
@@ -609,6 +704,46 @@ class AIO {
 	ulint			m_n_reserved;
 
 
+#if defined(LINUX_NATIVE_AIO) && defined(HAVE_URING)
+	/** io_uring submission and completion queues of a segment */
+	struct uring_t {
+		/** the ring; the submission queue is protected by mutex,
+		the completion queue is only accessed by the I/O handler
+		thread of the segment */
+		struct io_uring	ring;
+
+		/** protects the submission queue and n_queued */
+		SysMutex	mutex;
+
+		/** number of requests that were queued but not submitted */
+		ulint		n_queued;
+
+		/** whether an IORING_OP_TIMEOUT request is pending */
+		bool		timer_armed;
+
+		/** timeout of the IORING_OP_TIMEOUT requests */
+		struct __kernel_timespec timeout;
+
+		/** set by the I/O handler thread after it has reaped
+		completions; waited for by uring_flush() */
+		os_event_t	cq_space;
+	};
+
+	/** Submit the queued io_uring requests of a segment. If the
+	kernel is out of resources or the completion queue is full,
+	release the mutex while waiting for the I/O handler thread to
+	reap completions.
+	@param[in,out]	u	io_uring of a segment, with mutex held
+	@param[in]	wait	false if called by the I/O handler thread
+				of the segment, which must not wait for
+				itself
+	@return whether the requests were submitted */
+	static bool uring_flush(uring_t& u, bool wait = true);
+
+	/** io_uring instances, one per segment. Each thread will work
+	on one ring exclusively. NULL if the array uses libaio. */
+	uring_t*		m_uring;
+#endif /* LINUX_NATIVE_AIO && HAVE_URING */
 #if defined(LINUX_NATIVE_AIO)
 	typedef std::vector<io_event> IOEvents;
 
@@ -650,7 +785,7 @@ AIO*	AIO::s_log;
 AIO*	AIO::s_sync;
 
 #if defined(LINUX_NATIVE_AIO)
-/** timeout for each io_getevents() call = 500ms. */
+/** timeout for each io_getevents() call or io_uring timer = 500ms. */
 static const ulint	OS_AIO_REAP_TIMEOUT = 500000000UL;
 
 /** time to sleep, in microseconds if io_setup() returns EAGAIN. */
@@ -658,6 +793,27 @@ static const ulint	OS_AIO_IO_SETUP_RETRY_SLEEP = 500000UL;
 
 /** number of attempts before giving up on io_setup(). */
 static const int	OS_AIO_IO_SETUP_RETRY_ATTEMPTS = 5;
+
+# ifdef HAVE_URING
+/** Whether AIO::init() should create io_uring instances instead of
+libaio contexts; determined by innodb_linux_aio in AIO::start() */
+static bool			os_aio_uring;
+
+/** Memory ranges that were registered with io_uring_register_buffers(),
+sorted by address */
+static std::vector<iovec>	os_aio_fixed_buffers;
+
+/** Whether os_aio_fixed_buffers may be used; cleared while holding
+the mutex of each AIO::uring_t */
+static bool			os_aio_use_fixed_buffers;
+
+/** Compare memory ranges by address.
+@return whether a starts before b */
+static bool os_aio_iovec_less(const iovec& a, const iovec& b)
+{
+	return(a.iov_base < b.iov_base);
+}
+# endif /* HAVE_URING */
 #endif /* LINUX_NATIVE_AIO */
 
 /** Array of events used in simulated AIO */
@@ -1597,14 +1753,32 @@ class LinuxAIOHandler {
 	/** This is called from within the IO-thread. If there are no completed
 	IO requests in the slot array, the thread calls this function to
 	collect more requests from the Linux kernel.
-	The IO-thread waits on io_getevents(), which is a blocking call, with
-	a timeout value. Unless the system is very heavy loaded, keeping the
-	IO-thread very busy, the io-thread will spend most of its time waiting
-	in this function.
+	The IO-thread waits on io_getevents() or io_uring_wait_cqe(), which
+	is a blocking call, with a timeout value. Unless the system is very
+	heavy loaded, keeping the IO-thread very busy, the io-thread will
+	spend most of its time waiting in this function.
 	The IO-thread also exits in this function. It checks server status at
-	each wakeup and that is why we use timed wait in io_getevents(). */
+	each wakeup and that is why we use a timed wait. */
 	void collect();
 
+#ifdef HAVE_URING
+	/** collect() for an array that uses io_uring */
+	void uring_collect();
+
+	/** Process the entries that are available in the completion
+	queue of the segment, without waiting for more.
+	@param[in]	owned	whether the caller holds the array mutex
+	@return number of completed I/O requests */
+	int uring_reap(bool owned);
+#endif /* HAVE_URING */
+
+	/** Mark a request as completed by the kernel.
+	@param[in,out]	slot	the completed request
+	@param[in]	n_bytes	number of bytes transferred
+	@param[in]	ret	0 or negative error code
+	@param[in]	owned	whether the caller holds the array mutex */
+	void completed(Slot* slot, long n_bytes, int ret, bool owned = false);
+
 private:
 	/** Slot array */
 	AIO*			m_array;
@@ -1647,6 +1821,24 @@ LinuxAIOHandler::resubmit(Slot* slot)
 
 	compile_time_assert(sizeof(off_t) >= sizeof(os_offset_t));
 
+#ifdef HAVE_URING
+	if (m_array->uses_uring()) {
+		/* Submit the remainder right away; nobody would wake
+		us up. Only this thread reaps the completion queue of
+		the segment, so it must not wait for room in it.
+		Instead, reap the completions and try again. */
+		slot->type.clear_do_not_wake();
+
+		while (!m_array->uring_dispatch(slot, false)) {
+			if (!uring_reap(true)) {
+				os_thread_yield();
+			}
+		}
+
+		return(DB_SUCCESS);
+	}
+#endif /* HAVE_URING */
+
 	struct iocb*	iocb = &slot->control;
 
 	if (slot->type.is_read()) {
@@ -1758,16 +1950,63 @@ LinuxAIOHandler::find_completed_slot(ulint* n_pending)
 	return(NULL);
 }
 
+/** Mark a request as completed by the kernel.
+@param[in,out]	slot	the completed request
+@param[in]	n_bytes	number of bytes transferred
+@param[in]	ret	0 or negative error code
+@param[in]	owned	whether the caller holds the array mutex */
+void
+LinuxAIOHandler::completed(Slot* slot, long n_bytes, int ret, bool owned)
+{
+	/* Some sanity checks. */
+	ut_a(slot != NULL);
+	ut_a(slot->is_reserved);
+
+	/* We are not scribbling previous segment. */
+	ut_a(slot->pos >= m_segment * m_n_slots);
+
+	/* We have not overstepped to next segment. */
+	ut_a(slot->pos < (m_segment + 1) * m_n_slots);
+
+	/* Deallocate unused blocks from file system.
+	This is newer done to page 0 or to log files.*/
+	if (slot->offset > 0
+	    && !slot->type.is_log()
+	    && slot->type.is_write()
+	    && slot->type.punch_hole()) {
+
+		slot->err = slot->type.punch_hole(
+			slot->file,
+			slot->offset, slot->len);
+	} else {
+		slot->err = DB_SUCCESS;
+	}
+
+	/* Mark this request as completed. The error handling
+	will be done in the calling function. */
+	if (!owned) {
+		m_array->acquire();
+	}
+
+	slot->ret = ret;
+	slot->io_already_done = true;
+	slot->n_bytes = n_bytes;
+
+	if (!owned) {
+		m_array->release();
+	}
+}
+
 /** This function is only used in Linux native asynchronous i/o. This is
 called from within the io-thread. If there are no completed IO requests
 in the slot array, the thread calls this function to collect more
 requests from the kernel.
-The io-thread waits on io_getevents(), which is a blocking call, with
-a timeout value. Unless the system is very heavy loaded, keeping the
-io-thread very busy, the io-thread will spend most of its time waiting
-in this function.
+The io-thread waits on io_getevents() or io_uring_wait_cqe(), which is
+a blocking call, with a timeout value. Unless the system is very heavy
+loaded, keeping the io-thread very busy, the io-thread will spend most
+of its time waiting in this function.
 The io-thread also exits in this function. It checks server status at
-each wakeup and that is why we use timed wait in io_getevents(). */
+each wakeup and that is why we use a timed wait. */
 void
 LinuxAIOHandler::collect()
 {
@@ -1775,15 +2014,16 @@ LinuxAIOHandler::collect()
 	ut_ad(m_array != NULL);
 	ut_ad(m_segment < m_array->get_n_segments());
 
+#ifdef HAVE_URING
+	if (m_array->uses_uring()) {
+		uring_collect();
+		return;
+	}
+#endif /* HAVE_URING */
+
 	/* Which io_context we are going to use. */
 	io_context*	io_ctx = m_array->io_ctx(m_segment);
 
-	/* Starting point of the m_segment we will be working on. */
-	ulint	start_pos = m_segment * m_n_slots;
-
-	/* End point. */
-	ulint	end_pos = start_pos + m_n_slots;
-
 	for (;;) {
 		struct io_event*	events;
 
@@ -1811,41 +2051,8 @@ LinuxAIOHandler::collect()
 			iocb = reinterpret_cast<struct iocb*>(events[i].obj);
 			ut_a(iocb != NULL);
 
-			Slot*	slot = reinterpret_cast<Slot*>(iocb->data);
-
-			/* Some sanity checks. */
-			ut_a(slot != NULL);
-			ut_a(slot->is_reserved);
-
-			/* We are not scribbling previous segment. */
-			ut_a(slot->pos >= start_pos);
-
-			/* We have not overstepped to next segment. */
-			ut_a(slot->pos < end_pos);
-
-			/* Deallocate unused blocks from file system.
-			This is newer done to page 0 or to log files.*/
-			if (slot->offset > 0
-			    && !slot->type.is_log()
-			    && slot->type.is_write()
-			    && slot->type.punch_hole()) {
-
-				slot->err = slot->type.punch_hole(
-					slot->file,
-					slot->offset, slot->len);
-			} else {
-				slot->err = DB_SUCCESS;
-			}
-
-			/* Mark this request as completed. The error handling
-			will be done in the calling function. */
-			m_array->acquire();
-
-			slot->ret = events[i].res2;
-			slot->io_already_done = true;
-			slot->n_bytes = events[i].res;
-
-			m_array->release();
+			completed(reinterpret_cast<Slot*>(iocb->data),
+				  events[i].res, int(events[i].res2));
 		}
 
 		if (srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS
@@ -1885,6 +2092,98 @@ LinuxAIOHandler::collect()
 	}
 }
 
+#ifdef HAVE_URING
+/** Process the entries that are available in the completion queue of
+the segment, without waiting for more.
+@param[in]	owned	whether the caller holds the array mutex
+@return number of completed I/O requests */
+int
+LinuxAIOHandler::uring_reap(bool owned)
+{
+	struct io_uring*	ring = m_array->io_ring(m_segment);
+	struct io_uring_cqe*	cqe;
+	unsigned		head;
+	unsigned		n_cqe = 0;
+	int			n = 0;
+	bool			expired = false;
+
+	io_uring_for_each_cqe(ring, head, cqe) {
+		Slot*	slot = static_cast<Slot*>(io_uring_cqe_get_data(cqe));
+
+		++n_cqe;
+
+		if (slot == NULL) {
+			expired = true;
+			continue;
+		}
+
+		++n;
+
+		if (cqe->res < 0) {
+			completed(slot, 0, cqe->res, owned);
+		} else {
+			completed(slot, cqe->res, 0, owned);
+		}
+	}
+
+	if (n_cqe) {
+		/* Make room in the completion queue, and wake up
+		anyone who is waiting for that in uring_flush(). */
+		io_uring_cq_advance(ring, n_cqe);
+		m_array->uring_reaped(m_segment);
+	}
+
+	if (expired) {
+		m_array->uring_timer_expired(m_segment);
+	}
+
+	return(n);
+}
+
+/** collect() for an array that uses io_uring */
+void
+LinuxAIOHandler::uring_collect()
+{
+	/* Which ring we are going to use. */
+	struct io_uring*	ring = m_array->io_ring(m_segment);
+
+	for (;;) {
+		/* The IORING_OP_TIMEOUT request of the segment bounds
+		the wait, so that we will notice a shutdown. */
+		m_array->uring_arm_timer(m_segment);
+
+		struct io_uring_cqe*	cqe;
+
+		int	ret = io_uring_wait_cqe(ring, &cqe);
+
+		if (ret == 0) {
+			ret = uring_reap(false);
+		}
+
+		if (srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS
+		    || !buf_page_cleaner_is_active
+		    || ret > 0) {
+
+			break;
+		}
+
+		switch (ret) {
+		case -EAGAIN:
+		case -EINTR:
+		case 0:
+			/* Only the timer expired, or we were interrupted.
+			Go back and check again. */
+			continue;
+		}
+
+		/* All other errors should cause a trap for now. */
+		ib::fatal()
+			<< "Unexpected ret_code[" << ret
+			<< "] from io_uring_wait_cqe()!";
+	}
+}
+#endif /* HAVE_URING */
+
 /** Process a Linux AIO request
 @param[out]	m1		the messages passed with the
 @param[out]	m2		AIO request; note that in case the
@@ -2004,12 +2303,378 @@ os_aio_linux_handler(
 	return LinuxAIOHandler(global_segment).poll(m1, m2, request);
 }
 
+#ifdef HAVE_URING
+/** Find the registered memory range that contains a buffer.
+@param[in]	ptr	start of the buffer
+@param[in]	len	length of the buffer
+@return index of the range in os_aio_fixed_buffers, or -1 */
+static int
+os_aio_fixed_buffer_index(const byte* ptr, ulint len)
+{
+	ulint	low = 0;
+	ulint	high = os_aio_fixed_buffers.size();
+
+	/* Find the last range that starts at or before ptr. */
+	while (low < high) {
+		ulint	mid = (low + high) / 2;
+
+		if (static_cast<const byte*>(os_aio_fixed_buffers[mid].iov_base)
+		    <= ptr) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	if (low == 0) {
+		return(-1);
+	}
+
+	const iovec&	iov = os_aio_fixed_buffers[low - 1];
+	const byte*	base = static_cast<const byte*>(iov.iov_base);
+
+	return(ptr + len <= base + iov.iov_len ? int(low - 1) : -1);
+}
+
+/** Submit the queued io_uring requests of a segment. If the kernel is
+out of resources or the completion queue is full, release the mutex while
+waiting for the I/O handler thread to reap completions.
+@param[in,out]	u	io_uring of a segment, with mutex held
+@param[in]	wait	false if called by the I/O handler thread of the
+			segment, which must not wait for itself
+@return whether the requests were submitted */
+bool
+AIO::uring_flush(uring_t& u, bool wait)
+{
+	ut_ad(mutex_own(&u.mutex));
+
+	for (;;) {
+		int	ret = io_uring_submit(&u.ring);
+
+		if (ret >= 0) {
+			u.n_queued = 0;
+			return(true);
+		}
+
+		switch (ret) {
+		case -EAGAIN:
+		case -EBUSY:
+			if (!wait) {
+				/* The caller will reap completions
+				and try again. */
+				return(false);
+			}
+			/* Not enough resources, or the completion queue
+			is full. The I/O handler thread will make room;
+			it needs the mutex in order to rearm its timer.
+			The unsubmitted requests stay in the submission
+			queue, and other threads may append to it. */
+			{
+				int64_t	sig_count = os_event_reset(
+					u.cq_space);
+				mutex_exit(&u.mutex);
+				os_event_wait_time_low(
+					u.cq_space,
+					OS_AIO_REAP_TIMEOUT / 1000,
+					sig_count);
+				mutex_enter(&u.mutex);
+			}
+			/* fall through */
+		case -EINTR:
+			continue;
+		}
+
+		ib::fatal()
+			<< "Unexpected ret_code[" << ret
+			<< "] from io_uring_submit()!";
+	}
+}
+
+/** Dispatch an AIO request to io_uring. The request is only queued if
+it was flagged IORequest::DO_NOT_WAKE; os_aio_simulated_wake_handler_threads()
+will submit the whole batch with a single system call.
+@param[in,out]	slot	an already reserved slot
+@param[in]	wait	false if called by the I/O handler thread of the
+			segment, which must not wait for itself
+@return whether the request was queued; always true if wait */
+bool
+AIO::uring_dispatch(Slot* slot, bool wait)
+{
+	ut_a(slot->is_reserved);
+	ut_ad(slot->type.validate());
+
+	/* The ring is one per segment. */
+	uring_t&	u = m_uring[(slot->pos * m_n_segments)
+				    / m_slots.size()];
+
+	mutex_enter(&u.mutex);
+
+	struct io_uring_sqe*	sqe;
+
+	/* The submission queue is sized for all slots of the segment,
+	but let us not depend on that. uring_flush() may release the
+	mutex, so the queue may be full again when it returns. */
+	while ((sqe = io_uring_get_sqe(&u.ring)) == NULL) {
+		if (!uring_flush(u, wait)) {
+			/* Only the caller can make room. */
+			mutex_exit(&u.mutex);
+			return(false);
+		}
+	}
+
+	int	index = os_aio_use_fixed_buffers
+		? os_aio_fixed_buffer_index(slot->ptr, slot->len) : -1;
+
+	if (slot->type.is_read()) {
+		if (index >= 0) {
+			io_uring_prep_read_fixed(
+				sqe, slot->file, slot->ptr, slot->len,
+				slot->offset, index);
+		} else {
+			io_uring_prep_read(
+				sqe, slot->file, slot->ptr, slot->len,
+				slot->offset);
+		}
+	} else {
+		ut_a(slot->type.is_write());
+
+		if (index >= 0) {
+			io_uring_prep_write_fixed(
+				sqe, slot->file, slot->ptr, slot->len,
+				slot->offset, index);
+		} else {
+			io_uring_prep_write(
+				sqe, slot->file, slot->ptr, slot->len,
+				slot->offset);
+		}
+	}
+
+	io_uring_sqe_set_data(sqe, slot);
+
+	if (!slot->type.is_wake() || !uring_flush(u, wait)) {
+		/* Without wait, the request stays in the submission
+		queue until the I/O handler thread has reaped some
+		completions and submits it in uring_arm_timer(). */
+		++u.n_queued;
+	}
+
+	mutex_exit(&u.mutex);
+
+	return(true);
+}
+
+/** Submit the requests that were queued with IORequest::DO_NOT_WAKE
+in a segment.
+@param[in]	segment	Segment whose requests to submit */
+void
+AIO::uring_submit(ulint segment)
+{
+	uring_t&	u = m_uring[segment];
+
+	mutex_enter(&u.mutex);
+
+	if (u.n_queued) {
+		uring_flush(u);
+	}
+
+	mutex_exit(&u.mutex);
+}
+
+/** Submit the queued requests of all segments of all arrays */
+void
+AIO::uring_submit_all()
+{
+	AIO*	all_arrays[] = { s_reads, s_writes, s_log, s_ibuf };
+
+	for (ulint i = 0; i < array_elements(all_arrays); i++) {
+		AIO*	array = all_arrays[i];
+
+		if (array == NULL || array->m_uring == NULL) {
+			continue;
+		}
+
+		for (ulint j = 0; j < array->m_n_segments; j++) {
+			array->uring_submit(j);
+		}
+	}
+}
+
+/** Arm the periodic timer of a segment unless it is pending,
+and submit any queued requests.
+@param[in]	segment	Segment whose timer to arm */
+void
+AIO::uring_arm_timer(ulint segment)
+{
+	uring_t&	u = m_uring[segment];
+
+	mutex_enter(&u.mutex);
+
+	/* This is called by the I/O handler thread of the segment.
+	If the completion queue is full, do not wait; the caller will
+	find the completions in io_uring_wait_cqe() and try again. */
+	if (!u.timer_armed) {
+		struct io_uring_sqe*	sqe = io_uring_get_sqe(&u.ring);
+
+		if (sqe == NULL && uring_flush(u, false)) {
+			sqe = io_uring_get_sqe(&u.ring);
+		}
+
+		if (sqe != NULL) {
+			io_uring_prep_timeout(sqe, &u.timeout, 0, 0);
+			io_uring_sqe_set_data(sqe, NULL);
+			u.timer_armed = true;
+			++u.n_queued;
+		}
+	}
+
+	if (u.n_queued) {
+		uring_flush(u, false);
+	}
+
+	mutex_exit(&u.mutex);
+}
+
+/** Register memory ranges for IORING_OP_READ_FIXED and
+IORING_OP_WRITE_FIXED requests in all segments.
+@param[in]	iov	memory ranges
+@param[in]	n	number of memory ranges */
+void
+AIO::uring_register_buffers(const struct iovec* iov, ulint n)
+{
+	AIO*	all_arrays[] = { s_reads, s_writes, s_log, s_ibuf };
+
+	ut_ad(!os_aio_use_fixed_buffers);
+
+	os_aio_fixed_buffers.assign(iov, iov + n);
+	std::sort(os_aio_fixed_buffers.begin(), os_aio_fixed_buffers.end(),
+		  os_aio_iovec_less);
+
+	for (ulint i = 0; i < array_elements(all_arrays); i++) {
+		AIO*	array = all_arrays[i];
+
+		if (array == NULL || array->m_uring == NULL) {
+			continue;
+		}
+
+		for (ulint j = 0; j < array->m_n_segments; j++) {
+			int	ret = io_uring_register_buffers(
+				&array->m_uring[j].ring,
+				&os_aio_fixed_buffers[0],
+				unsigned(os_aio_fixed_buffers.size()));
+
+			if (ret < 0) {
+				ib::warn()
+					<< "io_uring_register_buffers()"
+					" returned error[" << -ret << "];"
+					" not using registered buffers."
+					" Check the RLIMIT_MEMLOCK limit"
+					" (ulimit -l).";
+				uring_unregister_buffers();
+				return;
+			}
+		}
+	}
+
+	/* This is called during startup, before any page I/O. */
+	os_aio_use_fixed_buffers = true;
+
+	ib::info() << "Registered " << n
+		<< " buffer pool memory ranges with io_uring";
+}
+
+/** Stop using and unregister the registered memory ranges */
+void
+AIO::uring_unregister_buffers()
+{
+	AIO*	all_arrays[] = { s_reads, s_writes, s_log, s_ibuf };
+
+	if (os_aio_fixed_buffers.empty()) {
+		return;
+	}
+
+	for (ulint i = 0; i < array_elements(all_arrays); i++) {
+		AIO*	array = all_arrays[i];
+
+		if (array == NULL || array->m_uring == NULL) {
+			continue;
+		}
+
+		for (ulint j = 0; j < array->m_n_segments; j++) {
+			uring_t&	u = array->m_uring[j];
+
+			/* After this, linux_dispatch() will not submit
+			any more fixed-buffer requests to this ring.
+			Pending ones keep their own reference to the
+			registered memory. */
+			mutex_enter(&u.mutex);
+			os_aio_use_fixed_buffers = false;
+			mutex_exit(&u.mutex);
+
+			/* This fails with ENXIO if nothing was
+			registered; ignore that. */
+			io_uring_unregister_buffers(&u.ring);
+		}
+	}
+
+	os_aio_fixed_buffers.clear();
+}
+
+/** Creates an io_uring instance.
+@param[in]	max_events	number of submission queue entries
+@param[out]	ring		ring to initialize
+@return true on success. */
+bool
+AIO::linux_create_io_ctx(
+	unsigned	max_events,
+	struct io_uring* ring)
+{
+	int	ret = io_uring_queue_init(max_events, ring, 0);
+
+	if (ret == 0) {
+		return(true);
+	}
+
+	switch (ret) {
+	case -ENOSYS:
+		ib::error()
+			<< "io_uring interface is not supported on this"
+			" platform. Please check your OS documentation"
+			" and install appropriate binary of InnoDB.";
+		break;
+
+	case -ENOMEM:
+		ib::error()
+			<< "io_uring_queue_init() failed with ENOMEM."
+			" Check the RLIMIT_MEMLOCK limit (ulimit -l).";
+		break;
+
+	default:
+		ib::error()
+			<< "io_uring setup returned following error["
+			<< -ret << "]";
+		break;
+	}
+
+	ib::info()
+		<< "You can disable Linux Native AIO by"
+		" setting innodb_use_native_aio = 0 in my.cnf";
+
+	return(false);
+}
+#endif /* HAVE_URING */
+
 /** Dispatch an AIO request to the kernel.
 @param[in,out]	slot		an already reserved slot
 @return true on success. */
 bool
 AIO::linux_dispatch(Slot* slot)
 {
+#ifdef HAVE_URING
+	if (uses_uring()) {
+		return(uring_dispatch(slot, true));
+	}
+#endif /* HAVE_URING */
+
 	ut_a(slot->is_reserved);
 	ut_ad(slot->type.validate());
 
@@ -2122,16 +2787,24 @@ AIO::linux_create_io_ctx(
 /** Checks if the system supports native linux aio. On some kernel
 versions where native aio is supported it won't work on tmpfs. In such
 cases we can't use native aio as it is not possible to mix simulated
-and native aio.
+and native aio. With os_aio_uring, io_uring is checked instead of libaio.
 @return: true if supported, false otherwise. */
 bool
 AIO::is_linux_native_aio_supported()
 {
 	int		fd;
+#ifdef HAVE_URING
+	struct io_uring	ring;
+#endif /* HAVE_URING */
 	io_context_t	io_ctx;
 	char		name[1000];
 
+#ifdef HAVE_URING
+	if (os_aio_uring ? !linux_create_io_ctx(1, &ring)
+	    : !linux_create_io_ctx(1, &io_ctx)) {
+#else
 	if (!linux_create_io_ctx(1, &io_ctx)) {
+#endif /* HAVE_URING */
 
 		/* The platform does not support native aio. */
 
@@ -2146,6 +2819,11 @@ AIO::is_linux_native_aio_supported()
 			ib::warn()
 				<< "Unable to create temp file to check"
 				" native AIO support.";
+#ifdef HAVE_URING
+			if (os_aio_uring) {
+				io_uring_queue_exit(&ring);
+			}
+#endif /* HAVE_URING */
 
 			return(false);
 		}
@@ -2175,40 +2853,80 @@ AIO::is_linux_native_aio_supported()
 				<< "Unable to open"
 				<< " \"" << name << "\" to check native"
 				<< " AIO read support.";
+#ifdef HAVE_URING
+			if (os_aio_uring) {
+				io_uring_queue_exit(&ring);
+			}
+#endif /* HAVE_URING */
 
 			return(false);
 		}
 	}
 
-	struct io_event	io_event;
-
-	memset(&io_event, 0x0, sizeof(io_event));
-
 	byte*	buf = static_cast<byte*>(ut_malloc_nokey(srv_page_size * 2));
 	byte*	ptr = static_cast<byte*>(ut_align(buf, srv_page_size));
 
-	struct iocb	iocb;
-
 	/* Suppress valgrind warning. */
 	memset(buf, 0x00, srv_page_size * 2);
-	memset(&iocb, 0x0, sizeof(iocb));
 
-	struct iocb*	p_iocb = &iocb;
+	int	err;
 
-	if (!srv_read_only_mode) {
+#ifdef HAVE_URING
+	if (os_aio_uring) {
+		struct io_uring_sqe*	sqe = io_uring_get_sqe(&ring);
 
-		io_prep_pwrite(p_iocb, fd, ptr, srv_page_size, 0);
+		if (!srv_read_only_mode) {
+			io_uring_prep_write(sqe, fd, ptr, srv_page_size, 0);
+		} else {
+			ut_a(srv_page_size >= 512);
+			io_uring_prep_read(sqe, fd, ptr, 512, 0);
+		}
 
-	} else {
-		ut_a(srv_page_size >= 512);
-		io_prep_pread(p_iocb, fd, ptr, 512, 0);
-	}
+		err = io_uring_submit(&ring);
+
+		if (err >= 1) {
+			/* Now collect the submitted IO request. A kernel
+			that does not know IORING_OP_READ or IORING_OP_WRITE
+			fails the request with EINVAL. */
+			struct io_uring_cqe*	cqe;
+
+			err = io_uring_wait_cqe(&ring, &cqe);
+
+			if (err == 0) {
+				err = cqe->res < 0 ? cqe->res : 1;
+				io_uring_cqe_seen(&ring, cqe);
+			}
+		}
+
+		io_uring_queue_exit(&ring);
+	} else
+#endif /* HAVE_URING */
+	{
+		struct io_event	io_event;
+
+		memset(&io_event, 0x0, sizeof(io_event));
+
+		struct iocb	iocb;
+
+		memset(&iocb, 0x0, sizeof(iocb));
+
+		struct iocb*	p_iocb = &iocb;
+
+		if (!srv_read_only_mode) {
 
-	int	err = io_submit(io_ctx, 1, &p_iocb);
+			io_prep_pwrite(p_iocb, fd, ptr, srv_page_size, 0);
 
-	if (err >= 1) {
-		/* Now collect the submitted IO request. */
-		err = io_getevents(io_ctx, 1, 1, &io_event, NULL);
+		} else {
+			ut_a(srv_page_size >= 512);
+			io_prep_pread(p_iocb, fd, ptr, 512, 0);
+		}
+
+		err = io_submit(io_ctx, 1, &p_iocb);
+
+		if (err >= 1) {
+			/* Now collect the submitted IO request. */
+			err = io_getevents(io_ctx, 1, 1, &io_event, NULL);
+		}
 	}
 
 	ut_free(buf);
@@ -5577,7 +6295,10 @@ AIO::AIO(
 	m_slots(n),
 	m_n_segments(segments),
 	m_n_reserved()
-# ifdef LINUX_NATIVE_AIO
+# if defined(LINUX_NATIVE_AIO) && defined(HAVE_URING)
+	,m_uring()
+# endif /* LINUX_NATIVE_AIO && HAVE_URING */
+# if defined(LINUX_NATIVE_AIO)
 	,m_aio_ctx(),
 	m_events(m_slots.size())
 # endif /* LINUX_NATIVE_AIO */
@@ -5594,7 +6315,7 @@ AIO::AIO(
 	m_is_empty = os_event_create("aio_is_empty");
 
 	memset((void*)&m_slots[0], 0x0, sizeof(m_slots[0]) * m_slots.size());
-#ifdef LINUX_NATIVE_AIO
+#if defined(LINUX_NATIVE_AIO)
 	memset(&m_events[0], 0x0, sizeof(m_events[0]) * m_events.size());
 #endif /* LINUX_NATIVE_AIO */
 
@@ -5631,10 +6352,100 @@ AIO::init_slots()
 }
 
 #ifdef LINUX_NATIVE_AIO
-/** Initialise the Linux Native AIO interface */
+# ifdef HAVE_URING
+/** Initialise the io_uring instances of the array. If that fails,
+m_uring is left NULL, and either libaio is to be used instead
+(innodb_linux_aio=auto) or srv_use_native_aio is cleared.
+@param[in]	id	Latch ID of the submission queue mutexes
+@return DB_SUCCESS or error code */
 dberr_t
-AIO::init_linux_native_aio()
+AIO::init_uring(latch_id_t id)
 {
+	/* Initialize the io_uring array. One ring per segment in the
+	array. Reserve room for the IORING_OP_TIMEOUT of the segment,
+	so that the submission queue cannot overflow. */
+
+	ut_a(m_uring == NULL);
+
+	m_uring = static_cast<uring_t*>(
+		ut_zalloc_nokey(m_n_segments * sizeof(*m_uring)));
+
+	if (m_uring == NULL) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	unsigned	max_events = unsigned(slots_per_segment() + 1);
+
+	for (ulint i = 0; i < m_n_segments; ++i) {
+		uring_t&	u = m_uring[i];
+
+		if (!linux_create_io_ctx(max_events, &u.ring)) {
+			while (i--) {
+				io_uring_queue_exit(&m_uring[i].ring);
+				mutex_destroy(&m_uring[i].mutex);
+				os_event_destroy(m_uring[i].cq_space);
+			}
+
+			ut_free(m_uring);
+			m_uring = NULL;
+
+			/* Any further arrays will not try io_uring. */
+			os_aio_uring = false;
+
+			if (srv_linux_aio == SRV_LINUX_AIO_AUTO) {
+				ib::warn()
+					<< "io_uring_queue_init() failed;"
+					" using libaio. To get rid of this"
+					" warning you can try increasing"
+					" RLIMIT_MEMLOCK or setting"
+					" innodb_linux_aio = aio in my.cnf";
+				return(DB_SUCCESS);
+			}
+
+			ib::warn()
+				<< "Linux Native AIO disabled because"
+				" io_uring_queue_init() failed. To get rid"
+				" of this warning you can try increasing"
+				" RLIMIT_MEMLOCK or setting"
+				" innodb_use_native_aio = 0 in my.cnf";
+			srv_use_native_aio = FALSE;
+			return(DB_SUCCESS);
+		}
+
+		mutex_create(id, &u.mutex);
+		u.cq_space = os_event_create(0);
+		u.timeout.tv_sec = 0;
+		u.timeout.tv_nsec = OS_AIO_REAP_TIMEOUT;
+	}
+
+	return(DB_SUCCESS);
+}
+# endif /* HAVE_URING */
+
+/** Initialise the Linux Native AIO interface
+@param[in]	id	Latch ID */
+dberr_t
+AIO::init_linux_native_aio(latch_id_t id)
+{
+# ifdef HAVE_URING
+	if (os_aio_uring) {
+		dberr_t	err = init_uring(id);
+
+		if (err != DB_SUCCESS || uses_uring()
+		    || !srv_use_native_aio) {
+			return(err);
+		}
+
+		/* innodb_linux_aio=auto: fall back to libaio, which
+		AIO::start() did not check. */
+		if (!is_linux_native_aio_supported()) {
+			ib::warn() << "Linux Native AIO disabled.";
+			srv_use_native_aio = FALSE;
+			return(DB_SUCCESS);
+		}
+	}
+# endif /* HAVE_URING */
+
 	/* Initialize the io_context array. One io_context
 	per segment in the array. */
 
@@ -5680,16 +6491,17 @@ AIO::init_linux_native_aio()
 }
 #endif /* LINUX_NATIVE_AIO */
 
-/** Initialise the array */
+/** Initialise the array
+@param[in]	id	Latch ID */
 dberr_t
-AIO::init()
+AIO::init(latch_id_t id)
 {
 	ut_a(!m_slots.empty());
 
 
 	if (srv_use_native_aio) {
 #ifdef LINUX_NATIVE_AIO
-		dberr_t	err = init_linux_native_aio();
+		dberr_t	err = init_linux_native_aio(id);
 
 		if (err != DB_SUCCESS) {
 			return(err);
@@ -5726,7 +6538,7 @@ AIO::create(
 
 	AIO*	array = UT_NEW_NOKEY(AIO(id, n, n_segments));
 
-	if (array != NULL && array->init() != DB_SUCCESS) {
+	if (array != NULL && array->init(id) != DB_SUCCESS) {
 
 		UT_DELETE(array);
 
@@ -5744,6 +6556,17 @@ AIO::~AIO()
 	os_event_destroy(m_not_full);
 	os_event_destroy(m_is_empty);
 
+#if defined(LINUX_NATIVE_AIO) && defined(HAVE_URING)
+	if (m_uring != NULL) {
+		for (ulint i = 0; i < m_n_segments; ++i) {
+			io_uring_queue_exit(&m_uring[i].ring);
+			mutex_destroy(&m_uring[i].mutex);
+			os_event_destroy(m_uring[i].cq_space);
+		}
+
+		ut_free(m_uring);
+	}
+#endif /* LINUX_NATIVE_AIO && HAVE_URING */
 #if defined(LINUX_NATIVE_AIO)
 	if (srv_use_native_aio) {
 		m_events.clear();
@@ -5777,8 +6600,33 @@ AIO::start(
 	ulint		n_slots_sync)
 {
 #if defined(LINUX_NATIVE_AIO)
+# ifdef HAVE_URING
+	/* Try io_uring first, unless innodb_linux_aio=aio */
+	os_aio_uring = srv_use_native_aio
+		&& srv_linux_aio != SRV_LINUX_AIO_AIO;
+
+	if (os_aio_uring && !is_linux_native_aio_supported()) {
+
+		os_aio_uring = false;
+
+		if (srv_linux_aio == SRV_LINUX_AIO_AUTO) {
+			ib::warn() << "io_uring is not available;"
+				" using libaio.";
+		} else {
+			ib::warn() << "Linux Native AIO disabled.";
+
+			srv_use_native_aio = FALSE;
+		}
+	}
+
+# endif /* HAVE_URING */
+
 	/* Check if native aio is supported on this system and tmpfs */
-	if (srv_use_native_aio && !is_linux_native_aio_supported()) {
+	if (srv_use_native_aio
+# ifdef HAVE_URING
+	    && !os_aio_uring
+# endif /* HAVE_URING */
+	    && !is_linux_native_aio_supported()) {
 
 		ib::warn() << "Linux Native AIO disabled.";
 
@@ -5867,6 +6715,13 @@ AIO::start(
 
 	os_last_printout = ut_time();
 
+#ifdef HAVE_URING
+	if (srv_use_native_aio) {
+		ib::info() << "Linux native AIO uses "
+			<< (os_aio_uring ? "io_uring" : "libaio");
+	}
+#endif /* HAVE_URING */
+
 	if (srv_use_native_aio) {
 		return(true);
 	}
@@ -5958,9 +6813,9 @@ os_aio_wake_all_threads_at_shutdown()
 	AIO::wake_at_shutdown();
 #elif defined(LINUX_NATIVE_AIO)
 	/* When using native AIO interface the io helper threads
-	wait on io_getevents with a timeout value of 500ms. At
-	each wake up these threads check the server status.
-	No need to do anything to wake them up. */
+	wait on io_getevents (or on an io_uring timeout request)
+	with a timeout value of 500ms. At each wake up these threads
+	check the server status. No need to do anything to wake them up. */
 #endif /* !WIN_ASYNC_AIO */
 
 	if (srv_use_native_aio) {
@@ -6162,6 +7017,8 @@ AIO::reserve_slot(
 		ut_a(sizeof(aio_offset) >= sizeof(offset)
 		     || ((os_offset_t) aio_offset) == offset);
 
+		/* This is only used by libaio. For io_uring,
+		uring_dispatch() prepares the submission queue entry. */
 		struct iocb*	iocb = &slot->control;
 
 		if (type.is_read()) {
@@ -6239,11 +7096,16 @@ AIO::wake_simulated_handler_thread(ulint global_segment, ulint segment)
 	release();
 }
 
-/** Wakes up simulated aio i/o-handler threads if they have something to do. */
+/** Wakes up simulated aio i/o-handler threads if they have something to do.
+With io_uring, submits the requests that were queued with
+IORequest::DO_NOT_WAKE. */
 void
 os_aio_simulated_wake_handler_threads()
 {
 	if (srv_use_native_aio) {
+#ifdef HAVE_URING
+		AIO::uring_submit_all();
+#endif /* HAVE_URING */
 		/* We do not use simulated aio: do nothing */
 
 		return;
@@ -6256,6 +7118,29 @@ os_aio_simulated_wake_handler_threads()
 	}
 }
 
+#ifdef HAVE_URING
+/** Register memory with io_uring, so that asynchronous reads and writes
+of buffers inside it can skip the per-request page pinning of the kernel.
+@param[in]	iov	memory ranges, such as the buffer pool chunks
+@param[in]	n	number of memory ranges */
+void
+os_aio_register_buffers(const struct iovec* iov, ulint n)
+{
+	if (srv_use_native_aio && os_aio_uring && n > 0) {
+		AIO::uring_register_buffers(iov, n);
+	}
+}
+
+/** Stop using the memory that was registered by os_aio_register_buffers() */
+void
+os_aio_unregister_buffers()
+{
+	if (srv_use_native_aio) {
+		AIO::uring_unregister_buffers();
+	}
+}
+#endif /* HAVE_URING */
+
 /** Select the IO slot array
 @param[in,out]	type		Type of IO, READ or WRITE
 @param[in]	read_only	true if running in read-only mode
@@ -183,7 +183,6 @@ will mark their views as closed but not actually free their views.
 inline void ReadView::snapshot(trx_t *trx)
 {
   trx_sys.snapshot_ids(trx, &m_ids, &m_low_limit_id, &m_low_limit_no);
-  std::sort(m_ids.begin(), m_ids.end());
   m_up_limit_id= m_ids.empty() ? m_low_limit_id : m_ids.front();
   ut_ad(m_up_limit_id <= m_low_limit_id);
 }
@@ -267,6 +266,24 @@ void ReadView::open(trx_t *trx)
 }
 
 
+void ReadView::open_clone(const ReadView &other)
+{
+  ut_ad(&other != this);
+  ut_ad(state() == READ_VIEW_STATE_CLOSED);
+  ut_ad(other.get_state() == READ_VIEW_STATE_OPEN);
+  /* trx_sys_t::clone_oldest_view() copies the views while holding
+  trx_sys.mutex. */
+  mutex_enter(&trx_sys.mutex);
+  m_ids= other.m_ids;
+  m_low_limit_id= other.m_low_limit_id;
+  m_up_limit_id= other.m_up_limit_id;
+  m_low_limit_no= other.m_low_limit_no;
+  m_creator_trx_id= other.m_creator_trx_id;
+  m_state.store(READ_VIEW_STATE_OPEN, std::memory_order_release);
+  mutex_exit(&trx_sys.mutex);
+}
+
+
 /**
   Clones the oldest view and stores it in view.
 
@@ -25,6 +25,7 @@ Database monitor counter interfaces
 Created 12/9/2009 Jimmy Yang
 *******************************************************/
 
+#include "btr0sea.h"
 #include "buf0buf.h"
 #include "dict0mem.h"
 #include "ibuf0ibuf.h"
@@ -466,6 +467,18 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_FLUSH_SYNC_WAITS},
 
+	{"buffer_flush_busy_instances", "buffer",
+	 "Number of times a buffer pool instance was not requested to flush"
+	 " because its previous request was still being processed",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_BUSY_INSTANCES},
+
+	{"buffer_flush_max_instance_lsn_age", "buffer",
+	 "Largest LSN age of the oldest modified page among the buffer pool"
+	 " instances",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_MAX_INSTANCE_AGE},
+
 	/* Cumulative counter for flush batches for adaptive flushing  */
 	{"buffer_flush_adaptive_total_pages", "buffer",
 	 "Total pages flushed as part of adaptive flushing",
@@ -863,6 +876,28 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_DISPLAY_CURRENT,
 	 MONITOR_DEFAULT_START, MONITOR_PURGE_RESUME_COUNT},
 
+	{"purge_threads_in_use", "purge",
+	 "Number of purge threads used for the last purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_N_THREADS},
+
+	{"purge_batch_tables", "purge",
+	 "Number of tables in the undo log records of the last purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_BATCH_TABLES},
+
+	{"purge_batch_max_thread_records", "purge",
+	 "Largest number of undo log records assigned to one purge thread"
+	 " in the last purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_BATCH_MAX_THREAD_RECS},
+
+	{"purge_table_rebalanced", "purge",
+	 "Number of times the undo log records of a table were moved to a"
+	 " less loaded purge thread",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_TABLE_REBALANCED},
+
 	/* ========== Counters for Recovery Module ========== */
 	{"module_log", "recovery", "Recovery Module",
 	 MONITOR_MODULE,
@@ -1049,6 +1084,132 @@ static monitor_info_t	innodb_counter_info[] =
 	 static_cast<monitor_type_t>(
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_SEARCH},
+
+	{"adaptive_hash_searches_latchless", "adaptive_hash_index",
+	 "Number of Adaptive Hash Index lookups that did not acquire"
+	 " the partition latch",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_LATCHLESS},
+
+	{"adaptive_hash_searches_latchless_retry", "adaptive_hash_index",
+	 "Number of Adaptive Hash Index lookups that were repeated"
+	 " under the partition latch due to a concurrent modification",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_LATCHLESS_RETRY},
+
+	{"adaptive_hash_part0_hits", "adaptive_hash_index",
+	 "Number of successful Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 0",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART0_HITS},
+
+	{"adaptive_hash_part1_hits", "adaptive_hash_index",
+	 "Number of successful Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 1",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART1_HITS},
+
+	{"adaptive_hash_part2_hits", "adaptive_hash_index",
+	 "Number of successful Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 2",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART2_HITS},
+
+	{"adaptive_hash_part3_hits", "adaptive_hash_index",
+	 "Number of successful Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 3",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART3_HITS},
+
+	{"adaptive_hash_part4_hits", "adaptive_hash_index",
+	 "Number of successful Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 4",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART4_HITS},
+
+	{"adaptive_hash_part5_hits", "adaptive_hash_index",
+	 "Number of successful Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 5",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART5_HITS},
+
+	{"adaptive_hash_part6_hits", "adaptive_hash_index",
+	 "Number of successful Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 6",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART6_HITS},
+
+	{"adaptive_hash_part7_hits", "adaptive_hash_index",
+	 "Number of successful Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 7",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART7_HITS},
+
+	{"adaptive_hash_part0_misses", "adaptive_hash_index",
+	 "Number of failed Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 0",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART0_MISSES},
+
+	{"adaptive_hash_part1_misses", "adaptive_hash_index",
+	 "Number of failed Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 1",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART1_MISSES},
+
+	{"adaptive_hash_part2_misses", "adaptive_hash_index",
+	 "Number of failed Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 2",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART2_MISSES},
+
+	{"adaptive_hash_part3_misses", "adaptive_hash_index",
+	 "Number of failed Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 3",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART3_MISSES},
+
+	{"adaptive_hash_part4_misses", "adaptive_hash_index",
+	 "Number of failed Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 4",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART4_MISSES},
+
+	{"adaptive_hash_part5_misses", "adaptive_hash_index",
+	 "Number of failed Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 5",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART5_MISSES},
+
+	{"adaptive_hash_part6_misses", "adaptive_hash_index",
+	 "Number of failed Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 6",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART6_MISSES},
+
+	{"adaptive_hash_part7_misses", "adaptive_hash_index",
+	 "Number of failed Adaptive Hash Index searches in partitions"
+	 " whose number modulo 8 is 7",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART7_MISSES},
 #endif /* BTR_CUR_HASH_ADAPT */
 
 	{"adaptive_hash_searches_btree", "adaptive_hash_index",
@@ -2011,6 +2172,41 @@ srv_mon_process_existing_counter(
 	case MONITOR_OVLD_ADAPTIVE_HASH_SEARCH:
 		value = btr_cur_n_sea;
 		break;
+
+	case MONITOR_OVLD_ADAPTIVE_HASH_LATCHLESS:
+		value = btr_search_sys ? btr_search_sys->n_latchless : 0;
+		break;
+
+	case MONITOR_OVLD_ADAPTIVE_HASH_LATCHLESS_RETRY:
+		value = btr_search_sys
+			? btr_search_sys->n_latchless_retry : 0;
+		break;
+
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART0_HITS:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART1_HITS:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART2_HITS:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART3_HITS:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART4_HITS:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART5_HITS:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART6_HITS:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART7_HITS:
+		value = btr_search_part_stat(
+			monitor_id - MONITOR_OVLD_ADAPTIVE_HASH_PART0_HITS,
+			true);
+		break;
+
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART0_MISSES:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART1_MISSES:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART2_MISSES:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART3_MISSES:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART4_MISSES:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART5_MISSES:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART6_MISSES:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART7_MISSES:
+		value = btr_search_part_stat(
+			monitor_id - MONITOR_OVLD_ADAPTIVE_HASH_PART0_MISSES,
+			false);
+		break;
 #endif /* BTR_CUR_HASH_ADAPT */
 
 	case MONITOR_OVLD_ADAPTIVE_HASH_SEARCH_BTREE:
@@ -162,6 +162,14 @@ use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
 my_bool	srv_numa_interleave;
+#ifdef HAVE_URING
+/** innodb_linux_aio: the interface of innodb_use_native_aio;
+@see srv_linux_aio_t */
+ulong	srv_linux_aio;
+/** innodb_uring_fixed_buffers: whether to register the buffer pool
+memory with io_uring */
+my_bool	srv_uring_fixed_buffers;
+#endif /* HAVE_URING */
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
 /** innodb_compression_algorithm; used with page compression */
@@ -193,6 +201,8 @@ ulong		srv_page_size;
 ulong		srv_page_size_shift;
 /** innodb_log_write_ahead_size */
 ulong		srv_log_write_ahead_size;
+/** innodb_log_parallel_copy */
+my_bool		srv_log_parallel_copy;
 
 /** innodb_adaptive_flushing; try to flush dirty pages so as to avoid
 IO bursts at the checkpoints. */
@@ -322,6 +332,10 @@ by SELECT or mysqldump. When this is nonzero, we do not allow any user
 modifications to the data. */
 ulong	srv_force_recovery;
 
+/** innodb_recovery_apply_threads: number of threads that apply redo log
+records to buffer pool pages during crash recovery */
+ulong	srv_n_recovery_apply_threads;
+
 /** innodb_print_all_deadlocks; whether to print all user-level
 transactions deadlocks to the error log */
 my_bool	srv_print_all_deadlocks;
@@ -375,6 +389,17 @@ number of pages to use in LRU and flush_list batch flushing.
 The rest of the doublewrite buffer is used for single-page flushing. */
 ulong	srv_doublewrite_batch_size = 120;
 
+/** innodb_doublewrite_files: number of files outside the system tablespace
+used for the doublewrite of batch flushes, or 0 to use the doublewrite
+buffer in the system tablespace. Each buffer pool instance uses the file
+instance_no % srv_doublewrite_files. */
+ulong	srv_doublewrite_files;
+
+/** innodb_read_view_cache: whether read views that are created while
+no read-write transaction starts or commits share one MVCC snapshot
+instead of each iterating trx_sys.rw_trx_hash */
+my_bool	srv_read_view_cache;
+
 /** innodb_replication_delay */
 ulong	srv_replication_delay;
 
@@ -1286,9 +1311,12 @@ srv_printf_innodb_monitor(
 		table->heap will be pointing to the same object
 		for the full lifetime of the server. Even during
 		btr_search_disable() the heap will stay valid. */
+		const btr_search_part_t& part = btr_search_sys->parts[i];
 		fprintf(file, "Hash table size " ULINTPF
-			", node heap has " ULINTPF " buffer(s)\n",
-			table->n_cells, heap->base.count - !heap->free_block);
+			", node heap has " ULINTPF " buffer(s)"
+			", hits " ULINTPF ", misses " ULINTPF "\n",
+			table->n_cells, heap->base.count - !heap->free_block,
+			ulint(part.n_hits), ulint(part.n_misses));
 	}
 
 	fprintf(file,
@@ -2537,17 +2565,30 @@ srv_do_purge(ulint* n_total_purged)
 		n_use_threads = n_threads;
 	}
 
+	/* Pretend that the previous batch used half of the threads
+	and left an empty history behind. */
+	DBUG_EXECUTE_IF("srv_purge_ramp_up",
+			n_use_threads = std::max<ulint>(n_threads / 2, 1);
+			rseg_history_len = 0;);
+
 	do {
-		if (trx_sys.rseg_history_len > rseg_history_len
-		    || (srv_max_purge_lag > 0
-			&& rseg_history_len > srv_max_purge_lag)) {
+		if (srv_max_purge_lag > 0
+		    && rseg_history_len > srv_max_purge_lag) {
+
+			/* DML is being delayed. Use all threads. */
+
+			n_use_threads = n_threads;
+
+		} else if (trx_sys.rseg_history_len > rseg_history_len) {
 
 			/* History length is now longer than what it was
-			when we took the last snapshot. Use more threads. */
+			when we took the last snapshot. Use more threads,
+			doubling their number while the history keeps
+			growing, so that a long history is caught up
+			with quickly. */
 
-			if (n_use_threads < n_threads) {
-				++n_use_threads;
-			}
+			n_use_threads = std::min(2 * n_use_threads,
+						 n_threads);
 
 		} else if (srv_check_activity(old_activity_count)
 			   && n_use_threads > 1) {
@@ -2566,6 +2607,8 @@ srv_do_purge(ulint* n_total_purged)
 		ut_a(n_use_threads > 0);
 		ut_a(n_use_threads <= n_threads);
 
+		MONITOR_SET(MONITOR_PURGE_N_THREADS, n_use_threads);
+
 		/* Take a snapshot of the history list before purge. */
 		if (!(rseg_history_len = trx_sys.rseg_history_len)) {
 			break;
@@ -1104,6 +1104,17 @@ trx_purge_fetch_next_rec(
 	return(trx_purge_get_next_rec(n_pages_handled, heap));
 }
 
+/** Number of undo records by which the purge node of a table may exceed
+the least loaded node before further records of the table are moved to
+the least loaded node */
+static const ulint TRX_PURGE_REBALANCE_RECS = 64;
+
+/** Map from table_id to the purge node that its undo records are
+assigned to in a purge batch */
+typedef std::map<
+	table_id_t, ulint, std::less<table_id_t>,
+	ut_allocator<std::pair<const table_id_t, ulint> > >	table_node_map;
+
 /** Run a purge batch.
 @param n_purge_threads	number of purge threads
 @return number of undo log pages handled in the batch */
@@ -1144,28 +1155,36 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 #endif
 
 	/* Fetch and parse the UNDO records. The UNDO records are added
-	to a per purge node vector. */
+	to a per purge node vector. The records of a table are assigned
+	to the same node, so that each purge thread mostly works on its
+	own tables and index pages, unless that would leave the node
+	with clearly more work than the least loaded one. */
+	purge_node_t*	nodes[SRV_MAX_N_PURGE_THREADS];
+	ulint		n_recs[SRV_MAX_N_PURGE_THREADS];
+
+	ut_a(n_purge_threads <= SRV_MAX_N_PURGE_THREADS);
+
 	thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
 	ut_a(n_thrs > 0 && thr != NULL);
 
-	ut_ad(purge_sys.head <= purge_sys.tail);
+	for (i = 0; i < n_purge_threads; i++) {
+		ut_a(thr != NULL);
+		ut_a(!thr->is_active);
+		nodes[i] = static_cast<purge_node_t*>(thr->child);
+		ut_a(que_node_get_type(nodes[i]) == QUE_NODE_PURGE);
+		n_recs[i] = 0;
+		thr = UT_LIST_GET_NEXT(thrs, thr);
+	}
 
-	i = 0;
+	ut_ad(purge_sys.head <= purge_sys.tail);
 
-	const ulint batch_size = srv_purge_batch_size;
+	const ulint	batch_size = srv_purge_batch_size;
+	mem_heap_t*	heap = mem_heap_create(srv_page_size);
+	table_node_map	table_node;
+	ulint		n_rebalanced = 0;
 
 	while (UNIV_LIKELY(srv_undo_sources) || !srv_fast_shutdown) {
-		purge_node_t*		node;
-		trx_purge_rec_t*	purge_rec;
-
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
-		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+		trx_purge_rec_t	rec;
 
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
@@ -1175,39 +1194,89 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 		}
 
 		/* Fetch the next record, and advance the purge_sys.tail. */
-		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
-
-		if (purge_rec->undo_rec != NULL) {
-
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
+		rec.undo_rec = trx_purge_fetch_next_rec(
+			&rec.roll_ptr, &n_pages_handled, heap);
+
+		if (rec.undo_rec == NULL) {
+			break;
+		}
+
+		ulint	least = 0;
+
+		for (ulint j = 1; j < n_purge_threads; j++) {
+			if (n_recs[j] < n_recs[least]) {
+				least = j;
 			}
+		}
 
-			ib_vector_push(node->undo_recs, purge_rec);
+		ulint	n = least;
 
-			if (n_pages_handled >= batch_size) {
+		if (rec.undo_rec != &trx_purge_dummy_rec) {
+			ulint		type;
+			ulint		cmpl_info;
+			bool		updated_extern;
+			undo_no_t	undo_no;
+			table_id_t	table_id;
 
-				break;
+			trx_undo_rec_get_pars(rec.undo_rec, &type, &cmpl_info,
+					      &updated_extern, &undo_no,
+					      &table_id);
+
+			std::pair<table_node_map::iterator, bool> ins
+				= table_node.insert(
+					table_node_map::value_type(
+						table_id, least));
+
+			if (!ins.second) {
+				n = ins.first->second;
+
+				if (n_recs[n] > n_recs[least]
+				    + TRX_PURGE_REBALANCE_RECS) {
+					ins.first->second = n = least;
+					n_rebalanced++;
+				}
 			}
+
+			/* The fetched record is a copy, which starts
+			with its own length. */
+			rec.undo_rec = static_cast<trx_undo_rec_t*>(
+				mem_heap_dup(nodes[n]->heap, rec.undo_rec,
+					     mach_read_from_2(rec.undo_rec)));
+		}
+
+		purge_node_t*	node = nodes[n];
+
+		if (node->undo_recs == NULL) {
+			node->undo_recs = ib_vector_create(
+				ib_heap_allocator_create(node->heap),
+				sizeof(trx_purge_rec_t),
+				batch_size);
 		} else {
-			break;
+			ut_a(!ib_vector_is_empty(node->undo_recs));
 		}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
+		ib_vector_push(node->undo_recs, &rec);
+		n_recs[n]++;
 
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
+		if (n_pages_handled >= batch_size) {
+			break;
 		}
 
-		ut_a(thr != NULL);
+		mem_heap_empty(heap);
 	}
 
+	mem_heap_free(heap);
+
+	ulint	max_recs = 0;
+
+	for (i = 0; i < n_purge_threads; i++) {
+		max_recs = std::max(max_recs, n_recs[i]);
+	}
+
+	MONITOR_SET(MONITOR_PURGE_BATCH_TABLES, table_node.size());
+	MONITOR_SET(MONITOR_PURGE_BATCH_MAX_THREAD_RECS, max_recs);
+	MONITOR_INC_VALUE(MONITOR_PURGE_TABLE_REBALANCED, n_rebalanced);
+
 	ut_ad(purge_sys.head <= purge_sys.tail);
 
 	return(n_pages_handled);
@@ -214,6 +214,10 @@ trx_sys_t::create()
 	rseg_history_len= 0;
 
 	rw_trx_hash.init();
+
+	m_rw_trx_hash_erased.store(0, std::memory_order_relaxed);
+	m_use_snapshot_cache = srv_read_view_cache && !srv_read_only_mode;
+	m_snapshot_cache.init();
 }
 
 /*****************************************************************//**
@@ -324,6 +328,7 @@ trx_sys_t::close()
 	}
 
 	rw_trx_hash.destroy();
+	m_snapshot_cache.destroy();
 
 	/* There can't be any active transactions. */
 
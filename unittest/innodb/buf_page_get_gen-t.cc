@@ -0,0 +1,246 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+*/
+
+/**
+  A microbenchmark of buf_page_get_gen() lookups of buffer pool resident
+  pages, which go through the lock-free page_hash lookup, as the number
+  of threads grows, and a stress test of the same lookups while
+  innodb_buffer_pool_size is being changed, which must wait for the
+  lock-free lookups before it frees any chunk.
+
+  The test runs InnoDB inside the embedded server on a scratch datadir.
+*/
+
+#include <tap.h>
+#include <my_global.h>
+#include <my_sys.h>
+#include <mysql.h>
+#include <stdlib.h>
+
+#include "univ.i"
+#include "buf0buf.h"
+#include "fil0fil.h"
+#include "mtr0mtr.h"
+
+static const char *datadir= "buf_page_get_gen_data";
+
+static MYSQL *mysql;
+static ulint space_id;
+static ulint *pages;
+static ulint n_pages;
+
+static volatile uint32 failed;
+static volatile uint32 stop;
+static uint iterations;
+
+
+static bool query(const char *q)
+{
+  if (!mysql_query(mysql, q))
+  {
+    mysql_free_result(mysql_store_result(mysql));
+    return false;
+  }
+  diag("%s: %s", q, mysql_error(mysql));
+  return true;
+}
+
+
+static bool query_value(const char *q, char *buf, size_t size)
+{
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  if (mysql_query(mysql, q) || !(res= mysql_store_result(mysql)))
+  {
+    diag("%s: %s", q, mysql_error(mysql));
+    return true;
+  }
+  row= mysql_fetch_row(res);
+  if (row && row[mysql_num_fields(res) - 1])
+    strmake(buf, row[mysql_num_fields(res) - 1], size - 1);
+  mysql_free_result(res);
+  return !row;
+}
+
+
+/** Look up a page if it is in the buffer pool.
+@return whether the page was found */
+static bool lookup(ulint page_no)
+{
+  mtr_t mtr;
+  dberr_t err= DB_SUCCESS;
+
+  mtr.start();
+  buf_block_t *block= buf_page_get_gen(page_id_t(space_id, page_no), 0,
+                                       RW_S_LATCH, NULL, BUF_GET_IF_IN_POOL,
+                                       __FILE__, __LINE__, &mtr, &err);
+  mtr.commit();
+  return block != NULL;
+}
+
+
+/** Create and fill the table, and collect its buffer pool resident pages. */
+static bool setup()
+{
+  char buf[64]= "";
+
+  if (query("CREATE DATABASE bench") ||
+      query("CREATE TABLE bench.t1 (a INT PRIMARY KEY, b CHAR(200))"
+            " ENGINE=InnoDB") ||
+      query("INSERT INTO bench.t1 VALUES (1, 'x')"))
+    return true;
+  for (uint i= 0; i < 15; i++)
+    if (query("INSERT INTO bench.t1 SELECT a + (SELECT MAX(a) FROM bench.t1),"
+              " b FROM bench.t1"))
+      return true;
+  if (query_value("SELECT SPACE FROM INFORMATION_SCHEMA.INNODB_SYS_TABLES"
+                  " WHERE NAME = 'bench/t1'", buf, sizeof buf) ||
+      query("SELECT COUNT(*), MAX(b) FROM bench.t1"))
+    return true;
+  space_id= strtoul(buf, NULL, 10);
+
+  const ulint size= fil_space_get_size(space_id);
+  pages= (ulint*) my_malloc(size * sizeof *pages, MYF(MY_FAE));
+  for (ulint page_no= 0; page_no < size; page_no++)
+    if (lookup(page_no))
+      pages[n_pages++]= page_no;
+  return n_pages == 0;
+}
+
+
+static void *lookup_loop(void *)
+{
+  mysql_thread_init();
+  for (uint i= 0; i < iterations; i++)
+    if (!lookup(pages[i % n_pages]))
+      failed= 1;
+  mysql_thread_end();
+  return NULL;
+}
+
+
+static void *resize_lookup_loop(void *)
+{
+  mysql_thread_init();
+  for (uint i= 0; !stop; i++)
+    lookup(pages[i % n_pages]);
+  mysql_thread_end();
+  return NULL;
+}
+
+
+static void bench(uint n_threads)
+{
+  pthread_t threads[64];
+  ulonglong start, elapsed;
+
+  start= my_interval_timer();
+  for (uint i= 0; i < n_threads; i++)
+    pthread_create(&threads[i], NULL, lookup_loop, NULL);
+  for (uint i= 0; i < n_threads; i++)
+    pthread_join(threads[i], NULL);
+  elapsed= my_interval_timer() - start;
+
+  ok(!failed, "%2u threads %10.0f lookups/s", n_threads,
+     (double) n_threads * iterations * 1e9 / (double) (elapsed + 1));
+}
+
+
+/** Wait for the buffer pool resize that was requested to complete. */
+static bool wait_for_resize()
+{
+  char status[512];
+  for (uint i= 0; i < 6000; i++)
+  {
+    status[0]= '\0';
+    if (query_value("SHOW STATUS LIKE 'innodb_buffer_pool_resize_status'",
+                    status, sizeof status))
+      return true;
+    if (strstr(status, "Completed"))
+      return false;
+    my_sleep(10000);
+  }
+  diag("buffer pool resize did not complete: %s", status);
+  return true;
+}
+
+
+static void test_resize(uint n_threads)
+{
+  pthread_t threads[64];
+  bool error= false;
+
+  for (uint i= 0; i < n_threads; i++)
+    pthread_create(&threads[i], NULL, resize_lookup_loop, NULL);
+  for (uint i= 0; i < 4 && !error; i++)
+    error= query(i & 1
+                 ? "SET GLOBAL innodb_buffer_pool_size = 33554432"
+                 : "SET GLOBAL innodb_buffer_pool_size = 67108864") ||
+      wait_for_resize();
+  stop= 1;
+  for (uint i= 0; i < n_threads; i++)
+    pthread_join(threads[i], NULL);
+
+  ok(!error, "%2u threads looking up pages while the buffer pool is resized",
+     n_threads);
+}
+
+
+int main(int argc __attribute__((unused)), char **argv)
+{
+  static const uint threads[]= { 1, 2, 4, 8, 16, 32, 64 };
+  char datadir_arg[FN_REFLEN];
+  char *server_args[]=
+  {
+    argv[0], (char*) "--no-defaults", datadir_arg,
+    (char*) "--lc-messages-dir=" LC_MESSAGES_DIR,
+    (char*) "--default-storage-engine=InnoDB",
+    (char*) "--innodb-buffer-pool-size=32M",
+    (char*) "--innodb-buffer-pool-chunk-size=2M",
+    (char*) "--innodb-log-file-size=8M",
+    (char*) "--innodb-flush-log-at-trx-commit=2"
+  };
+
+  MY_INIT(argv[0]);
+  plan(2 + array_elements(threads));
+  diag("N CPUs: %d", my_getncpus());
+
+  my_rmtree(datadir, MYF(0));
+  my_mkdir(datadir, 0777, MYF(MY_WME));
+  my_snprintf(datadir_arg, sizeof datadir_arg, "--datadir=%s", datadir);
+
+  if (mysql_server_init(array_elements(server_args), server_args, NULL) ||
+      !(mysql= mysql_init(NULL)) ||
+      mysql_options(mysql, MYSQL_OPT_USE_EMBEDDED_CONNECTION, NULL) ||
+      !mysql_real_connect(mysql, NULL, NULL, NULL, NULL, 0, NULL, 0))
+    BAIL_OUT("could not start the embedded server");
+
+  ok(!setup(), "%lu pages of the table are in the buffer pool",
+     (ulong) n_pages);
+
+  iterations= 1000000;
+  for (uint i= 0; i < array_elements(threads); i++)
+    bench(threads[i]);
+
+  test_resize(8);
+
+  my_free(pages);
+  mysql_close(mysql);
+  mysql_server_end();
+  my_rmtree(datadir, MYF(0));
+  return exit_status();
+}
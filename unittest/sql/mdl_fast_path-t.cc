@@ -0,0 +1,206 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+*/
+
+/**
+  Tests of the MDL fast path for unobtrusive locks, and a microbenchmark
+  of acquire/release throughput of SR locks on one hot table as the
+  number of threads grows, with the fast path open and with the fast
+  path closed by a granted obtrusive (SU) lock.
+
+  The fast path of a lock is only enabled once it is hot, that is once
+  MDL_FAST_PATH_MIN_TICKETS (see mdl.cc) tickets are granted at the same
+  time, so with fewer threads all locks are taken under MDL_lock::m_rwlock.
+*/
+
+#include <tap.h>
+#include <sql_class.h>
+#include <mdl.h>
+
+/** MDL_FAST_PATH_MIN_TICKETS */
+static const uint hot_tickets= 4;
+
+/** A minimal context owner, the tests never wait for a lock. */
+
+class Test_owner : public MDL_context_owner
+{
+public:
+  virtual void enter_cond(mysql_cond_t *, mysql_mutex_t *mutex,
+                          const PSI_stage_info *, PSI_stage_info *,
+                          const char *, const char *, int)
+  { m_mutex= mutex; }
+  virtual void exit_cond(const PSI_stage_info *, const char *, const char *,
+                         int)
+  { mysql_mutex_unlock(m_mutex); }
+  virtual int is_killed() { return 0; }
+  virtual THD *get_thd() { return NULL; }
+  virtual bool notify_shared_lock(MDL_context_owner *, bool)
+  { return false; }
+private:
+  mysql_mutex_t *m_mutex;
+};
+
+
+struct Lock_count
+{
+  uint granted, waiting;
+};
+
+static int count_ticket(MDL_ticket *, void *arg, bool granted)
+{
+  Lock_count *count= (Lock_count*) arg;
+  if (granted)
+    count->granted++;
+  else
+    count->waiting++;
+  return 0;
+}
+
+static uint granted_locks()
+{
+  Lock_count count= { 0, 0 };
+  mdl_iterate(count_ticket, &count);
+  return count.granted;
+}
+
+
+static bool lock_table(MDL_context *ctx, enum_mdl_type type)
+{
+  MDL_request request;
+  request.init(MDL_key::TABLE, "test", "t1", type, MDL_TRANSACTION);
+  return ctx->try_acquire_lock(&request) || !request.ticket;
+}
+
+
+static void test_fast_path()
+{
+  Test_owner owner_a, owner_b, owner_hot[hot_tickets];
+  MDL_context ctx_a, ctx_b, ctx_hot[hot_tickets];
+  bool error= false;
+  const uint n= hot_tickets;
+
+  ctx_a.init(&owner_a);
+  ctx_b.init(&owner_b);
+
+  /* Make the lock hot, which enables its fast path */
+  for (uint i= 0; i < hot_tickets; i++)
+  {
+    ctx_hot[i].init(&owner_hot[i]);
+    error|= lock_table(&ctx_hot[i], MDL_SHARED_READ);
+  }
+  ok(!error && granted_locks() == n, "SR locks of a hot table are granted");
+
+  ok(!lock_table(&ctx_a, MDL_SHARED_READ) && granted_locks() == n + 1,
+     "SR lock through the fast path is granted and visible");
+
+  ok(!lock_table(&ctx_b, MDL_SHARED_UPGRADABLE) && granted_locks() == n + 2,
+     "SU lock is granted with the SR lock moved to the granted queue");
+
+  ok(!lock_table(&ctx_a, MDL_SHARED_WRITE) && granted_locks() == n + 3,
+     "SW lock is granted while the fast path is closed");
+
+  ctx_b.release_transactional_locks();
+  ok(granted_locks() == n + 2, "SU lock is released");
+
+  ok(!lock_table(&ctx_b, MDL_SHARED_READ) && granted_locks() == n + 3,
+     "SR lock is granted after the fast path is open again");
+
+  ctx_a.release_transactional_locks();
+  ctx_b.release_transactional_locks();
+  for (uint i= 0; i < hot_tickets; i++)
+    ctx_hot[i].release_transactional_locks();
+  ok(granted_locks() == 0, "all locks are released");
+
+  for (uint i= 0; i < hot_tickets; i++)
+    ctx_hot[i].destroy();
+  ctx_a.destroy();
+  ctx_b.destroy();
+}
+
+
+static volatile uint32 failed;
+static uint iterations;
+
+static void *lock_loop(void *)
+{
+  Test_owner owner;
+  MDL_context ctx;
+
+  my_thread_init();
+  ctx.init(&owner);
+  for (uint i= 0; i < iterations; i++)
+  {
+    if (lock_table(&ctx, MDL_SHARED_READ))
+      failed= 1;
+    ctx.release_transactional_locks();
+  }
+  ctx.destroy();
+  my_thread_end();
+  return NULL;
+}
+
+
+static void bench(uint n_threads, bool fast_path)
+{
+  Test_owner owner;
+  MDL_context ctx;
+  pthread_t threads[64];
+  ulonglong start, elapsed;
+
+  ctx.init(&owner);
+  if (!fast_path && lock_table(&ctx, MDL_SHARED_UPGRADABLE))
+    failed= 1;
+
+  start= my_interval_timer();
+  for (uint i= 0; i < n_threads; i++)
+    pthread_create(&threads[i], NULL, lock_loop, NULL);
+  for (uint i= 0; i < n_threads; i++)
+    pthread_join(threads[i], NULL);
+  elapsed= my_interval_timer() - start;
+
+  ctx.release_transactional_locks();
+  ctx.destroy();
+
+  ok(!failed && granted_locks() == 0,
+     "%2u threads, fast path %-6s %10.0f locks/s", n_threads,
+     fast_path ? "open" : "closed",
+     (double) n_threads * iterations * 1e9 / (double) (elapsed + 1));
+}
+
+
+int main(int argc __attribute__((unused)), char **argv)
+{
+  static const uint threads[]= { 1, 2, 4, 8, 16, 32, 64 };
+
+  MY_INIT(argv[0]);
+  mdl_init();
+
+  plan(7 + 2 * array_elements(threads));
+  diag("N CPUs: %d", my_getncpus());
+
+  test_fast_path();
+
+  iterations= 20000;
+  for (uint i= 0; i < array_elements(threads); i++)
+  {
+    bench(threads[i], true);
+    bench(threads[i], false);
+  }
+
+  mdl_destroy();
+  my_end(0);
+  return exit_status();
+}
@@ -37,6 +37,10 @@
 #ifdef FIONREAD_IN_SYS_FILIO
 # include <sys/filio.h>
 #endif
+#if defined(HAVE_SENDFILE) && defined(HAVE_SYS_SENDFILE_H)
+# include <sys/sendfile.h>
+# define VIO_USE_SENDFILE 1
+#endif
 
 /* Network io wait callbacks  for threadpool */
 static void (*before_io_wait)(void)= 0;
@@ -316,6 +320,106 @@ size_t vio_write(Vio *vio, const uchar* buf, size_t size)
   DBUG_RETURN(ret);
 }
 
+/*
+  Write all of buf, waiting for the socket to become writable as needed.
+  returns 0 on success, -1 on error
+*/
+static int vio_send_all(Vio *vio, const uchar *buf, size_t size, int flags)
+{
+  ssize_t ret;
+
+  while (size)
+  {
+    if ((ret= mysql_socket_send(vio->mysql_socket, (SOCKBUF_T *)buf, size,
+                                flags)) == -1)
+    {
+      int error= socket_errno;
+      if (error != SOCKET_EAGAIN && error != SOCKET_EWOULDBLOCK &&
+          error != SOCKET_EINTR)
+        return -1;
+      if (vio_socket_io_wait(vio, VIO_IO_EVENT_WRITE))
+        return -1;
+      continue;
+    }
+    buf+= ret;
+    size-= ret;
+  }
+  return 0;
+}
+
+
+/*
+  Write header followed by length bytes of file from offset.
+
+  Where sendfile() is available, the file data is copied by the kernel from
+  the page cache to the socket, without being read into the process. Else
+  it is read and written in blocks.
+
+  returns 0 on success, -1 on error
+*/
+int vio_sendfile(Vio *vio, const uchar *header, size_t header_length,
+                 File file, my_off_t offset, size_t length)
+{
+  int ret= 0, flags= 0;
+  my_bool old_mode;
+  DBUG_ENTER("vio_sendfile");
+  DBUG_PRINT("enter", ("sd: %d  file: %d  offset: %llu  length: %zu",
+                       (int)mysql_socket_getfd(vio->mysql_socket), file,
+                       (ulonglong) offset, length));
+  DBUG_ASSERT(vio->type == VIO_TYPE_TCPIP || vio->type == VIO_TYPE_SOCKET);
+
+  /* If timeout is enabled, do not block, sendfile() takes no flags. */
+  if (vio->write_timeout >= 0 && vio_blocking(vio, FALSE, &old_mode))
+    DBUG_RETURN(-1);
+
+#if defined(VIO_USE_SENDFILE) && defined(MSG_MORE)
+  /* The header is sent in the same TCP segment as the file data */
+  flags= MSG_MORE;
+#endif
+  if (header_length && vio_send_all(vio, header, header_length, flags))
+    ret= -1;
+
+  while (!ret && length)
+  {
+#ifdef VIO_USE_SENDFILE
+    off_t pos= (off_t) offset;
+    ssize_t sent= sendfile(mysql_socket_getfd(vio->mysql_socket), file, &pos,
+                           length);
+    if (sent == -1)
+    {
+      int error= socket_errno;
+      if ((error != SOCKET_EAGAIN && error != SOCKET_EWOULDBLOCK &&
+           error != SOCKET_EINTR) ||
+          vio_socket_io_wait(vio, VIO_IO_EVENT_WRITE))
+        ret= -1;
+      continue;
+    }
+    if (sent == 0)
+    {
+      /* The file is shorter than expected */
+      ret= -1;
+      break;
+    }
+#else
+    uchar buf[IO_SIZE];
+    size_t sent= MY_MIN(length, sizeof(buf));
+    if (my_pread(file, buf, sent, offset, MYF(MY_NABP)) ||
+        vio_send_all(vio, buf, sent, 0))
+    {
+      ret= -1;
+      break;
+    }
+#endif
+    offset+= sent;
+    length-= sent;
+  }
+
+  if (vio->write_timeout >= 0)
+    vio_blocking(vio, old_mode, &old_mode);
+  DBUG_PRINT("exit", ("%d", ret));
+  DBUG_RETURN(ret);
+}
+
 int vio_socket_shutdown(Vio *vio, int how)
 {
   int ret= shutdown(mysql_socket_getfd(vio->mysql_socket), how);